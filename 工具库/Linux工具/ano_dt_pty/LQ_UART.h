@@ -0,0 +1,25 @@
+/**
+ ******************************************************************************
+ * @file    LQ_UART.h
+ * @brief   ANO_DT 主机移植层：替代龙邱 LQ_UART.h，串口改为伪终端(pty)
+ * @version 1.0.0
+ ******************************************************************************
+ * ANO_DT.c 先包含本文件再包含 ANO_DT.h，这里定义的配置优先于 ANO_DT.h 中的默认值：
+ * 开启发送队列，临界区用互斥锁代替关中断
+ ******************************************************************************
+ */
+
+#ifndef ANO_DT_HOST_LQ_UART_H
+#define ANO_DT_HOST_LQ_UART_H
+
+#define ANO_DT_TX_QUEUE          1
+#define ANO_DT_ENTER_CRITICAL()  ano_host_enter_critical()
+#define ANO_DT_EXIT_CRITICAL()   ano_host_exit_critical()
+
+void ano_host_enter_critical(void);
+void ano_host_exit_critical(void);
+
+/* 阻塞发送：写入 pty 并按波特率等到最后一个字节"发完"才返回 */
+void UART4_PutBuff(unsigned char *buff, unsigned short len);
+
+#endif /* ANO_DT_HOST_LQ_UART_H */
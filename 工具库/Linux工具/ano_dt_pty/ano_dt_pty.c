@@ -0,0 +1,386 @@
+/**
+ ******************************************************************************
+ * @file    ano_dt_pty.c
+ * @brief   ANO_DT 主机后端：经伪终端(pty)发送，对比阻塞发送与队列发送对控制循环的影响
+ * @version 1.0.0
+ ******************************************************************************
+ * 用法: ./ano_dt_pty [-r 控制频率Hz，默认 500] [-b 波特率，默认 115200，0 不限速] [-t 每种方式运行秒数，默认 2]
+ *
+ * 直接编译固件中的 ANO_DT.c：
+ *   阻塞方式 = ANO_DT_build_int16 + ANO_DT_Send_Data（原来的 ANO_DT_send_int16 行为）
+ *   队列方式 = ANO_DT_send_int16，入队后由模拟 DMA 线程发送并回调 ANO_DT_TX_Done
+ * 线路按 8N1 字节时间限速，接收线程从 pty 从端解析帧，统计丢帧、校验错误和端到端延迟
+ ******************************************************************************
+ */
+
+#define _GNU_SOURCE
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <string.h>
+#include <errno.h>
+#include <math.h>
+#include <time.h>
+#include <unistd.h>
+#include <fcntl.h>
+#include <poll.h>
+#include <termios.h>
+#include <pthread.h>
+#include <stdatomic.h>
+
+#include "LQ_UART.h"
+#include "ANO_DT.h"
+
+#define UART_BITS_PER_BYTE  10      /* 8N1: 起始位 + 8 数据位 + 停止位 */
+
+static uint32_t s_baud = 115200;
+static int s_master = -1;
+static double s_wire_free;          /* 线路空闲时刻，同一时刻只有一个发送方 */
+
+static double now_seconds(void)
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (double)ts.tv_sec + (double)ts.tv_nsec * 1e-9;
+}
+
+static void sleep_until(double t)
+{
+    struct timespec ts;
+    ts.tv_sec = (time_t)t;
+    ts.tv_nsec = (long)((t - (double)ts.tv_sec) * 1e9);
+    while (clock_nanosleep(CLOCK_MONOTONIC, TIMER_ABSTIME, &ts, NULL) == EINTR) {
+    }
+}
+
+/* ======================= 移植层 ======================= */
+
+static pthread_mutex_t s_crit = PTHREAD_MUTEX_INITIALIZER;
+
+void ano_host_enter_critical(void)
+{
+    pthread_mutex_lock(&s_crit);
+}
+
+void ano_host_exit_critical(void)
+{
+    pthread_mutex_unlock(&s_crit);
+}
+
+/**
+ * @brief 模拟串口线路：从 start 与线路空闲两者较晚的时刻开始发送，
+ *        等到最后一个字节移出移位寄存器的时刻，再把整段写入 pty
+ */
+static void wire_send(const unsigned char *buf, unsigned short len, double start)
+{
+    size_t done = 0;
+
+    if (s_baud != 0) {
+        if (s_wire_free < start) {
+            s_wire_free = start;
+        }
+        s_wire_free += (double)len * UART_BITS_PER_BYTE / s_baud;
+        sleep_until(s_wire_free);
+    }
+
+    while (done < len) {
+        ssize_t n = write(s_master, buf + done, len - done);
+        if (n < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            perror("write");
+            return;
+        }
+        done += (size_t)n;
+    }
+}
+
+void UART4_PutBuff(unsigned char *buff, unsigned short len)
+{
+    wire_send(buff, len, now_seconds());
+}
+
+/* 模拟 DMA：ANO_DT_TX_Start 只登记传输，发送线程发完后回调 ANO_DT_TX_Done，相当于传输完成中断 */
+static pthread_mutex_t s_dma_lock = PTHREAD_MUTEX_INITIALIZER;
+static pthread_cond_t s_dma_cond = PTHREAD_COND_INITIALIZER;
+static const unsigned char *s_dma_buf;
+static unsigned char s_dma_len;
+static double s_dma_start;
+static __thread int s_dma_in_done; /* 1：本线程正在 ANO_DT_TX_Done 中，由完成回调接力 */
+static int s_dma_quit;
+
+void ANO_DT_TX_Start(const unsigned char *frame, unsigned char length)
+{
+    pthread_mutex_lock(&s_dma_lock);
+    s_dma_buf = frame;
+    s_dma_len = length;
+    /* 完成中断里接力的帧紧接上一帧发出，不计线程唤醒延迟 */
+    s_dma_start = s_dma_in_done ? s_wire_free : now_seconds();
+    pthread_cond_signal(&s_dma_cond);
+    pthread_mutex_unlock(&s_dma_lock);
+}
+
+static void *dma_thread(void *arg)
+{
+    (void)arg;
+
+    for (;;) {
+        const unsigned char *buf;
+        unsigned char len;
+        double start;
+
+        pthread_mutex_lock(&s_dma_lock);
+        while (s_dma_buf == NULL && !s_dma_quit) {
+            pthread_cond_wait(&s_dma_cond, &s_dma_lock);
+        }
+        if (s_dma_buf == NULL) {
+            pthread_mutex_unlock(&s_dma_lock);
+            break;
+        }
+        buf = s_dma_buf;
+        len = s_dma_len;
+        start = s_dma_start;
+        s_dma_buf = NULL;
+        pthread_mutex_unlock(&s_dma_lock);
+
+        wire_send(buf, len, start);
+        s_dma_in_done = 1;
+        ANO_DT_TX_Done();
+        s_dma_in_done = 0;
+    }
+    return NULL;
+}
+
+/* ======================= 接收端 ======================= */
+
+typedef struct {
+    int fd;
+    atomic_int stop;
+    uint32_t frames;
+    uint32_t bad;
+    uint32_t lost;
+    uint16_t expect;
+    int synced;
+    double latency_sum;             /* ms */
+    double latency_max;
+    uint8_t frame[ANO_DT_INT16_FRAME_LEN];
+    uint8_t idx;
+} reader_t;
+
+static uint32_t now_us(void)
+{
+    return (uint32_t)(uint64_t)(now_seconds() * 1e6);
+}
+
+static void reader_frame(reader_t *r)
+{
+    uint8_t sum = 0;
+    for (int i = 0; i < ANO_DT_INT16_FRAME_LEN - 1; i++) {
+        sum += r->frame[i];
+    }
+    if (sum != r->frame[ANO_DT_INT16_FRAME_LEN - 1]) {
+        r->bad++;
+        return;
+    }
+
+    /* data1 = 序号，data2/data3 = 发送时刻 us 的高/低 16 位，均为大端 */
+    uint16_t seq = (uint16_t)((r->frame[4] << 8) | r->frame[5]);
+    uint32_t sent = ((uint32_t)r->frame[6] << 24) | ((uint32_t)r->frame[7] << 16) |
+                    ((uint32_t)r->frame[8] << 8) | r->frame[9];
+    double latency = (double)(uint32_t)(now_us() - sent) / 1000.0;
+
+    if (r->synced) {
+        r->lost += (uint16_t)(seq - r->expect);
+    }
+    r->synced = 1;
+    r->expect = (uint16_t)(seq + 1);
+    r->frames++;
+    r->latency_sum += latency;
+    r->latency_max = (latency > r->latency_max) ? latency : r->latency_max;
+}
+
+static void reader_byte(reader_t *r, uint8_t c)
+{
+    static const uint8_t header[4] = { 0xAA, 0xAA, 0xF1, 16 };
+
+    if (r->idx == 2 && c == 0xAA) {
+        return;                     /* 连续多个 0xAA，仍停在帧头第二字节之后 */
+    }
+    if (r->idx < 4 && c != header[r->idx]) {
+        r->idx = (c == 0xAA) ? 1 : 0;
+        r->frame[0] = c;
+        return;
+    }
+    r->frame[r->idx++] = c;
+    if (r->idx == ANO_DT_INT16_FRAME_LEN) {
+        reader_frame(r);
+        r->idx = 0;
+    }
+}
+
+static void *reader_thread(void *arg)
+{
+    reader_t *r = arg;
+    uint8_t buf[4096];
+
+    for (;;) {
+        struct pollfd pfd = { r->fd, POLLIN, 0 };
+        int ready = poll(&pfd, 1, 50);
+        if (ready <= 0) {
+            if (r->stop) {
+                break;
+            }
+            continue;
+        }
+        ssize_t n = read(r->fd, buf, sizeof(buf));
+        if (n <= 0) {
+            break;
+        }
+        for (ssize_t i = 0; i < n; i++) {
+            reader_byte(r, buf[i]);
+        }
+    }
+    return NULL;
+}
+
+/**
+ * @brief 打开一对 pty，从端设为原始模式，返回从端描述符
+ */
+static int open_pty(void)
+{
+    struct termios tio;
+
+    s_master = posix_openpt(O_RDWR | O_NOCTTY);
+    if (s_master < 0 || grantpt(s_master) != 0 || unlockpt(s_master) != 0) {
+        perror("posix_openpt");
+        return -1;
+    }
+    int slave = open(ptsname(s_master), O_RDWR | O_NOCTTY);
+    if (slave < 0) {
+        perror("open slave");
+        return -1;
+    }
+    tcgetattr(slave, &tio);
+    cfmakeraw(&tio);
+    tcsetattr(slave, TCSANOW, &tio);
+    return slave;
+}
+
+/* ======================= 控制循环 ======================= */
+
+static int run(int queued, double rate, double seconds)
+{
+    reader_t r;
+    pthread_t reader;
+    uint32_t iters = (uint32_t)(rate * seconds);
+    double period = 1.0 / rate;
+    double call_sum = 0, call_max = 0;
+    uint32_t overruns = 0;
+    unsigned short dropped0 = ANO_DT_TX_Dropped();
+
+    memset(&r, 0, sizeof(r));
+    r.fd = open_pty();
+    if (r.fd < 0) {
+        return -1;
+    }
+    s_wire_free = 0;
+    pthread_create(&reader, NULL, reader_thread, &r);
+
+    double start = now_seconds();
+    for (uint32_t i = 0; i < iters; i++) {
+        double t0 = now_seconds();
+        uint32_t us = (uint32_t)(uint64_t)(t0 * 1e6);
+        short wave = (short)(1000.0 * sin(2.0 * M_PI * 2.0 * i / rate));
+
+        if (queued) {
+            ANO_DT_send_int16((short)i, (short)(us >> 16), (short)us, wave, 0, 0, 0, 0);
+        } else {
+            unsigned char frame[ANO_DT_INT16_FRAME_LEN];
+            unsigned char len = ANO_DT_build_int16(frame, (short)i, (short)(us >> 16), (short)us, wave, 0, 0, 0, 0);
+            ANO_DT_Send_Data(frame, len);
+        }
+
+        double t1 = now_seconds();
+        call_sum += t1 - t0;
+        call_max = (t1 - t0 > call_max) ? t1 - t0 : call_max;
+
+        double next = start + (i + 1) * period;
+        if (t1 > next) {
+            overruns++;
+        } else {
+            sleep_until(next);
+        }
+    }
+    double elapsed = now_seconds() - start;
+
+    /* 等队列发空，再让接收端读完 */
+    while (ANO_DT_TX_Pending() != 0) {
+        sleep_until(now_seconds() + 1e-3);
+    }
+    r.stop = 1;
+    pthread_join(reader, NULL);
+    close(r.fd);
+    close(s_master);
+
+    unsigned short dropped = (unsigned short)(ANO_DT_TX_Dropped() - dropped0);
+    printf("%-9s %9.1f %9.1f %6.1f%% %9u %9.1f %7u %7u %7u %7u %5u %8.2f %8.2f\n",
+           queued ? "queued" : "blocking",
+           call_sum / iters * 1e6, call_max * 1e6, call_sum / elapsed * 100.0, overruns, iters / elapsed,
+           iters, r.frames, dropped, r.lost, r.bad,
+           r.frames ? r.latency_sum / r.frames : 0.0, r.latency_max);
+    return 0;
+}
+
+int main(int argc, char **argv)
+{
+    double rate = 500;
+    double seconds = 2;
+    int opt;
+    pthread_t dma;
+
+    while ((opt = getopt(argc, argv, "r:b:t:")) != -1) {
+        switch (opt) {
+            case 'r': rate = strtod(optarg, NULL); break;
+            case 'b': s_baud = (uint32_t)strtoul(optarg, NULL, 0); break;
+            case 't': seconds = strtod(optarg, NULL); break;
+            default:
+                fprintf(stderr, "usage: %s [-r rate_hz] [-b baud, 0 = unpaced] [-t seconds]\n", argv[0]);
+                return 1;
+        }
+    }
+    if (rate <= 0 || seconds <= 0 || rate * seconds < 1) {
+        fprintf(stderr, "rate and seconds must be > 0\n");
+        return 1;
+    }
+
+    pthread_create(&dma, NULL, dma_thread, NULL);
+
+    printf("8x int16 frames (%d B) at %.0f Hz for %.1f s, ", ANO_DT_INT16_FRAME_LEN, rate, seconds);
+    if (s_baud != 0) {
+        printf("%u baud 8N1 (%.3f ms/frame on the wire), ", s_baud,
+               ANO_DT_INT16_FRAME_LEN * UART_BITS_PER_BYTE * 1000.0 / s_baud);
+    } else {
+        printf("unpaced pty, ");
+    }
+    printf("queue %d slots\n\n", ANO_DT_TX_SLOTS - 1);
+    printf("%-9s %9s %9s %7s %9s %9s %7s %7s %7s %7s %5s %8s %8s\n",
+           "mode", "call us", "max us", "busy", "overruns", "loop Hz",
+           "sent", "recv", "qdrop", "lost", "bad", "lat ms", "max ms");
+
+    if (run(0, rate, seconds) != 0 || run(1, rate, seconds) != 0) {
+        return 1;
+    }
+
+    printf("\ncall = time inside the send call, busy = share of the loop spent sending, "
+           "qdrop = frames rejected by a full queue, lost = sequence gaps seen by the receiver, "
+           "lat = send call to last byte received\n");
+
+    pthread_mutex_lock(&s_dma_lock);
+    s_dma_quit = 1;
+    pthread_cond_signal(&s_dma_cond);
+    pthread_mutex_unlock(&s_dma_lock);
+    pthread_join(dma, NULL);
+    return 0;
+}
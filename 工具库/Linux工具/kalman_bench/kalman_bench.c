@@ -0,0 +1,251 @@
+/**
+ ******************************************************************************
+ * @file    kalman_bench.c
+ * @brief   卡尔曼滤波稳态增益与批量接口的一致性校验和每采样耗时
+ * @version 1.0.0
+ ******************************************************************************
+ * 用法: ./kalman_bench [每组采样数，默认 4000000] [随机种子，默认 1]
+ ******************************************************************************
+ */
+
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#include "kalman.h"
+#include "kalman_batch.h"
+
+#define REPEAT          5           /* 取 5 次中最好的一次 */
+#define INPUT_TICKS     256         /* 预先生成的测量值周期数，循环使用 */
+#define CHECK_TICKS     5000        /* 一致性校验的周期数 */
+
+static const uint16_t channel_counts[] = { 1, 4, 16, 64 };
+
+static kalman_t s_kf[KALMAN_BATCH_MAX_CHANNELS];
+static kalman_batch_t s_batch;
+static float s_input[INPUT_TICKS][KALMAN_BATCH_MAX_CHANNELS];
+static float s_q[KALMAN_BATCH_MAX_CHANNELS], s_r[KALMAN_BATCH_MAX_CHANNELS];
+static volatile float s_sink;
+
+static uint32_t s_rng = 1;
+
+static uint32_t bench_rand(void)
+{
+    uint32_t x = s_rng;
+    x ^= x << 13;
+    x ^= x >> 17;
+    x ^= x << 5;
+    s_rng = x;
+    return x;
+}
+
+/* [lo, hi) 均匀分布 */
+static float rand_range(float lo, float hi)
+{
+    return lo + (hi - lo) * (float)(bench_rand() >> 8) / 16777216.0f;
+}
+
+static double wall_seconds(void)
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (double)ts.tv_sec + (double)ts.tv_nsec * 1e-9;
+}
+
+/* 每路随机的 Q、R（跨三个数量级）和一段带噪声的测量值 */
+static void make_channels(uint16_t count)
+{
+    for (uint16_t i = 0; i < count; i++) {
+        float level = rand_range(-100.0f, 100.0f);
+
+        s_q[i] = powf(10.0f, rand_range(-4.0f, -1.0f));
+        s_r[i] = powf(10.0f, rand_range(-2.0f, 1.0f));
+        for (int t = 0; t < INPUT_TICKS; t++) {
+            level += rand_range(-0.5f, 0.5f);
+            s_input[t][i] = level + rand_range(-3.0f, 3.0f);
+        }
+    }
+}
+
+/* 两组滤波器用同样的参数初始化 */
+static void setup(uint16_t count, uint8_t mode)
+{
+    kalman_batch_init(&s_batch, count);
+    for (uint16_t i = 0; i < count; i++) {
+        kalman_init(&s_kf[i], s_input[0][i], 1.0f, s_q[i], s_r[i]);
+        kalman_set_mode(&s_kf[i], mode);
+        kalman_batch_setup(&s_batch, i, s_input[0][i], 1.0f, s_q[i], s_r[i]);
+    }
+    kalman_batch_set_mode(&s_batch, mode);
+}
+
+static int same_float(float a, float b)
+{
+    return memcmp(&a, &b, sizeof(float)) == 0;
+}
+
+/* 动态、稳态模式下批量与逐路调用逐位比较，返回不一致的次数 */
+static uint32_t check_batch(uint16_t count, uint8_t mode)
+{
+    uint32_t bad = 0;
+
+    setup(count, mode);
+    for (int t = 0; t < CHECK_TICKS; t++) {
+        const float *in = s_input[t % INPUT_TICKS];
+
+        if (t == CHECK_TICKS / 2) {
+            uint16_t ch = (uint16_t)(bench_rand() % count);
+            kalman_set_r(&s_kf[ch], 0.5f);
+            kalman_batch_set_r(&s_batch, ch, 0.5f);
+        }
+        for (uint16_t i = 0; i < count; i++) {
+            kalman_update(&s_kf[i], in[i]);
+        }
+        kalman_batch_update(&s_batch, in);
+        for (uint16_t i = 0; i < count; i++) {
+            if (!same_float(s_kf[i].x, s_batch.x[i]) || !same_float(s_kf[i].K, s_batch.K[i])) {
+                bad++;
+            }
+        }
+    }
+    return bad;
+}
+
+/*
+ * 自动模式与动态模式的差别：
+ * 进入稳态前的采样数，进入稳态后两者输出的最大差值（相对测量噪声幅度 3.0）
+ */
+static void check_auto(uint16_t count, uint32_t *max_settle, double *max_diff, double *max_gain_err)
+{
+    kalman_t dyn, aut;
+
+    *max_settle = 0;
+    *max_diff = 0;
+    *max_gain_err = 0;
+    for (uint16_t i = 0; i < count; i++) {
+        uint32_t settle = 0;
+
+        kalman_init(&dyn, s_input[0][i], 1.0f, s_q[i], s_r[i]);
+        kalman_init(&aut, s_input[0][i], 1.0f, s_q[i], s_r[i]);
+        kalman_set_mode(&aut, KALMAN_MODE_AUTO);
+        for (int t = 0; t < CHECK_TICKS; t++) {
+            float in = s_input[t % INPUT_TICKS][i];
+
+            kalman_update(&dyn, in);
+            kalman_update(&aut, in);
+            if (!kalman_is_steady(&aut)) {
+                settle = (uint32_t)t + 1;
+            } else {
+                double d = fabs((double)dyn.x - (double)aut.x);
+                if (d > *max_diff) {
+                    *max_diff = d;
+                }
+            }
+        }
+        if (settle > *max_settle) {
+            *max_settle = settle;
+        }
+        /* 迭代 CHECK_TICKS 次后的 K 与解析解的相对误差 */
+        double err = fabs((double)dyn.K - (double)aut.K) / (double)aut.K;
+        if (err > *max_gain_err) {
+            *max_gain_err = err;
+        }
+    }
+}
+
+/* 每路一个采样的纳秒数：逐路调用 kalman_update() */
+static double time_per_call(uint16_t count, uint32_t samples, uint8_t mode)
+{
+    uint32_t ticks = samples / count;
+    double best = 1e30;
+
+    for (int r = 0; r < REPEAT; r++) {
+        setup(count, mode);
+        double t0 = wall_seconds();
+        for (uint32_t t = 0; t < ticks; t++) {
+            const float *in = s_input[t % INPUT_TICKS];
+            for (uint16_t i = 0; i < count; i++) {
+                kalman_update(&s_kf[i], in[i]);
+            }
+        }
+        double dt = wall_seconds() - t0;
+        if (dt < best) {
+            best = dt;
+        }
+        s_sink = s_kf[0].x;
+    }
+    return best / ((double)ticks * count) * 1e9;
+}
+
+/* 每路一个采样的纳秒数：批量 */
+static double time_batch(uint16_t count, uint32_t samples, uint8_t mode)
+{
+    uint32_t ticks = samples / count;
+    double best = 1e30;
+
+    for (int r = 0; r < REPEAT; r++) {
+        setup(count, mode);
+        double t0 = wall_seconds();
+        for (uint32_t t = 0; t < ticks; t++) {
+            kalman_batch_update(&s_batch, s_input[t % INPUT_TICKS]);
+        }
+        double dt = wall_seconds() - t0;
+        if (dt < best) {
+            best = dt;
+        }
+        s_sink = s_batch.x[0];
+    }
+    return best / ((double)ticks * count) * 1e9;
+}
+
+int main(int argc, char **argv)
+{
+    uint32_t samples = 4000000;
+
+    if (argc > 1) {
+        samples = (uint32_t)strtoul(argv[1], NULL, 0);
+    }
+    if (argc > 2) {
+        s_rng = (uint32_t)strtoul(argv[2], NULL, 0);
+    }
+    if (s_rng == 0) {
+        s_rng = 1;
+    }
+
+    make_channels(KALMAN_BATCH_MAX_CHANNELS);
+
+    {
+        uint32_t settle;
+        double diff, gain_err;
+
+        check_auto(KALMAN_BATCH_MAX_CHANNELS, &settle, &diff, &gain_err);
+        printf("auto mode, %d channels, Q 1e-4~1e-1, R 1e-2~1e1:\n", KALMAN_BATCH_MAX_CHANNELS);
+        printf("  samples before steady (max)      %u\n", settle);
+        printf("  max |auto - dynamic| after steady %.3g\n", diff);
+        printf("  max relative K error (iterated vs closed form) %.3g\n", gain_err);
+        printf("batch vs kalman_update mismatches: dynamic %u, steady %u\n\n",
+               check_batch(KALMAN_BATCH_MAX_CHANNELS, KALMAN_MODE_DYNAMIC),
+               check_batch(KALMAN_BATCH_MAX_CHANNELS, KALMAN_MODE_STEADY));
+    }
+
+    printf("ns per channel-sample, best of %d\n", REPEAT);
+    printf("%4s %14s %14s %14s %14s %10s\n",
+           "N", "update dyn", "update steady", "batch dyn", "batch steady", "speedup");
+    for (size_t k = 0; k < sizeof(channel_counts) / sizeof(channel_counts[0]); k++) {
+        uint16_t count = channel_counts[k];
+        if (count > KALMAN_BATCH_MAX_CHANNELS) {
+            continue;
+        }
+
+        double call_dyn = time_per_call(count, samples, KALMAN_MODE_DYNAMIC);
+        double call_steady = time_per_call(count, samples, KALMAN_MODE_STEADY);
+        double batch_dyn = time_batch(count, samples, KALMAN_MODE_DYNAMIC);
+        double batch_steady = time_batch(count, samples, KALMAN_MODE_STEADY);
+
+        printf("%4u %14.2f %14.2f %14.2f %14.2f %9.1fx\n", count,
+               call_dyn, call_steady, batch_dyn, batch_steady, call_dyn / batch_steady);
+    }
+    return 0;
+}
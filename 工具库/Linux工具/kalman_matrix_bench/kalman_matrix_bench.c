@@ -0,0 +1,647 @@
+/**
+ ******************************************************************************
+ * @file    kalman_matrix_bench.c
+ * @brief   编译期定维卡尔曼模板（kalman_matrix.h）与通用稠密实现的一致性和每步耗时
+ * @version 1.0.0
+ ******************************************************************************
+ * 用法: ./kalman_matrix_bench [每组步数，默认 1000000]
+ *
+ * 三个场景：
+ *   2 状态  mcu_dmp.c 的偏航角 [角度, 角速度] 滤波，测量角度
+ *   4 状态  平面匀速目标跟踪 [px, py, vx, vy]，测量位置（2维）
+ *   7 状态  四元数 + 陀螺零偏扩展卡尔曼，测量加速度计重力方向（3维）
+ * 对照实现：运行时维数的稠密矩阵，完整的 P，S = H*P*H' + R 用高斯-约当求逆
+ ******************************************************************************
+ */
+
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#define KALMAN_MATRIX_NAME  yaw_kf
+#define KALMAN_MATRIX_N     2
+#include "kalman_matrix.h"
+
+#define KALMAN_MATRIX_NAME  track_kf
+#define KALMAN_MATRIX_N     4
+#define KALMAN_MATRIX_M     2
+#include "kalman_matrix.h"
+
+#define KALMAN_MATRIX_NAME  att_ekf
+#define KALMAN_MATRIX_N     7
+#define KALMAN_MATRIX_M     3
+#include "kalman_matrix.h"
+
+#define REPEAT      5           /* 取 5 次中最好的一次 */
+#define STEPS       4000        /* 预先生成的测量序列长度（20 s），计时时循环使用 */
+#define DT          0.005f
+#define DENSE_MAX   7
+
+static uint32_t s_rng = 1;
+static volatile float s_sink;
+
+static uint32_t bench_rand(void)
+{
+    uint32_t x = s_rng;
+    x ^= x << 13;
+    x ^= x >> 17;
+    x ^= x << 5;
+    s_rng = x;
+    return x;
+}
+
+/* 近似高斯噪声（4个均匀分布之和），标准差 sigma */
+static float rand_noise(float sigma)
+{
+    float s = 0.0f;
+    for (int i = 0; i < 4; i++) {
+        s += (float)(bench_rand() >> 8) / 16777216.0f - 0.5f;
+    }
+    return s * 1.7320508f * sigma;
+}
+
+static double wall_seconds(void)
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (double)ts.tv_sec + (double)ts.tv_nsec * 1e-9;
+}
+
+/* ======================= 稠密对照实现 ======================= */
+
+typedef struct {
+    int n;
+    float x[DENSE_MAX];
+    float P[DENSE_MAX][DENSE_MAX];
+    float Q[DENSE_MAX][DENSE_MAX];
+} DENSE_KF_T;
+
+static void dense_init(DENSE_KF_T *kf, int n, const float *x, float p, float q)
+{
+    memset(kf, 0, sizeof(*kf));
+    kf->n = n;
+    for (int i = 0; i < n; i++) {
+        kf->x[i] = x ? x[i] : 0.0f;
+        kf->P[i][i] = p;
+        kf->Q[i][i] = q;
+    }
+}
+
+/* x 由调用者更新；P = F*P*F' + Q */
+static void dense_predict_cov(DENSE_KF_T *kf, const float F[DENSE_MAX][DENSE_MAX])
+{
+    int n = kf->n;
+    float A[DENSE_MAX][DENSE_MAX];
+
+    for (int i = 0; i < n; i++) {
+        for (int k = 0; k < n; k++) {
+            float acc = 0.0f;
+            for (int j = 0; j < n; j++) {
+                acc += F[i][j] * kf->P[j][k];
+            }
+            A[i][k] = acc;
+        }
+    }
+    for (int i = 0; i < n; i++) {
+        for (int k = 0; k < n; k++) {
+            float acc = kf->Q[i][k];
+            for (int j = 0; j < n; j++) {
+                acc += A[i][j] * F[k][j];
+            }
+            kf->P[i][k] = acc;
+        }
+    }
+}
+
+/* 高斯-约当求逆，m <= 3 */
+static int dense_inverse(int m, float S[3][3], float inv[3][3])
+{
+    for (int i = 0; i < m; i++) {
+        for (int j = 0; j < m; j++) {
+            inv[i][j] = (i == j) ? 1.0f : 0.0f;
+        }
+    }
+    for (int c = 0; c < m; c++) {
+        int piv = c;
+        for (int r = c + 1; r < m; r++) {
+            if (fabsf(S[r][c]) > fabsf(S[piv][c])) {
+                piv = r;
+            }
+        }
+        if (S[piv][c] == 0.0f) {
+            return -1;
+        }
+        for (int j = 0; j < m; j++) {
+            float t = S[c][j]; S[c][j] = S[piv][j]; S[piv][j] = t;
+            t = inv[c][j]; inv[c][j] = inv[piv][j]; inv[piv][j] = t;
+        }
+        float d = 1.0f / S[c][c];
+        for (int j = 0; j < m; j++) {
+            S[c][j] *= d;
+            inv[c][j] *= d;
+        }
+        for (int r = 0; r < m; r++) {
+            if (r != c) {
+                float f = S[r][c];
+                for (int j = 0; j < m; j++) {
+                    S[r][j] -= f * S[c][j];
+                    inv[r][j] -= f * inv[c][j];
+                }
+            }
+        }
+    }
+    return 0;
+}
+
+/* 一次性矩阵形式的测量更新：K = P*H'*S^-1, x += K*v, P = (I - K*H)*P */
+static void dense_update(DENSE_KF_T *kf, int m, const float H[3][DENSE_MAX], const float *innovation,
+                         const float *r)
+{
+    int n = kf->n;
+    float PHt[DENSE_MAX][3], S[3][3], Sinv[3][3], K[DENSE_MAX][3], KH[DENSE_MAX][DENSE_MAX];
+    float P[DENSE_MAX][DENSE_MAX];
+
+    for (int i = 0; i < n; i++) {
+        for (int a = 0; a < m; a++) {
+            float acc = 0.0f;
+            for (int j = 0; j < n; j++) {
+                acc += kf->P[i][j] * H[a][j];
+            }
+            PHt[i][a] = acc;
+        }
+    }
+    for (int a = 0; a < m; a++) {
+        for (int b = 0; b < m; b++) {
+            float acc = (a == b) ? r[a] : 0.0f;
+            for (int j = 0; j < n; j++) {
+                acc += H[a][j] * PHt[j][b];
+            }
+            S[a][b] = acc;
+        }
+    }
+    if (dense_inverse(m, S, Sinv) != 0) {
+        return;
+    }
+    for (int i = 0; i < n; i++) {
+        for (int a = 0; a < m; a++) {
+            float acc = 0.0f;
+            for (int b = 0; b < m; b++) {
+                acc += PHt[i][b] * Sinv[b][a];
+            }
+            K[i][a] = acc;
+        }
+    }
+    for (int i = 0; i < n; i++) {
+        for (int a = 0; a < m; a++) {
+            kf->x[i] += K[i][a] * innovation[a];
+        }
+    }
+    for (int i = 0; i < n; i++) {
+        for (int j = 0; j < n; j++) {
+            float acc = (i == j) ? 1.0f : 0.0f;
+            for (int a = 0; a < m; a++) {
+                acc -= K[i][a] * H[a][j];
+            }
+            KH[i][j] = acc;
+        }
+    }
+    for (int i = 0; i < n; i++) {
+        for (int j = 0; j < n; j++) {
+            float acc = 0.0f;
+            for (int k = 0; k < n; k++) {
+                acc += KH[i][k] * kf->P[k][j];
+            }
+            P[i][j] = acc;
+        }
+    }
+    memcpy(kf->P, P, sizeof(P));
+}
+
+/* ======================= 2 状态：mcu_dmp.c 偏航角滤波 ======================= */
+
+/* 与 mcu_dmp.c 的 ekf_update() 相同（手工展开），作为第三种对照 */
+typedef struct {
+    float x[2];
+    float p[2][2];
+    float q[2];
+    float r;
+    int init;
+} UNROLLED_KF_T;
+
+static void unrolled_update(UNROLLED_KF_T *ekf, float measurement, float dt)
+{
+    if (!ekf->init) {
+        ekf->x[0] = measurement;
+        ekf->init = 1;
+        return;
+    }
+    ekf->x[0] += ekf->x[1] * dt;
+
+    float temp_p[2][2];
+    temp_p[0][0] = ekf->p[0][0] + dt * ekf->p[1][0] + dt * ekf->p[0][1] + dt * dt * ekf->p[1][1] + ekf->q[0];
+    temp_p[0][1] = ekf->p[0][1] + dt * ekf->p[1][1];
+    temp_p[1][0] = ekf->p[1][0] + dt * ekf->p[1][1];
+    temp_p[1][1] = ekf->p[1][1] + ekf->q[1];
+
+    float k[2];
+    k[0] = temp_p[0][0] / (temp_p[0][0] + ekf->r);
+    k[1] = temp_p[1][0] / (temp_p[0][0] + ekf->r);
+
+    float innovation = measurement - ekf->x[0];
+    ekf->x[0] += k[0] * innovation;
+    ekf->x[1] += k[1] * innovation;
+
+    ekf->p[0][0] = (1 - k[0]) * temp_p[0][0];
+    ekf->p[0][1] = (1 - k[0]) * temp_p[0][1];
+    ekf->p[1][0] = temp_p[1][0] - k[1] * temp_p[0][0];
+    ekf->p[1][1] = temp_p[1][1] - k[1] * temp_p[0][1];
+}
+
+static float s_yaw[STEPS];
+static const float s_yaw_F[2][2] = { { 1.0f, DT }, { 0.0f, 1.0f } };
+static const float s_yaw_q[2] = { 0.001f, 0.002f };
+
+static void yaw_make(void)
+{
+    for (int t = 0; t < STEPS; t++) {
+        float tt = t * DT;
+        s_yaw[t] = 30.0f * sinf(0.8f * tt) + 10.0f * tt + rand_noise(0.5f);
+    }
+}
+
+static void yaw_kf_start(yaw_kf_t *kf)
+{
+    yaw_kf_init(kf, NULL, 0.1f, 0.0f);
+    yaw_kf_set_q_diag(kf, s_yaw_q);
+    kf->x[0] = s_yaw[0];
+}
+
+static void yaw_kf_step(yaw_kf_t *kf, float z)
+{
+    yaw_kf_predict(kf, s_yaw_F);
+    yaw_kf_update_state(kf, 0, z, 0.3f);
+}
+
+static void yaw_unrolled_start(UNROLLED_KF_T *kf)
+{
+    memset(kf, 0, sizeof(*kf));
+    kf->p[0][0] = kf->p[1][1] = 0.1f;
+    kf->q[0] = s_yaw_q[0];
+    kf->q[1] = s_yaw_q[1];
+    kf->r = 0.3f;
+    unrolled_update(kf, s_yaw[0], DT);
+}
+
+static void yaw_dense_start(DENSE_KF_T *kf)
+{
+    dense_init(kf, 2, NULL, 0.1f, 0.0f);
+    kf->Q[0][0] = s_yaw_q[0];
+    kf->Q[1][1] = s_yaw_q[1];
+    kf->x[0] = s_yaw[0];
+}
+
+static void yaw_dense_step(DENSE_KF_T *kf, float z)
+{
+    static const float F[DENSE_MAX][DENSE_MAX] = { { 1.0f, DT }, { 0.0f, 1.0f } };
+    static const float H[3][DENSE_MAX] = { { 1.0f, 0.0f } };
+    static const float r = 0.3f;
+    float v;
+
+    kf->x[0] += kf->x[1] * DT;
+    dense_predict_cov(kf, F);
+    v = z - kf->x[0];
+    dense_update(kf, 1, H, &v, &r);
+}
+
+/* ======================= 4 状态：匀速目标跟踪 ======================= */
+
+static float s_pos[STEPS][2];
+static const float s_track_F[4][4] = {
+    { 1.0f, 0.0f, DT, 0.0f }, { 0.0f, 1.0f, 0.0f, DT }, { 0.0f, 0.0f, 1.0f, 0.0f }, { 0.0f, 0.0f, 0.0f, 1.0f }
+};
+static const float s_track_H[2][4] = { { 1.0f, 0.0f, 0.0f, 0.0f }, { 0.0f, 1.0f, 0.0f, 0.0f } };
+static const float s_track_r[2] = { 0.04f, 0.04f };
+
+static void track_make(void)
+{
+    float px = 0, py = 0, vx = 1.0f, vy = -0.5f;
+
+    for (int t = 0; t < STEPS; t++) {
+        vx += rand_noise(0.02f);
+        vy += rand_noise(0.02f);
+        px += vx * DT;
+        py += vy * DT;
+        s_pos[t][0] = px + rand_noise(0.2f);
+        s_pos[t][1] = py + rand_noise(0.2f);
+    }
+}
+
+static void track_kf_step(track_kf_t *kf, const float *z)
+{
+    track_kf_predict(kf, s_track_F);
+    track_kf_update(kf, s_track_H, z, s_track_r);
+}
+
+static void track_dense_step(DENSE_KF_T *kf, const float *z)
+{
+    static const float F[DENSE_MAX][DENSE_MAX] = {
+        { 1.0f, 0.0f, DT, 0.0f }, { 0.0f, 1.0f, 0.0f, DT }, { 0.0f, 0.0f, 1.0f, 0.0f }, { 0.0f, 0.0f, 0.0f, 1.0f }
+    };
+    static const float H[3][DENSE_MAX] = { { 1.0f, 0.0f, 0.0f, 0.0f }, { 0.0f, 1.0f, 0.0f, 0.0f } };
+    float x[4], v[2];
+
+    for (int i = 0; i < 4; i++) {
+        float acc = 0.0f;
+        for (int j = 0; j < 4; j++) {
+            acc += F[i][j] * kf->x[j];
+        }
+        x[i] = acc;
+    }
+    memcpy(kf->x, x, sizeof(x));
+    dense_predict_cov(kf, F);
+    v[0] = z[0] - kf->x[0];
+    v[1] = z[1] - kf->x[1];
+    dense_update(kf, 2, H, v, s_track_r);
+}
+
+/* ======================= 7 状态：四元数 + 陀螺零偏 ======================= */
+
+static float s_gyro[STEPS][3], s_acc[STEPS][3], s_true_q[STEPS][4];
+static const float s_bias[3] = { 0.02f, -0.01f, 0.015f };
+static const float s_att_r[3] = { 0.0025f, 0.0025f, 0.0025f };
+static const float s_att_q[7] = { 1e-6f, 1e-6f, 1e-6f, 1e-6f, 1e-9f, 1e-9f, 1e-9f };
+
+static void quat_normalize(float *q)
+{
+    float n = 1.0f / sqrtf(q[0] * q[0] + q[1] * q[1] + q[2] * q[2] + q[3] * q[3]);
+    for (int i = 0; i < 4; i++) {
+        q[i] *= n;
+    }
+}
+
+/* q += 0.5 * dt * q ⊗ [0, w] */
+static void quat_integrate(const float *q, const float *w, float dt, float *out)
+{
+    float h = 0.5f * dt;
+    out[0] = q[0] + h * (-q[1] * w[0] - q[2] * w[1] - q[3] * w[2]);
+    out[1] = q[1] + h * (q[0] * w[0] + q[2] * w[2] - q[3] * w[1]);
+    out[2] = q[2] + h * (q[0] * w[1] + q[3] * w[0] - q[1] * w[2]);
+    out[3] = q[3] + h * (q[0] * w[2] + q[1] * w[1] - q[2] * w[0]);
+}
+
+/* 机体系下的重力方向 */
+static void quat_gravity(const float *q, float *g)
+{
+    g[0] = 2.0f * (q[1] * q[3] - q[0] * q[2]);
+    g[1] = 2.0f * (q[2] * q[3] + q[0] * q[1]);
+    g[2] = q[0] * q[0] - q[1] * q[1] - q[2] * q[2] + q[3] * q[3];
+}
+
+static void att_make(void)
+{
+    float q[4] = { 1.0f, 0.0f, 0.0f, 0.0f };
+
+    for (int t = 0; t < STEPS; t++) {
+        float tt = t * DT;
+        float w[3] = { 0.5f * sinf(0.7f * tt), 0.4f * cosf(0.5f * tt), 0.3f * sinf(0.3f * tt) };
+        float g[3];
+
+        quat_integrate(q, w, DT, q);
+        quat_normalize(q);
+        memcpy(s_true_q[t], q, sizeof(q));
+        quat_gravity(q, g);
+        for (int i = 0; i < 3; i++) {
+            s_gyro[t][i] = w[i] + s_bias[i] + rand_noise(0.01f);
+            s_acc[t][i] = g[i] + rand_noise(0.05f);
+        }
+    }
+}
+
+/* 预测模型 f(x) 和雅可比 F，两种实现共用 */
+static void att_model(const float *x, const float *gyro, float x_pred[7], float F[7][7])
+{
+    float w[3] = { gyro[0] - x[4], gyro[1] - x[5], gyro[2] - x[6] };
+    float h = 0.5f * DT;
+
+    quat_integrate(x, w, DT, x_pred);
+    x_pred[4] = x[4];
+    x_pred[5] = x[5];
+    x_pred[6] = x[6];
+
+    memset(F, 0, sizeof(float) * 49);
+    for (int i = 0; i < 7; i++) {
+        F[i][i] = 1.0f;
+    }
+    /* d(q_pred)/dq = I + 0.5*dt*Omega(w) */
+    F[0][1] = -h * w[0]; F[0][2] = -h * w[1]; F[0][3] = -h * w[2];
+    F[1][0] = h * w[0];  F[1][2] = h * w[2];  F[1][3] = -h * w[1];
+    F[2][0] = h * w[1];  F[2][1] = -h * w[2]; F[2][3] = h * w[0];
+    F[3][0] = h * w[2];  F[3][1] = h * w[1];  F[3][2] = -h * w[0];
+    /* d(q_pred)/db = -0.5*dt*Xi(q) */
+    F[0][4] = h * x[1];  F[0][5] = h * x[2];  F[0][6] = h * x[3];
+    F[1][4] = -h * x[0]; F[1][5] = h * x[3];  F[1][6] = -h * x[2];
+    F[2][4] = -h * x[3]; F[2][5] = -h * x[0]; F[2][6] = h * x[1];
+    F[3][4] = h * x[2];  F[3][5] = -h * x[1]; F[3][6] = -h * x[0];
+}
+
+/* 测量新息 z - h(x) 和雅可比 H */
+static void att_measure(const float *x, const float *acc, float v[3], float H[3][7])
+{
+    float g[3];
+
+    quat_gravity(x, g);
+    for (int i = 0; i < 3; i++) {
+        v[i] = acc[i] - g[i];
+    }
+    memset(H, 0, sizeof(float) * 21);
+    H[0][0] = -2.0f * x[2]; H[0][1] = 2.0f * x[3];  H[0][2] = -2.0f * x[0]; H[0][3] = 2.0f * x[1];
+    H[1][0] = 2.0f * x[1];  H[1][1] = 2.0f * x[0];  H[1][2] = 2.0f * x[3];  H[1][3] = 2.0f * x[2];
+    H[2][0] = 2.0f * x[0];  H[2][1] = -2.0f * x[1]; H[2][2] = -2.0f * x[2]; H[2][3] = 2.0f * x[3];
+}
+
+static void att_ekf_start(att_ekf_t *kf)
+{
+    static const float x0[7] = { 1.0f, 0, 0, 0, 0, 0, 0 };
+    static const float p0[7] = { 0.1f, 0.1f, 0.1f, 0.1f, 1e-3f, 1e-3f, 1e-3f };
+
+    att_ekf_init(kf, x0, 0.1f, 0.0f);
+    att_ekf_set_p_diag(kf, p0);
+    att_ekf_set_q_diag(kf, s_att_q);
+}
+
+static void att_ekf_step(att_ekf_t *kf, int t)
+{
+    float x_pred[7], F[7][7], v[3], H[3][7];
+
+    att_model(kf->x, s_gyro[t], x_pred, F);
+    att_ekf_predict_ext(kf, x_pred, (const float (*)[7])F);
+    att_measure(kf->x, s_acc[t], v, H);
+    att_ekf_update_ext(kf, (const float (*)[7])H, v, s_att_r);
+    quat_normalize(kf->x);
+}
+
+static void att_dense_start(DENSE_KF_T *kf)
+{
+    static const float x0[7] = { 1.0f, 0, 0, 0, 0, 0, 0 };
+
+    dense_init(kf, 7, x0, 0.1f, 0.0f);
+    for (int i = 0; i < 7; i++) {
+        kf->P[i][i] = (i < 4) ? 0.1f : 1e-3f;
+        kf->Q[i][i] = s_att_q[i];
+    }
+}
+
+static void att_dense_step(DENSE_KF_T *kf, int t)
+{
+    float x_pred[7], F7[7][7], v[3], H7[3][7];
+    float F[DENSE_MAX][DENSE_MAX], H[3][DENSE_MAX];
+
+    att_model(kf->x, s_gyro[t], x_pred, F7);
+    memcpy(kf->x, x_pred, sizeof(x_pred));
+    memcpy(F, F7, sizeof(F7));              /* DENSE_MAX == 7 */
+    dense_predict_cov(kf, (const float (*)[DENSE_MAX])F);
+    att_measure(kf->x, s_acc[t], v, H7);
+    memcpy(H, H7, sizeof(H7));
+    dense_update(kf, 3, (const float (*)[DENSE_MAX])H, v, s_att_r);
+    quat_normalize(kf->x);
+}
+
+/* 估计与真实重力方向的夹角（度），只看横滚俯仰 */
+static double tilt_error_deg(const float *q_est, const float *q_true)
+{
+    float a[3], b[3];
+    quat_gravity(q_est, a);
+    quat_gravity(q_true, b);
+    double c = (double)a[0] * b[0] + (double)a[1] * b[1] + (double)a[2] * b[2];
+    if (c > 1.0) {
+        c = 1.0;
+    }
+    return acos(c) * 57.29578;
+}
+
+/* ======================= 主程序 ======================= */
+
+static double max_abs_diff(const float *a, const float *b, int n)
+{
+    double d = 0;
+    for (int i = 0; i < n; i++) {
+        double e = fabs((double)a[i] - (double)b[i]);
+        if (e > d) {
+            d = e;
+        }
+    }
+    return d;
+}
+
+#define TIME_LOOP(result, start, step_expr)                             \
+    do {                                                                \
+        double best_ = 1e30;                                            \
+        for (int r_ = 0; r_ < REPEAT; r_++) {                           \
+            start;                                                      \
+            double t0_ = wall_seconds();                                \
+            for (uint32_t i_ = 0; i_ < steps; i_++) {                   \
+                int t = (int)(i_ % STEPS);                              \
+                step_expr;                                              \
+            }                                                           \
+            double dt_ = wall_seconds() - t0_;                          \
+            if (dt_ < best_) {                                          \
+                best_ = dt_;                                            \
+            }                                                           \
+        }                                                               \
+        (result) = best_ / steps * 1e9;                                 \
+    } while (0)
+
+int main(int argc, char **argv)
+{
+    uint32_t steps = 1000000;
+    yaw_kf_t yaw;
+    track_kf_t track;
+    att_ekf_t att;
+    UNROLLED_KF_T unrolled;
+    DENSE_KF_T dense;
+    double d_dense, d_unrolled, t_tmpl, t_dense, t_unrolled;
+
+    if (argc > 1) {
+        steps = (uint32_t)strtoul(argv[1], NULL, 0);
+    }
+    if (steps == 0) {
+        steps = 1;
+    }
+
+    yaw_make();
+    track_make();
+    att_make();
+
+    printf("sizeof: yaw_kf_t %zu, track_kf_t %zu, att_ekf_t %zu, dense %zu\n\n",
+           sizeof(yaw_kf_t), sizeof(track_kf_t), sizeof(att_ekf_t), sizeof(DENSE_KF_T));
+
+    /* 一致性：同一测量序列跑一遍，比较状态 */
+    d_dense = d_unrolled = 0;
+    yaw_kf_start(&yaw);
+    yaw_dense_start(&dense);
+    yaw_unrolled_start(&unrolled);
+    for (int t = 1; t < STEPS; t++) {
+        yaw_kf_step(&yaw, s_yaw[t]);
+        yaw_dense_step(&dense, s_yaw[t]);
+        unrolled_update(&unrolled, s_yaw[t], DT);
+        d_dense = fmax(d_dense, max_abs_diff(yaw.x, dense.x, 2));
+        d_unrolled = fmax(d_unrolled, max_abs_diff(yaw.x, unrolled.x, 2));
+    }
+    printf("2-state yaw:    max |x - dense| %.3g, max |x - mcu_dmp unrolled| %.3g\n", d_dense, d_unrolled);
+
+    d_dense = 0;
+    track_kf_init(&track, NULL, 1.0f, 1e-6f);
+    dense_init(&dense, 4, NULL, 1.0f, 1e-6f);
+    for (int t = 0; t < STEPS; t++) {
+        track_kf_step(&track, s_pos[t]);
+        track_dense_step(&dense, s_pos[t]);
+        d_dense = fmax(d_dense, max_abs_diff(track.x, dense.x, 4));
+    }
+    printf("4-state track:  max |x - dense| %.3g (position noise 0.2)\n", d_dense);
+
+    {
+        double tilt = 0, bias = 0;
+
+        d_dense = 0;
+        att_ekf_start(&att);
+        att_dense_start(&dense);
+        for (int t = 0; t < STEPS; t++) {
+            att_ekf_step(&att, t);
+            att_dense_step(&dense, t);
+            d_dense = fmax(d_dense, max_abs_diff(att.x, dense.x, 7));
+            if (t >= STEPS - 1000) {
+                tilt = fmax(tilt, tilt_error_deg(att.x, s_true_q[t]));
+            }
+        }
+        bias = fmax(fabs(att.x[4] - s_bias[0]), fabs(att.x[5] - s_bias[1]));
+        printf("7-state att:    max |x - dense| %.3g, tilt error (last 5 s) %.2f deg, "
+               "bias x/y error %.4f rad/s\n\n", d_dense, tilt, bias);
+    }
+
+    /* 计时：一次预测 + 一次测量更新 */
+    printf("ns per step (predict + update), best of %d x %u steps\n", REPEAT, steps);
+    printf("%-16s %12s %12s %12s %10s\n", "case", "template", "dense", "unrolled", "speedup");
+
+    TIME_LOOP(t_tmpl, yaw_kf_start(&yaw), yaw_kf_step(&yaw, s_yaw[t]));
+    s_sink = yaw.x[0];
+    TIME_LOOP(t_dense, yaw_dense_start(&dense), yaw_dense_step(&dense, s_yaw[t]));
+    s_sink = dense.x[0];
+    TIME_LOOP(t_unrolled, yaw_unrolled_start(&unrolled), unrolled_update(&unrolled, s_yaw[t], DT));
+    s_sink = unrolled.x[0];
+    printf("%-16s %12.1f %12.1f %12.1f %9.1fx\n", "2-state yaw", t_tmpl, t_dense, t_unrolled, t_dense / t_tmpl);
+
+    TIME_LOOP(t_tmpl, track_kf_init(&track, NULL, 1.0f, 1e-6f), track_kf_step(&track, s_pos[t]));
+    s_sink = track.x[0];
+    TIME_LOOP(t_dense, dense_init(&dense, 4, NULL, 1.0f, 1e-6f), track_dense_step(&dense, s_pos[t]));
+    s_sink = dense.x[0];
+    printf("%-16s %12.1f %12.1f %12s %9.1fx\n", "4-state track", t_tmpl, t_dense, "-", t_dense / t_tmpl);
+
+    TIME_LOOP(t_tmpl, att_ekf_start(&att), att_ekf_step(&att, t));
+    s_sink = att.x[0];
+    TIME_LOOP(t_dense, att_dense_start(&dense), att_dense_step(&dense, t));
+    s_sink = dense.x[0];
+    printf("%-16s %12.1f %12.1f %12s %9.1fx\n", "7-state att EKF", t_tmpl, t_dense, "-", t_dense / t_tmpl);
+    return 0;
+}
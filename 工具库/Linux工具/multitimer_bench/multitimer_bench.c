@@ -0,0 +1,341 @@
+/**
+ ******************************************************************************
+ * @file    multitimer_bench.c
+ * @brief   MultiTimer 分层时间轮与原版有序链表的到期一致性校验与耗时对比
+ * @version 1.0.0
+ ******************************************************************************
+ * 用法: ./multitimer_bench [定时器数，默认 10000] [节拍数，默认 100000]
+ *       ./multitimer_bench_c99 同上，MultiTimer 以 -std=gnu99 编译，请求队列不使用 C11 原子操作
+ *
+ * 一致性：2000 个定时器，超时多数为 1~5000 节拍，1/8 为超过时间轮范围（2^24）的长超时；
+ *         主循环一半逐节拍、一半按随机步长（偶尔跳 2^20 节拍）推进时钟，随机停止/重启定时器，
+ *         回调中以新的超时重启，时间轮一半的停止/重启走 FromISR 请求队列。
+ *         两种实现逐次 Yield 比较到期的 (节拍, 定时器) 集合
+ * 耗时：  N 个定时器，超时 1~5000 节拍随机，到期后在回调中以新的随机超时重启，
+ *         逐节拍调用 Yield，统计总耗时与每次到期（含重启）的平均耗时
+ *
+ * 重启超时由 (定时器编号, 第几次到期) 决定，与同一节拍内回调的先后顺序无关，
+ * 两种实现因此运行完全相同的序列。校验失败时程序返回非 0
+ ******************************************************************************
+ */
+
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#include "MultiTimer.h"
+#include "multitimer_list.h"
+
+#define MAX_TIMEOUT     5000u
+#define CHECK_TIMERS    2000u
+#define CHECK_STEPS     100000u
+#define LONG_TIMEOUT    ((uint64_t)1 << 25)  /* 超过默认时间轮范围 2^24 */
+
+static uint64_t s_now;
+static uint32_t *s_fires;           /* 每个定时器的到期次数 */
+static uint64_t s_expired;          /* 本次运行的到期总数 */
+static int s_long;                  /* 回调重启时是否混入长超时 */
+static MultiTimerCtx s_ctx;
+static uint32_t s_isr_fail;         /* FromISR 接口返回失败的次数 */
+
+/* 本次 Yield 到期的定时器编号（一致性校验用），NULL 表示只计数 */
+static uint32_t *s_batch;
+static uint32_t s_batch_len;
+
+static uint64_t bench_ticks(void)
+{
+    return s_now;
+}
+
+static double wall_seconds(void)
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (double)ts.tv_sec + (double)ts.tv_nsec * 1e-9;
+}
+
+static uint32_t xorshift(uint32_t *state)
+{
+    uint32_t x = *state;
+    x ^= x << 13;
+    x ^= x >> 17;
+    x ^= x << 5;
+    *state = x;
+    return x;
+}
+
+static uint32_t mix(uint32_t x)
+{
+    x ^= x >> 16;
+    x *= 0x7FEB352Du;
+    x ^= x >> 15;
+    x *= 0x846CA68Bu;
+    x ^= x >> 16;
+    return x;
+}
+
+/* 第 n 次到期后的重启超时，只取决于编号和次数 */
+static uint64_t timeout_for(uint32_t id, uint32_t n)
+{
+    uint32_t h = mix(id * 0x9E3779B9u + n);
+
+    if (s_long && (h & 7) == 0) {
+        return MAX_TIMEOUT + (h >> 3) % LONG_TIMEOUT;
+    }
+    return 1 + h % MAX_TIMEOUT;
+}
+
+static void on_expire(uint32_t id)
+{
+    s_expired++;
+    s_fires[id]++;
+    if (s_batch != NULL) {
+        s_batch[s_batch_len++] = id;
+    }
+}
+
+/* ======================= 两种实现的回调 ======================= */
+
+static void wheel_cb(MultiTimer *timer, void *userData)
+{
+    uint32_t id = (uint32_t)(uintptr_t)userData;
+
+    on_expire(id);
+    multiTimerCtxStart(&s_ctx, timer, timeout_for(id, s_fires[id]), wheel_cb, userData);
+}
+
+static void list_cb(ListTimer *timer, void *userData)
+{
+    uint32_t id = (uint32_t)(uintptr_t)userData;
+
+    on_expire(id);
+    listTimerStart(timer, timeout_for(id, s_fires[id]), list_cb, userData);
+}
+
+/* ======================= 统一的驱动接口 ======================= */
+
+typedef struct {
+    const char *name;
+    void (*setup)(uint32_t n);
+    void (*start)(uint32_t id, uint64_t timing);
+    void (*stop)(uint32_t id);
+    void (*start_isr)(uint32_t id, uint64_t timing);   /* 中断接口，链表没有，等同于直接调用 */
+    void (*stop_isr)(uint32_t id);
+    void (*yield)(void);
+} impl_t;
+
+static MultiTimer *s_wheel_timers;
+static ListTimer *s_list_timers;
+
+static void wheel_setup(uint32_t n)
+{
+    multiTimerCtxInit(&s_ctx, bench_ticks);     /* 每次运行重新初始化，丢弃上次的定时器 */
+    for (uint32_t i = 0; i < n; i++) {
+        multiTimerInit(&s_wheel_timers[i]);
+    }
+}
+
+static void wheel_start(uint32_t id, uint64_t timing)
+{
+    multiTimerCtxStart(&s_ctx, &s_wheel_timers[id], timing, wheel_cb, (void *)(uintptr_t)id);
+}
+
+static void wheel_stop(uint32_t id)
+{
+    multiTimerCtxStop(&s_ctx, &s_wheel_timers[id]);
+}
+
+/* 请求在下一次 Yield 开头应用，截止时间取投递时刻，结果与直接启动/停止相同 */
+static void wheel_start_isr(uint32_t id, uint64_t timing)
+{
+    if (multiTimerCtxStartFromISR(&s_ctx, &s_wheel_timers[id], timing, wheel_cb, (void *)(uintptr_t)id) != 0) {
+        s_isr_fail++;
+    }
+}
+
+static void wheel_stop_isr(uint32_t id)
+{
+    if (multiTimerCtxStopFromISR(&s_ctx, &s_wheel_timers[id]) != 0) {
+        s_isr_fail++;
+    }
+}
+
+static void wheel_yield(void)
+{
+    multiTimerCtxYield(&s_ctx);
+}
+
+static void list_setup(uint32_t n)
+{
+    listTimerInstall(bench_ticks);
+    memset(s_list_timers, 0, n * sizeof(ListTimer));
+}
+
+static void list_start(uint32_t id, uint64_t timing)
+{
+    listTimerStart(&s_list_timers[id], timing, list_cb, (void *)(uintptr_t)id);
+}
+
+static void list_stop(uint32_t id)
+{
+    listTimerStop(&s_list_timers[id]);
+}
+
+static void list_yield(void)
+{
+    listTimerYield();
+}
+
+static const impl_t s_impls[] = {
+    { "sorted list (original)", list_setup, list_start, list_stop, list_start, list_stop, list_yield },
+    { "timing wheel", wheel_setup, wheel_start, wheel_stop, wheel_start_isr, wheel_stop_isr, wheel_yield },
+};
+
+static void reset_run(const impl_t *impl, uint32_t n)
+{
+    s_now = 0;
+    s_expired = 0;
+    memset(s_fires, 0, n * sizeof(s_fires[0]));
+    impl->setup(n);
+}
+
+/* ======================= 一致性 ======================= */
+
+static int cmp_u32(const void *a, const void *b)
+{
+    uint32_t x = *(const uint32_t *)a, y = *(const uint32_t *)b;
+    return (x > y) - (x < y);
+}
+
+/* 返回每次 Yield 的到期集合摘要（节拍 + 排序后的编号），写入 digest[] */
+static void check_run(const impl_t *impl, uint64_t *digest)
+{
+    uint32_t rng = 12345;
+
+    s_long = 1;
+    reset_run(impl, CHECK_TIMERS);
+    for (uint32_t i = 0; i < CHECK_TIMERS; i++) {
+        impl->start(i, timeout_for(i, 0));
+    }
+
+    for (uint32_t step = 0; step < CHECK_STEPS; step++) {
+        uint32_t r = xorshift(&rng);
+        uint64_t h = 14695981039346656037ull;
+
+        /* 一半逐节拍推进，能分辨差一个节拍的到期；其余随机跳 1~64 节拍，偶尔跳 2^20 */
+        if ((r & 1023) == 0) {
+            s_now += (uint64_t)1 << 20;
+        } else {
+            s_now += (r & 1024) ? 1 : 1 + (r >> 11) % 64;
+        }
+
+        /* 主循环中的随机停止/重启，两种实现使用同一随机序列；奇数步改走中断接口 */
+        r = xorshift(&rng);
+        if ((r & 3) == 0) {
+            ((step & 1) ? impl->stop_isr : impl->stop)((r >> 2) % CHECK_TIMERS);
+        } else if ((r & 3) == 1) {
+            uint32_t t = xorshift(&rng);
+            uint64_t timing = (t & 7) ? 1 + t % MAX_TIMEOUT : t % LONG_TIMEOUT + MAX_TIMEOUT;
+            ((step & 1) ? impl->start_isr : impl->start)((r >> 2) % CHECK_TIMERS, timing);
+        }
+
+        s_batch_len = 0;
+        impl->yield();
+        qsort(s_batch, s_batch_len, sizeof(s_batch[0]), cmp_u32);
+        for (uint32_t i = 0; i < s_batch_len; i++) {
+            h = (h ^ s_batch[i]) * 1099511628211ull;
+        }
+        digest[step] = (h ^ s_now) * 1099511628211ull ^ s_batch_len;
+    }
+}
+
+static int check(void)
+{
+    uint64_t *digest[2];
+    uint64_t expired[2];
+    int fail = 0;
+
+    s_batch = malloc(CHECK_TIMERS * sizeof(s_batch[0]));
+    for (int k = 0; k < 2; k++) {
+        digest[k] = malloc(CHECK_STEPS * sizeof(uint64_t));
+        check_run(&s_impls[k], digest[k]);
+        expired[k] = s_expired;
+    }
+
+    for (uint32_t step = 0; step < CHECK_STEPS; step++) {
+        if (digest[0][step] != digest[1][step]) {
+            printf("expiry mismatch at step %u\n", step);
+            fail = 1;
+            break;
+        }
+    }
+    if (expired[0] != expired[1] || s_isr_fail != 0) {
+        fail = 1;
+    }
+    printf("check: %u timers, %u yields, %.1fM virtual ticks, expirations %llu / %llu  %s\n",
+           CHECK_TIMERS, CHECK_STEPS, (double)s_now / 1e6,
+           (unsigned long long)expired[0], (unsigned long long)expired[1], fail ? "FAIL" : "ok");
+
+    free(digest[0]);
+    free(digest[1]);
+    free(s_batch);
+    s_batch = NULL;
+    return fail;
+}
+
+/* ======================= 耗时 ======================= */
+
+static void timing_run(const impl_t *impl, uint32_t n, uint64_t ticks)
+{
+    s_long = 0;
+    reset_run(impl, n);
+    for (uint32_t i = 0; i < n; i++) {
+        impl->start(i, timeout_for(i, 0));
+    }
+
+    double t0 = wall_seconds();
+    for (s_now = 1; s_now <= ticks; s_now++) {
+        impl->yield();
+    }
+    double dt = wall_seconds() - t0;
+
+    printf("%-24s %10.3f s %12llu %12.1f ns\n", impl->name, dt, (unsigned long long)s_expired,
+           s_expired ? dt / (double)s_expired * 1e9 : 0.0);
+}
+
+int main(int argc, char **argv)
+{
+    uint32_t n = 10000;
+    uint64_t ticks = 100000;
+    int fail;
+
+    if (argc > 1) {
+        n = (uint32_t)strtoul(argv[1], NULL, 0);
+    }
+    if (argc > 2) {
+        ticks = strtoull(argv[2], NULL, 0);
+    }
+    if (n < CHECK_TIMERS) {
+        n = CHECK_TIMERS;
+    }
+
+    s_fires = malloc(n * sizeof(s_fires[0]));
+    s_wheel_timers = malloc(n * sizeof(MultiTimer));
+    s_list_timers = malloc(n * sizeof(ListTimer));
+
+    fail = check();
+
+    printf("\n%u timers, timeout 1..%u ticks, restart in callback, %llu ticks\n",
+           n, MAX_TIMEOUT, (unsigned long long)ticks);
+    printf("%-24s %12s %12s %15s\n", "implementation", "total", "expirations", "per expiry");
+    for (int k = 0; k < 2; k++) {
+        timing_run(&s_impls[k], n, ticks);
+    }
+
+    free(s_fires);
+    free(s_wheel_timers);
+    free(s_list_timers);
+    return fail;
+}
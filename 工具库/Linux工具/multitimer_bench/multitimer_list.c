@@ -0,0 +1,72 @@
+/*
+ * 原版 MultiTimer（0x1abin/MultiTimer，MIT）的有序链表实现，仅改了函数名。
+ * 启动时按截止时间插入有序链表，停止时从表头查找，Yield 从表头取出到期定时器。
+ */
+
+#include "multitimer_list.h"
+#include <stddef.h>
+
+static ListTimer* timerList = NULL;
+static uint64_t (*platformTicksFunction)(void) = NULL;
+
+int listTimerInstall(uint64_t (*ticksFunc)(void)) {
+    if (ticksFunc == NULL) {
+        return -1;
+    }
+    platformTicksFunction = ticksFunc;
+    timerList = NULL;
+    return 0;
+}
+
+static void removeTimer(ListTimer* timer) {
+    ListTimer** current = &timerList;
+    while (*current) {
+        if (*current == timer) {
+            *current = timer->next;
+            break;
+        }
+        current = &(*current)->next;
+    }
+}
+
+int listTimerStart(ListTimer* timer, uint64_t timing, ListTimerCallback_t callback, void* userData) {
+    if (!timer || !callback || platformTicksFunction == NULL) {
+        return -1;
+    }
+
+    removeTimer(timer);
+
+    timer->deadline = platformTicksFunction() + timing;
+    timer->callback = callback;
+    timer->userData = userData;
+
+    ListTimer** current = &timerList;
+    while (*current && ((*current)->deadline < timer->deadline)) {
+        current = &(*current)->next;
+    }
+    timer->next = *current;
+    *current = timer;
+
+    return 0;
+}
+
+int listTimerStop(ListTimer* timer) {
+    removeTimer(timer);
+    return 0;
+}
+
+int listTimerYield(void) {
+    if (platformTicksFunction == NULL) {
+        return -1;
+    }
+    uint64_t currentTicks = platformTicksFunction();
+    while (timerList && (currentTicks >= timerList->deadline)) {
+        ListTimer* timer = timerList;
+        timerList = timer->next;
+
+        if (timer->callback) {
+            timer->callback(timer, timer->userData);
+        }
+    }
+    return timerList ? (int)(timerList->deadline - currentTicks) : 0;
+}
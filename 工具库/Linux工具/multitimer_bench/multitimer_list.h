@@ -0,0 +1,31 @@
+/**
+ ******************************************************************************
+ * @file    multitimer_list.h
+ * @brief   原版 MultiTimer 有序链表实现（基准对照用，函数改名以便与时间轮同时链接）
+ * @version 1.0.0
+ ******************************************************************************
+ */
+
+#ifndef _MULTITIMER_LIST_H_
+#define _MULTITIMER_LIST_H_
+
+#include <stdint.h>
+
+typedef struct ListTimerHandle ListTimer;
+
+typedef void (*ListTimerCallback_t)(ListTimer* timer, void* userData);
+
+struct ListTimerHandle {
+    ListTimer* next;
+    uint64_t deadline;
+    ListTimerCallback_t callback;
+    void* userData;
+};
+
+/* 安装时间基准并清空链表（原版只保存函数指针，这里为多次运行加了清空） */
+int listTimerInstall(uint64_t (*ticksFunc)(void));
+int listTimerStart(ListTimer* timer, uint64_t timing, ListTimerCallback_t callback, void* userData);
+int listTimerStop(ListTimer* timer);
+int listTimerYield(void);
+
+#endif
@@ -0,0 +1,180 @@
+/**
+ ******************************************************************************
+ * @file    multitimer_slack_bench.c
+ * @brief   MultiTimer 定时器合并（slack）仿真：不同 slack 下的每秒唤醒次数与最大延迟
+ * @version 1.0.0
+ ******************************************************************************
+ * 用法: ./multitimer_slack_bench [定时器数，默认 100] [秒数，默认 60] [随机种子，默认 1 2 5]
+ *
+ * N 个周期定时器，周期 10~200ms 随机，1ms 节拍逐节拍调用 Yield。两种启动方式：
+ *   同时启动：全部在 t=0 启动，相同周期及其倍数的到期天然重合
+ *   随机相位：第 i 个定时器在 [0, 周期) 内的随机时刻启动
+ * slack 取 0、周期的 10%、周期的 20%，统计窗口从所有定时器启动后开始。
+ * 每次到期检查到期时刻正好是 [截止时间, 截止时间 + slack] 内对齐程度最高的节拍，不符时程序返回非 0
+ ******************************************************************************
+ */
+
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "MultiTimer.h"
+
+#define MIN_PERIOD      10u
+#define MAX_PERIOD      200u
+
+typedef struct {
+    MultiTimer timer;
+    uint64_t period;
+    uint64_t next;          /* 下一次的截止时间 */
+    uint32_t slack;
+    uint32_t phase;
+} sim_timer_t;
+
+static uint64_t s_now;
+static MultiTimerCtx s_ctx;
+static uint64_t s_delay_max;
+static uint64_t s_delay_total;
+static int s_fail;
+
+static uint64_t sim_ticks(void)
+{
+    return s_now;
+}
+
+static uint32_t xorshift(uint32_t *state)
+{
+    uint32_t x = *state;
+    x ^= x << 13;
+    x ^= x >> 17;
+    x ^= x << 5;
+    *state = x;
+    return x;
+}
+
+/* 窗口 [deadline, deadline + slack] 内低位 0 最多的节拍，逐级尝试 2 的幂向上取整 */
+static uint64_t most_aligned(uint64_t deadline, uint32_t slack)
+{
+    for (int j = 63; j > 0; j--) {
+        uint64_t grid = (uint64_t)1 << j;
+        uint64_t m = (deadline + grid - 1) & ~(grid - 1);
+        if (m >= deadline && m <= deadline + slack) {
+            return m;
+        }
+    }
+    return deadline;
+}
+
+static void on_expire(MultiTimer *timer, void *userData)
+{
+    sim_timer_t *t = userData;
+    uint64_t delay = s_now - t->next;
+
+    (void)timer;
+    /* 每个节拍都调用 Yield，到期时刻应正好是窗口内对齐程度最高的节拍 */
+    if (s_now != most_aligned(t->next, t->slack)) {
+        s_fail = 1;
+    }
+    if (delay > s_delay_max) {
+        s_delay_max = delay;
+    }
+    s_delay_total += delay;
+    t->next += t->period;
+}
+
+/* 每秒唤醒次数、每秒到期次数和平均延迟写入输出参数，最大延迟留在 s_delay_max */
+static void run(sim_timer_t *timers, uint32_t n, uint32_t seconds, uint32_t slack_pct, int random_phase,
+                double *wakeups, double *expirations, double *delay_avg)
+{
+    MultiTimerStats st;
+    uint64_t start = random_phase ? MAX_PERIOD : 0;
+
+    s_now = 0;
+    s_delay_max = 0;
+    s_delay_total = 0;
+    multiTimerCtxInit(&s_ctx, sim_ticks);
+    for (uint32_t i = 0; i < n; i++) {
+        multiTimerInit(&timers[i].timer);
+        timers[i].slack = (uint32_t)(timers[i].period * slack_pct / 100);
+        multiTimerSetSlack(&timers[i].timer, timers[i].slack);
+    }
+
+    /* 启动阶段：逐节拍在各自的相位上启动 */
+    for (;; s_now++) {
+        for (uint32_t i = 0; i < n; i++) {
+            if ((random_phase ? timers[i].phase : 0) == s_now) {
+                timers[i].next = s_now + timers[i].period;
+                multiTimerCtxStartPeriodic(&s_ctx, &timers[i].timer, timers[i].period, on_expire, &timers[i]);
+            }
+        }
+        multiTimerCtxYield(&s_ctx);
+        if (s_now >= start) {
+            break;
+        }
+    }
+
+    s_delay_max = 0;
+    s_delay_total = 0;
+    multiTimerCtxResetStats(&s_ctx);
+    for (uint64_t end = s_now + (uint64_t)seconds * 1000; s_now < end;) {
+        s_now++;
+        multiTimerCtxYield(&s_ctx);
+    }
+
+    multiTimerCtxGetStats(&s_ctx, &st);
+    *wakeups = st.wakeups * 1000.0 / (double)st.ticks;
+    *expirations = st.expirations * 1000.0 / (double)st.ticks;
+    *delay_avg = st.expirations ? (double)s_delay_total / st.expirations : 0.0;
+}
+
+int main(int argc, char **argv)
+{
+    static const uint32_t slack_pct[] = { 0, 10, 20 };
+    static const char *const start_name[] = { "all at t=0", "random phase" };
+    uint32_t seeds[8] = { 1, 2, 5 };
+    uint32_t seed_count = 3;
+    uint32_t n = 100;
+    uint32_t seconds = 60;
+
+    if (argc > 1) {
+        n = (uint32_t)strtoul(argv[1], NULL, 0);
+    }
+    if (argc > 2) {
+        seconds = (uint32_t)strtoul(argv[2], NULL, 0);
+    }
+    if (argc > 3) {
+        seed_count = 0;
+        for (int i = 3; i < argc && seed_count < 8; i++) {
+            seeds[seed_count++] = (uint32_t)strtoul(argv[i], NULL, 0);
+        }
+    }
+
+    sim_timer_t *timers = calloc(n, sizeof(sim_timer_t));
+
+    printf("%u periodic timers, period %u..%u ms, 1 ms tick, %u s\n", n, MIN_PERIOD, MAX_PERIOD, seconds);
+    printf("%-14s %5s %6s %12s %14s %10s %10s\n",
+           "start", "seed", "slack", "wakeups/s", "expirations/s", "delay max", "delay avg");
+
+    for (int random_phase = 0; random_phase < 2; random_phase++) {
+        for (uint32_t s = 0; s < seed_count; s++) {
+            uint32_t rng = seeds[s];
+
+            for (uint32_t i = 0; i < n; i++) {
+                timers[i].period = MIN_PERIOD + xorshift(&rng) % (MAX_PERIOD - MIN_PERIOD + 1);
+                timers[i].phase = xorshift(&rng) % (uint32_t)timers[i].period;
+            }
+            for (unsigned k = 0; k < sizeof(slack_pct) / sizeof(slack_pct[0]); k++) {
+                double wakeups, expirations, delay_avg;
+
+                run(timers, n, seconds, slack_pct[k], random_phase, &wakeups, &expirations, &delay_avg);
+                printf("%-14s %5u %5u%% %12.1f %14.1f %8llums %8.2fms\n",
+                       start_name[random_phase], seeds[s], slack_pct[k], wakeups, expirations,
+                       (unsigned long long)s_delay_max, delay_avg);
+            }
+        }
+    }
+
+    free(timers);
+    printf("result: %s\n", s_fail ? "FAIL (expiry is not the most aligned tick of its window)" : "ok");
+    return s_fail;
+}
@@ -0,0 +1,14 @@
+/**
+ ******************************************************************************
+ * @file    fuzz_bno08x.c
+ * @brief   libFuzzer 目标：parseInputReport（经 dataAvailable/receivePacket）
+ ******************************************************************************
+ */
+
+#include "parsers.h"
+
+int LLVMFuzzerTestOneInput(const uint8_t *data, size_t size)
+{
+    parser_fuzz(&parser_bno08x, data, size);
+    return 0;
+}
@@ -0,0 +1,267 @@
+/**
+ ******************************************************************************
+ * @file    fuzz_driver.c
+ * @brief   没有 libFuzzer 时的独立驱动：回放语料并做随机变异，配合 ASan/UBSan 使用
+ * @version 1.0.0
+ ******************************************************************************
+ * 用法: ./fuzz_xxx [-runs=N] [-seed=N] [-max_len=N] [语料文件或目录 ...]
+ * 参数形式与 libFuzzer 相同，同一个目标文件用 clang -fsanitize=fuzzer 链接时不需要本文件。
+ * 没有覆盖率反馈，只对种子做随机变异（翻转、覆盖、插入、删除、拼接、截断、插入文本记号），
+ * 出错时把当前输入写到 crash-<序号>，可直接作为参数回放
+ ******************************************************************************
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <string.h>
+#include <signal.h>
+#include <dirent.h>
+#include <sys/stat.h>
+
+int LLVMFuzzerTestOneInput(const uint8_t *data, size_t size);
+
+#define MAX_SEEDS       1024
+
+/* 让 ASan/UBSan 报错后 abort()，由 on_abort 写出当前输入 */
+const char *__asan_default_options(void)
+{
+    return "abort_on_error=1";
+}
+
+const char *__ubsan_default_options(void)
+{
+    return "abort_on_error=1:print_stacktrace=1";
+}
+
+typedef struct {
+    uint8_t *data;
+    size_t size;
+} input_t;
+
+static input_t s_seeds[MAX_SEEDS];
+static size_t s_seed_count;
+
+static uint8_t *s_cur;          /* 正在执行的输入，出错时写出 */
+static size_t s_cur_size;
+static unsigned long s_iter;
+
+static uint32_t s_rng = 1;
+
+static uint32_t fuzz_rand(void)
+{
+    uint32_t x = s_rng;
+    x ^= x << 13;
+    x ^= x >> 17;
+    x ^= x << 5;
+    s_rng = x;
+    return x;
+}
+
+static void dump_input(void)
+{
+    char path[64];
+    FILE *fp;
+
+    snprintf(path, sizeof(path), "crash-%lu", s_iter);
+    fp = fopen(path, "wb");
+    if (fp != NULL) {
+        fwrite(s_cur, 1, s_cur_size, fp);
+        fclose(fp);
+        fprintf(stderr, "==fuzz== input written to %s (%zu bytes)\n", path, s_cur_size);
+    }
+}
+
+static void on_abort(int sig)
+{
+    (void)sig;
+    dump_input();
+    _Exit(1);
+}
+
+static void add_seed(const char *path)
+{
+    FILE *fp = fopen(path, "rb");
+    long size;
+
+    if (fp == NULL || s_seed_count >= MAX_SEEDS) {
+        if (fp != NULL) {
+            fclose(fp);
+        }
+        return;
+    }
+    fseek(fp, 0, SEEK_END);
+    size = ftell(fp);
+    fseek(fp, 0, SEEK_SET);
+    s_seeds[s_seed_count].data = malloc(size > 0 ? (size_t)size : 1);
+    s_seeds[s_seed_count].size = fread(s_seeds[s_seed_count].data, 1, (size_t)(size > 0 ? size : 0), fp);
+    s_seed_count++;
+    fclose(fp);
+}
+
+static void add_path(const char *path)
+{
+    struct stat st;
+    DIR *dir;
+    struct dirent *de;
+    char child[1024];
+
+    if (stat(path, &st) != 0) {
+        perror(path);
+        return;
+    }
+    if (!S_ISDIR(st.st_mode)) {
+        add_seed(path);
+        return;
+    }
+    dir = opendir(path);
+    if (dir == NULL) {
+        return;
+    }
+    while ((de = readdir(dir)) != NULL) {
+        if (de->d_name[0] != '.') {
+            snprintf(child, sizeof(child), "%s/%s", path, de->d_name);
+            add_path(child);
+        }
+    }
+    closedir(dir);
+}
+
+static void run(const uint8_t *data, size_t size)
+{
+    /* 拷贝到刚好大小的堆内存，越界读写能被 ASan 发现 */
+    free(s_cur);
+    s_cur = malloc(size > 0 ? size : 1);
+    memcpy(s_cur, data, size);
+    s_cur_size = size;
+    LLVMFuzzerTestOneInput(s_cur, size);
+}
+
+/* 对 buf 做 1~4 次变异，返回新长度 */
+static size_t mutate(uint8_t *buf, size_t size, size_t max_len)
+{
+    int rounds = 1 + (int)(fuzz_rand() % 4);
+
+    for (int r = 0; r < rounds; r++) {
+        size_t at = size ? fuzz_rand() % size : 0;
+
+        switch (fuzz_rand() % 8) {
+            case 0:     /* 翻转 1 位 */
+                if (size) {
+                    buf[at] ^= (uint8_t)(1u << (fuzz_rand() % 8));
+                }
+                break;
+            case 1:     /* 覆盖为随机字节或特殊值 */
+                if (size) {
+                    static const uint8_t special[] = { 0x00, 0xFF, 0x7F, 0x80, 0x55, 0x6B, '$', ',', '\n' };
+                    buf[at] = (fuzz_rand() & 1) ? (uint8_t)fuzz_rand() : special[fuzz_rand() % sizeof(special)];
+                }
+                break;
+            case 2:     /* 插入 */
+                if (size < max_len) {
+                    memmove(buf + at + 1, buf + at, size - at);
+                    buf[at] = (uint8_t)fuzz_rand();
+                    size++;
+                }
+                break;
+            case 3:     /* 删除 */
+                if (size) {
+                    memmove(buf + at, buf + at + 1, size - at - 1);
+                    size--;
+                }
+                break;
+            case 4:     /* 拼接另一个种子 */
+                if (s_seed_count) {
+                    const input_t *o = &s_seeds[fuzz_rand() % s_seed_count];
+                    size_t n = o->size;
+                    if (n > max_len - size) {
+                        n = max_len - size;
+                    }
+                    memcpy(buf + size, o->data, n);
+                    size += n;
+                }
+                break;
+            case 5:     /* 截断 */
+                size = at;
+                break;
+            case 6:     /* 插入文本协议常见的记号，相当于 libFuzzer 的 -dict */
+            {
+                static const char *const tokens[] = {
+                    "nan", "inf", "-1", "1e38", "0x", ",", "\r\n", "$R,", "SET_PID,", "GET_PID,",
+                };
+                const char *t = tokens[fuzz_rand() % (sizeof(tokens) / sizeof(tokens[0]))];
+                size_t n = strlen(t);
+                if (size + n <= max_len) {
+                    memmove(buf + at + n, buf + at, size - at);
+                    memcpy(buf + at, t, n);
+                    size += n;
+                }
+                break;
+            }
+            default:    /* 复制一段到别处 */
+                if (size > 1) {
+                    size_t from = fuzz_rand() % size;
+                    size_t n = 1 + fuzz_rand() % (size - from);
+                    size_t to = fuzz_rand() % size;
+                    if (n > size - to) {
+                        n = size - to;
+                    }
+                    memmove(buf + to, buf + from, n);
+                }
+                break;
+        }
+    }
+    return size;
+}
+
+int main(int argc, char **argv)
+{
+    unsigned long runs = 100000;
+    size_t max_len = 256;
+    uint8_t *buf;
+
+    for (int i = 1; i < argc; i++) {
+        if (strncmp(argv[i], "-runs=", 6) == 0) {
+            runs = strtoul(argv[i] + 6, NULL, 0);
+        } else if (strncmp(argv[i], "-seed=", 6) == 0) {
+            s_rng = (uint32_t)strtoul(argv[i] + 6, NULL, 0);
+        } else if (strncmp(argv[i], "-max_len=", 9) == 0) {
+            max_len = strtoul(argv[i] + 9, NULL, 0);
+        } else if (argv[i][0] == '-') {
+            fprintf(stderr, "忽略参数 %s\n", argv[i]);
+        } else {
+            add_path(argv[i]);
+        }
+    }
+    if (s_rng == 0) {
+        s_rng = 1;
+    }
+    if (max_len < 16) {
+        max_len = 16;
+    }
+
+    signal(SIGABRT, on_abort);
+
+    /* 先原样回放，再变异 */
+    for (size_t i = 0; i < s_seed_count; i++) {
+        run(s_seeds[i].data, s_seeds[i].size);
+    }
+    fprintf(stderr, "==fuzz== %zu seed(s) replayed\n", s_seed_count);
+
+    buf = malloc(max_len * 2);
+    for (s_iter = 1; s_iter <= runs; s_iter++) {
+        size_t size = 0;
+        if (s_seed_count) {
+            const input_t *s = &s_seeds[fuzz_rand() % s_seed_count];
+            size = s->size < max_len ? s->size : max_len;
+            memcpy(buf, s->data, size);
+        }
+        size = mutate(buf, size, max_len);
+        run(buf, size);
+    }
+    fprintf(stderr, "==fuzz== %lu runs, no crash\n", runs);
+
+    free(buf);
+    free(s_cur);
+    return 0;
+}
@@ -0,0 +1,14 @@
+/**
+ ******************************************************************************
+ * @file    fuzz_emm_v5.c
+ * @brief   libFuzzer 目标：Emm_V5_Parse_Response
+ ******************************************************************************
+ */
+
+#include "parsers.h"
+
+int LLVMFuzzerTestOneInput(const uint8_t *data, size_t size)
+{
+    parser_fuzz(&parser_emm_v5, data, size);
+    return 0;
+}
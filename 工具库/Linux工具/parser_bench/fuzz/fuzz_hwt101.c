@@ -0,0 +1,14 @@
+/**
+ ******************************************************************************
+ * @file    fuzz_hwt101.c
+ * @brief   libFuzzer 目标：HWT101_ProcessBuffer
+ ******************************************************************************
+ */
+
+#include "parsers.h"
+
+int LLVMFuzzerTestOneInput(const uint8_t *data, size_t size)
+{
+    parser_fuzz(&parser_hwt101, data, size);
+    return 0;
+}
@@ -0,0 +1,14 @@
+/**
+ ******************************************************************************
+ * @file    fuzz_jy901s.c
+ * @brief   libFuzzer 目标：JY901S_ProcessBuffer
+ ******************************************************************************
+ */
+
+#include "parsers.h"
+
+int LLVMFuzzerTestOneInput(const uint8_t *data, size_t size)
+{
+    parser_fuzz(&parser_jy901s, data, size);
+    return 0;
+}
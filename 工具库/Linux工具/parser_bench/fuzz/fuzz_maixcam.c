@@ -0,0 +1,14 @@
+/**
+ ******************************************************************************
+ * @file    fuzz_maixcam.c
+ * @brief   libFuzzer 目标：maixcam_parse_data
+ ******************************************************************************
+ */
+
+#include "parsers.h"
+
+int LLVMFuzzerTestOneInput(const uint8_t *data, size_t size)
+{
+    parser_fuzz(&parser_maixcam, data, size);
+    return 0;
+}
@@ -0,0 +1,14 @@
+/**
+ ******************************************************************************
+ * @file    fuzz_pid_tuner.c
+ * @brief   libFuzzer 目标：PidTuner_ParseCommand
+ ******************************************************************************
+ */
+
+#include "parsers.h"
+
+int LLVMFuzzerTestOneInput(const uint8_t *data, size_t size)
+{
+    parser_fuzz(&parser_pid_tuner, data, size);
+    return 0;
+}
@@ -0,0 +1,14 @@
+/**
+ ******************************************************************************
+ * @file    fuzz_usart_pack_batch.c
+ * @brief   libFuzzer 目标：usart_pack_batch_parse（累加和，增量压缩批量帧，变长整数）
+ ******************************************************************************
+ */
+
+#include "parsers.h"
+
+int LLVMFuzzerTestOneInput(const uint8_t *data, size_t size)
+{
+    parser_fuzz(&parser_usart_pack_batch, data, size);
+    return 0;
+}
@@ -0,0 +1,14 @@
+/**
+ ******************************************************************************
+ * @file    fuzz_usart_pack_crc.c
+ * @brief   libFuzzer 目标：usart_pack_stream_feed（CRC-16 + 序号，流式解码）
+ ******************************************************************************
+ */
+
+#include "parsers.h"
+
+int LLVMFuzzerTestOneInput(const uint8_t *data, size_t size)
+{
+    parser_fuzz(&parser_usart_pack_crc, data, size);
+    return 0;
+}
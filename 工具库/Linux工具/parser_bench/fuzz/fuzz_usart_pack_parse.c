@@ -0,0 +1,14 @@
+/**
+ ******************************************************************************
+ * @file    fuzz_usart_pack_parse.c
+ * @brief   libFuzzer 目标：usart_pack_parse（累加和，每次一条空闲中断分隔的消息）
+ ******************************************************************************
+ */
+
+#include "parsers.h"
+
+int LLVMFuzzerTestOneInput(const uint8_t *data, size_t size)
+{
+    parser_fuzz(&parser_usart_pack_parse, data, size);
+    return 0;
+}
@@ -0,0 +1,501 @@
+/**
+ ******************************************************************************
+ * @file    parser_bench.c
+ * @brief   全部字节流解析器的吞吐量与抗干扰基准：干净/损坏/分片数据
+ * @version 1.0.0
+ ******************************************************************************
+ * 用法: ./parser_bench [帧数，默认 200000] [随机种子，默认 1] [解析器名，默认全部]
+ *       ./parser_bench corpus <目录>     为模糊测试生成种子语料
+ ******************************************************************************
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <errno.h>
+#include <sys/stat.h>
+
+#include "parsers.h"
+
+#define REPEAT          5           /* 吞吐量取 5 次中最好的一次 */
+#define STREAM_CHUNK    256         /* 流式入口每次喂入的字节数，相当于 DMA 半缓冲 */
+#define FRAG_MAX        24          /* 分片测试中每次喂入 1~24 字节 */
+#define CORRUPT_PERMILLE 20         /* 损坏测试中 2% 的帧被破坏 */
+#define FAIL_PERMILLE   20          /* 事务型：2% 的数据包有一次 I2C 读取出错 */
+#define MAX_FRAMES      1000000     /* maixcam/PidTuner 的序号字段最多 6 位十进制 */
+
+static uint32_t s_rng = 1;
+
+static uint32_t bench_rand(void)
+{
+    uint32_t x = s_rng;
+    x ^= x << 13;
+    x ^= x >> 17;
+    x ^= x << 5;
+    s_rng = x;
+    return x;
+}
+
+static double wall_seconds(void)
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (double)ts.tv_sec + (double)ts.tv_nsec * 1e-9;
+}
+
+/* ======================= 测试数据 ======================= */
+
+/* 连续存放的 n 帧，第 i 帧为 data[off[i]] ~ data[off[i + 1]] */
+typedef struct {
+    uint8_t *data;
+    uint32_t *off;
+    uint8_t *corrupted;     /* 第 i 帧被破坏 */
+    uint32_t n;
+    uint32_t events;
+} frames_t;
+
+static void frames_alloc(frames_t *f, uint32_t n)
+{
+    f->data = malloc((size_t)n * (PARSER_MAX_FRAME + 1));
+    f->off = malloc(((size_t)n + 1) * sizeof(uint32_t));
+    f->corrupted = calloc(n, 1);
+    f->n = n;
+    f->events = 0;
+    if (f->data == NULL || f->off == NULL || f->corrupted == NULL) {
+        fprintf(stderr, "内存不足\n");
+        exit(1);
+    }
+}
+
+static void frames_free(frames_t *f)
+{
+    free(f->data);
+    free(f->off);
+    free(f->corrupted);
+}
+
+static const char *const corrupt_names[] = { "bit flip", "drop", "insert" };
+
+/*
+ * 对一帧做一处破坏：翻转 1 位 / 删除 1 字节 / 插入 1 个随机字节，返回新长度；
+ * 插入不放在帧首，否则只是帧间多了一个垃圾字节，帧本身完好
+ */
+static uint16_t corrupt_frame(uint8_t *buf, uint16_t len)
+{
+    uint16_t at = (uint16_t)(bench_rand() % len);
+
+    switch (bench_rand() % 3) {
+        case 0:
+            buf[at] ^= (uint8_t)(1u << (bench_rand() % 8));
+            return len;
+        case 1:
+            memmove(buf + at, buf + at + 1, (size_t)(len - at - 1));
+            return (uint16_t)(len - 1);
+        default:
+            if (at == 0) {
+                at = 1;
+            }
+            memmove(buf + at + 1, buf + at, (size_t)(len - at));
+            buf[at] = (uint8_t)bench_rand();
+            return (uint16_t)(len + 1);
+    }
+}
+
+/* 生成 n 帧，permille 为被破坏帧的千分比 */
+static void frames_build(frames_t *f, const parser_t *p, uint32_t permille)
+{
+    uint32_t pos = 0;
+
+    for (uint32_t i = 0; i < f->n; i++) {
+        uint16_t len = p->build(f->data + pos, i);
+        f->off[i] = pos;
+        if (permille > 0 && bench_rand() % 1000 < permille) {
+            len = corrupt_frame(f->data + pos, len);
+            f->corrupted[i] = 1;
+            f->events++;
+        }
+        pos += len;
+    }
+    f->off[f->n] = pos;
+}
+
+/* ======================= 接收统计 ======================= */
+
+static uint8_t *s_accepted;     /* 第 i 帧被接受 */
+static uint32_t s_limit;
+static int64_t s_last;          /* 上一个被接受的序号 */
+static uint32_t s_feed_lo;      /* 本次调用可能解出的序号范围 */
+static uint32_t s_feed_hi;
+static uint32_t s_count;
+static uint32_t s_bogus;        /* 序号不递增或不在本次喂入的帧中：误收的垃圾帧 */
+
+/*
+ * 只接受本次喂入的数据中可能出现的序号；垃圾帧不更新 s_last，
+ * 避免一个错误的大序号让之后的正常帧都被判为误收
+ */
+static void on_frame(uint32_t seq)
+{
+    s_count++;
+    if (seq < s_limit && (int64_t)seq > s_last && seq >= s_feed_lo && seq <= s_feed_hi) {
+        if (s_accepted != NULL) {
+            s_accepted[seq] = 1;
+        }
+        s_last = seq;
+    } else {
+        s_bogus++;
+    }
+}
+
+static void on_invalid(const char *what)
+{
+    (void)what;
+    s_count++;
+    s_bogus++;
+}
+
+static void track_begin(uint8_t *accepted, uint32_t limit)
+{
+    s_accepted = accepted;
+    s_limit = limit;
+    s_last = -1;
+    s_feed_lo = 0;
+    s_feed_hi = limit - 1;
+    s_count = 0;
+    s_bogus = 0;
+    parser_on_frame = on_frame;
+    parser_on_invalid = on_invalid;
+}
+
+/* ======================= 喂入方式 ======================= */
+
+/* 流式：帧可以在之前的调用中开始，最多解出到本段结束前已开始的那一帧 */
+static void feed_stream(const parser_t *p, const frames_t *f, uint32_t chunk_max)
+{
+    const uint8_t *data = f->data;
+    size_t total = f->off[f->n];
+    size_t pos = 0;
+    uint32_t k = 0;
+
+    s_feed_lo = 0;
+    while (pos < total) {
+        size_t n = (chunk_max == STREAM_CHUNK) ? STREAM_CHUNK : 1 + bench_rand() % chunk_max;
+        if (n > total - pos) {
+            n = total - pos;
+        }
+        while (k + 1 < f->n && f->off[k + 1] < pos + n) {
+            k++;
+        }
+        s_feed_hi = k;
+        p->feed(data + pos, n);
+        pos += n;
+    }
+}
+
+/* 消息/事务型：每帧一次调用，只能解出这一帧 */
+static void feed_frames(const parser_t *p, const frames_t *f)
+{
+    for (uint32_t i = 0; i < f->n; i++) {
+        s_feed_lo = s_feed_hi = i;
+        p->feed(f->data + f->off[i], f->off[i + 1] - f->off[i]);
+    }
+}
+
+static void feed_all(const parser_t *p, const frames_t *f)
+{
+    if (p->framing == PARSER_STREAM) {
+        feed_stream(p, f, STREAM_CHUNK);
+    } else {
+        feed_frames(p, f);
+    }
+}
+
+/* ======================= 干净数据 ======================= */
+
+static void bench_clean(const parser_t *p, uint32_t n)
+{
+    frames_t f;
+    double best = 1e30;
+
+    frames_alloc(&f, n);
+    p->reset();
+    frames_build(&f, p, 0);
+
+    for (int r = 0; r < REPEAT; r++) {
+        p->reset();
+        track_begin(NULL, n);
+        double t0 = wall_seconds();
+        feed_all(p, &f);
+        double dt = wall_seconds() - t0;
+        if (dt < best) {
+            best = dt;
+        }
+    }
+
+    double bytes = (double)f.off[n];
+    printf("%-18s %-24s %6.1f %9.1f %10.2f %9.1f %8u/%u%s\n",
+           p->name, p->entry, bytes / n, bytes / best / 1e6, n / best / 1e6, best / n * 1e9,
+           s_count - s_bogus, n, (s_count - s_bogus == n && s_bogus == 0) ? "" : "  !");
+    frames_free(&f);
+}
+
+/* ======================= 损坏数据 ======================= */
+
+static void bench_corrupt(const parser_t *p, uint32_t n)
+{
+    frames_t f;
+    uint8_t *accepted = calloc(n, 1);
+    uint32_t detected = 0, undetected = 0, clean_lost = 0;
+    uint32_t resync_sum = 0, resync_max = 0, resync_bytes = 0;
+
+    frames_alloc(&f, n);
+    p->reset();
+    frames_build(&f, p, CORRUPT_PERMILLE);
+
+    p->reset();
+    track_begin(accepted, n);
+    feed_all(p, &f);
+
+    for (uint32_t i = 0; i < n; i++) {
+        if (f.corrupted[i]) {
+            if (accepted[i]) {
+                undetected++;
+            } else {
+                detected++;
+            }
+            /* 重新同步：紧跟在损坏帧之后、连续丢失的干净帧 */
+            uint32_t lost = 0;
+            for (uint32_t j = i + 1; j < n && !f.corrupted[j] && !accepted[j]; j++) {
+                lost++;
+                resync_bytes += f.off[j + 1] - f.off[j];
+            }
+            resync_sum += lost;
+            if (lost > resync_max) {
+                resync_max = lost;
+            }
+        } else if (!accepted[i]) {
+            clean_lost++;
+        }
+    }
+
+    printf("%-18s %7u %9u %11u %11u %9.2f %9u %9.1f %7u\n",
+           p->name, f.events, detected, undetected, clean_lost,
+           f.events ? (double)resync_sum / f.events : 0.0, resync_max,
+           f.events ? (double)resync_bytes / f.events : 0.0, s_bogus);
+
+    free(accepted);
+    frames_free(&f);
+}
+
+/* ======================= 分片数据 ======================= */
+
+static void print_frag(const parser_t *p, const char *mode, double mbps, uint32_t n)
+{
+    char rate[16] = "-";
+
+    if (mbps > 0) {
+        snprintf(rate, sizeof(rate), "%.1f", mbps);
+    }
+    printf("%-18s %-26s %9s %8u/%u %7u\n", p->name, mode, rate, s_count - s_bogus, n, s_bogus);
+}
+
+static void bench_frag(const parser_t *p, uint32_t n)
+{
+    frames_t f;
+    char mode[32];
+
+    frames_alloc(&f, n);
+    p->reset();
+    frames_build(&f, p, 0);
+
+    switch (p->framing) {
+        case PARSER_STREAM:
+        {
+            double best = 1e30;
+            for (int r = 0; r < REPEAT; r++) {
+                uint32_t seed = s_rng;
+                p->reset();
+                track_begin(NULL, n);
+                double t0 = wall_seconds();
+                feed_stream(p, &f, FRAG_MAX);
+                double dt = wall_seconds() - t0;
+                if (dt < best) {
+                    best = dt;
+                }
+                s_rng = seed;   /* 每次用同样的分片 */
+            }
+            snprintf(mode, sizeof(mode), "1~%u B chunks", FRAG_MAX);
+            print_frag(p, mode, f.off[n] / best / 1e6, n);
+            break;
+        }
+
+        case PARSER_MESSAGE:
+            /* 一条消息被串口空闲中断分成两段 */
+            p->reset();
+            track_begin(NULL, n);
+            for (uint32_t i = 0; i < n; i++) {
+                const uint8_t *m = f.data + f.off[i];
+                uint32_t len = f.off[i + 1] - f.off[i];
+                uint32_t cut = 1 + bench_rand() % (len - 1);
+                s_feed_lo = s_feed_hi = i;
+                p->feed(m, cut);
+                p->feed(m + cut, len - cut);
+            }
+            print_frag(p, "split in 2", 0, n);
+
+            /* 两条消息在一次空闲中断里收到 */
+            p->reset();
+            track_begin(NULL, n);
+            for (uint32_t i = 0; i + 1 < n; i += 2) {
+                s_feed_lo = i;
+                s_feed_hi = i + 1;
+                p->feed(f.data + f.off[i], f.off[i + 2] - f.off[i]);
+            }
+            print_frag(p, "2 merged", 0, n);
+            break;
+
+        case PARSER_TRANSACTION:
+        {
+            uint32_t failed = 0;
+            p->reset();
+            track_begin(NULL, n);
+            for (uint32_t i = 0; i < n; i++) {
+                parser_i2c_fail_read = 0;
+                if (bench_rand() % 1000 < FAIL_PERMILLE) {
+                    parser_i2c_fail_read = 1 + bench_rand() % 2;
+                    failed++;
+                }
+                s_feed_lo = s_feed_hi = i;
+                p->feed(f.data + f.off[i], f.off[i + 1] - f.off[i]);
+            }
+            parser_i2c_fail_read = 0;
+            snprintf(mode, sizeof(mode), "%u I2C read errors", failed);
+            print_frag(p, mode, 0, n);
+            break;
+        }
+    }
+    frames_free(&f);
+}
+
+/* ======================= 种子语料 ======================= */
+
+static int write_file(const char *path, const uint8_t *data, size_t len)
+{
+    FILE *fp = fopen(path, "wb");
+
+    if (fp == NULL) {
+        perror(path);
+        return -1;
+    }
+    fwrite(data, 1, len, fp);
+    fclose(fp);
+    return 0;
+}
+
+/* 每个解析器一个子目录：单帧、连续 4 帧、各种破坏各一个 */
+static int write_corpus(const char *dir)
+{
+    char path[512];
+    uint8_t buf[PARSER_MAX_FRAME * 4 + 1];
+
+    if (mkdir(dir, 0755) != 0 && errno != EEXIST) {
+        perror(dir);
+        return 1;
+    }
+    for (size_t k = 0; k < parser_count; k++) {
+        const parser_t *p = parsers[k];
+        char name[64];
+        uint16_t len;
+
+        snprintf(name, sizeof(name), "%s", p->name);
+        for (char *c = name; *c; c++) {
+            if (*c == '/') {
+                *c = '_';
+            }
+        }
+        snprintf(path, sizeof(path), "%s/%s", dir, name);
+        if (mkdir(path, 0755) != 0 && errno != EEXIST) {
+            perror(path);
+            return 1;
+        }
+
+        p->reset();
+        len = p->build(buf, 1);
+        snprintf(path, sizeof(path), "%s/%s/frame", dir, name);
+        write_file(path, buf, len);
+
+        size_t total = 0;
+        for (uint32_t i = 0; i < 4; i++) {
+            total += p->build(buf + total, 100 + i);
+        }
+        snprintf(path, sizeof(path), "%s/%s/frames4", dir, name);
+        write_file(path, buf, total);
+
+        for (int c = 0; c < 6; c++) {
+            len = p->build(buf, 65535u + (uint32_t)c * 977u);
+            len = corrupt_frame(buf, len);
+            snprintf(path, sizeof(path), "%s/%s/corrupt%d", dir, name, c);
+            write_file(path, buf, len);
+        }
+    }
+    printf("语料已写入 %s/\n", dir);
+    return 0;
+}
+
+/* ======================= 主程序 ======================= */
+
+int main(int argc, char **argv)
+{
+    uint32_t n = 200000;
+    const char *only = NULL;
+
+    if (argc > 1 && strcmp(argv[1], "corpus") == 0) {
+        return write_corpus(argc > 2 ? argv[2] : "corpus");
+    }
+    if (argc > 1) {
+        n = (uint32_t)strtoul(argv[1], NULL, 0);
+    }
+    if (argc > 2) {
+        s_rng = (uint32_t)strtoul(argv[2], NULL, 0);
+    }
+    if (argc > 3) {
+        only = argv[3];
+    }
+    if (n < 2 || n > MAX_FRAMES) {
+        fprintf(stderr, "帧数范围 2~%u\n", MAX_FRAMES);
+        return 1;
+    }
+    if (s_rng == 0) {
+        s_rng = 1;
+    }
+
+    printf("== clean: %u frames, stream entries fed %u B per call, best of %d ==\n", n, STREAM_CHUNK, REPEAT);
+    printf("%-18s %-24s %6s %9s %10s %9s %10s\n",
+           "parser", "entry", "B/frm", "MB/s", "Mframes/s", "ns/frame", "accepted");
+    for (size_t k = 0; k < parser_count; k++) {
+        if (only == NULL || strcmp(only, parsers[k]->name) == 0) {
+            bench_clean(parsers[k], n);
+        }
+    }
+
+    printf("\n== corrupted: %u.%u%% of frames get one %s/%s/%s ==\n",
+           CORRUPT_PERMILLE / 10, CORRUPT_PERMILLE % 10, corrupt_names[0], corrupt_names[1], corrupt_names[2]);
+    printf("%-18s %7s %9s %11s %11s %9s %9s %9s %7s\n",
+           "parser", "events", "detected", "undetected", "clean lost", "resync", "max", "resync B", "bogus");
+    for (size_t k = 0; k < parser_count; k++) {
+        if (only == NULL || strcmp(only, parsers[k]->name) == 0) {
+            bench_corrupt(parsers[k], n);
+        }
+    }
+
+    printf("\n== fragmented ==\n");
+    printf("%-18s %-26s %9s %10s %7s\n", "parser", "mode", "MB/s", "accepted", "bogus");
+    for (size_t k = 0; k < parser_count; k++) {
+        if (only == NULL || strcmp(only, parsers[k]->name) == 0) {
+            bench_frag(parsers[k], n);
+        }
+    }
+
+    parser_on_frame = NULL;
+    return 0;
+}
@@ -0,0 +1,574 @@
+/**
+ ******************************************************************************
+ * @file    parsers.c
+ * @brief   被测解析器适配层：每个驱动的帧生成、喂入方式和序号回报
+ * @version 1.0.0
+ ******************************************************************************
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+
+#include "parsers.h"
+
+#include "jy901s_driver.h"
+#include "hwt101_driver.h"
+#include "Emm_V5.h"
+#include "app_maixcam.h"
+#include "usart_pack.h"
+#include "pid_tuner.h"
+#include "bno08x_hal.h"
+
+void (*parser_on_frame)(uint32_t seq);
+void (*parser_on_invalid)(const char *what);
+uint32_t parser_i2c_fail_read;
+
+static void report(uint32_t seq)
+{
+    if (parser_on_frame != NULL) {
+        parser_on_frame(seq);
+    }
+}
+
+/* 16 位序号按上一帧展开为 32 位，误收的帧会产生跳变，由基准识别 */
+static uint32_t s_seq16_base;
+
+static uint32_t unwrap16(uint16_t v)
+{
+    s_seq16_base += (uint32_t)(int32_t)(int16_t)(v - (uint16_t)s_seq16_base);
+    return s_seq16_base;
+}
+
+/* ======================= WIT 协议（JY901S / HWT101） ======================= */
+
+/*
+ * 角度包 0x55 0x53 RollL RollH PitchL PitchH YawL YawH VL VH SUM，
+ * 版本号字段两端都原样搬运，用来放序号低 16 位，其余字段随序号变化
+ */
+static uint16_t wit_build(uint8_t *buf, uint32_t seq)
+{
+    uint8_t sum = 0;
+
+    buf[0] = 0x55;
+    buf[1] = 0x53;
+    buf[2] = (uint8_t)(seq * 7);
+    buf[3] = (uint8_t)(seq >> 5);
+    buf[4] = (uint8_t)(seq * 13);
+    buf[5] = (uint8_t)(seq >> 7);
+    buf[6] = (uint8_t)(seq * 3);
+    buf[7] = (uint8_t)(seq >> 3);
+    buf[8] = (uint8_t)seq;
+    buf[9] = (uint8_t)(seq >> 8);
+    for (int i = 0; i < 10; i++) {
+        sum += buf[i];
+    }
+    buf[10] = sum;
+    return 11;
+}
+
+JY901S_t jy901s;    /* jy901s_driver.c 以 extern 引用 */
+
+/* 校验通过后驱动先解析再喂狗，两次取时间戳；喂狗时状态已是 DATA_READY，只在这一次回报 */
+static void jy901s_tick(void)
+{
+    if (jy901s.state == JY901S_STATE_DATA_READY) {
+        report(unwrap16((uint16_t)(jy901s.rx_buffer[8] | (jy901s.rx_buffer[9] << 8))));
+    }
+}
+
+static void jy901s_reset(void)
+{
+    bench_tick_hook = NULL;
+    JY901S_Create(&jy901s, &huart2, 0);
+    s_seq16_base = 0;
+    bench_tick_hook = jy901s_tick;
+}
+
+static void jy901s_feed(const uint8_t *data, size_t length)
+{
+    JY901S_ProcessBuffer(&jy901s, (uint8_t *)data, (uint16_t)length);
+}
+
+const parser_t parser_jy901s = {
+    "jy901s", "JY901S_ProcessBuffer", PARSER_STREAM, jy901s_reset, wit_build, jy901s_feed,
+};
+
+static HWT101_t s_hwt101;
+
+/* 只有角速度/角度包会被解析并取时间戳，此时 rx_buffer 中是整包 */
+static void hwt101_tick(void)
+{
+    report(unwrap16((uint16_t)(s_hwt101.rx_buffer[8] | (s_hwt101.rx_buffer[9] << 8))));
+}
+
+static void hwt101_reset(void)
+{
+    bench_tick_hook = NULL;
+    HWT101_Create(&s_hwt101, &huart2, 0);
+    s_seq16_base = 0;
+    bench_tick_hook = hwt101_tick;
+}
+
+static void hwt101_feed(const uint8_t *data, size_t length)
+{
+    HWT101_ProcessBuffer(&s_hwt101, (uint8_t *)data, (uint16_t)length);
+}
+
+const parser_t parser_hwt101 = {
+    "hwt101", "HWT101_ProcessBuffer", PARSER_STREAM, hwt101_reset, wit_build, hwt101_feed,
+};
+
+/* ======================= Emm_V5 ======================= */
+
+/* 读编码器值应答：地址 0x31 值(4B 大端) 0x6B */
+static uint16_t emm_v5_build(uint8_t *buf, uint32_t seq)
+{
+    buf[0] = 1;
+    buf[1] = 0x31;
+    buf[2] = (uint8_t)(seq >> 24);
+    buf[3] = (uint8_t)(seq >> 16);
+    buf[4] = (uint8_t)(seq >> 8);
+    buf[5] = (uint8_t)seq;
+    buf[6] = 0x6B;
+    return 7;
+}
+
+static void emm_v5_reset(void)
+{
+    bench_tick_hook = NULL;
+}
+
+/* 每次串口空闲中断收到的一段数据调用一次 */
+static void emm_v5_feed(const uint8_t *data, size_t length)
+{
+    Emm_V5_Response_t resp;
+
+    if (length > 255) {
+        length = 255;
+    }
+    if (Emm_V5_Parse_Response((uint8_t *)data, (uint8_t)length, &resp)) {
+        report((uint32_t)resp.encoder);
+    }
+}
+
+const parser_t parser_emm_v5 = {
+    "emm_v5", "Emm_V5_Parse_Response", PARSER_MESSAGE, emm_v5_reset, emm_v5_build, emm_v5_feed,
+};
+
+/* ======================= maixcam ======================= */
+
+/* $R,x,y,校验\n，校验为最后一个逗号之前所有字符之和的低 8 位，x 为序号 */
+static uint16_t maixcam_build(uint8_t *buf, uint32_t seq)
+{
+    char *s = (char *)buf;
+    int n = snprintf(s, PARSER_MAX_FRAME, "$%c,%u,%u", (seq & 1) ? 'G' : 'R',
+                     (unsigned)(seq % 1000000), (unsigned)(seq * 7 % 480));
+    uint8_t sum = 0;
+
+    for (int i = 0; i < n; i++) {
+        sum += (uint8_t)s[i];
+    }
+    n += snprintf(s + n, PARSER_MAX_FRAME - n, ",%02X\n", sum);
+    return (uint16_t)n;
+}
+
+static void maixcam_coord(LaserCoord_t coord)
+{
+    report((uint32_t)coord.x);
+}
+
+static void maixcam_reset(void)
+{
+    bench_tick_hook = NULL;
+    maixcam_set_callback(maixcam_coord);
+}
+
+/* 与 maixcam_task 相同：取出一段数据，补 '\0' 后整段解析 */
+static void maixcam_feed(const uint8_t *data, size_t length)
+{
+    char line[256];
+
+    if (length > sizeof(line) - 1) {
+        length = sizeof(line) - 1;
+    }
+    memcpy(line, data, length);
+    line[length] = '\0';
+    maixcam_parse_data(line);
+}
+
+const parser_t parser_maixcam = {
+    "maixcam", "maixcam_parse_data", PARSER_MESSAGE, maixcam_reset, maixcam_build, maixcam_feed,
+};
+
+/* ======================= usart_pack ======================= */
+
+static usart_pack_t s_pack;
+static usart_pack_stream_t s_pack_stream;
+static uint32_t s_pack_seq;
+static float s_pack_f[3];
+static uint16_t s_pack_s;
+
+/* 序号 INT + 3 个 FLOAT + 1 个 SHORT，与常见遥测帧相当 */
+static void usart_pack_setup(usart_pack_check_t check, uint8_t flags)
+{
+    usart_pack_init(&s_pack);
+    usart_pack_add_var(&s_pack, PACK_TYPE_INT, &s_pack_seq);
+    for (int i = 0; i < 3; i++) {
+        usart_pack_add_var(&s_pack, PACK_TYPE_FLOAT, &s_pack_f[i]);
+    }
+    usart_pack_add_var(&s_pack, PACK_TYPE_SHORT, &s_pack_s);
+    usart_pack_set_format(&s_pack, check, flags);
+}
+
+static uint16_t usart_pack_build_frame(uint8_t *buf, uint32_t seq)
+{
+    s_pack_seq = seq;
+    s_pack_f[0] = (float)seq * 0.01f;
+    s_pack_f[1] = -(float)(seq % 360);
+    s_pack_f[2] = 9.8f;
+    s_pack_s = (uint16_t)(seq * 3);
+    return usart_pack_build(&s_pack, buf, PARSER_MAX_FRAME);
+}
+
+static void usart_pack_frame(usart_pack_stream_t *stream, const uint8_t *frame, uint16_t length, void *arg)
+{
+    (void)stream;
+    (void)frame;
+    (void)length;
+    (void)arg;
+    report(s_pack_seq);
+}
+
+static void usart_pack_reset_sum8(void)
+{
+    bench_tick_hook = NULL;
+    usart_pack_setup(USART_PACK_CHECK_SUM8, 0);
+    usart_pack_stream_init(&s_pack_stream, &s_pack, usart_pack_frame, NULL);
+}
+
+static void usart_pack_reset_crc(void)
+{
+    bench_tick_hook = NULL;
+    usart_pack_setup(USART_PACK_CHECK_CRC16, USART_PACK_FLAG_SEQ);
+    usart_pack_stream_init(&s_pack_stream, &s_pack, usart_pack_frame, NULL);
+}
+
+static void usart_pack_feed(const uint8_t *data, size_t length)
+{
+    usart_pack_stream_feed(&s_pack_stream, data, length);
+}
+
+const parser_t parser_usart_pack = {
+    "usart_pack", "usart_pack_stream_feed", PARSER_STREAM, usart_pack_reset_sum8, usart_pack_build_frame, usart_pack_feed,
+};
+
+const parser_t parser_usart_pack_crc = {
+    "usart_pack/crc16", "usart_pack_stream_feed", PARSER_STREAM, usart_pack_reset_crc, usart_pack_build_frame, usart_pack_feed,
+};
+
+/* 单帧解析：串口空闲中断每收到一段数据调用一次 usart_pack_parse() */
+static void usart_pack_reset_parse(void)
+{
+    bench_tick_hook = NULL;
+    usart_pack_setup(USART_PACK_CHECK_SUM8, 0);
+}
+
+static void usart_pack_parse_feed(const uint8_t *data, size_t length)
+{
+    uint8_t buf[PARSER_MAX_FRAME * 4];
+
+    if (length > sizeof(buf)) {
+        length = sizeof(buf);
+    }
+    memcpy(buf, data, length);
+    if (usart_pack_parse(&s_pack, buf, (uint16_t)length) == 0) {
+        report(s_pack_seq);
+    }
+}
+
+const parser_t parser_usart_pack_parse = {
+    "usart_pack/parse", "usart_pack_parse", PARSER_MESSAGE, usart_pack_reset_parse, usart_pack_build_frame,
+    usart_pack_parse_feed,
+};
+
+/*
+ * 批量帧：每帧 3 个样本，逐样本时间偏移 + 增量压缩，INT 变量在帧内都等于序号，
+ * 其余变量逐样本小幅变化，首个样本之后都是变长整数差值
+ */
+#define PACK_BATCH_SAMPLES  3
+
+static usart_pack_batch_t s_pack_batch;
+static uint8_t s_pack_batch_buf[128];
+
+static void usart_pack_reset_batch(void)
+{
+    bench_tick_hook = NULL;
+    usart_pack_setup(USART_PACK_CHECK_SUM8, 0);
+    usart_pack_batch_init(&s_pack_batch, &s_pack, s_pack_batch_buf, sizeof(s_pack_batch_buf), PACK_BATCH_SAMPLES, 0);
+    usart_pack_batch_set_delta(&s_pack_batch, 1);
+}
+
+static uint16_t usart_pack_batch_build(uint8_t *buf, uint32_t seq)
+{
+    for (uint32_t k = 0; k < PACK_BATCH_SAMPLES; k++) {
+        s_pack_seq = seq;
+        s_pack_f[0] = (float)seq * 0.01f + (float)k * 0.001f;
+        s_pack_f[1] = -(float)(seq % 360);
+        s_pack_f[2] = 9.8f;
+        s_pack_s = (uint16_t)(seq * 3 + k);
+        usart_pack_batch_add(&s_pack_batch, seq * 10 + k);
+    }
+
+    uint16_t len = usart_pack_batch_finish(&s_pack_batch);
+    memcpy(buf, s_pack_batch_buf, len);
+    return len;
+}
+
+static void usart_pack_batch_feed(const uint8_t *data, size_t length)
+{
+    /* 样本回调中的 s_pack_seq 是本样本的值，解析完成后取最后一个样本 */
+    if (usart_pack_batch_parse(&s_pack, data, (uint32_t)length, NULL, NULL) > 0) {
+        report(s_pack_seq);
+    }
+}
+
+const parser_t parser_usart_pack_batch = {
+    "usart_pack/batch", "usart_pack_batch_parse", PARSER_MESSAGE, usart_pack_reset_batch, usart_pack_batch_build,
+    usart_pack_batch_feed,
+};
+
+/* ======================= PidTuner ======================= */
+
+static PidTuner_t s_tuner;
+
+/* SET_PID,1,kp,ki,kd：kp 为序号低 3 位十进制，ki 为其上 3 位，参数都在允许范围内 */
+static uint16_t pid_tuner_build(uint8_t *buf, uint32_t seq)
+{
+    return (uint16_t)snprintf((char *)buf, PARSER_MAX_FRAME, "SET_PID,1,%u,%u,0.5\r\n",
+                              (unsigned)(seq % 1000), (unsigned)(seq / 1000 % 1000));
+}
+
+static int8_t pid_tuner_set(uint8_t id, float kp, float ki, float kd)
+{
+    (void)id;
+    if (!isfinite(kp) || !isfinite(ki) || !isfinite(kd) ||
+        fabsf(kp) > 1000.0f || fabsf(ki) > 1000.0f || fabsf(kd) > 1000.0f) {
+        if (parser_on_invalid != NULL) {
+            parser_on_invalid("PID parameter outside validate_pid_params range");
+        }
+    } else {
+        report((uint32_t)(lroundf(ki) * 1000 + lroundf(kp)));
+    }
+    return 0;
+}
+
+static int8_t pid_tuner_get(uint8_t id, float *kp, float *ki, float *kd)
+{
+    (void)id;
+    *kp = 1.0f;
+    *ki = 0.1f;
+    *kd = 0.01f;
+    return 0;
+}
+
+static int8_t pid_tuner_save(uint8_t id)
+{
+    (void)id;
+    return 0;
+}
+
+static void pid_tuner_reset(void)
+{
+    bench_tick_hook = NULL;
+    PidTuner_Create(&s_tuner, &huart1);
+    PidTuner_RegisterController(&s_tuner, 1, "angle", pid_tuner_set, pid_tuner_get, pid_tuner_save);
+    PidTuner_RegisterController(&s_tuner, 2, "speed", pid_tuner_set, pid_tuner_get, pid_tuner_save);
+}
+
+/* 与 example.c 相同：收到一段数据补 '\0' 后作为命令字符串 */
+static void pid_tuner_feed(const uint8_t *data, size_t length)
+{
+    char line[256];
+
+    if (length > sizeof(line) - 1) {
+        length = sizeof(line) - 1;
+    }
+    memcpy(line, data, length);
+    line[length] = '\0';
+    PidTuner_ParseCommand(&s_tuner, line);
+}
+
+const parser_t parser_pid_tuner = {
+    "pid_tuner", "PidTuner_ParseCommand", PARSER_MESSAGE, pid_tuner_reset, pid_tuner_build, pid_tuner_feed,
+};
+
+/* ======================= BNO08x ======================= */
+
+/*
+ * SHTP 包：长度(2B 小端) 通道 序号 | 0xFB 时间戳(4B) 报告ID 序号 状态 延迟 X(2B) Y(2B) Z(2B)
+ * 加速度报告，X/Y 放序号低/高 16 位，经 getAccelX/Y（Q8）原样还原
+ */
+static uint16_t bno08x_build(uint8_t *buf, uint32_t seq)
+{
+    uint8_t *d = buf + 4;
+
+    buf[0] = 19;
+    buf[1] = 0;
+    buf[2] = CHANNEL_REPORTS;
+    buf[3] = (uint8_t)seq;
+    d[0] = SHTP_REPORT_BASE_TIMESTAMP;
+    d[1] = d[2] = d[3] = d[4] = 0;
+    d[5] = SENSOR_REPORTID_ACCELEROMETER;
+    d[6] = (uint8_t)seq;
+    d[7] = 3;
+    d[8] = 0;
+    d[9] = (uint8_t)seq;
+    d[10] = (uint8_t)(seq >> 8);
+    d[11] = (uint8_t)(seq >> 16);
+    d[12] = (uint8_t)(seq >> 24);
+    d[13] = (uint8_t)(seq * 5);
+    d[14] = 0;
+    return 19;
+}
+
+/*
+ * 模拟器件：头部读取返回 4 字节包头；数据读取返回 4 字节包头 + 下一段数据，
+ * 与 receivePacket 的分段读取方式一致
+ */
+static const uint8_t *s_i2c_packet;
+static size_t s_i2c_len;
+static size_t s_i2c_pos;            /* 已送出的数据字节（不含包头） */
+static uint32_t s_i2c_reads;
+
+static HAL_StatusTypeDef bno08x_device_read(uint8_t *data, uint16_t size)
+{
+    if (++s_i2c_reads == parser_i2c_fail_read) {
+        return HAL_ERROR;
+    }
+    if (s_i2c_reads == 1) {
+        memcpy(data, s_i2c_packet, size < 4 ? size : 4);
+        return HAL_OK;
+    }
+
+    memcpy(data, s_i2c_packet, 4);
+    data[1] |= 0x80;                /* 续传位 */
+    for (uint16_t i = 4; i < size; i++) {
+        size_t at = 4 + s_i2c_pos++;
+        data[i] = (at < s_i2c_len) ? s_i2c_packet[at] : 0;
+    }
+    return HAL_OK;
+}
+
+static void bno08x_reset(void)
+{
+    bench_tick_hook = NULL;
+    bench_i2c_read = bno08x_device_read;
+    BNO080_Init(&hi2c1, 0x4A);
+}
+
+/* 器件拉低 INT 表示有一包数据，主机调用一次 dataAvailable 读取并解析 */
+static void bno08x_feed(const uint8_t *data, size_t length)
+{
+    s_i2c_packet = data;
+    s_i2c_len = length;
+    s_i2c_pos = 0;
+    s_i2c_reads = 0;
+    if (length >= 4 && dataAvailable()) {
+        uint16_t lo = (uint16_t)(int16_t)lroundf(getAccelX() * 256.0f);
+        uint16_t hi = (uint16_t)(int16_t)lroundf(getAccelY() * 256.0f);
+        report(((uint32_t)hi << 16) | lo);
+    }
+}
+
+const parser_t parser_bno08x = {
+    "bno08x", "parseInputReport", PARSER_TRANSACTION, bno08x_reset, bno08x_build, bno08x_feed,
+};
+
+/* ======================= 列表 ======================= */
+
+const parser_t *const parsers[] = {
+    &parser_jy901s,
+    &parser_hwt101,
+    &parser_usart_pack,
+    &parser_usart_pack_crc,
+    &parser_usart_pack_parse,
+    &parser_usart_pack_batch,
+    &parser_emm_v5,
+    &parser_maixcam,
+    &parser_pid_tuner,
+    &parser_bno08x,
+};
+
+const size_t parser_count = sizeof(parsers) / sizeof(parsers[0]);
+
+/* ======================= 模糊测试入口 ======================= */
+
+/* 事务型：输入即器件送出的全部字节，每次读取按顺序取走，取完后读取失败 */
+static const uint8_t *s_fuzz_data;
+static size_t s_fuzz_size;
+
+static HAL_StatusTypeDef fuzz_i2c_read(uint8_t *data, uint16_t size)
+{
+    if (s_fuzz_size < size) {
+        s_fuzz_size = 0;
+        return HAL_ERROR;
+    }
+    memcpy(data, s_fuzz_data, size);
+    s_fuzz_data += size;
+    s_fuzz_size -= size;
+    return HAL_OK;
+}
+
+/* 模糊测试中驱动交出违反协议约束的结果即视为缺陷 */
+static void fuzz_on_invalid(const char *what)
+{
+    fprintf(stderr, "invalid result: %s\n", what);
+    abort();
+}
+
+void parser_fuzz(const parser_t *p, const uint8_t *data, size_t size)
+{
+    p->reset();
+    parser_on_frame = NULL;
+    parser_on_invalid = fuzz_on_invalid;
+
+    switch (p->framing) {
+        case PARSER_STREAM:
+        {
+            p->feed(data, size);
+            /* 再以首字节决定的分片大小重喂一次，覆盖跨调用的状态 */
+            size_t step = (size > 0) ? (size_t)(data[0] % 16) + 1 : 1;
+            for (size_t i = 0; i < size; i += step) {
+                p->feed(data + i, (size - i < step) ? size - i : step);
+            }
+            break;
+        }
+
+        case PARSER_MESSAGE:
+        {
+            size_t start = 0;
+            for (size_t i = 0; i < size; i++) {
+                if (data[i] == '\n') {
+                    p->feed(data + start, i + 1 - start);
+                    start = i + 1;
+                }
+            }
+            if (start < size) {
+                p->feed(data + start, size - start);
+            }
+            p->feed(data, size);
+            break;
+        }
+
+        case PARSER_TRANSACTION:
+            s_fuzz_data = data;
+            s_fuzz_size = size;
+            bench_i2c_read = fuzz_i2c_read;
+            while (s_fuzz_size > 0) {
+                dataAvailable();
+            }
+            break;
+    }
+}
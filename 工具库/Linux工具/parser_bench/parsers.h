@@ -0,0 +1,79 @@
+/**
+ ******************************************************************************
+ * @file    parsers.h
+ * @brief   被测解析器的统一适配接口：生成帧、按驱动的实际用法喂入数据、回报解出的帧
+ * @version 1.0.0
+ ******************************************************************************
+ * 每个适配器直接调用仓库中的驱动源码，不做任何修改。
+ * 生成的每帧都带一个序号（写在驱动会原样解出的字段里），驱动接受一帧后
+ * 适配层把解出的序号通过 parser_on_frame 回报，基准据此统计丢帧、误收和重新同步
+ ******************************************************************************
+ */
+
+#ifndef PARSERS_H
+#define PARSERS_H
+
+#include <stdint.h>
+#include <stddef.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define PARSER_MAX_FRAME    64      /* 生成帧的最大长度 */
+
+/* 驱动的数据入口形式 */
+typedef enum {
+    PARSER_STREAM,          /* 字节流：任意分片喂入，驱动自己找帧头（串口中断/DMA 回调） */
+    PARSER_MESSAGE,         /* 消息：每次调用一条完整消息（串口空闲中断、按行读取） */
+    PARSER_TRANSACTION,     /* 事务：每次调用驱动自己发起 I2C 读取一个数据包 */
+} parser_framing_t;
+
+typedef struct {
+    const char *name;
+    const char *entry;                                  /* 被测函数 */
+    parser_framing_t framing;
+    void (*reset)(void);                                /* 重新创建驱动实例 */
+    uint16_t (*build)(uint8_t *buf, uint32_t seq);      /* 生成序号为 seq 的一帧，返回长度 */
+    void (*feed)(const uint8_t *data, size_t length);   /* 按驱动的实际用法喂入 */
+} parser_t;
+
+/* 驱动每接受一帧回报一次解出的序号，由基准或模糊测试设置，可为 NULL */
+extern void (*parser_on_frame)(uint32_t seq);
+
+/* 驱动交出了违反协议约束的内容（如超出范围的参数）时调用，可为 NULL */
+extern void (*parser_on_invalid)(const char *what);
+
+/* PARSER_TRANSACTION：下一次 I2C 读第 fail_read 次（从 1 计）返回错误，0 表示不出错 */
+extern uint32_t parser_i2c_fail_read;
+
+extern const parser_t parser_jy901s;
+extern const parser_t parser_hwt101;
+extern const parser_t parser_emm_v5;
+extern const parser_t parser_maixcam;
+extern const parser_t parser_usart_pack;
+extern const parser_t parser_usart_pack_crc;
+extern const parser_t parser_usart_pack_parse;
+extern const parser_t parser_usart_pack_batch;
+extern const parser_t parser_pid_tuner;
+extern const parser_t parser_bno08x;
+
+extern const parser_t *const parsers[];
+extern const size_t parser_count;
+
+/**
+ * @brief 模糊测试入口：按解析器的入口形式喂入任意数据
+ * @param p: 解析器
+ * @param data: 任意数据
+ * @param size: 数据长度
+ * @note STREAM 整段喂入后再以首字节决定的分片重喂一次；MESSAGE 按 '\n' 切成消息，
+ *       另把整段作为一条消息；TRANSACTION 把数据作为 I2C 读到的字节，读完为止；
+ *       驱动交出违反协议约束的内容时 abort()
+ */
+void parser_fuzz(const parser_t *p, const uint8_t *data, size_t size);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* PARSERS_H */
@@ -0,0 +1,2 @@
+/* parser_bench 主机移植层：pid_tuner 按大写文件名包含 */
+#include "mydefine.h"
@@ -0,0 +1,2 @@
+/* parser_bench 主机移植层：Emm_V5 包含的串口应用头文件（原工程文件名如此） */
+#include "mydefine.h"
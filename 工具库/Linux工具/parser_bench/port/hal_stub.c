@@ -0,0 +1,165 @@
+/**
+ ******************************************************************************
+ * @file    hal_stub.c
+ * @brief   parser_bench 主机移植层：HAL、串口打印和工程全局符号的空实现
+ * @version 1.0.0
+ ******************************************************************************
+ */
+
+#include <stdarg.h>
+
+#include "mydefine.h"
+#include "uart_driver.h"
+
+UART_HandleTypeDef huart1 = { { 115200 } };
+UART_HandleTypeDef huart2 = { { 115200 } };
+I2C_HandleTypeDef hi2c1;
+GPIO_TypeDef bench_gpio;
+
+struct rt_ringbuffer ringbuffer_cam;
+uint8_t output_buffer_cam[256];
+
+uint32_t bench_tick_calls;
+void (*bench_tick_hook)(void);
+bench_i2c_read_fn bench_i2c_read;
+
+/* ======================= HAL ======================= */
+
+void HAL_Delay(uint32_t delay)
+{
+    (void)delay;
+}
+
+uint32_t HAL_GetTick(void)
+{
+    if (bench_tick_hook != NULL) {
+        bench_tick_hook();
+    }
+    return ++bench_tick_calls;
+}
+
+void HAL_GPIO_WritePin(GPIO_TypeDef *port, uint16_t pin, GPIO_PinState state)
+{
+    (void)port;
+    (void)pin;
+    (void)state;
+}
+
+HAL_StatusTypeDef HAL_UART_Init(UART_HandleTypeDef *huart)
+{
+    (void)huart;
+    return HAL_OK;
+}
+
+HAL_StatusTypeDef HAL_UART_DeInit(UART_HandleTypeDef *huart)
+{
+    (void)huart;
+    return HAL_OK;
+}
+
+HAL_StatusTypeDef HAL_UART_AbortReceive(UART_HandleTypeDef *huart)
+{
+    (void)huart;
+    return HAL_OK;
+}
+
+HAL_StatusTypeDef HAL_UART_Receive_DMA(UART_HandleTypeDef *huart, uint8_t *data, uint16_t size)
+{
+    (void)huart;
+    (void)data;
+    (void)size;
+    return HAL_OK;
+}
+
+HAL_StatusTypeDef HAL_UART_Transmit(UART_HandleTypeDef *huart, const uint8_t *data, uint16_t size, uint32_t timeout)
+{
+    (void)huart;
+    (void)data;
+    (void)size;
+    (void)timeout;
+    return HAL_OK;
+}
+
+HAL_StatusTypeDef HAL_I2C_Master_Transmit(I2C_HandleTypeDef *hi2c, uint16_t addr, uint8_t *data, uint16_t size, uint32_t timeout)
+{
+    (void)hi2c;
+    (void)addr;
+    (void)data;
+    (void)size;
+    (void)timeout;
+    return HAL_OK;
+}
+
+HAL_StatusTypeDef HAL_I2C_Master_Receive(I2C_HandleTypeDef *hi2c, uint16_t addr, uint8_t *data, uint16_t size, uint32_t timeout)
+{
+    (void)hi2c;
+    (void)addr;
+    (void)timeout;
+    if (bench_i2c_read == NULL) {
+        return HAL_ERROR;
+    }
+    return bench_i2c_read(data, size);
+}
+
+/* ======================= 串口打印 ======================= */
+
+/* 响应只格式化不输出，保留 vsnprintf 的开销 */
+static int format_discard(const char *format, va_list args)
+{
+    char buf[256];
+    return vsnprintf(buf, sizeof(buf), format, args);
+}
+
+int my_printf(UART_HandleTypeDef *huart, const char *format, ...)
+{
+    va_list args;
+    int n;
+
+    (void)huart;
+    va_start(args, format);
+    n = format_discard(format, args);
+    va_end(args);
+    return n;
+}
+
+int Uart_Printf(UART_HandleTypeDef *huart, const char *format, ...)
+{
+    va_list args;
+    int n;
+
+    (void)huart;
+    va_start(args, format);
+    n = format_discard(format, args);
+    va_end(args);
+    return n;
+}
+
+/* ======================= maixcam 引用的工程符号 ======================= */
+
+void app_pid_init(void)
+{
+}
+
+void app_pid_set_target(int x, int y)
+{
+    (void)x;
+    (void)y;
+}
+
+void app_pid_start(void)
+{
+}
+
+uint32_t rt_ringbuffer_data_len(struct rt_ringbuffer *rb)
+{
+    (void)rb;
+    return 0;
+}
+
+uint32_t rt_ringbuffer_get(struct rt_ringbuffer *rb, uint8_t *ptr, uint32_t length)
+{
+    (void)rb;
+    (void)ptr;
+    (void)length;
+    return 0;
+}
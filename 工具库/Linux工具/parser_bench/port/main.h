@@ -0,0 +1,80 @@
+/**
+ ******************************************************************************
+ * @file    main.h
+ * @brief   parser_bench 主机移植层：替代 STM32CubeMX 生成的 main.h 和 HAL 头文件
+ * @version 1.0.0
+ ******************************************************************************
+ * 只提供被测驱动用到的类型和函数，HAL 调用全部为空实现（见 hal_stub.c），
+ * HAL_GetTick 与 HAL_I2C_Master_Receive 带计数/数据源钩子，供基准和模糊测试使用
+ ******************************************************************************
+ */
+
+#ifndef PARSER_BENCH_MAIN_H
+#define PARSER_BENCH_MAIN_H
+
+#include <stdint.h>
+#include <stddef.h>
+#include <stdio.h>
+#include <string.h>
+
+typedef enum {
+    HAL_OK = 0,
+    HAL_ERROR,
+    HAL_BUSY,
+    HAL_TIMEOUT
+} HAL_StatusTypeDef;
+
+typedef enum {
+    GPIO_PIN_RESET = 0,
+    GPIO_PIN_SET
+} GPIO_PinState;
+
+typedef struct {
+    uint32_t BaudRate;
+} UART_InitTypeDef;
+
+typedef struct {
+    UART_InitTypeDef Init;
+} UART_HandleTypeDef;
+
+typedef struct {
+    int unused;
+} I2C_HandleTypeDef;
+
+typedef struct {
+    int unused;
+} GPIO_TypeDef;
+
+#define HAL_MAX_DELAY       0xFFFFFFFFu
+
+/* bno08x 复位引脚 */
+extern GPIO_TypeDef bench_gpio;
+#define BNO_RST_GPIO_Port   (&bench_gpio)
+#define BNO_RST_Pin         1u
+
+extern UART_HandleTypeDef huart1;
+extern UART_HandleTypeDef huart2;
+extern I2C_HandleTypeDef hi2c1;
+
+void HAL_Delay(uint32_t delay);
+uint32_t HAL_GetTick(void);
+void HAL_GPIO_WritePin(GPIO_TypeDef *port, uint16_t pin, GPIO_PinState state);
+HAL_StatusTypeDef HAL_UART_Init(UART_HandleTypeDef *huart);
+HAL_StatusTypeDef HAL_UART_DeInit(UART_HandleTypeDef *huart);
+HAL_StatusTypeDef HAL_UART_AbortReceive(UART_HandleTypeDef *huart);
+HAL_StatusTypeDef HAL_UART_Receive_DMA(UART_HandleTypeDef *huart, uint8_t *data, uint16_t size);
+HAL_StatusTypeDef HAL_UART_Transmit(UART_HandleTypeDef *huart, const uint8_t *data, uint16_t size, uint32_t timeout);
+HAL_StatusTypeDef HAL_I2C_Master_Transmit(I2C_HandleTypeDef *hi2c, uint16_t addr, uint8_t *data, uint16_t size, uint32_t timeout);
+HAL_StatusTypeDef HAL_I2C_Master_Receive(I2C_HandleTypeDef *hi2c, uint16_t addr, uint8_t *data, uint16_t size, uint32_t timeout);
+
+/* ======================= 钩子 ======================= */
+
+/* HAL_GetTick 被调用的次数；串口陀螺仪驱动在解析完一帧时取时间戳，钩子在此时读取刚解析的帧 */
+extern uint32_t bench_tick_calls;
+extern void (*bench_tick_hook)(void);
+
+/* HAL_I2C_Master_Receive 的数据源，返回 HAL_OK 以外的值模拟 I2C 读失败 */
+typedef HAL_StatusTypeDef (*bench_i2c_read_fn)(uint8_t *data, uint16_t size);
+extern bench_i2c_read_fn bench_i2c_read;
+
+#endif /* PARSER_BENCH_MAIN_H */
@@ -0,0 +1,42 @@
+/**
+ ******************************************************************************
+ * @file    mydefine.h
+ * @brief   parser_bench 主机移植层：替代工程公共头文件 mydefine.h
+ * @version 1.0.0
+ ******************************************************************************
+ * 被测驱动（jy901s、bno08x、maixcam）通过它取得 HAL 类型、my_printf 以及
+ * maixcam 任务函数引用的工程全局变量，这里只声明到能编译为止
+ ******************************************************************************
+ */
+
+#ifndef PARSER_BENCH_MYDEFINE_H
+#define PARSER_BENCH_MYDEFINE_H
+
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdio.h>
+#include <math.h>
+
+#include "main.h"
+#include "usart.h"
+
+/* MultiTimer 只用到类型名 */
+typedef struct MultiTimer MultiTimer;
+
+int my_printf(UART_HandleTypeDef *huart, const char *format, ...);
+
+/* maixcam 默认回调与任务函数引用的工程符号 */
+void app_pid_init(void);
+void app_pid_set_target(int x, int y);
+void app_pid_start(void);
+
+struct rt_ringbuffer {
+    int unused;
+};
+extern struct rt_ringbuffer ringbuffer_cam;
+extern uint8_t output_buffer_cam[];
+uint32_t rt_ringbuffer_data_len(struct rt_ringbuffer *rb);
+uint32_t rt_ringbuffer_get(struct rt_ringbuffer *rb, uint8_t *ptr, uint32_t length);
+
+#endif /* PARSER_BENCH_MYDEFINE_H */
@@ -0,0 +1,9 @@
+/* parser_bench 主机移植层：pid_tuner 包含的串口驱动头文件 */
+#ifndef PARSER_BENCH_UART_DRIVER_H
+#define PARSER_BENCH_UART_DRIVER_H
+
+#include "mydefine.h"
+
+int Uart_Printf(UART_HandleTypeDef *huart, const char *format, ...);
+
+#endif /* PARSER_BENCH_UART_DRIVER_H */
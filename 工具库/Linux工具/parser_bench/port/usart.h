@@ -0,0 +1,7 @@
+/* parser_bench 主机移植层：替代 STM32CubeMX 生成的 usart.h */
+#ifndef PARSER_BENCH_USART_H
+#define PARSER_BENCH_USART_H
+
+#include "main.h"
+
+#endif /* PARSER_BENCH_USART_H */
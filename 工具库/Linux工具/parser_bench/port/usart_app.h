@@ -0,0 +1,2 @@
+/* parser_bench 主机移植层：jy901s 包含的串口应用头文件，my_printf 已在 mydefine.h 声明 */
+#include "mydefine.h"
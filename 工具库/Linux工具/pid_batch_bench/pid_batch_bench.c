@@ -0,0 +1,241 @@
+/**
+ ******************************************************************************
+ * @file    pid_batch_bench.c
+ * @brief   批量PID与逐路 PID_T 调用的一致性校验和每路更新耗时
+ * @version 1.0.0
+ ******************************************************************************
+ * 用法: ./pid_batch_bench [每组更新次数，默认 2000000] [随机种子，默认 1]
+ ******************************************************************************
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#include "pid.h"
+#include "pid_batch.h"
+
+#define REPEAT          5           /* 取 5 次中最好的一次 */
+#define INPUT_TICKS     256         /* 预先生成的测量值周期数，循环使用 */
+#define CHECK_TICKS     20000       /* 一致性校验的周期数 */
+
+static const uint16_t channel_counts[] = { 4, 12, 16, 32, 64 };
+
+static PID_T s_pid[PID_BATCH_MAX_CHANNELS];
+static PID_BATCH_T s_batch;
+static float s_input[INPUT_TICKS][PID_BATCH_MAX_CHANNELS];
+static volatile float s_sink;
+
+static uint32_t s_rng = 1;
+
+static uint32_t bench_rand(void)
+{
+    uint32_t x = s_rng;
+    x ^= x << 13;
+    x ^= x >> 17;
+    x ^= x << 5;
+    s_rng = x;
+    return x;
+}
+
+/* [lo, hi) 均匀分布 */
+static float rand_range(float lo, float hi)
+{
+    return lo + (hi - lo) * (float)(bench_rand() >> 8) / 16777216.0f;
+}
+
+static double wall_seconds(void)
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (double)ts.tv_sec + (double)ts.tv_nsec * 1e-9;
+}
+
+/* 两组控制器用同样的随机参数初始化，限幅较小，输出经常被限幅 */
+static void setup(uint16_t count)
+{
+    pid_batch_init(&s_batch, count);
+    for (uint16_t i = 0; i < count; i++) {
+        float kp = rand_range(0.0f, 5.0f);
+        float ki = rand_range(0.0f, 0.5f);
+        float kd = rand_range(0.0f, 2.0f);
+        float target = rand_range(-500.0f, 500.0f);
+        float limit = rand_range(50.0f, 1000.0f);
+
+        pid_init(&s_pid[i], kp, ki, kd, target, limit);
+        pid_batch_setup(&s_batch, i, kp, ki, kd, target, limit);
+    }
+}
+
+/* 每路测量值在目标附近随机游走 */
+static void make_inputs(uint16_t count)
+{
+    for (uint16_t i = 0; i < count; i++) {
+        float v = s_pid[i].target + rand_range(-200.0f, 200.0f);
+        for (int t = 0; t < INPUT_TICKS; t++) {
+            v += rand_range(-20.0f, 20.0f);
+            s_input[t][i] = v;
+        }
+    }
+}
+
+static int same_float(float a, float b)
+{
+    return memcmp(&a, &b, sizeof(float)) == 0;
+}
+
+/* 逐位比较输出和全部状态，返回不一致的通道数 */
+static uint32_t compare(uint16_t count)
+{
+    uint32_t bad = 0;
+
+    for (uint16_t i = 0; i < count; i++) {
+        const PID_T *p = &s_pid[i];
+        if (!same_float(p->out, s_batch.out[i]) ||
+            !same_float(p->integral, s_batch.integral[i]) ||
+            !same_float(p->last_error, s_batch.last_error[i]) ||
+            !same_float(p->last2_error, s_batch.last2_error[i])) {
+            bad++;
+        }
+    }
+    return bad;
+}
+
+/*
+ * 一致性：两种形式各跑 CHECK_TICKS 个周期，每周期比较；
+ * 中途改目标值、改参数、做积分限幅，覆盖 pid.c 的其余接口
+ */
+static uint32_t check(uint16_t count, int incremental)
+{
+    uint32_t bad = 0;
+
+    setup(count);
+    make_inputs(count);
+    for (int t = 0; t < CHECK_TICKS; t++) {
+        const float *in = s_input[t % INPUT_TICKS];
+
+        if (t % 5000 == 2500) {
+            uint16_t ch = (uint16_t)(bench_rand() % count);
+            float target = rand_range(-500.0f, 500.0f);
+            pid_set_target(&s_pid[ch], target);
+            pid_batch_set_target(&s_batch, ch, target);
+        }
+        if (t % 7000 == 3500) {
+            uint16_t ch = (uint16_t)(bench_rand() % count);
+            float kp = rand_range(0.0f, 5.0f);
+            pid_set_params(&s_pid[ch], kp, 0.1f, 0.5f);
+            pid_batch_set_params(&s_batch, ch, kp, 0.1f, 0.5f);
+        }
+
+        for (uint16_t i = 0; i < count; i++) {
+            if (incremental) {
+                pid_calculate_incremental(&s_pid[i], in[i]);
+            } else {
+                pid_calculate_positional(&s_pid[i], in[i]);
+                pid_limit_integral(&s_pid[i], -2000.0f, 2000.0f);
+            }
+        }
+        if (incremental) {
+            pid_batch_incremental(&s_batch, in);
+        } else {
+            pid_batch_positional(&s_batch, in);
+            for (uint16_t i = 0; i < count; i++) {
+                pid_batch_limit_integral(&s_batch, i, -2000.0f, 2000.0f);
+            }
+        }
+        bad += compare(count);
+    }
+    return bad;
+}
+
+/* 每路一次更新的纳秒数：逐路调用 PID_T */
+static double time_per_call(uint16_t count, uint32_t updates, int incremental)
+{
+    uint32_t ticks = updates / count;
+    double best = 1e30;
+
+    for (int r = 0; r < REPEAT; r++) {
+        setup(count);
+        double t0 = wall_seconds();
+        for (uint32_t t = 0; t < ticks; t++) {
+            const float *in = s_input[t % INPUT_TICKS];
+            for (uint16_t i = 0; i < count; i++) {
+                if (incremental) {
+                    pid_calculate_incremental(&s_pid[i], in[i]);
+                } else {
+                    pid_calculate_positional(&s_pid[i], in[i]);
+                }
+            }
+        }
+        double dt = wall_seconds() - t0;
+        if (dt < best) {
+            best = dt;
+        }
+        s_sink = s_pid[0].out;
+    }
+    return best / ((double)ticks * count) * 1e9;
+}
+
+/* 每路一次更新的纳秒数：批量 */
+static double time_batch(uint16_t count, uint32_t updates, int incremental)
+{
+    uint32_t ticks = updates / count;
+    double best = 1e30;
+
+    for (int r = 0; r < REPEAT; r++) {
+        setup(count);
+        double t0 = wall_seconds();
+        for (uint32_t t = 0; t < ticks; t++) {
+            if (incremental) {
+                pid_batch_incremental(&s_batch, s_input[t % INPUT_TICKS]);
+            } else {
+                pid_batch_positional(&s_batch, s_input[t % INPUT_TICKS]);
+            }
+        }
+        double dt = wall_seconds() - t0;
+        if (dt < best) {
+            best = dt;
+        }
+        s_sink = s_batch.out[0];
+    }
+    return best / ((double)ticks * count) * 1e9;
+}
+
+int main(int argc, char **argv)
+{
+    uint32_t updates = 2000000;
+
+    if (argc > 1) {
+        updates = (uint32_t)strtoul(argv[1], NULL, 0);
+    }
+    if (argc > 2) {
+        s_rng = (uint32_t)strtoul(argv[2], NULL, 0);
+    }
+    if (s_rng == 0) {
+        s_rng = 1;
+    }
+
+    printf("kernel: %s, PID_BATCH_MAX_CHANNELS %d, sizeof(PID_T) %zu, sizeof(PID_BATCH_T) %zu\n",
+           pid_batch_kernel(), PID_BATCH_MAX_CHANNELS, sizeof(PID_T), sizeof(PID_BATCH_T));
+    printf("%-12s %4s %14s %14s %9s %10s\n",
+           "form", "N", "per-call ns", "batch ns", "speedup", "mismatch");
+
+    for (int incremental = 0; incremental <= 1; incremental++) {
+        for (size_t k = 0; k < sizeof(channel_counts) / sizeof(channel_counts[0]); k++) {
+            uint16_t count = channel_counts[k];
+            if (count > PID_BATCH_MAX_CHANNELS) {
+                continue;
+            }
+
+            uint32_t bad = check(count, incremental);
+            double t_call = time_per_call(count, updates, incremental);
+            double t_batch = time_batch(count, updates, incremental);
+
+            printf("%-12s %4u %14.2f %14.2f %8.1fx %10u\n",
+                   incremental ? "incremental" : "positional", count,
+                   t_call, t_batch, t_call / t_batch, bad);
+        }
+    }
+    return 0;
+}
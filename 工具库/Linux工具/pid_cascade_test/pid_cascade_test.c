@@ -0,0 +1,352 @@
+/**
+ ******************************************************************************
+ * @file    pid_cascade_test.c
+ * @brief   多速率串级PID主机测试：分频/相位调度、级间目标传递、假时钟执行时间统计
+ * @version 1.0.0
+ ******************************************************************************
+ * 用法: ./pid_cascade_test           （默认配置，PID_CASCADE_ENABLE_STATS=1）
+ *       ./pid_cascade_test_nostats   （同一份源码关闭统计编译，只校验调度和目标传递）
+ *       ./pid_cascade_test_sched     （PID_CASCADE_USE_SCHEDULER=1，另校验 pid_cascade_add_task()）
+ *
+ * 每次运行的级都会把 current 设为本节拍的反馈值，反馈值取节拍序号，
+ * 由此得到每级在哪些节拍运行，与按分频和相位推算的节拍逐一比较。
+ * 假时钟每被调用一次前进 s_step，节拍开头、每级前后、节拍结尾各调用一次，
+ * 因此每级执行时间为 s_step，运行 k 级的节拍耗时 (2k + 1) * s_step。
+ * 任一项不符时程序返回非 0
+ ******************************************************************************
+ */
+
+#include <math.h>
+#include <stdio.h>
+#include <stdint.h>
+
+#include "pid_cascade.h"
+
+#define TICKS           1000u
+
+static PID_T s_pid[PID_CASCADE_MAX_STAGES + 1];
+static PID_CASCADE_T s_cascade;
+static uint32_t s_errors;
+
+static void expect(const char *what, uint64_t got, uint64_t want)
+{
+    if (got != want) {
+        printf("  %-28s %llu, expected %llu  FAIL\n", what, (unsigned long long)got, (unsigned long long)want);
+        s_errors++;
+    }
+}
+
+#if PID_CASCADE_ENABLE_STATS || (PID_CASCADE_USE_SCHEDULER && SCHEDULER_ENABLE_STATS)
+static uint32_t s_now;
+static uint32_t s_step;
+
+static uint32_t fake_clock(void)
+{
+    uint32_t t = s_now;
+
+    s_now += s_step;
+    return t;
+}
+#endif
+
+/* 分频 divisor、相位 phase 的级是否在第 t 个节拍（从 0 起）运行 */
+static int due(uint32_t t, uint16_t divisor, uint16_t phase)
+{
+    return t >= phase && (t - phase) % divisor == 0;
+}
+
+/*
+ * 位置环分频 10、相位 1，速度环分频 2，电流环每拍运行，
+ * 另加一级分频 5、相位 7（按 7 % 5 = 2 处理）
+ */
+static void check_schedule(void)
+{
+    static const uint16_t divisor[] = { 10, 2, 5, 1 };
+    static const uint16_t phase[] = { 1, 0, 2, 0 };
+    float feedback[4];
+    uint32_t runs[4] = { 0 };
+    uint32_t both_outer = 0;
+    uint32_t errors = s_errors;
+
+    pid_cascade_init(&s_cascade);
+    for (int i = 0; i < 4; i++) {
+        pid_init(&s_pid[i], 1.0f, 0.0f, 0.0f, 0.0f, 1e6f);
+        s_pid[i].current = -1.0f;
+        expect("add_stage", pid_cascade_add_stage(&s_cascade, &s_pid[i], PID_CASCADE_POSITIONAL, divisor[i]), i);
+    }
+    expect("add_stage when full", pid_cascade_add_stage(&s_cascade, &s_pid[4], PID_CASCADE_POSITIONAL, 1),
+           (uint64_t)-1);
+    expect("set_phase", pid_cascade_set_phase(&s_cascade, 0, 1), 0);
+    expect("set_phase >= divisor", pid_cascade_set_phase(&s_cascade, 2, 7), 0);
+    expect("set_phase bad stage", pid_cascade_set_phase(&s_cascade, 4, 0), (uint64_t)-1);
+
+    for (uint32_t t = 0; t < TICKS; t++) {
+        int ran[4];
+
+        for (int i = 0; i < 4; i++) {
+            feedback[i] = (float)t;
+        }
+        pid_cascade_tick(&s_cascade, feedback);
+        for (int i = 0; i < 4; i++) {
+            ran[i] = s_pid[i].current == (float)t;
+            if (ran[i] != due(t, divisor[i], phase[i])) {
+                printf("  stage %d %s at tick %u  FAIL\n", i, ran[i] ? "ran" : "skipped", t);
+                s_errors++;
+            }
+            runs[i] += ran[i];
+        }
+        both_outer += ran[0] && ran[1];
+    }
+
+    expect("tick_count", s_cascade.tick_count, TICKS);
+    for (int i = 0; i < 4; i++) {
+        uint32_t want = (TICKS - phase[i] + divisor[i] - 1) / divisor[i];
+        expect("runs per stage", runs[i], want);
+#if PID_CASCADE_ENABLE_STATS
+        expect("run_count without clock", s_cascade.stage[i].run_count, want);
+        expect("exec_total without clock", s_cascade.stage[i].exec_total, 0);
+#endif
+    }
+    /* 位置环在奇数节拍，速度环在偶数节拍，两个外环不会在同一拍运行 */
+    expect("outer stages in same tick", both_outer, 0);
+
+    /* 分频 0 按 1 处理；reset 后分频计数清零，所有级在下一拍都运行 */
+    pid_cascade_init(&s_cascade);
+    pid_cascade_add_stage(&s_cascade, &s_pid[0], PID_CASCADE_POSITIONAL, 0);
+    expect("divisor 0", s_cascade.stage[0].divisor, 1);
+    pid_cascade_init(&s_cascade);
+    pid_cascade_add_stage(&s_cascade, &s_pid[0], PID_CASCADE_POSITIONAL, 10);
+    pid_cascade_add_stage(&s_cascade, &s_pid[1], PID_CASCADE_POSITIONAL, 3);
+    pid_cascade_set_phase(&s_cascade, 0, 4);
+    feedback[0] = feedback[1] = 0.0f;
+    pid_cascade_tick(&s_cascade, feedback);
+    pid_cascade_reset(&s_cascade);
+    feedback[0] = feedback[1] = 5.0f;
+    pid_cascade_tick(&s_cascade, feedback);
+    expect("stage 0 runs after reset", s_pid[0].current == 5.0f, 1);
+    expect("stage 1 runs after reset", s_pid[1].current == 5.0f, 1);
+    expect("tick_count after reset", s_cascade.tick_count, 1);
+
+    printf("schedule: %u ticks, runs %u/%u/%u/%u  %s\n", TICKS, runs[0], runs[1], runs[2], runs[3],
+           s_errors != errors ? "FAIL" : "ok");
+}
+
+/*
+ * 外环输出在同一节拍写入内环 target，外环不运行的节拍内环 target 保持不变，
+ * 内环的积分累加不因外环更新目标而清零；再接一个二阶对象（加速度 = 速度环输出）闭环运行，位置应收敛到目标值
+ */
+static void check_target(void)
+{
+    const float dt = 0.001f;
+    float x = 0.0f, v = 0.0f;
+    float feedback[2];
+    float held = 0.0f;
+    float integral = 0.0f;
+    uint32_t errors = s_errors;
+
+    pid_init(&s_pid[0], 4.0f, 0.0f, 0.0f, 0.0f, 5.0f);     /* 位置环 100Hz，输出速度目标 */
+    pid_init(&s_pid[1], 20.0f, 0.0f, 0.0f, 0.0f, 50.0f);   /* 速度环 1kHz，输出加速度 */
+    pid_cascade_init(&s_cascade);
+    pid_cascade_add_stage(&s_cascade, &s_pid[0], PID_CASCADE_POSITIONAL, 10);
+    pid_cascade_add_stage(&s_cascade, &s_pid[1], PID_CASCADE_POSITIONAL, 1);
+    pid_cascade_set_target(&s_cascade, 1.0f);
+    expect("set_target", s_pid[0].target == 1.0f, 1);
+
+    for (uint32_t t = 0; t < 5000; t++) {
+        float a;
+
+        if (t == 2500) {
+            pid_cascade_set_target(&s_cascade, -0.5f);
+        }
+        feedback[0] = x;
+        feedback[1] = v;
+        a = pid_cascade_tick(&s_cascade, feedback);
+        if (a != s_pid[1].out) {
+            expect("tick returns inner out", 0, 1);
+        }
+        if (t % 10 == 0) {
+            held = s_pid[0].out;
+        }
+        if (s_pid[1].target != held) {
+            printf("  inner target %g at tick %u, outer out %g  FAIL\n", s_pid[1].target, t, held);
+            s_errors++;
+            break;
+        }
+        integral += s_pid[1].target - v;
+        if (s_pid[1].integral != integral) {
+            printf("  inner integral %g at tick %u, expected %g  FAIL\n", s_pid[1].integral, t, integral);
+            s_errors++;
+            break;
+        }
+        v += a * dt;
+        x += v * dt;
+        if (t == 2499) {
+            expect("converged to 1.0", fabsf(x - 1.0f) < 1e-3f, 1);
+        }
+    }
+    expect("converged to -0.5", fabsf(x + 0.5f) < 1e-3f, 1);
+
+    printf("target: outer out held as inner target, x = %.4f  %s\n", x, s_errors != errors ? "FAIL" : "ok");
+}
+
+#if PID_CASCADE_ENABLE_STATS
+/* 分频 4 / 2 / 1，第 t 个节拍假时钟步长为 t % 7 + 1，起点靠近 32 位回绕 */
+static void check_stats(void)
+{
+    static const uint16_t divisor[] = { 4, 2, 1 };
+    float feedback[3] = { 0.0f, 0.0f, 0.0f };
+    uint64_t total[3] = { 0 };
+    uint32_t max[3] = { 0 };
+    uint32_t last[3] = { 0 };
+    uint32_t runs[3] = { 0 };
+    uint32_t tick_max = 0;
+    uint32_t tick_last = 0;
+    uint32_t errors = s_errors;
+
+    pid_cascade_init(&s_cascade);
+    for (int i = 0; i < 3; i++) {
+        pid_init(&s_pid[i], 1.0f, 0.1f, 0.0f, 0.0f, 100.0f);
+        pid_cascade_add_stage(&s_cascade, &s_pid[i], PID_CASCADE_POSITIONAL, divisor[i]);
+    }
+    /* 没有计时源时跑几拍，安装计时源后统计从零开始 */
+    for (int k = 0; k < 5; k++) {
+        pid_cascade_tick(&s_cascade, feedback);
+    }
+    s_now = 0xFFFFFF00u;
+    pid_cascade_set_clock(&s_cascade, fake_clock);
+    expect("set_clock clears run_count", s_cascade.stage[2].run_count, 0);
+    pid_cascade_reset(&s_cascade);
+
+    for (uint32_t t = 0; t < TICKS; t++) {
+        uint32_t k = 0;
+
+        s_step = t % 7 + 1;
+        pid_cascade_tick(&s_cascade, feedback);
+        for (int i = 0; i < 3; i++) {
+            if (t % divisor[i] == 0) {
+                total[i] += s_step;
+                last[i] = s_step;
+                if (s_step > max[i]) {
+                    max[i] = s_step;
+                }
+                runs[i]++;
+                k++;
+            }
+        }
+        tick_last = (2 * k + 1) * s_step;
+        if (tick_last > tick_max) {
+            tick_max = tick_last;
+        }
+    }
+
+    for (int i = 0; i < 3; i++) {
+        expect("run_count", s_cascade.stage[i].run_count, runs[i]);
+        expect("exec_total", s_cascade.stage[i].exec_total, total[i]);
+        expect("exec_max", s_cascade.stage[i].exec_max, max[i]);
+        expect("exec_last", s_cascade.stage[i].exec_last, last[i]);
+        expect("exec_mean", pid_cascade_exec_mean(&s_cascade, (uint8_t)i), total[i] / runs[i]);
+    }
+    expect("tick_exec_last", s_cascade.tick_exec_last, tick_last);
+    expect("tick_exec_max", s_cascade.tick_exec_max, tick_max);
+    expect("exec_mean bad stage", pid_cascade_exec_mean(&s_cascade, 3), 0);
+
+    /* stats_reset 只清统计，不影响分频计数和 tick_count */
+    pid_cascade_stats_reset(&s_cascade);
+    expect("stats_reset run_count", s_cascade.stage[0].run_count, 0);
+    expect("stats_reset tick_exec_max", s_cascade.tick_exec_max, 0);
+    expect("stats_reset exec_mean", pid_cascade_exec_mean(&s_cascade, 0), 0);
+    expect("tick_count kept", s_cascade.tick_count, TICKS);
+
+    printf("stats: fake clock, mean %u/%u/%u, tick max %u  %s\n", (uint32_t)(total[0] / runs[0]),
+           (uint32_t)(total[1] / runs[1]), (uint32_t)(total[2] / runs[2]), tick_max, s_errors != errors ? "FAIL" : "ok");
+}
+#endif
+
+#if PID_CASCADE_USE_SCHEDULER
+static scheduler_t s_sched;
+static PID_CASCADE_T s_sched_cascade;
+
+static void servo_task(void)
+{
+    float feedback[2] = { 0.0f, 0.0f };
+
+    pid_cascade_tick(&s_sched_cascade, feedback);
+}
+
+static void other_task(void)
+{
+}
+
+#if PID_CASCADE_ENABLE_STATS && SCHEDULER_ENABLE_STATS
+static uint32_t cascade_clock(void)
+{
+    return 0;
+}
+#endif
+
+/* 串级挂到调度器上，节拍 1ms，另有一个普通任务；调度器的时间戳源作为串级的计时源 */
+static void check_scheduler(void)
+{
+    uint32_t errors = s_errors;
+    int index;
+
+    scheduler_init(&s_sched);
+    scheduler_add_task(&s_sched, other_task, 5);
+    pid_cascade_init(&s_sched_cascade);
+    pid_cascade_add_stage(&s_sched_cascade, &s_pid[0], PID_CASCADE_POSITIONAL, 10);
+    pid_cascade_add_stage(&s_sched_cascade, &s_pid[1], PID_CASCADE_POSITIONAL, 1);
+#if SCHEDULER_ENABLE_STATS
+    s_step = 1;
+    scheduler_stats_install(&s_sched, fake_clock, 1000);
+#endif
+
+    index = pid_cascade_add_task(&s_sched_cascade, &s_sched, servo_task, 1);
+    expect("add_task index", index, 1);
+    expect("add_task priority", s_sched.tasks[index].priority, SCHEDULER_PRIORITY_HIGHEST);
+#if PID_CASCADE_ENABLE_STATS && SCHEDULER_ENABLE_STATS
+    expect("clock from scheduler", s_sched_cascade.clock == fake_clock, 1);
+#endif
+
+    /* 任务在加入一个周期后首次到期 */
+    for (uint32_t ms = 1; ms <= 100; ms++) {
+        scheduler_run(&s_sched, ms);
+    }
+    expect("cascade ticks", s_sched_cascade.tick_count, 100);
+#if SCHEDULER_ENABLE_STATS
+    expect("scheduler task runs", scheduler_get_task_stats(&s_sched, index)->run_count, 100);
+#endif
+#if PID_CASCADE_ENABLE_STATS
+    expect("outer stage runs", s_sched_cascade.stage[0].run_count, 10);
+    expect("inner stage runs", s_sched_cascade.stage[1].run_count, 100);
+#endif
+#if PID_CASCADE_ENABLE_STATS && SCHEDULER_ENABLE_STATS
+    expect("inner exec (clock steps)", s_sched_cascade.stage[1].exec_max, 1);
+
+    /* 已安装计时源的串级沿用自己的计时源 */
+    pid_cascade_init(&s_sched_cascade);
+    pid_cascade_add_stage(&s_sched_cascade, &s_pid[1], PID_CASCADE_POSITIONAL, 1);
+    pid_cascade_set_clock(&s_sched_cascade, cascade_clock);
+    scheduler_init(&s_sched);
+    scheduler_stats_install(&s_sched, fake_clock, 1000);
+    pid_cascade_add_task(&s_sched_cascade, &s_sched, servo_task, 1);
+    expect("own clock kept", s_sched_cascade.clock == cascade_clock, 1);
+#endif
+
+    printf("scheduler: pid_cascade_add_task, 100 ms  %s\n", s_errors != errors ? "FAIL" : "ok");
+}
+#endif
+
+int main(void)
+{
+    check_schedule();
+    check_target();
+#if PID_CASCADE_ENABLE_STATS
+    check_stats();
+#endif
+#if PID_CASCADE_USE_SCHEDULER
+    check_scheduler();
+#endif
+
+    printf("result: %s\n", s_errors ? "FAIL" : "ok");
+    return s_errors != 0;
+}
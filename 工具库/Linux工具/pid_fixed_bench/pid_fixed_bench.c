@@ -0,0 +1,474 @@
+/**
+ ******************************************************************************
+ * @file    pid_fixed_bench.c
+ * @brief   定点PID与 pid.c 的跟踪误差校验，以及与硬件浮点、软件浮点的周期数对比
+ * @version 1.0.0
+ ******************************************************************************
+ * 用法: ./pid_fixed_bench [计时更新次数，默认 1000000] [随机种子，默认 1]
+ *
+ * 误差界（输出单位，即整数的1）：
+ *   |定点 - pid.c| <= 0.5 + 增益量化项 + pid.c 自身的舍入误差
+ *   增益量化项 = |Δkp|·|e| + |Δki|·|integral| + |Δkd|·|e - last_error|（位置式），
+ *   增量式为每周期增量中同样各项之和的累计；|Δk| <= 2^-(q+1)
+ *   pid.c 自身的舍入误差用 double 按同样公式计算作参考得到
+ ******************************************************************************
+ */
+
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <x86intrin.h>
+#endif
+
+#include "pid.h"
+#include "pid_fixed.h"
+#include "soft_float.h"
+
+#define REPEAT          5           /* 取 5 次中最好的一次 */
+#define SCENARIOS       200         /* 跟踪误差校验的场景数 */
+#define TICKS           2000        /* 每个场景的周期数 */
+#define INPUT_TICKS     256         /* 计时用的测量值周期数，循环使用 */
+#define INTEGRAL_LIMIT  3000        /* 位置式积分限幅 */
+
+#define Q15_Q           12          /* kp 最大 4，Q15 取 12 位小数 */
+#define Q31_Q           24
+
+static uint32_t s_rng = 1;
+
+static uint32_t bench_rand(void)
+{
+    uint32_t x = s_rng;
+    x ^= x << 13;
+    x ^= x >> 17;
+    x ^= x << 5;
+    s_rng = x;
+    return x;
+}
+
+/* [lo, hi) 均匀分布 */
+static float rand_range(float lo, float hi)
+{
+    return lo + (hi - lo) * (float)(bench_rand() >> 8) / 16777216.0f;
+}
+
+static int32_t rand_int(int32_t lo, int32_t hi)
+{
+    return lo + (int32_t)(bench_rand() % (uint32_t)(hi - lo + 1));
+}
+
+/* ======================= 周期计数 ======================= */
+
+#if defined(__x86_64__) || defined(__i386__)
+#define COUNTER_UNIT "cycles"
+static uint64_t counter_now(void)
+{
+    return __rdtsc();
+}
+#else
+#define COUNTER_UNIT "ns"
+static uint64_t counter_now(void)
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000000u + (uint64_t)ts.tv_nsec;
+}
+#endif
+
+/* ======================= 软件浮点自检 ======================= */
+
+/* 随机位模式，偏向 PID 中常见的量级，也覆盖非规格化数和正好一半的舍入 */
+static float rand_float_bits(void)
+{
+    uint32_t r = bench_rand();
+    uint32_t exp;
+
+    switch (r & 3) {
+    case 0:
+        exp = 0;                            /* 非规格化数 */
+        break;
+    case 1:
+        exp = 1 + (bench_rand() % 254);     /* 任意有限数 */
+        break;
+    default:
+        exp = 110 + (bench_rand() % 40);    /* 1e-5 ~ 1e5 */
+        break;
+    }
+    r = bench_rand();
+    if ((r & 7) == 0) {
+        r &= ~0xFFu;                        /* 低位为0，乘加时容易出现正好一半 */
+    }
+    return sf_to_float((r & 0x80000000u) | (exp << 23) | (r & 0x007FFFFFu));
+}
+
+static uint32_t check_soft_ops(uint32_t count)
+{
+    uint32_t bad = 0;
+
+    for (uint32_t i = 0; i < count; i++) {
+        float a = rand_float_bits();
+        float b = rand_float_bits();
+        volatile float sum = a + b, diff = a - b, prod = a * b;
+
+        if (sf_add(sf_from_float(a), sf_from_float(b)) != sf_from_float(sum) ||
+            sf_sub(sf_from_float(a), sf_from_float(b)) != sf_from_float(diff) ||
+            sf_mul(sf_from_float(a), sf_from_float(b)) != sf_from_float(prod) ||
+            sf_lt(sf_from_float(a), sf_from_float(b)) != (a < b)) {
+            bad++;
+        }
+    }
+    return bad;
+}
+
+/* ======================= 场景 ======================= */
+
+typedef struct
+{
+    float kp, ki, kd;
+    int16_t target, limit;
+    int16_t input[TICKS];
+} SCENARIO_T;
+
+static SCENARIO_T s_sc;
+
+/* 测量值在目标附近随机游走，限幅较小时输出经常被限幅 */
+static void make_scenario(void)
+{
+    int32_t v;
+
+    s_sc.kp = rand_range(0.0f, 4.0f);
+    s_sc.ki = rand_range(0.0f, 0.25f);
+    s_sc.kd = rand_range(0.0f, 2.0f);
+    s_sc.target = (int16_t)rand_int(-1000, 1000);
+    s_sc.limit = (int16_t)rand_int(100, 8000);
+
+    v = s_sc.target + rand_int(-500, 500);
+    for (int t = 0; t < TICKS; t++) {
+        v += rand_int(-40, 40);
+        if (v > 4000)
+            v = 4000;
+        if (v < -4000)
+            v = -4000;
+        s_sc.input[t] = (int16_t)v;
+    }
+}
+
+/* ======================= double 参考 ======================= */
+
+typedef struct
+{
+    double kp, ki, kd, target, limit;
+    double out, error, last_error, last2_error, integral;
+} REF_PID_T;
+
+static void ref_init(REF_PID_T *r, double kp, double ki, double kd, double target, double limit)
+{
+    r->kp = kp;
+    r->ki = ki;
+    r->kd = kd;
+    r->target = target;
+    r->limit = limit;
+    r->out = r->error = r->last_error = r->last2_error = r->integral = 0;
+}
+
+static void ref_limit(REF_PID_T *r)
+{
+    if (r->out > r->limit)
+        r->out = r->limit;
+    else if (r->out < -r->limit)
+        r->out = -r->limit;
+}
+
+/* ======================= 跟踪误差 ======================= */
+
+typedef struct
+{
+    double max_err;         /* max |定点 - pid.c| */
+    double max_ratio;       /* max |定点 - pid.c| / 误差界 */
+    double max_float_err;   /* max |pid.c - double| */
+    uint32_t violations;    /* 超出误差界的周期数 */
+} TRACK_T;
+
+static void track_update(TRACK_T *s, double fixed, float flt, double ref, double quant)
+{
+    double err = fabs(fixed - (double)flt);
+    double float_err = fabs((double)flt - ref);
+    double bound = 0.5 + quant + float_err + 1e-6;
+
+    if (err > s->max_err)
+        s->max_err = err;
+    if (err / bound > s->max_ratio)
+        s->max_ratio = err / bound;
+    if (float_err > s->max_float_err)
+        s->max_float_err = float_err;
+    if (err > bound)
+        s->violations++;
+}
+
+/*
+ * 一个场景：定点、pid.c、double 参考三者用同一组测量值
+ * exact 为1时 pid.c 和参考也使用量化后的增益，误差界只剩 0.5 + 浮点舍入
+ */
+static void track_scenario(TRACK_T *s, int wide, int incremental, int exact)
+{
+    uint8_t q = wide ? Q31_Q : Q15_Q;
+    int32_t kp_q, ki_q, kd_q;
+    double kp_x, ki_x, kd_x;        /* 定点增益的实际值 */
+    float kp, ki, kd;
+    PID_T pid;
+    REF_PID_T ref;
+    PID_Q15_T p15;
+    PID_Q31_T p31;
+    double quant_sum = 0;
+
+    if (wide) {
+        kp_q = pid_q31_gain(s_sc.kp, q);
+        ki_q = pid_q31_gain(s_sc.ki, q);
+        kd_q = pid_q31_gain(s_sc.kd, q);
+    } else {
+        kp_q = pid_q15_gain(s_sc.kp, q);
+        ki_q = pid_q15_gain(s_sc.ki, q);
+        kd_q = pid_q15_gain(s_sc.kd, q);
+    }
+    kp_x = ldexp(kp_q, -q);
+    ki_x = ldexp(ki_q, -q);
+    kd_x = ldexp(kd_q, -q);
+    kp = exact ? (float)kp_x : s_sc.kp;
+    ki = exact ? (float)ki_x : s_sc.ki;
+    kd = exact ? (float)kd_x : s_sc.kd;
+
+    pid_init(&pid, kp, ki, kd, s_sc.target, s_sc.limit);
+    ref_init(&ref, kp, ki, kd, s_sc.target, s_sc.limit);
+    if (wide)
+        pid_q31_init(&p31, kp_q, ki_q, kd_q, q, s_sc.target, s_sc.limit);
+    else
+        pid_q15_init(&p15, (int16_t)kp_q, (int16_t)ki_q, (int16_t)kd_q, q, s_sc.target, s_sc.limit);
+
+    for (int t = 0; t < TICKS; t++) {
+        int16_t in = s_sc.input[t];
+        double fixed, quant;
+
+        ref.error = ref.target - in;
+        if (incremental) {
+            double de = ref.error - ref.last_error;
+            double dde = ref.error - 2 * ref.last_error + ref.last2_error;
+
+            ref.out += ref.kp * de + ref.ki * ref.error + ref.kd * dde;
+            ref_limit(&ref);
+            quant_sum += fabs(kp - kp_x) * fabs(de) + fabs(ki - ki_x) * fabs(ref.error) +
+                         fabs(kd - kd_x) * fabs(dde);
+            quant = quant_sum;
+            ref.last2_error = ref.last_error;
+            ref.last_error = ref.error;
+
+            pid_calculate_incremental(&pid, in);
+            fixed = wide ? pid_q31_calculate_incremental(&p31, in) : pid_q15_calculate_incremental(&p15, in);
+        } else {
+            double de = ref.error - ref.last_error;
+
+            ref.integral += ref.error;
+            ref.out = ref.kp * ref.error + ref.ki * ref.integral + ref.kd * de;
+            ref_limit(&ref);
+            quant = fabs(kp - kp_x) * fabs(ref.error) + fabs(ki - ki_x) * fabs(ref.integral) +
+                    fabs(kd - kd_x) * fabs(de);
+            ref.last_error = ref.error;
+            if (ref.integral > INTEGRAL_LIMIT)
+                ref.integral = INTEGRAL_LIMIT;
+            else if (ref.integral < -INTEGRAL_LIMIT)
+                ref.integral = -INTEGRAL_LIMIT;
+
+            pid_calculate_positional(&pid, in);
+            pid_limit_integral(&pid, -INTEGRAL_LIMIT, INTEGRAL_LIMIT);
+            if (wide) {
+                fixed = pid_q31_calculate_positional(&p31, in);
+                pid_q31_limit_integral(&p31, -INTEGRAL_LIMIT, INTEGRAL_LIMIT);
+            } else {
+                fixed = pid_q15_calculate_positional(&p15, in);
+                pid_q15_limit_integral(&p15, -INTEGRAL_LIMIT, INTEGRAL_LIMIT);
+            }
+        }
+        track_update(s, fixed, pid.out, ref.out, quant);
+    }
+}
+
+/* 软件浮点 PID 与 pid.c 逐位比较，返回不一致的周期数 */
+static uint32_t soft_scenario(int incremental)
+{
+    uint32_t bad = 0;
+    PID_T pid;
+    SF_PID_T sf;
+
+    pid_init(&pid, s_sc.kp, s_sc.ki, s_sc.kd, s_sc.target, s_sc.limit);
+    sf_pid_init(&sf, s_sc.kp, s_sc.ki, s_sc.kd, s_sc.target, s_sc.limit);
+    for (int t = 0; t < TICKS; t++) {
+        float in = s_sc.input[t];
+        SF32 out;
+
+        if (incremental) {
+            pid_calculate_incremental(&pid, in);
+            out = sf_pid_calculate_incremental(&sf, sf_from_float(in));
+        } else {
+            pid_calculate_positional(&pid, in);
+            pid_limit_integral(&pid, -INTEGRAL_LIMIT, INTEGRAL_LIMIT);
+            out = sf_pid_calculate_positional(&sf, sf_from_float(in));
+            sf_pid_limit_integral(&sf, sf_from_float(-INTEGRAL_LIMIT), sf_from_float(INTEGRAL_LIMIT));
+        }
+        if (out != sf_from_float(pid.out) || sf.integral != sf_from_float(pid.integral))
+            bad++;
+    }
+    return bad;
+}
+
+/* ======================= 计时 ======================= */
+
+enum { IMPL_FLOAT, IMPL_SOFT, IMPL_Q15, IMPL_Q31, IMPL_COUNT };
+
+static const char *const impl_names[IMPL_COUNT] = {
+    "pid.c float", "soft-float", "pid_q15", "pid_q31"
+};
+
+static int16_t s_in_i[INPUT_TICKS];
+static float s_in_f[INPUT_TICKS];
+static SF32 s_in_sf[INPUT_TICKS];
+static volatile int32_t s_sink;
+
+/* 每次更新的周期数，取 REPEAT 次中最好的一次 */
+static double time_impl(int impl, int incremental, uint32_t updates)
+{
+    double best = 1e30;
+
+    for (int r = 0; r < REPEAT; r++) {
+        PID_T pid;
+        SF_PID_T sf;
+        PID_Q15_T p15;
+        PID_Q31_T p31;
+        uint64_t t0, dt;
+
+        pid_init(&pid, s_sc.kp, s_sc.ki, s_sc.kd, s_sc.target, s_sc.limit);
+        sf_pid_init(&sf, s_sc.kp, s_sc.ki, s_sc.kd, s_sc.target, s_sc.limit);
+        pid_q15_init(&p15, pid_q15_gain(s_sc.kp, Q15_Q), pid_q15_gain(s_sc.ki, Q15_Q),
+                     pid_q15_gain(s_sc.kd, Q15_Q), Q15_Q, s_sc.target, s_sc.limit);
+        pid_q31_init(&p31, pid_q31_gain(s_sc.kp, Q31_Q), pid_q31_gain(s_sc.ki, Q31_Q),
+                     pid_q31_gain(s_sc.kd, Q31_Q), Q31_Q, s_sc.target, s_sc.limit);
+
+        t0 = counter_now();
+        switch (impl) {
+        case IMPL_FLOAT:
+            for (uint32_t t = 0; t < updates; t++) {
+                if (incremental)
+                    pid_calculate_incremental(&pid, s_in_f[t % INPUT_TICKS]);
+                else
+                    pid_calculate_positional(&pid, s_in_f[t % INPUT_TICKS]);
+            }
+            s_sink = (int32_t)pid.out;
+            break;
+        case IMPL_SOFT:
+            for (uint32_t t = 0; t < updates; t++) {
+                if (incremental)
+                    sf_pid_calculate_incremental(&sf, s_in_sf[t % INPUT_TICKS]);
+                else
+                    sf_pid_calculate_positional(&sf, s_in_sf[t % INPUT_TICKS]);
+            }
+            s_sink = (int32_t)sf.out;
+            break;
+        case IMPL_Q15:
+            for (uint32_t t = 0; t < updates; t++) {
+                if (incremental)
+                    pid_q15_calculate_incremental(&p15, s_in_i[t % INPUT_TICKS]);
+                else
+                    pid_q15_calculate_positional(&p15, s_in_i[t % INPUT_TICKS]);
+            }
+            s_sink = p15.out;
+            break;
+        default:
+            for (uint32_t t = 0; t < updates; t++) {
+                if (incremental)
+                    pid_q31_calculate_incremental(&p31, s_in_i[t % INPUT_TICKS]);
+                else
+                    pid_q31_calculate_positional(&p31, s_in_i[t % INPUT_TICKS]);
+            }
+            s_sink = p31.out;
+            break;
+        }
+        dt = counter_now() - t0;
+        if ((double)dt < best)
+            best = (double)dt;
+    }
+    return best / updates;
+}
+
+int main(int argc, char **argv)
+{
+    uint32_t updates = 1000000;
+    uint32_t soft_bad = 0;
+
+    if (argc > 1) {
+        updates = (uint32_t)strtoul(argv[1], NULL, 0);
+    }
+    if (argc > 2) {
+        s_rng = (uint32_t)strtoul(argv[2], NULL, 0);
+    }
+    if (s_rng == 0) {
+        s_rng = 1;
+    }
+    if (updates == 0) {
+        updates = 1;
+    }
+
+    /* 软件浮点先与硬件浮点逐位比较，保证计时对比的是同样的计算 */
+    printf("soft-float ops vs hardware: %u mismatches in 1000000\n", check_soft_ops(1000000));
+    for (int sc = 0; sc < SCENARIOS; sc++) {
+        make_scenario();
+        soft_bad += soft_scenario(0) + soft_scenario(1);
+    }
+    printf("soft-float PID vs pid.c:    %u mismatches in %u updates\n\n",
+           soft_bad, 2u * SCENARIOS * TICKS);
+
+    printf("tracking vs pid.c, %d scenarios x %d ticks (Q15 q=%d, Q31 q=%d)\n",
+           SCENARIOS, TICKS, Q15_Q, Q31_Q);
+    printf("%-8s %-12s %-8s %10s %10s %12s %10s\n",
+           "format", "form", "gains", "max err", "err/bound", "float err", "violate");
+    for (int wide = 0; wide <= 1; wide++) {
+        for (int incremental = 0; incremental <= 1; incremental++) {
+            for (int exact = 1; exact >= 0; exact--) {
+                TRACK_T s = { 0 };
+
+                s_rng = 12345;      /* 每行同样的场景 */
+                for (int sc = 0; sc < SCENARIOS; sc++) {
+                    make_scenario();
+                    track_scenario(&s, wide, incremental, exact);
+                }
+                printf("%-8s %-12s %-8s %10.4f %10.3f %12.5f %10u\n",
+                       wide ? "q31" : "q15", incremental ? "incremental" : "positional",
+                       exact ? "exact" : "rounded", s.max_err, s.max_ratio, s.max_float_err,
+                       s.violations);
+            }
+        }
+    }
+
+    /* 计时：取一个典型场景 */
+    make_scenario();
+    for (int t = 0; t < INPUT_TICKS; t++) {
+        s_in_i[t] = s_sc.input[t];
+        s_in_f[t] = s_sc.input[t];
+        s_in_sf[t] = sf_from_float(s_in_f[t]);
+    }
+    printf("\n%s per update, best of %d x %u updates\n", COUNTER_UNIT, REPEAT, updates);
+    printf("%-12s %12s %12s %14s\n", "impl", "positional", "incremental", "vs soft-float");
+    {
+        double soft[2];
+
+        soft[0] = time_impl(IMPL_SOFT, 0, updates);
+        soft[1] = time_impl(IMPL_SOFT, 1, updates);
+        for (int impl = 0; impl < IMPL_COUNT; impl++) {
+            double pos = impl == IMPL_SOFT ? soft[0] : time_impl(impl, 0, updates);
+            double inc = impl == IMPL_SOFT ? soft[1] : time_impl(impl, 1, updates);
+
+            printf("%-12s %12.1f %12.1f %6.1fx/%5.1fx\n", impl_names[impl], pos, inc,
+                   soft[0] / pos, soft[1] / inc);
+        }
+    }
+    return 0;
+}
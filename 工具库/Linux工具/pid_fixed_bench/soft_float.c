@@ -0,0 +1,321 @@
+/**
+ ******************************************************************************
+ * @file    soft_float.c
+ * @brief   IEEE 单精度软件浮点及 pid.c 公式的软件浮点版本
+ * @version 1.0.0
+ ******************************************************************************
+ * @attention
+ *
+ * 算法与 Berkeley SoftFloat 的 f32_add/f32_sub/f32_mul 相同：
+ * 尾数左移留出7位舍入位，运算后统一在 sf_round_pack() 中就近舍入到偶数，
+ * 支持非规格化数；无穷大和 NaN 只做最简单的处理（PID 计算中不会出现）
+ *
+ ******************************************************************************
+ */
+
+#include <string.h>
+
+#include "soft_float.h"
+
+#define SF_SIGN(a)  ((a) >> 31)
+#define SF_EXP(a)   ((int32_t)(((a) >> 23) & 0xFF))
+#define SF_FRAC(a)  ((a) & 0x007FFFFFu)
+#define SF_NAN      0x7FC00000u
+
+/* 尾数中已含隐含位，进位会自动加到指数上 */
+#define SF_PACK(sign, exp, sig) (((uint32_t)(sign) << 31) + ((uint32_t)(exp) << 23) + (sig))
+
+/* ======================= 内部函数 ======================= */
+
+static int sf_clz32(uint32_t a)
+{
+    return a ? __builtin_clz(a) : 32;
+}
+
+/* 右移，移出的位非零时置最低位（粘滞位） */
+static uint32_t sf_shift_right_jam32(uint32_t a, int32_t dist)
+{
+    if (dist < 31)
+        return (a >> dist) | ((uint32_t)(a << (-dist & 31)) != 0);
+    return a != 0;
+}
+
+static uint32_t sf_shift_right_jam64(uint64_t a, int32_t dist)
+{
+    return (uint32_t)(a >> dist) | ((uint64_t)(a << (-dist & 63)) != 0);
+}
+
+/**
+ * @brief 舍入并打包
+ * @param exp 指数减1
+ * @param sig 隐含位在 bit30，低7位为舍入位
+ */
+static SF32 sf_round_pack(uint32_t sign, int32_t exp, uint32_t sig)
+{
+    uint32_t round_bits = sig & 0x7F;
+
+    if ((uint32_t)exp >= 0xFD) {
+        if (exp < 0) {
+            sig = sf_shift_right_jam32(sig, -exp);
+            exp = 0;
+            round_bits = sig & 0x7F;
+        } else if (exp > 0xFD || sig + 0x40 >= 0x80000000u) {
+            return SF_PACK(sign, 0xFF, 0);
+        }
+    }
+    sig = (sig + 0x40) >> 7;
+    if (round_bits == 0x40)
+        sig &= ~1u;             /* 正好一半时舍入到偶数 */
+    if (!sig)
+        exp = 0;
+    return SF_PACK(sign, exp, sig);
+}
+
+/* 先规格化再舍入打包 */
+static SF32 sf_norm_round_pack(uint32_t sign, int32_t exp, uint32_t sig)
+{
+    int32_t shift = sf_clz32(sig) - 1;
+
+    exp -= shift;
+    if (shift >= 7 && (uint32_t)exp < 0xFD)
+        return SF_PACK(sign, sig ? exp : 0, sig << (shift - 7));
+    return sf_round_pack(sign, exp, sig << shift);
+}
+
+/* 同号相加 */
+static SF32 sf_add_mags(SF32 a, SF32 b, uint32_t sign)
+{
+    int32_t exp_a = SF_EXP(a), exp_b = SF_EXP(b), exp_z;
+    uint32_t sig_a = SF_FRAC(a), sig_b = SF_FRAC(b), sig_z;
+    int32_t diff = exp_a - exp_b;
+
+    if (diff == 0) {
+        if (exp_a == 0)
+            return a + sig_b;   /* 两个非规格化数直接相加 */
+        if (exp_a == 0xFF)
+            return (sig_a | sig_b) ? SF_NAN : a;
+        exp_z = exp_a;
+        sig_z = 0x01000000 + sig_a + sig_b;
+        if (!(sig_z & 1) && exp_z < 0xFE)
+            return SF_PACK(sign, exp_z, sig_z >> 1);
+        sig_z <<= 6;
+    } else {
+        sig_a <<= 6;
+        sig_b <<= 6;
+        if (diff < 0) {
+            if (exp_b == 0xFF)
+                return sig_b ? SF_NAN : SF_PACK(sign, 0xFF, 0);
+            exp_z = exp_b;
+            sig_a += exp_a ? 0x20000000 : sig_a;
+            sig_a = sf_shift_right_jam32(sig_a, -diff);
+        } else {
+            if (exp_a == 0xFF)
+                return sig_a ? SF_NAN : a;
+            exp_z = exp_a;
+            sig_b += exp_b ? 0x20000000 : sig_b;
+            sig_b = sf_shift_right_jam32(sig_b, diff);
+        }
+        sig_z = 0x20000000 + sig_a + sig_b;
+        if (sig_z < 0x40000000) {
+            exp_z--;
+            sig_z <<= 1;
+        }
+    }
+    return sf_round_pack(sign, exp_z, sig_z);
+}
+
+/* 异号相加 */
+static SF32 sf_sub_mags(SF32 a, SF32 b, uint32_t sign)
+{
+    int32_t exp_a = SF_EXP(a), exp_b = SF_EXP(b), exp_z;
+    uint32_t sig_a = SF_FRAC(a), sig_b = SF_FRAC(b), sig_x, sig_y;
+    int32_t diff = exp_a - exp_b;
+
+    if (diff == 0) {
+        int32_t sig_diff;
+        int32_t shift;
+
+        if (exp_a == 0xFF)
+            return SF_NAN;
+        sig_diff = (int32_t)sig_a - (int32_t)sig_b;
+        if (!sig_diff)
+            return 0;           /* 就近舍入时 x - x = +0 */
+        if (exp_a)
+            exp_a--;
+        if (sig_diff < 0) {
+            sign ^= 1;
+            sig_diff = -sig_diff;
+        }
+        shift = sf_clz32((uint32_t)sig_diff) - 8;
+        exp_z = exp_a - shift;
+        if (exp_z < 0) {
+            shift = exp_a;
+            exp_z = 0;
+        }
+        return SF_PACK(sign, exp_z, (uint32_t)sig_diff << shift);
+    }
+
+    sig_a <<= 7;
+    sig_b <<= 7;
+    if (diff < 0) {
+        sign ^= 1;
+        if (exp_b == 0xFF)
+            return sig_b ? SF_NAN : SF_PACK(sign, 0xFF, 0);
+        exp_z = exp_b - 1;
+        sig_x = sig_b | 0x40000000;
+        sig_y = sig_a + (exp_a ? 0x40000000 : sig_a);
+        diff = -diff;
+    } else {
+        if (exp_a == 0xFF)
+            return sig_a ? SF_NAN : a;
+        exp_z = exp_a - 1;
+        sig_x = sig_a | 0x40000000;
+        sig_y = sig_b + (exp_b ? 0x40000000 : sig_b);
+    }
+    return sf_norm_round_pack(sign, exp_z, sig_x - sf_shift_right_jam32(sig_y, diff));
+}
+
+/* ======================= 浮点运算 ======================= */
+
+SF32 sf_from_float(float f)
+{
+    SF32 a;
+    memcpy(&a, &f, sizeof(a));
+    return a;
+}
+
+float sf_to_float(SF32 a)
+{
+    float f;
+    memcpy(&f, &a, sizeof(f));
+    return f;
+}
+
+SF32 sf_add(SF32 a, SF32 b)
+{
+    if (SF_SIGN(a ^ b))
+        return sf_sub_mags(a, b, SF_SIGN(a));
+    return sf_add_mags(a, b, SF_SIGN(a));
+}
+
+SF32 sf_sub(SF32 a, SF32 b)
+{
+    return sf_add(a, b ^ 0x80000000u);
+}
+
+SF32 sf_mul(SF32 a, SF32 b)
+{
+    uint32_t sign = SF_SIGN(a ^ b);
+    int32_t exp_a = SF_EXP(a), exp_b = SF_EXP(b), exp_z;
+    uint32_t sig_a = SF_FRAC(a), sig_b = SF_FRAC(b), sig_z;
+
+    if (exp_a == 0xFF || exp_b == 0xFF) {
+        if ((exp_a == 0xFF && sig_a) || (exp_b == 0xFF && sig_b))
+            return SF_NAN;
+        if ((!exp_a && !sig_a) || (!exp_b && !sig_b))
+            return SF_NAN;      /* 无穷大乘0 */
+        return SF_PACK(sign, 0xFF, 0);
+    }
+    if (!exp_a) {
+        int32_t shift;
+        if (!sig_a)
+            return SF_PACK(sign, 0, 0);
+        shift = sf_clz32(sig_a) - 8;
+        sig_a <<= shift;
+        exp_a = 1 - shift;
+    }
+    if (!exp_b) {
+        int32_t shift;
+        if (!sig_b)
+            return SF_PACK(sign, 0, 0);
+        shift = sf_clz32(sig_b) - 8;
+        sig_b <<= shift;
+        exp_b = 1 - shift;
+    }
+
+    exp_z = exp_a + exp_b - 0x7F;
+    sig_a = (sig_a | 0x00800000) << 7;
+    sig_b = (sig_b | 0x00800000) << 8;
+    sig_z = sf_shift_right_jam64((uint64_t)sig_a * sig_b, 32);
+    if (sig_z < 0x40000000) {
+        exp_z--;
+        sig_z <<= 1;
+    }
+    return sf_round_pack(sign, exp_z, sig_z);
+}
+
+int sf_lt(SF32 a, SF32 b)
+{
+    if ((SF_EXP(a) == 0xFF && SF_FRAC(a)) || (SF_EXP(b) == 0xFF && SF_FRAC(b)))
+        return 0;
+    if (SF_SIGN(a) != SF_SIGN(b))
+        return SF_SIGN(a) && ((a | b) << 1) != 0;
+    return a != b && (SF_SIGN(a) ^ (a < b));
+}
+
+/* ======================= pid.c 公式 ======================= */
+
+#define SF_TWO  0x40000000u     /* 2.0f */
+
+static void sf_pid_out_limit(SF_PID_T *_tpPID)
+{
+    SF32 neg_limit = _tpPID->limit ^ 0x80000000u;
+
+    if (sf_lt(_tpPID->limit, _tpPID->out))
+        _tpPID->out = _tpPID->limit;
+    else if (sf_lt(_tpPID->out, neg_limit))
+        _tpPID->out = neg_limit;
+}
+
+void sf_pid_init(SF_PID_T *_tpPID, float _kp, float _ki, float _kd, float _target, float _limit)
+{
+    memset(_tpPID, 0, sizeof(*_tpPID));
+    _tpPID->kp = sf_from_float(_kp);
+    _tpPID->ki = sf_from_float(_ki);
+    _tpPID->kd = sf_from_float(_kd);
+    _tpPID->target = sf_from_float(_target);
+    _tpPID->limit = sf_from_float(_limit);
+}
+
+SF32 sf_pid_calculate_positional(SF_PID_T *_tpPID, SF32 _current)
+{
+    _tpPID->current = _current;
+    _tpPID->error = sf_sub(_tpPID->target, _tpPID->current);
+    _tpPID->integral = sf_add(_tpPID->integral, _tpPID->error);
+
+    _tpPID->p_out = sf_mul(_tpPID->kp, _tpPID->error);
+    _tpPID->i_out = sf_mul(_tpPID->ki, _tpPID->integral);
+    _tpPID->d_out = sf_mul(_tpPID->kd, sf_sub(_tpPID->error, _tpPID->last_error));
+
+    _tpPID->out = sf_add(sf_add(_tpPID->p_out, _tpPID->i_out), _tpPID->d_out);
+
+    _tpPID->last_error = _tpPID->error;
+    sf_pid_out_limit(_tpPID);
+    return _tpPID->out;
+}
+
+SF32 sf_pid_calculate_incremental(SF_PID_T *_tpPID, SF32 _current)
+{
+    _tpPID->current = _current;
+    _tpPID->error = sf_sub(_tpPID->target, _tpPID->current);
+
+    _tpPID->p_out = sf_mul(_tpPID->kp, sf_sub(_tpPID->error, _tpPID->last_error));
+    _tpPID->i_out = sf_mul(_tpPID->ki, _tpPID->error);
+    _tpPID->d_out = sf_mul(_tpPID->kd, sf_add(sf_sub(_tpPID->error, sf_mul(SF_TWO, _tpPID->last_error)),
+                                              _tpPID->last2_error));
+
+    _tpPID->out = sf_add(_tpPID->out, sf_add(sf_add(_tpPID->p_out, _tpPID->i_out), _tpPID->d_out));
+
+    _tpPID->last2_error = _tpPID->last_error;
+    _tpPID->last_error = _tpPID->error;
+    sf_pid_out_limit(_tpPID);
+    return _tpPID->out;
+}
+
+void sf_pid_limit_integral(SF_PID_T *_tpPID, SF32 min, SF32 max)
+{
+    if (sf_lt(max, _tpPID->integral))
+        _tpPID->integral = max;
+    else if (sf_lt(_tpPID->integral, min))
+        _tpPID->integral = min;
+}
@@ -0,0 +1,45 @@
+/**
+ ******************************************************************************
+ * @file    soft_float.h
+ * @brief   IEEE 单精度软件浮点（加减乘、比较）及用它实现的 pid.c 公式
+ * @version 1.0.0
+ ******************************************************************************
+ * @attention
+ *
+ * 没有FPU的单片机上 pid.c 的每次浮点运算都调用编译器库中的 __aeabi_fadd、
+ * __aeabi_fmul 等函数，x86-64 的 libgcc 不带这些函数，这里按同样的算法
+ * （拆分指数尾数、对齐、就近舍入到偶数）写一份，用来在主机上估计软件浮点的开销
+ *
+ ******************************************************************************
+ */
+
+#ifndef __SOFT_FLOAT_H
+#define __SOFT_FLOAT_H
+
+#include <stdint.h>
+
+typedef uint32_t SF32;      /* 单精度浮点数的位模式 */
+
+SF32 sf_from_float(float f);
+float sf_to_float(SF32 a);
+
+SF32 sf_add(SF32 a, SF32 b);
+SF32 sf_sub(SF32 a, SF32 b);
+SF32 sf_mul(SF32 a, SF32 b);
+int sf_lt(SF32 a, SF32 b);
+
+/* 与 PID_T 同样的字段，全部用位模式保存 */
+typedef struct
+{
+    SF32 kp, ki, kd;
+    SF32 target, current, out, limit;
+    SF32 error, last_error, last2_error, integral;
+    SF32 p_out, i_out, d_out;
+} SF_PID_T;
+
+void sf_pid_init(SF_PID_T *_tpPID, float _kp, float _ki, float _kd, float _target, float _limit);
+SF32 sf_pid_calculate_positional(SF_PID_T *_tpPID, SF32 _current);
+SF32 sf_pid_calculate_incremental(SF_PID_T *_tpPID, SF32 _current);
+void sf_pid_limit_integral(SF_PID_T *_tpPID, SF32 min, SF32 max);
+
+#endif /* __SOFT_FLOAT_H */
@@ -0,0 +1,439 @@
+/**
+ ******************************************************************************
+ * @file    ringbuffer_msgq_bench.c
+ * @brief   rb_msgq 随机操作对照校验与双线程压力测试
+ * @version 1.0.0
+ ******************************************************************************
+ * 用法: ./ringbuffer_msgq_bench [每种容量的操作数，默认 500000] [随机种子，默认 1]
+ *
+ * 对照校验：单线程随机执行 put / reserve+commit（含提交更短长度、放弃、重复预留）/
+ *           get（含缓冲区放不下）/ peek+release，与参考 FIFO 逐条比较内容和长度。
+ *           参考模型按文档的记录格式（4 字节头 + 负载补齐到 4 字节，末尾放不下时整段填充）
+ *           独立计算占用量，写入成功与否必须与模型一致；负载长度偏向 1、最大长度及其附近，
+ *           记录回绕产生的填充次数单独统计
+ * 压力测试：生产者、消费者各一个线程，记录带序号和按序号生成的内容，消费者逐条校验
+ ******************************************************************************
+ */
+
+#include <pthread.h>
+#include <sched.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#include "ringbuffer_msgq.h"
+
+#define MAX_POOL        4096
+#define MODEL_DEPTH     1024        /* 参考 FIFO 深度，大于任何容量下的记录数 */
+
+static const rb_uint32_t model_sizes[] = { 16, 64, 100, 256 };
+static const rb_uint32_t stress_sizes[] = { 64, 1000, 4096 };
+
+static rb_uint32_t s_pool[MAX_POOL / 4];     /* 须 4 字节对齐 */
+
+/* ======================= 工具函数 ======================= */
+
+static double wall_seconds(void)
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (double)ts.tv_sec + (double)ts.tv_nsec * 1e-9;
+}
+
+static rb_uint32_t xorshift(rb_uint32_t *state)
+{
+    rb_uint32_t x = *state;
+    x ^= x << 13;
+    x ^= x >> 17;
+    x ^= x << 5;
+    *state = x;
+    return x;
+}
+
+/* 第 id 条记录的内容，由编号和下标决定 */
+static rb_uint8_t payload_byte(rb_uint32_t id, rb_uint32_t i)
+{
+    rb_uint32_t x = id * 0x9E3779B9u + i * 0x85EBCA6Bu;
+    return (rb_uint8_t)(x ^ (x >> 13) ^ (x >> 24));
+}
+
+static void payload_fill(rb_uint8_t *p, rb_uint32_t id, rb_size_t len)
+{
+    for (rb_size_t i = 0; i < len; i++) {
+        p[i] = payload_byte(id, (rb_uint32_t)i);
+    }
+}
+
+static int payload_check(const rb_uint8_t *p, rb_uint32_t id, rb_size_t len)
+{
+    for (rb_size_t i = 0; i < len; i++) {
+        if (p[i] != payload_byte(id, (rb_uint32_t)i)) {
+            return 0;
+        }
+    }
+    return 1;
+}
+
+/* ======================= 对照校验 ======================= */
+
+#define ALIGN4(x)       (((x) + 3u) & ~3u)
+
+typedef struct {
+    rb_uint32_t id;
+    rb_uint32_t len;
+    rb_uint32_t bytes;      /* 占用的存储：填充 + 头 + 补齐后的负载 */
+} MODEL_REC_T;
+
+typedef struct {
+    rb_uint32_t size;
+    rb_uint32_t wr;         /* 写偏移 [0, size) */
+    rb_uint32_t used;
+    MODEL_REC_T rec[MODEL_DEPTH];
+    rb_uint32_t head, count;
+} MODEL_T;
+
+typedef struct {
+    size_t puts, put_full, gets, small_buf, abandons, shortened, pads, max_len_recs;
+    size_t errors;
+} MODEL_STATS_T;
+
+/* 按记录格式计算一条 len 字节的记录能否写入，能则返回占用字节数（含填充），否则返回 0 */
+static rb_uint32_t model_fits(const MODEL_T *m, rb_uint32_t len, rb_uint32_t *pad)
+{
+    rb_uint32_t total = 4 + ALIGN4(len);
+    rb_uint32_t tail = m->size - m->wr;
+    rb_uint32_t space = m->size - m->used;
+
+    *pad = 0;
+    if (total <= tail) {
+        return (space >= total) ? total : 0;
+    }
+    *pad = tail;
+    return (space >= tail + total) ? tail + total : 0;
+}
+
+static void model_push(MODEL_T *m, rb_uint32_t id, rb_uint32_t len, rb_uint32_t bytes)
+{
+    MODEL_REC_T *r = &m->rec[(m->head + m->count) % MODEL_DEPTH];
+
+    r->id = id;
+    r->len = len;
+    r->bytes = bytes;
+    m->count++;
+    m->used += bytes;
+    m->wr = (m->wr + bytes) % m->size;
+}
+
+static MODEL_REC_T model_pop(MODEL_T *m)
+{
+    MODEL_REC_T r = m->rec[m->head];
+
+    m->head = (m->head + 1) % MODEL_DEPTH;
+    m->count--;
+    m->used -= r.bytes;
+    return r;
+}
+
+static void model_error(MODEL_STATS_T *st, const char *what, size_t op)
+{
+    if (st->errors++ < 5) {
+        printf("    op %zu: %s\n", op, what);
+    }
+}
+
+/* 负载长度：1/4 取 1 或最大长度附近，其余在 [1, max] 均匀分布，偶尔取 0 或超过最大长度 */
+static rb_size_t model_len(rb_uint32_t *rng, rb_size_t max)
+{
+    rb_uint32_t r = xorshift(rng);
+
+    switch (r & 15) {
+        case 0: return 1;
+        case 1: return max;
+        case 2: return (max > 1) ? max - 1 : max;
+        case 3: return (max > 4) ? max - 4 + (r >> 8) % 4 : max;
+        case 4: return ((r >> 8) & 7) == 0 ? 0 : max + 1 + (r >> 11) % 4;
+        default: return 1 + (r >> 8) % max;
+    }
+}
+
+static void model_check_front(struct rb_msgq *q, const MODEL_T *m, MODEL_STATS_T *st, size_t op)
+{
+    rb_uint8_t *ptr;
+    rb_size_t len = rb_msgq_peek(q, &ptr);
+    const rb_uint8_t *pool = (const rb_uint8_t *)s_pool;
+
+    if (m->count == 0) {
+        if (len != 0 || !rb_msgq_is_empty(q)) {
+            model_error(st, "peek on empty queue returned a record", op);
+        }
+        return;
+    }
+
+    const MODEL_REC_T *r = &m->rec[m->head];
+    if (len != r->len) {
+        model_error(st, "peek length differs from reference", op);
+    } else if (((rb_size_t)ptr & 3) != 0 || ptr < pool + 4 || ptr + len > pool + m->size) {
+        model_error(st, "record not contiguous/aligned inside the pool", op);
+    } else if (!payload_check(ptr, r->id, len)) {
+        model_error(st, "payload differs from reference", op);
+    }
+}
+
+static int model_run(rb_uint32_t size, size_t ops, rb_uint32_t seed)
+{
+    static MODEL_T m;
+    struct rb_msgq q;
+    MODEL_STATS_T st;
+    rb_uint8_t buf[MAX_POOL];
+    rb_uint32_t rng = seed * 2654435761u + size;
+    rb_uint32_t next_id = 1;
+    rb_size_t max;
+
+    memset(&st, 0, sizeof(st));
+    memset(&m, 0, sizeof(m));
+    m.size = size;
+    rb_msgq_init(&q, s_pool, size);
+    max = rb_msgq_max_len(&q);
+
+    for (size_t op = 0; op < ops; op++) {
+        rb_uint32_t r = xorshift(&rng);
+        /* 写多读少与读多写少交替，队列在满和空之间来回 */
+        int write_bias = ((op >> 10) & 1) ? 3 : 1;
+
+        if ((r & 3) < (rb_uint32_t)write_bias) {
+            rb_size_t len = model_len(&rng, max);
+            rb_uint32_t pad = 0;
+            rb_uint32_t bytes = (len >= 1 && len <= max) ? model_fits(&m, (rb_uint32_t)len, &pad) : 0;
+            rb_uint32_t id = next_id;
+            rb_size_t n;
+
+            if ((r >> 2) & 1) {
+                payload_fill(buf, id, len);
+                n = rb_msgq_put(&q, buf, len);
+            } else {
+                /* 零拷贝：偶尔先做一次被覆盖的预留 */
+                rb_uint8_t *ptr;
+                if (((r >> 3) & 7) == 0 && len > 0) {
+                    rb_msgq_reserve(&q, 1 + (r >> 8) % max, &ptr);
+                }
+                n = rb_msgq_reserve(&q, len, &ptr);
+                if (n != 0) {
+                    payload_fill(ptr, id, len);
+                }
+            }
+
+            if ((n != 0) != (bytes != 0)) {
+                model_error(&st, n ? "write succeeded but reference says full" : "write failed but reference has room", op);
+            }
+            if (bytes == 0) {
+                st.put_full += len >= 1 && len <= max;
+                continue;
+            }
+
+            if (!((r >> 2) & 1)) {
+                /* 预留成功后：偶尔放弃，偶尔提交更短的长度（按实际长度占用，填充不变） */
+                switch ((r >> 6) & 7) {
+                    case 1:
+                        if (rb_msgq_commit(&q, 0) != 0) {
+                            model_error(&st, "commit(0) did not abandon the reservation", op);
+                        }
+                        st.abandons++;
+                        continue;
+                    case 2:
+                        if (len > 1) {
+                            len = 1 + (r >> 12) % (len - 1);
+                            bytes = pad + 4 + ALIGN4((rb_uint32_t)len);
+                            st.shortened++;
+                        }
+                        break;
+                    default:
+                        break;
+                }
+                if (rb_msgq_commit(&q, len) != len) {
+                    model_error(&st, "commit length differs", op);
+                }
+            }
+            model_push(&m, id, (rb_uint32_t)len, bytes);
+            next_id++;
+            st.puts++;
+            st.pads += pad != 0;
+            st.max_len_recs += len == max;
+        } else {
+            model_check_front(&q, &m, &st, op);
+            if (m.count == 0) {
+                continue;
+            }
+            const MODEL_REC_T *front = &m.rec[m.head];
+
+            switch ((r >> 2) & 3) {
+                case 0:
+                    /* 缓冲区小一字节：返回 0，记录保留 */
+                    if (rb_msgq_get(&q, buf, front->len - 1) != 0) {
+                        model_error(&st, "get into a short buffer consumed the record", op);
+                    }
+                    st.small_buf++;
+                    break;
+                case 1:
+                {
+                    MODEL_REC_T want = model_pop(&m);
+                    if (rb_msgq_release(&q) != want.len) {
+                        model_error(&st, "release length differs from reference", op);
+                    }
+                    st.gets++;
+                    break;
+                }
+                default:
+                {
+                    MODEL_REC_T want = model_pop(&m);
+                    rb_size_t len = rb_msgq_get(&q, buf, sizeof(buf));
+                    if (len != want.len || !payload_check(buf, want.id, len)) {
+                        model_error(&st, "get differs from reference", op);
+                    }
+                    st.gets++;
+                    break;
+                }
+            }
+        }
+    }
+
+    /* 排空后最大长度的记录总能写入 */
+    while (m.count) {
+        model_pop(&m);
+        rb_msgq_release(&q);
+    }
+    if (!rb_msgq_is_empty(&q)) {
+        model_error(&st, "queue not empty after draining", ops);
+    }
+    for (int k = 0; k < 8; k++) {
+        rb_uint8_t *ptr;
+        if (rb_msgq_reserve(&q, max, &ptr) == 0) {
+            model_error(&st, "max-length record rejected on an empty queue", ops);
+            break;
+        }
+        rb_msgq_commit(&q, max);
+        rb_msgq_release(&q);
+    }
+
+    printf("%6u %6zu %9zu %8zu %8zu %7zu %7zu %8zu %7zu  %s\n", size, (size_t)max, st.puts, st.put_full,
+           st.pads, st.max_len_recs, st.abandons, st.shortened, st.small_buf, st.errors ? "FAIL" : "ok");
+    return st.errors ? 1 : 0;
+}
+
+/* ======================= 压力测试 ======================= */
+
+typedef struct {
+    struct rb_msgq *q;
+    size_t records;
+    rb_uint32_t seed;
+    size_t bytes;
+    size_t bad;             /* 消费者：长度或内容不符的记录数 */
+} STRESS_T;
+
+/* 第 n 条记录的长度，两端按同一序列计算 */
+static rb_size_t stress_len(rb_uint32_t *rng, rb_size_t max)
+{
+    rb_uint32_t r = xorshift(rng);
+    return ((r & 7) == 0) ? max : 1 + (r >> 3) % max;
+}
+
+static void *stress_producer(void *arg)
+{
+    STRESS_T *st = arg;
+    rb_uint32_t rng = st->seed;
+    rb_size_t max = rb_msgq_max_len(st->q);
+
+    for (size_t n = 0; n < st->records; n++) {
+        rb_size_t len = stress_len(&rng, max);
+        rb_uint8_t *ptr;
+
+        while (rb_msgq_reserve(st->q, len, &ptr) == 0) {
+            sched_yield();
+        }
+        payload_fill(ptr, (rb_uint32_t)n, len);
+        rb_msgq_commit(st->q, len);
+        st->bytes += len;
+    }
+    return NULL;
+}
+
+static void *stress_consumer(void *arg)
+{
+    STRESS_T *st = arg;
+    rb_uint32_t rng = st->seed;
+    rb_size_t max = rb_msgq_max_len(st->q);
+
+    for (size_t n = 0; n < st->records; n++) {
+        rb_size_t want = stress_len(&rng, max);
+        rb_uint8_t *ptr;
+        rb_size_t len;
+
+        while ((len = rb_msgq_peek(st->q, &ptr)) == 0) {
+            sched_yield();
+        }
+        if (len != want || !payload_check(ptr, (rb_uint32_t)n, len)) {
+            st->bad++;
+        }
+        rb_msgq_release(st->q);
+        st->bytes += len;
+    }
+    return NULL;
+}
+
+static int stress_one(rb_uint32_t size, size_t records, rb_uint32_t seed)
+{
+    struct rb_msgq q;
+    STRESS_T prod, cons;
+    pthread_t tp, tc;
+    double t0, dt;
+    int ok;
+
+    rb_msgq_init(&q, s_pool, size);
+    memset(&prod, 0, sizeof(prod));
+    prod.q = &q;
+    prod.records = records;
+    prod.seed = seed * 2654435761u + size;
+    cons = prod;
+
+    t0 = wall_seconds();
+    pthread_create(&tc, NULL, stress_consumer, &cons);
+    pthread_create(&tp, NULL, stress_producer, &prod);
+    pthread_join(tp, NULL);
+    pthread_join(tc, NULL);
+    dt = wall_seconds() - t0;
+
+    ok = cons.bad == 0 && prod.bytes == cons.bytes && rb_msgq_is_empty(&q);
+    printf("%6u %6zu %10zu %12zu %8zu %9.1f  %s\n", size, (size_t)rb_msgq_max_len(&q), records, cons.bytes,
+           cons.bad, (double)records / dt / 1e6, ok ? "ok" : "FAIL");
+    return ok ? 0 : 1;
+}
+
+int main(int argc, char **argv)
+{
+    size_t ops = 500000;
+    rb_uint32_t seed = 1;
+    int fail = 0;
+
+    if (argc > 1) {
+        ops = strtoul(argv[1], NULL, 0);
+    }
+    if (argc > 2) {
+        seed = (rb_uint32_t)strtoul(argv[2], NULL, 0);
+    }
+
+    printf("model check: %zu random ops per pool size against a reference FIFO\n", ops);
+    printf("%6s %6s %9s %8s %8s %7s %7s %8s %7s\n",
+           "size", "maxlen", "records", "full", "pads", "maxlen", "abandon", "shorter", "smallbuf");
+    for (size_t i = 0; i < sizeof(model_sizes) / sizeof(model_sizes[0]); i++) {
+        fail |= model_run(model_sizes[i], ops, seed);
+    }
+
+    printf("\nstress: producer/consumer threads, zero-copy reserve/commit and peek/release\n");
+    printf("%6s %6s %10s %12s %8s %9s\n", "size", "maxlen", "records", "bytes", "bad", "Mrec/s");
+    for (size_t i = 0; i < sizeof(stress_sizes) / sizeof(stress_sizes[0]); i++) {
+        fail |= stress_one(stress_sizes[i], ops * 2, seed);
+    }
+
+    printf("result: %s\n", fail ? "FAIL" : "ok");
+    return fail;
+}
@@ -0,0 +1,333 @@
+/**
+ ******************************************************************************
+ * @file    ringbuffer_spsc_bench.c
+ * @brief   rb_spsc 双线程压力测试（序列 + CRC 校验）与吞吐量对比
+ * @version 1.0.0
+ ******************************************************************************
+ * 用法: ./ringbuffer_spsc_bench [每组 MB 数，默认 32] [随机种子，默认 1]
+ *
+ * 压力测试：生产者线程按随机长度写入一条伪随机字节序列（长度为 1 时走 putchar），
+ *           消费者线程按随机长度读出，逐字节与同一序列比较，两端各算一遍 CRC-32
+ * 吞吐量：  rb_spsc 与 "rb_ringbuffer + 互斥锁"（模拟原来每次读写都关中断）对比
+ ******************************************************************************
+ */
+
+#include <pthread.h>
+#include <sched.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#include "ringbuffer.h"
+#include "ringbuffer_spsc.h"
+
+#define REPEAT          3           /* 吞吐量取 3 次中最好的一次 */
+#define BENCH_SIZE      16384       /* 吞吐量测试的缓冲区大小，rb_ringbuffer 默认配置上限 32KB */
+#define MAX_CHUNK       8192
+
+static const rb_uint32_t stress_sizes[] = { 1, 7, 64, 1000, 4093 };
+static const rb_uint32_t chunk_sizes[] = { 1, 16, 256, 4096 };
+
+static rb_uint8_t s_pool[BENCH_SIZE];
+static rb_uint32_t s_crc_table[256];
+
+/* ======================= 工具函数 ======================= */
+
+static double wall_seconds(void)
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (double)ts.tv_sec + (double)ts.tv_nsec * 1e-9;
+}
+
+static rb_uint32_t xorshift(rb_uint32_t *state)
+{
+    rb_uint32_t x = *state;
+    x ^= x << 13;
+    x ^= x >> 17;
+    x ^= x << 5;
+    *state = x;
+    return x;
+}
+
+static void crc32_init(void)
+{
+    for (rb_uint32_t i = 0; i < 256; i++) {
+        rb_uint32_t c = i;
+        for (int k = 0; k < 8; k++) {
+            c = (c & 1) ? (0xEDB88320u ^ (c >> 1)) : (c >> 1);
+        }
+        s_crc_table[i] = c;
+    }
+}
+
+static rb_uint32_t crc32_update(rb_uint32_t crc, const rb_uint8_t *p, rb_size_t n)
+{
+    while (n--) {
+        crc = s_crc_table[(crc ^ *p++) & 0xFF] ^ (crc >> 8);
+    }
+    return crc;
+}
+
+/* ======================= 压力测试 ======================= */
+
+typedef struct {
+    struct rb_spsc *rb;
+    rb_uint32_t size;
+    size_t total;           /* 本组传输的字节数 */
+    rb_uint32_t seed;       /* 字节序列的种子，两端相同 */
+    rb_uint32_t len_seed;   /* 随机分块长度的种子，两端不同 */
+    rb_uint32_t crc;
+    size_t mismatch;        /* 消费者：与期望序列不同的字节数 */
+    size_t bad_len;         /* 消费者：data_len 超出容量的次数 */
+} STRESS_T;
+
+static void *stress_producer(void *arg)
+{
+    STRESS_T *st = arg;
+    rb_uint8_t chunk[MAX_CHUNK];
+    rb_uint32_t seq = st->seed, len_rng = st->len_seed;
+    rb_uint32_t crc = 0xFFFFFFFFu;
+    size_t sent = 0;
+    rb_size_t have = 0, off = 0;
+
+    while (sent < st->total) {
+        if (off == have) {
+            /* 新的一块：长度 1 ~ 2 倍容量，不超过剩余量 */
+            have = 1 + xorshift(&len_rng) % (2 * st->size);
+            if (have > MAX_CHUNK) {
+                have = MAX_CHUNK;
+            }
+            if (have > st->total - sent) {
+                have = st->total - sent;
+            }
+            for (rb_size_t i = 0; i < have; i++) {
+                chunk[i] = (rb_uint8_t)(xorshift(&seq) >> 24);
+            }
+            crc = crc32_update(crc, chunk, have);
+            off = 0;
+        }
+
+        rb_size_t n = (have - off == 1) ? rb_spsc_putchar(st->rb, chunk[off])
+                                        : rb_spsc_put(st->rb, &chunk[off], have - off);
+        if (n == 0) {
+            sched_yield();
+        }
+        off += n;
+        sent += n;
+    }
+    st->crc = crc ^ 0xFFFFFFFFu;
+    return NULL;
+}
+
+static void *stress_consumer(void *arg)
+{
+    STRESS_T *st = arg;
+    rb_uint8_t chunk[MAX_CHUNK];
+    rb_uint32_t seq = st->seed, len_rng = st->len_seed ^ 0x5A5A5A5Au;
+    rb_uint32_t crc = 0xFFFFFFFFu;
+    size_t got = 0;
+
+    while (got < st->total) {
+        rb_size_t want = 1 + xorshift(&len_rng) % (2 * st->size);
+        rb_size_t n;
+
+        if (want > MAX_CHUNK) {
+            want = MAX_CHUNK;
+        }
+        if (rb_spsc_data_len(st->rb) > st->size) {
+            st->bad_len++;
+        }
+        n = (want == 1) ? rb_spsc_getchar(st->rb, chunk) : rb_spsc_get(st->rb, chunk, want);
+        if (n == 0) {
+            sched_yield();
+            continue;
+        }
+        for (rb_size_t i = 0; i < n; i++) {
+            if (chunk[i] != (rb_uint8_t)(xorshift(&seq) >> 24)) {
+                st->mismatch++;
+            }
+        }
+        crc = crc32_update(crc, chunk, n);
+        got += n;
+    }
+    st->crc = crc ^ 0xFFFFFFFFu;
+    return NULL;
+}
+
+/* 返回 0 表示通过 */
+static int stress_one(rb_uint32_t size, size_t total, rb_uint32_t seed)
+{
+    static rb_uint8_t pool[4096 + 64];
+    struct rb_spsc rb;
+    STRESS_T prod, cons;
+    pthread_t tp, tc;
+    double t0;
+    int ok;
+
+    rb_spsc_init(&rb, pool, size);
+    memset(&prod, 0, sizeof(prod));
+    prod.rb = &rb;
+    prod.size = size;
+    prod.total = total;
+    prod.seed = seed;
+    prod.len_seed = seed * 2654435761u + 1;
+    cons = prod;
+
+    t0 = wall_seconds();
+    pthread_create(&tc, NULL, stress_consumer, &cons);
+    pthread_create(&tp, NULL, stress_producer, &prod);
+    pthread_join(tp, NULL);
+    pthread_join(tc, NULL);
+
+    ok = cons.mismatch == 0 && cons.bad_len == 0 && prod.crc == cons.crc && rb_spsc_data_len(&rb) == 0;
+    printf("%6u %10zu %10zu %8zu   %08X %08X  %5.2fs  %s\n", size, total, cons.mismatch, cons.bad_len,
+           prod.crc, cons.crc, wall_seconds() - t0, ok ? "ok" : "FAIL");
+    return ok ? 0 : 1;
+}
+
+/* ======================= 吞吐量 ======================= */
+
+typedef struct {
+    int locked;             /* 0: rb_spsc，1: rb_ringbuffer + 互斥锁 */
+    rb_uint32_t chunk;
+    size_t total;
+} THROUGHPUT_T;
+
+static struct rb_spsc s_spsc;
+static struct rb_ringbuffer s_rb;
+static pthread_mutex_t s_lock = PTHREAD_MUTEX_INITIALIZER;
+static rb_uint32_t s_sink;
+
+static rb_size_t bench_put(int locked, const rb_uint8_t *p, rb_size_t n)
+{
+    rb_size_t r;
+
+    if (!locked) {
+        return (n == 1) ? rb_spsc_putchar(&s_spsc, *p) : rb_spsc_put(&s_spsc, p, n);
+    }
+    pthread_mutex_lock(&s_lock);
+    r = (n == 1) ? rb_ringbuffer_putchar(&s_rb, *p) : rb_ringbuffer_put(&s_rb, p, (rb_length_t)n);
+    pthread_mutex_unlock(&s_lock);
+    return r;
+}
+
+static rb_size_t bench_get(int locked, rb_uint8_t *p, rb_size_t n)
+{
+    rb_size_t r;
+
+    if (!locked) {
+        return (n == 1) ? rb_spsc_getchar(&s_spsc, p) : rb_spsc_get(&s_spsc, p, n);
+    }
+    pthread_mutex_lock(&s_lock);
+    r = (n == 1) ? rb_ringbuffer_getchar(&s_rb, p) : rb_ringbuffer_get(&s_rb, p, (rb_length_t)n);
+    pthread_mutex_unlock(&s_lock);
+    return r;
+}
+
+static void *bench_producer(void *arg)
+{
+    THROUGHPUT_T *tp = arg;
+    rb_uint8_t chunk[MAX_CHUNK];
+    size_t sent = 0;
+
+    memset(chunk, 0xA5, sizeof(chunk));
+    while (sent < tp->total) {
+        rb_size_t n = bench_put(tp->locked, chunk, tp->chunk);
+        if (n == 0) {
+            sched_yield();
+        }
+        sent += n;
+    }
+    return NULL;
+}
+
+static void *bench_consumer(void *arg)
+{
+    THROUGHPUT_T *tp = arg;
+    rb_uint8_t chunk[MAX_CHUNK];
+    size_t got = 0;
+
+    while (got < tp->total) {
+        rb_size_t n = bench_get(tp->locked, chunk, tp->chunk);
+        if (n == 0) {
+            sched_yield();
+        }
+        got += n;
+    }
+    s_sink += chunk[0];
+    return NULL;
+}
+
+/* MB/s */
+static double throughput(int locked, rb_uint32_t chunk, size_t total)
+{
+    THROUGHPUT_T tp = { locked, chunk, total };
+    double best = 1e30;
+
+    for (int r = 0; r < REPEAT; r++) {
+        pthread_t a, b;
+        double t0;
+
+        rb_spsc_init(&s_spsc, s_pool, BENCH_SIZE);
+        rb_ringbuffer_init(&s_rb, s_pool, BENCH_SIZE);
+        t0 = wall_seconds();
+        pthread_create(&b, NULL, bench_consumer, &tp);
+        pthread_create(&a, NULL, bench_producer, &tp);
+        pthread_join(a, NULL);
+        pthread_join(b, NULL);
+        double dt = wall_seconds() - t0;
+        if (dt < best) {
+            best = dt;
+        }
+    }
+    return (double)total / best / 1e6;
+}
+
+int main(int argc, char **argv)
+{
+    size_t mb = 32;
+    rb_uint32_t seed = 1;
+    int fail = 0;
+
+    if (argc > 1) {
+        mb = strtoul(argv[1], NULL, 0);
+    }
+    if (argc > 2) {
+        seed = (rb_uint32_t)strtoul(argv[2], NULL, 0);
+    }
+    if (mb == 0) {
+        mb = 1;
+    }
+    if (seed == 0) {
+        seed = 1;
+    }
+    crc32_init();
+
+#ifdef RB_SPSC_NO_C11_ATOMICS
+    printf("index publish: volatile + compiler barrier\n\n");
+#else
+    printf("index publish: C11 atomics (acquire/release)\n\n");
+#endif
+
+    printf("stress: producer/consumer threads, random chunk 1..2*size\n");
+    printf("%6s %10s %10s %8s   %8s %8s  %6s\n", "size", "bytes", "mismatch", "bad_len", "crc_tx", "crc_rx", "time");
+    for (size_t k = 0; k < sizeof(stress_sizes) / sizeof(stress_sizes[0]); k++) {
+        /* 容量很小时每次只能传几个字节，少传一些 */
+        size_t total = (stress_sizes[k] < 64) ? mb * 32768 : mb * 1048576;
+        fail |= stress_one(stress_sizes[k], total, seed + (rb_uint32_t)k);
+    }
+
+    printf("\nthroughput: %u-byte buffer, best of %d, MB/s\n", BENCH_SIZE, REPEAT);
+    printf("%6s %12s %14s %8s\n", "chunk", "rb_spsc", "ringbuf+mutex", "ratio");
+    for (size_t k = 0; k < sizeof(chunk_sizes) / sizeof(chunk_sizes[0]); k++) {
+        rb_uint32_t chunk = chunk_sizes[k];
+        size_t total = (chunk < 16) ? mb * 65536 : mb * 1048576;
+        double lockfree = throughput(0, chunk, total);
+        double locked = throughput(1, chunk, total);
+
+        printf("%6u %12.1f %14.1f %7.1fx\n", chunk, lockfree, locked, lockfree / locked);
+    }
+    return fail;
+}
@@ -0,0 +1,422 @@
+/**
+ ******************************************************************************
+ * @file    ringbuffer_typed_bench.c
+ * @brief   rb_typed 定长元素环形缓冲区与手写循环数组、逐元素 rb_ringbuffer_put 的耗时对比
+ * @version 1.0.0
+ ******************************************************************************
+ * 用法: ./ringbuffer_typed_bench [每组元素数，默认 16M]
+ *
+ * 三种实现存同样的 float / Axis3f 数据：
+ *   adhoc     WouoUI 波形页的写法：data[tail] = v; tail = (tail + 1) % DEPTH; 满了 head 后移
+ *   bytewise  字节缓冲区 rb_ringbuffer，每个元素一次 rb_ringbuffer_put/get(sizeof(elem))
+ *   typed     rb_typed_push_n / pop_n / push_n_force / snapshot
+ * 三个场景：按块写入再读出、满缓冲区持续覆盖写入、取最近 N 个元素（波形显示）；
+ * 每个场景的输出在三种实现间逐字节比较，不一致时程序返回非 0
+ ******************************************************************************
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#include "ringbuffer.h"
+#include "ringbuffer_typed.h"
+
+#define REPEAT          5           /* 取 5 次中最好的一次 */
+#define DEPTH           250         /* 元素个数，与 WouoUI 的 WAVE_DEPTH 一样不是 2 的幂 */
+#define SHOW_WIDTH      128         /* 快照元素个数，相当于波形显示宽度 */
+#define MAX_BLOCK       64
+#define INPUT_COUNT     4096        /* 预先生成的输入元素个数，循环使用 */
+
+typedef struct {
+    float x, y, z;
+} Axis3f;
+
+static const rb_uint32_t block_sizes[] = { 1, 8, 64 };
+
+static float s_in_f[INPUT_COUNT];
+static Axis3f s_in_a[INPUT_COUNT];
+static rb_uint8_t s_byte_pool[DEPTH * sizeof(Axis3f)];
+static rb_uint8_t s_typed_pool[DEPTH * sizeof(Axis3f)];
+static rb_uint32_t s_hash[3];       /* 各实现输出的哈希，按场景比较 */
+static int s_fail;
+
+static double wall_seconds(void)
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (double)ts.tv_sec + (double)ts.tv_nsec * 1e-9;
+}
+
+static rb_uint32_t hash_bytes(rb_uint32_t h, const void *p, size_t n)
+{
+    const rb_uint8_t *b = p;
+
+    while (n--) {
+        h = (h ^ *b++) * 16777619u;
+    }
+    return h;
+}
+
+/* ======================= 手写循环数组（WouoUI 波形页写法） ======================= */
+
+#define ADHOC_DEFINE(name, type)                                                \
+    typedef struct {                                                            \
+        type data[DEPTH];                                                       \
+        rb_uint16_t head, tail;     /* tail 指向空位，留一个空位区分满/空 */    \
+    } name##_t;                                                                 \
+                                                                                \
+    static void name##_reset(name##_t *q)                                       \
+    {                                                                           \
+        q->head = q->tail = 0;                                                  \
+    }                                                                           \
+                                                                                \
+    /* 不覆盖：满了返回0 */                                                     \
+    static int name##_push(name##_t *q, const type *v)                          \
+    {                                                                           \
+        rb_uint16_t next = (rb_uint16_t)((q->tail + 1) % DEPTH);                \
+        if (next == q->head) {                                                  \
+            return 0;                                                           \
+        }                                                                       \
+        q->data[q->tail] = *v;                                                  \
+        q->tail = next;                                                         \
+        return 1;                                                               \
+    }                                                                           \
+                                                                                \
+    /* 覆盖：满了 head 后移 */                                                  \
+    static void name##_push_force(name##_t *q, const type *v)                   \
+    {                                                                           \
+        q->data[q->tail] = *v;                                                  \
+        q->tail++;                                                              \
+        q->tail %= DEPTH;                                                       \
+        if (q->tail == q->head) {                                               \
+            q->head++;                                                          \
+            q->head %= DEPTH;                                                   \
+        }                                                                       \
+    }                                                                           \
+                                                                                \
+    static int name##_pop(name##_t *q, type *v)                                 \
+    {                                                                           \
+        if (q->head == q->tail) {                                               \
+            return 0;                                                           \
+        }                                                                       \
+        *v = q->data[q->head];                                                  \
+        q->head = (rb_uint16_t)((q->head + 1) % DEPTH);                         \
+        return 1;                                                               \
+    }                                                                           \
+                                                                                \
+    /* 最近 n 个元素，由旧到新 */                                               \
+    static rb_uint32_t name##_snapshot(const name##_t *q, type *out, rb_uint32_t n) \
+    {                                                                           \
+        rb_uint32_t count = (rb_uint32_t)((q->tail + DEPTH - q->head) % DEPTH); \
+        rb_uint32_t k = 0;                                                      \
+        if (n > count) {                                                        \
+            n = count;                                                          \
+        }                                                                       \
+        for (rb_uint16_t i = (rb_uint16_t)((q->tail + DEPTH - n) % DEPTH);      \
+             i != q->tail; i++, i %= DEPTH) {                                   \
+            out[k++] = q->data[i];                                              \
+        }                                                                       \
+        return k;                                                               \
+    }
+
+ADHOC_DEFINE(adhoc_f, float)
+ADHOC_DEFINE(adhoc_a, Axis3f)
+
+/*
+ * 手写数组留一个空位，只能存 DEPTH - 1 个；
+ * 另外两种实现的容量也取 DEPTH - 1，三者的满/空时刻和覆盖结果相同
+ */
+#define CAPACITY        (DEPTH - 1)
+
+static adhoc_f_t s_adhoc_f;
+static adhoc_a_t s_adhoc_a;
+static struct rb_ringbuffer s_byte_rb;
+static struct rb_typed_ringbuffer s_typed_rb;
+
+/* ======================= 场景 ======================= */
+
+enum {
+    IMPL_ADHOC,
+    IMPL_BYTEWISE,
+    IMPL_TYPED,
+};
+
+static const char *const impl_names[] = { "adhoc", "bytewise", "typed" };
+
+static void setup(int impl, rb_uint32_t elem)
+{
+    switch (impl) {
+    case IMPL_ADHOC:
+        adhoc_f_reset(&s_adhoc_f);
+        adhoc_a_reset(&s_adhoc_a);
+        break;
+    case IMPL_BYTEWISE:
+        /* rb_ringbuffer 会把大小按 4 字节向下对齐，float/Axis3f 都是 4 的倍数 */
+        rb_ringbuffer_init(&s_byte_rb, s_byte_pool, (rb_bufsize_t)(CAPACITY * elem));
+        break;
+    default:
+        rb_typed_init(&s_typed_rb, s_typed_pool, elem, CAPACITY);
+        break;
+    }
+}
+
+/* 写一块 n 个元素（不覆盖），返回写入个数 */
+static rb_uint32_t push_block(int impl, rb_uint32_t elem, const void *src, rb_uint32_t n)
+{
+    rb_uint32_t k = 0;
+
+    switch (impl) {
+    case IMPL_ADHOC:
+        if (elem == sizeof(float)) {
+            while (k < n && adhoc_f_push(&s_adhoc_f, &((const float *)src)[k])) {
+                k++;
+            }
+        } else {
+            while (k < n && adhoc_a_push(&s_adhoc_a, &((const Axis3f *)src)[k])) {
+                k++;
+            }
+        }
+        return k;
+    case IMPL_BYTEWISE:
+        while (k < n && rb_ringbuffer_put(&s_byte_rb, (const rb_uint8_t *)src + k * elem, (rb_length_t)elem) == elem) {
+            k++;
+        }
+        return k;
+    default:
+        return (rb_uint32_t)((n == 1) ? rb_typed_push(&s_typed_rb, src) : rb_typed_push_n(&s_typed_rb, src, n));
+    }
+}
+
+static rb_uint32_t pop_block(int impl, rb_uint32_t elem, void *dst, rb_uint32_t n)
+{
+    rb_uint32_t k = 0;
+
+    switch (impl) {
+    case IMPL_ADHOC:
+        if (elem == sizeof(float)) {
+            while (k < n && adhoc_f_pop(&s_adhoc_f, &((float *)dst)[k])) {
+                k++;
+            }
+        } else {
+            while (k < n && adhoc_a_pop(&s_adhoc_a, &((Axis3f *)dst)[k])) {
+                k++;
+            }
+        }
+        return k;
+    case IMPL_BYTEWISE:
+        while (k < n && rb_ringbuffer_get(&s_byte_rb, (rb_uint8_t *)dst + k * elem, (rb_length_t)elem) == elem) {
+            k++;
+        }
+        return k;
+    default:
+        return (rb_uint32_t)((n == 1) ? rb_typed_pop(&s_typed_rb, dst) : rb_typed_pop_n(&s_typed_rb, dst, n));
+    }
+}
+
+static void push_force_block(int impl, rb_uint32_t elem, const void *src, rb_uint32_t n)
+{
+    switch (impl) {
+    case IMPL_ADHOC:
+        for (rb_uint32_t k = 0; k < n; k++) {
+            if (elem == sizeof(float)) {
+                adhoc_f_push_force(&s_adhoc_f, &((const float *)src)[k]);
+            } else {
+                adhoc_a_push_force(&s_adhoc_a, &((const Axis3f *)src)[k]);
+            }
+        }
+        break;
+    case IMPL_BYTEWISE:
+        for (rb_uint32_t k = 0; k < n; k++) {
+            rb_ringbuffer_put_force(&s_byte_rb, (const rb_uint8_t *)src + k * elem, (rb_length_t)elem);
+        }
+        break;
+    default:
+        rb_typed_push_n_force(&s_typed_rb, src, n);
+        break;
+    }
+}
+
+/* 最近 n 个元素；字节缓冲区没有快照接口，只能读出后再写回，这里记为不支持 */
+static rb_uint32_t snapshot(int impl, rb_uint32_t elem, void *dst, rb_uint32_t n)
+{
+    switch (impl) {
+    case IMPL_ADHOC:
+        return (elem == sizeof(float)) ? adhoc_f_snapshot(&s_adhoc_f, dst, n)
+                                       : adhoc_a_snapshot(&s_adhoc_a, dst, n);
+    case IMPL_TYPED:
+        return (rb_uint32_t)rb_typed_snapshot(&s_typed_rb, dst, n);
+    default:
+        return 0;
+    }
+}
+
+static const void *input(rb_uint32_t elem, rb_uint32_t i)
+{
+    return (elem == sizeof(float)) ? (const void *)&s_in_f[i] : (const void *)&s_in_a[i];
+}
+
+/*
+ * 按块写入再读出：生产者先领先半个缓冲区，之后每次写一块读一块；返回 ns/元素
+ * 前 REPEAT 次计时，最后一次不计时，对读出的数据算哈希
+ */
+static double run_stream(int impl, rb_uint32_t elem, rb_uint32_t block, size_t count)
+{
+    rb_uint8_t out[MAX_BLOCK * sizeof(Axis3f)];
+    double best = 1e30;
+
+    for (int r = 0; r <= REPEAT; r++) {
+        rb_uint32_t pos = 0, h = 2166136261u;
+        double t0;
+
+        setup(impl, elem);
+        for (rb_uint32_t i = 0; i < CAPACITY / 2; i++) {
+            push_block(impl, elem, input(elem, pos++), 1);
+        }
+        t0 = wall_seconds();
+        for (size_t done = 0; done < count; done += block) {
+            if (pos + block > INPUT_COUNT) {
+                pos = 0;
+            }
+            push_block(impl, elem, input(elem, pos), block);
+            pos += block;
+            rb_uint32_t got = pop_block(impl, elem, out, block);
+            if (r == REPEAT) {
+                h = hash_bytes(h, out, (size_t)got * elem);
+            }
+        }
+        double dt = wall_seconds() - t0;
+        if (r < REPEAT && dt < best) {
+            best = dt;
+        }
+        s_hash[impl] = h;
+    }
+    return best / (double)count * 1e9;
+}
+
+/* 满缓冲区持续覆盖写入，每写 SHOW_WIDTH 个取一次快照校验；返回 ns/元素（只计写入） */
+static double run_overwrite(int impl, rb_uint32_t elem, rb_uint32_t block, size_t count)
+{
+    rb_uint8_t snap[SHOW_WIDTH * sizeof(Axis3f)];
+    double best = 1e30;
+
+    for (int r = 0; r < REPEAT; r++) {
+        rb_uint32_t pos = 0;
+        double t0;
+
+        setup(impl, elem);
+        t0 = wall_seconds();
+        for (size_t done = 0; done < count; done += block) {
+            if (pos + block > INPUT_COUNT) {
+                pos = 0;
+            }
+            push_force_block(impl, elem, input(elem, pos), block);
+            pos += block;
+        }
+        double dt = wall_seconds() - t0;
+        if (dt < best) {
+            best = dt;
+        }
+        /* 覆盖后缓冲区里应是最后 CAPACITY 个元素，读出全部比较 */
+        rb_uint32_t h = 2166136261u;
+        for (rb_uint32_t got; (got = pop_block(impl, elem, snap, SHOW_WIDTH)) > 0;) {
+            h = hash_bytes(h, snap, (size_t)got * elem);
+        }
+        s_hash[impl] = h;
+    }
+    return best / (double)count * 1e9;
+}
+
+/* 取最近 SHOW_WIDTH 个元素；返回 ns/次 */
+static double run_snapshot(int impl, rb_uint32_t elem, size_t calls)
+{
+    rb_uint8_t snap[SHOW_WIDTH * sizeof(Axis3f)];
+    double best = 1e30;
+
+    for (int r = 0; r < REPEAT; r++) {
+        rb_uint32_t h = 2166136261u, got = 0;
+        double t0;
+
+        setup(impl, elem);
+        push_force_block(impl, elem, input(elem, 0), CAPACITY);
+        push_force_block(impl, elem, input(elem, CAPACITY), 100);   /* 让数据跨过数组末尾 */
+        t0 = wall_seconds();
+        for (size_t i = 0; i < calls; i++) {
+            got = snapshot(impl, elem, snap, SHOW_WIDTH);
+            h += snap[(i * 13) % (SHOW_WIDTH * elem)];
+        }
+        double dt = wall_seconds() - t0;
+        if (dt < best) {
+            best = dt;
+        }
+        s_hash[impl] = hash_bytes(h, snap, (size_t)got * elem);
+    }
+    return best / (double)calls * 1e9;
+}
+
+static void check(int a, int b, const char *what)
+{
+    if (s_hash[a] != s_hash[b]) {
+        printf("  MISMATCH: %s %s vs %s\n", what, impl_names[a], impl_names[b]);
+        s_fail = 1;
+    }
+}
+
+int main(int argc, char **argv)
+{
+    size_t count = 16u << 20;
+
+    if (argc > 1) {
+        count = strtoul(argv[1], NULL, 0);
+    }
+    if (count < MAX_BLOCK) {
+        count = MAX_BLOCK;
+    }
+    for (rb_uint32_t i = 0; i < INPUT_COUNT; i++) {
+        s_in_f[i] = (float)i * 0.25f - 100.0f;
+        s_in_a[i].x = (float)i;
+        s_in_a[i].y = -(float)i;
+        s_in_a[i].z = (float)(i ^ 0x55);
+    }
+
+    printf("capacity %u elements, best of %d, ns per element\n", CAPACITY, REPEAT);
+    printf("%-8s %-10s %6s %10s %10s %10s %8s\n", "type", "scenario", "block", "adhoc", "bytewise", "typed", "speedup");
+
+    for (int t = 0; t < 2; t++) {
+        rb_uint32_t elem = (t == 0) ? sizeof(float) : sizeof(Axis3f);
+        const char *tname = (t == 0) ? "float" : "Axis3f";
+        double ns[3];
+
+        for (size_t k = 0; k < sizeof(block_sizes) / sizeof(block_sizes[0]); k++) {
+            rb_uint32_t block = block_sizes[k];
+
+            for (int impl = 0; impl < 3; impl++) {
+                ns[impl] = run_stream(impl, elem, block, count);
+            }
+            printf("%-8s %-10s %6u %10.2f %10.2f %10.2f %7.1fx\n", tname, "push/pop", block,
+                   ns[0], ns[1], ns[2], ns[0] / ns[2]);
+            check(IMPL_ADHOC, IMPL_TYPED, "push/pop");
+            check(IMPL_BYTEWISE, IMPL_TYPED, "push/pop");
+        }
+        for (size_t k = 0; k < sizeof(block_sizes) / sizeof(block_sizes[0]); k++) {
+            rb_uint32_t block = block_sizes[k];
+
+            for (int impl = 0; impl < 3; impl++) {
+                ns[impl] = run_overwrite(impl, elem, block, count);
+            }
+            printf("%-8s %-10s %6u %10.2f %10.2f %10.2f %7.1fx\n", tname, "overwrite", block,
+                   ns[0], ns[1], ns[2], ns[0] / ns[2]);
+            check(IMPL_ADHOC, IMPL_TYPED, "overwrite");
+            check(IMPL_BYTEWISE, IMPL_TYPED, "overwrite");
+        }
+
+        ns[IMPL_ADHOC] = run_snapshot(IMPL_ADHOC, elem, count / SHOW_WIDTH) / SHOW_WIDTH;
+        ns[IMPL_TYPED] = run_snapshot(IMPL_TYPED, elem, count / SHOW_WIDTH) / SHOW_WIDTH;
+        printf("%-8s %-10s %6u %10.2f %10s %10.2f %7.1fx\n", tname, "snapshot", SHOW_WIDTH,
+               ns[IMPL_ADHOC], "-", ns[IMPL_TYPED], ns[IMPL_ADHOC] / ns[IMPL_TYPED]);
+        check(IMPL_ADHOC, IMPL_TYPED, "snapshot");
+    }
+    printf("\nspeedup = adhoc / typed; outputs identical across implementations: %s\n", s_fail ? "NO" : "yes");
+    return s_fail;
+}
@@ -0,0 +1,178 @@
+/**
+ ******************************************************************************
+ * @file    ringbuffer_wide_bench.c
+ * @brief   rb_ringbuffer 单字节与批量读写微基准，宽索引与镜像位两种配置各编译一次
+ * @version 1.0.0
+ ******************************************************************************
+ * 用法: ./ringbuffer_wide_bench [每组字节数，默认 64M]
+ *       ./ringbuffer_mirror_bench [每组字节数，默认 64M]
+ *
+ * 同一份源码：定义 RB_USING_WIDE_INDEX 时为宽索引，否则为默认的 15 位索引 + 镜像位。
+ * 单字节组先写入半个缓冲区，之后读写交替进行，索引会反复回绕；
+ * 读出的字节与写入序列逐个比较，不一致时程序返回非 0
+ ******************************************************************************
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#include "ringbuffer.h"
+
+#define REPEAT          5           /* 取 5 次中最好的一次 */
+#define SMALL_SIZE      4096
+#define LARGE_SIZE      (256 * 1024) /* 只有宽索引配置能用 */
+#define MAX_CHUNK       1024
+
+static const rb_uint32_t chunk_sizes[] = { 16, 256, 1024 };
+
+static rb_uint8_t s_pool[LARGE_SIZE];
+static rb_uint8_t s_out[MAX_CHUNK];
+static struct rb_ringbuffer s_rb;
+static volatile rb_size_t s_sink;
+static int s_fail;
+
+static double wall_seconds(void)
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (double)ts.tv_sec + (double)ts.tv_nsec * 1e-9;
+}
+
+/* 预填半个缓冲区，写入字节为序号的低 8 位 */
+static rb_uint32_t prefill(rb_uint32_t size)
+{
+    rb_uint32_t w;
+
+    rb_ringbuffer_init(&s_rb, s_pool, (rb_bufsize_t)size);
+    for (w = 0; w < size / 2; w++) {
+        rb_ringbuffer_putchar(&s_rb, (rb_uint8_t)w);
+    }
+    return w;
+}
+
+/* putchar + getchar 一对，返回 ns/字节 */
+static double bench_byte(rb_uint32_t size, size_t bytes)
+{
+    double best = 1e30;
+
+    for (int r = 0; r < REPEAT; r++) {
+        rb_uint32_t w = prefill(size), rd = 0;
+        rb_uint8_t ch;
+        double t0 = wall_seconds();
+
+        for (size_t i = 0; i < bytes; i++) {
+            rb_ringbuffer_putchar(&s_rb, (rb_uint8_t)w++);
+            rb_ringbuffer_getchar(&s_rb, &ch);
+            if (ch != (rb_uint8_t)rd++) {
+                s_fail = 1;
+            }
+        }
+        double dt = wall_seconds() - t0;
+        if (dt < best) {
+            best = dt;
+        }
+    }
+    return best / (double)bytes * 1e9;
+}
+
+/* 按块 put + get，返回 MB/s */
+static double bench_bulk(rb_uint32_t size, rb_uint32_t chunk, size_t bytes)
+{
+    rb_uint8_t in[MAX_CHUNK];
+    double best = 1e30;
+
+    for (rb_uint32_t i = 0; i < chunk; i++) {
+        in[i] = (rb_uint8_t)(i * 7u + 1);
+    }
+    for (int r = 0; r < REPEAT; r++) {
+        size_t moved = 0;
+        double t0;
+
+        /* 预填后读空，索引从缓冲区中间开始，读出的都是本组写入的块 */
+        prefill(size);
+        while (rb_ringbuffer_get(&s_rb, s_out, MAX_CHUNK) > 0) {
+        }
+        t0 = wall_seconds();
+        while (moved < bytes) {
+            rb_ringbuffer_put(&s_rb, in, (rb_length_t)chunk);
+            moved += rb_ringbuffer_get(&s_rb, s_out, (rb_length_t)chunk);
+        }
+        double dt = wall_seconds() - t0;
+        if (dt < best) {
+            best = dt;
+        }
+        if (memcmp(in, s_out, chunk) != 0) {
+            s_fail = 1;
+        }
+    }
+    return (double)bytes / best / 1e6;
+}
+
+/* data_len + space_len，返回 ns/次 */
+static double bench_len(rb_uint32_t size, size_t calls)
+{
+    double best = 1e30;
+
+    for (int r = 0; r < REPEAT; r++) {
+        rb_size_t acc = 0;
+        rb_uint8_t ch;
+        double t0;
+
+        prefill(size);
+        t0 = wall_seconds();
+        for (size_t i = 0; i < calls; i++) {
+            acc += rb_ringbuffer_data_len(&s_rb) + rb_ringbuffer_space_len(&s_rb);
+            /* 每 8 次移动一下索引，让状态在空、半满、满之间变化 */
+            if ((i & 7) == 0) {
+                if (i & 8) {
+                    rb_ringbuffer_putchar(&s_rb, 0);
+                } else {
+                    rb_ringbuffer_getchar(&s_rb, &ch);
+                }
+            }
+        }
+        double dt = wall_seconds() - t0;
+        if (dt < best) {
+            best = dt;
+        }
+        s_sink = acc;
+    }
+    return best / (double)calls * 1e9;
+}
+
+static void run(rb_uint32_t size, size_t bytes)
+{
+    printf("%7u %12.2f %12.2f", size, bench_byte(size, bytes), bench_len(size, bytes));
+    for (size_t k = 0; k < sizeof(chunk_sizes) / sizeof(chunk_sizes[0]); k++) {
+        printf(" %10.0f", bench_bulk(size, chunk_sizes[k], bytes * 4));
+    }
+    printf("\n");
+}
+
+int main(int argc, char **argv)
+{
+    size_t bytes = 64u << 20;
+
+    if (argc > 1) {
+        bytes = strtoul(argv[1], NULL, 0);
+    }
+    if (bytes == 0) {
+        bytes = 1;
+    }
+
+#ifdef RB_USING_WIDE_INDEX
+    printf("RB_USING_WIDE_INDEX: 32-bit free-running index, power-of-two mask\n");
+#else
+    printf("default: 15-bit index + mirror bit\n");
+#endif
+    printf("%7s %12s %12s %10s %10s %10s\n", "size", "byte ns/B", "len ns/pair", "bulk 16", "bulk 256", "bulk 1024");
+    run(SMALL_SIZE, bytes);
+#ifdef RB_USING_WIDE_INDEX
+    run(LARGE_SIZE, bytes);
+#endif
+    printf("bulk columns: MB/s (put + get of one chunk per iteration), best of %d\n", REPEAT);
+    printf("data check: %s\n", s_fail ? "FAIL" : "ok");
+    return s_fail;
+}
@@ -0,0 +1,13 @@
+/**
+ * @file    bench_memcpy.h
+ * @brief   计数版 memcpy，编译 ringbuffer.c 时以 -include 引入并替换 rb_memcpy
+ */
+
+#ifndef BENCH_MEMCPY_H
+#define BENCH_MEMCPY_H
+
+#include <stddef.h>
+
+void *bench_memcpy(void *dst, const void *src, size_t n);
+
+#endif /* BENCH_MEMCPY_H */
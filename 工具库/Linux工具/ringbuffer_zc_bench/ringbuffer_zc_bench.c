@@ -0,0 +1,414 @@
+/**
+ ******************************************************************************
+ * @file    ringbuffer_zc_bench.c
+ * @brief   rb_ringbuffer 零拷贝接口（reserve/commit、peek_spans/consume）与 put/get 的拷贝量和吞吐量
+ * @version 1.0.0
+ ******************************************************************************
+ * 用法: ./ringbuffer_zc_bench [每组 MB 数，默认 64] [随机种子，默认 1]
+ *
+ * 两条数据通路，各用 put/get 与零拷贝接口跑一遍：
+ *   串口接收  DMA 按空闲中断随机长度搬入 -> 环形缓冲区 -> 帧解析
+ *   日志记录  解析器产生 32 字节记录 -> 环形缓冲区 -> 按 256 字节页写 Flash
+ * ringbuffer.c 以 -Drb_memcpy=bench_memcpy 编译，库内每次 memcpy 的字节数都计入 CPU 拷贝量；
+ * 模拟的 DMA 搬运和 Flash 写入由外设完成，不计入
+ ******************************************************************************
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#include "ringbuffer.h"
+#include "bench_memcpy.h"
+
+#define REPEAT          5           /* 吞吐量取 5 次中最好的一次 */
+#define RING_SIZE       4096
+#define DMA_MAX         256         /* 一次空闲中断最多收到的字节数 */
+#define PARSE_CHUNK     256         /* put/get 方式下解析器每次取出的字节数 */
+#define FRAME_PAYLOAD   28          /* 帧：0xAA, 长度, 负载, 和校验 */
+#define RECORD_SIZE     32
+#define FLASH_PAGE      256
+#define SOURCE_SIZE     (1 << 20)   /* 预先生成的串口字节流，循环使用 */
+
+static rb_uint8_t s_ring_pool[RING_SIZE];
+static rb_uint8_t s_source[SOURCE_SIZE];
+static size_t s_cpu_copied;         /* 库内 memcpy 的字节数 */
+static rb_uint32_t s_rng = 1;
+
+/* ringbuffer.c 中的 rb_memcpy 被替换为本函数 */
+void *bench_memcpy(void *dst, const void *src, size_t n)
+{
+    s_cpu_copied += n;
+    return memcpy(dst, src, n);
+}
+
+static rb_uint32_t bench_rand(void)
+{
+    rb_uint32_t x = s_rng;
+    x ^= x << 13;
+    x ^= x >> 17;
+    x ^= x << 5;
+    s_rng = x;
+    return x;
+}
+
+static double wall_seconds(void)
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (double)ts.tv_sec + (double)ts.tv_nsec * 1e-9;
+}
+
+/* ======================= 串口帧解析 ======================= */
+
+typedef struct {
+    int state;              /* 0: 找帧头，1: 长度，2: 负载，3: 校验 */
+    rb_uint8_t len, pos, sum;
+    rb_uint32_t frames;
+    rb_uint32_t hash;       /* 负载的 FNV 哈希，两种接口结果须相同 */
+} PARSER_T;
+
+static void parser_feed(PARSER_T *ps, const rb_uint8_t *p, rb_size_t n)
+{
+    for (rb_size_t i = 0; i < n; i++) {
+        rb_uint8_t b = p[i];
+
+        switch (ps->state) {
+        case 0:
+            if (b == 0xAA) {
+                ps->state = 1;
+            }
+            break;
+        case 1:
+            ps->len = b;
+            ps->pos = 0;
+            ps->sum = 0;
+            ps->state = (b > 0 && b <= FRAME_PAYLOAD) ? 2 : 0;
+            break;
+        case 2:
+            ps->sum += b;
+            ps->hash = (ps->hash ^ b) * 16777619u;
+            if (++ps->pos == ps->len) {
+                ps->state = 3;
+            }
+            break;
+        default:
+            if (b == ps->sum) {
+                ps->frames++;
+            }
+            ps->state = 0;
+            break;
+        }
+    }
+}
+
+static void make_source(void)
+{
+    size_t i = 0;
+
+    while (i + FRAME_PAYLOAD + 3 <= SOURCE_SIZE) {
+        rb_uint8_t len = (rb_uint8_t)(1 + bench_rand() % FRAME_PAYLOAD), sum = 0;
+
+        s_source[i++] = 0xAA;
+        s_source[i++] = len;
+        for (rb_uint8_t k = 0; k < len; k++) {
+            rb_uint8_t b = (rb_uint8_t)bench_rand();
+            s_source[i++] = b;
+            sum += b;
+        }
+        s_source[i++] = sum;
+    }
+    while (i < SOURCE_SIZE) {
+        s_source[i++] = 0;
+    }
+}
+
+/* 模拟 DMA 把串口流的下一段搬到 dst */
+static size_t s_src_pos;
+
+static void dma_receive(rb_uint8_t *dst, rb_size_t n)
+{
+    for (rb_size_t done = 0; done < n;) {
+        rb_size_t k = n - done;
+
+        if (k > SOURCE_SIZE - s_src_pos) {
+            k = SOURCE_SIZE - s_src_pos;
+        }
+        memcpy(&dst[done], &s_source[s_src_pos], k);
+        s_src_pos = (s_src_pos + k) % SOURCE_SIZE;
+        done += k;
+    }
+}
+
+/* put/get：DMA 进驱动缓冲区，put 拷入环形缓冲区，get 拷到解析缓冲区 */
+static void uart_copy(size_t total, PARSER_T *ps)
+{
+    struct rb_ringbuffer rb;
+    rb_uint8_t dma_buf[DMA_MAX], parse_buf[PARSE_CHUNK];
+    size_t moved = 0;
+
+    rb_ringbuffer_init(&rb, s_ring_pool, RING_SIZE);
+    while (moved < total) {
+        rb_size_t n = 1 + bench_rand() % DMA_MAX;
+
+        if (n > rb_ringbuffer_space_len(&rb)) {
+            n = rb_ringbuffer_space_len(&rb);
+        }
+        dma_receive(dma_buf, n);
+        rb_ringbuffer_put(&rb, dma_buf, (rb_length_t)n);
+        moved += n;
+
+        /* 主循环：取出一部分交给解析器 */
+        rb_size_t k = rb_ringbuffer_get(&rb, parse_buf, PARSE_CHUNK);
+        parser_feed(ps, parse_buf, k);
+    }
+    for (rb_size_t k; (k = rb_ringbuffer_get(&rb, parse_buf, PARSE_CHUNK)) > 0;) {
+        parser_feed(ps, parse_buf, k);
+    }
+}
+
+/* 零拷贝：DMA 直接写入预留区域，解析器在环形缓冲区内原地解析 */
+static void uart_zero_copy(size_t total, PARSER_T *ps)
+{
+    struct rb_ringbuffer rb;
+    size_t moved = 0;
+    rb_uint8_t *p0, *p1;
+    rb_size_t n0, n1;
+
+    rb_ringbuffer_init(&rb, s_ring_pool, RING_SIZE);
+    while (moved < total) {
+        rb_size_t n = 1 + bench_rand() % DMA_MAX;
+        rb_uint8_t *wp;
+
+        if (n > rb_ringbuffer_space_len(&rb)) {
+            n = rb_ringbuffer_space_len(&rb);
+        }
+        /* 到缓冲区末尾时分两次预留，相当于 DMA 的双缓冲切换 */
+        for (rb_size_t left = n; left > 0;) {
+            rb_size_t room = rb_ringbuffer_reserve(&rb, &wp);
+            if (room > left) {
+                room = left;
+            }
+            dma_receive(wp, room);
+            rb_ringbuffer_commit(&rb, room);
+            left -= room;
+        }
+        moved += n;
+
+        if (rb_ringbuffer_peek_spans(&rb, &p0, &n0, &p1, &n1) > 0) {
+            /* 与 put/get 方式每次处理的量相同 */
+            if (n0 > PARSE_CHUNK) {
+                n0 = PARSE_CHUNK;
+            }
+            if (n1 > PARSE_CHUNK - n0) {
+                n1 = PARSE_CHUNK - n0;
+            }
+            parser_feed(ps, p0, n0);
+            parser_feed(ps, p1, n1);
+            rb_ringbuffer_consume(&rb, n0 + n1);
+        }
+    }
+    while (rb_ringbuffer_peek_spans(&rb, &p0, &n0, &p1, &n1) > 0) {
+        parser_feed(ps, p0, n0);
+        parser_feed(ps, p1, n1);
+        rb_ringbuffer_consume(&rb, n0 + n1);
+    }
+}
+
+/* ======================= 日志记录 ======================= */
+
+typedef struct {
+    rb_uint32_t pages;
+    rb_uint32_t hash;       /* 写入 Flash 的全部字节的 FNV 哈希 */
+} FLASH_T;
+
+static void flash_write(FLASH_T *fl, const rb_uint8_t *p, rb_size_t n)
+{
+    for (rb_size_t i = 0; i < n; i++) {
+        fl->hash = (fl->hash ^ p[i]) * 16777619u;
+    }
+}
+
+/* 在 dst 处生成第 seq 条记录 */
+static void record_build(rb_uint8_t *dst, rb_uint32_t seq)
+{
+    dst[0] = 0x55;
+    dst[1] = RECORD_SIZE;
+    dst[2] = (rb_uint8_t)seq;
+    dst[3] = (rb_uint8_t)(seq >> 8);
+    for (int i = 4; i < RECORD_SIZE; i++) {
+        dst[i] = (rb_uint8_t)(seq * 7u + (rb_uint32_t)i);
+    }
+}
+
+/* put/get：记录在局部变量中组好再 put，日志任务 get 到页缓冲区再写 Flash */
+static void log_copy(size_t total, FLASH_T *fl)
+{
+    struct rb_ringbuffer rb;
+    rb_uint8_t rec[RECORD_SIZE], page[FLASH_PAGE];
+    rb_uint32_t seq = 0;
+
+    rb_ringbuffer_init(&rb, s_ring_pool, RING_SIZE);
+    while ((size_t)seq * RECORD_SIZE < total) {
+        record_build(rec, seq++);
+        rb_ringbuffer_put(&rb, rec, RECORD_SIZE);
+        if (rb_ringbuffer_data_len(&rb) >= FLASH_PAGE) {
+            rb_ringbuffer_get(&rb, page, FLASH_PAGE);
+            flash_write(fl, page, FLASH_PAGE);
+            fl->pages++;
+        }
+    }
+}
+
+/*
+ * 零拷贝：连续空间够一条记录时直接在环形缓冲区里组帧，不够时退回局部变量 + put；
+ * 日志任务把环形缓冲区里的一页（可能分两段）直接交给 Flash 驱动
+ */
+static void log_zero_copy(size_t total, FLASH_T *fl)
+{
+    struct rb_ringbuffer rb;
+    rb_uint8_t rec[RECORD_SIZE];
+    rb_uint32_t seq = 0;
+
+    rb_ringbuffer_init(&rb, s_ring_pool, RING_SIZE);
+    while ((size_t)seq * RECORD_SIZE < total) {
+        rb_uint8_t *wp;
+
+        if (rb_ringbuffer_reserve(&rb, &wp) >= RECORD_SIZE) {
+            record_build(wp, seq++);
+            rb_ringbuffer_commit(&rb, RECORD_SIZE);
+        } else {
+            record_build(rec, seq++);
+            rb_ringbuffer_put(&rb, rec, RECORD_SIZE);
+        }
+        if (rb_ringbuffer_data_len(&rb) >= FLASH_PAGE) {
+            rb_uint8_t *p0, *p1;
+            rb_size_t n0, n1;
+
+            rb_ringbuffer_peek_spans(&rb, &p0, &n0, &p1, &n1);
+            if (n0 >= FLASH_PAGE) {
+                flash_write(fl, p0, FLASH_PAGE);
+            } else {
+                flash_write(fl, p0, n0);
+                flash_write(fl, p1, FLASH_PAGE - n0);
+            }
+            rb_ringbuffer_consume(&rb, FLASH_PAGE);
+            fl->pages++;
+        }
+    }
+}
+
+/* ======================= 主程序 ======================= */
+
+typedef struct {
+    const char *name;
+    size_t copied;          /* 库内 CPU 拷贝的字节数 */
+    double seconds;
+    rb_uint32_t check;      /* 帧数或页数 */
+    rb_uint32_t hash;
+} RESULT_T;
+
+static void run_uart(int zero_copy, size_t total, RESULT_T *res)
+{
+    res->seconds = 1e30;
+    for (int r = 0; r < REPEAT; r++) {
+        PARSER_T ps;
+        double t0;
+
+        memset(&ps, 0, sizeof(ps));
+        ps.hash = 2166136261u;
+        s_rng = 12345;
+        s_src_pos = 0;
+        s_cpu_copied = 0;
+        t0 = wall_seconds();
+        if (zero_copy) {
+            uart_zero_copy(total, &ps);
+        } else {
+            uart_copy(total, &ps);
+        }
+        double dt = wall_seconds() - t0;
+        if (dt < res->seconds) {
+            res->seconds = dt;
+        }
+        res->copied = s_cpu_copied;
+        res->check = ps.frames;
+        res->hash = ps.hash;
+    }
+}
+
+static void run_log(int zero_copy, size_t total, RESULT_T *res)
+{
+    res->seconds = 1e30;
+    for (int r = 0; r < REPEAT; r++) {
+        FLASH_T fl;
+        double t0;
+
+        memset(&fl, 0, sizeof(fl));
+        fl.hash = 2166136261u;
+        s_cpu_copied = 0;
+        t0 = wall_seconds();
+        if (zero_copy) {
+            log_zero_copy(total, &fl);
+        } else {
+            log_copy(total, &fl);
+        }
+        double dt = wall_seconds() - t0;
+        if (dt < res->seconds) {
+            res->seconds = dt;
+        }
+        res->copied = s_cpu_copied;
+        res->check = fl.pages;
+        res->hash = fl.hash;
+    }
+}
+
+static void print_row(const char *path, const RESULT_T *res, size_t total)
+{
+    printf("%-12s %-14s %14.0f %10.2f %10.0f %10u %08X\n", path, res->name,
+           (double)res->copied / ((double)total / 1048576.0), (double)res->copied / (double)total,
+           (double)total / res->seconds / 1e6, res->check, res->hash);
+}
+
+int main(int argc, char **argv)
+{
+    size_t mb = 64;
+    RESULT_T uart[2] = { { "put/get", 0, 0, 0, 0 }, { "reserve/peek", 0, 0, 0, 0 } };
+    RESULT_T log[2] = { { "put/get", 0, 0, 0, 0 }, { "reserve/peek", 0, 0, 0, 0 } };
+    size_t total;
+    int fail;
+
+    if (argc > 1) {
+        mb = strtoul(argv[1], NULL, 0);
+    }
+    if (argc > 2) {
+        s_rng = (rb_uint32_t)strtoul(argv[2], NULL, 0);
+    }
+    if (mb == 0) {
+        mb = 1;
+    }
+    if (s_rng == 0) {
+        s_rng = 1;
+    }
+    total = mb * 1048576;
+    make_source();
+
+    for (int z = 0; z < 2; z++) {
+        run_uart(z, total, &uart[z]);
+        run_log(z, total, &log[z]);
+    }
+
+    printf("%u-byte ring, %zu MB per path, best of %d\n", RING_SIZE, mb, REPEAT);
+    printf("%-12s %-14s %14s %10s %10s %10s %8s\n",
+           "path", "api", "copied B/MB", "copies/B", "MB/s", "frames", "hash");
+    print_row("uart->parse", &uart[0], total);
+    print_row("uart->parse", &uart[1], total);
+    print_row("log->flash", &log[0], total);
+    print_row("log->flash", &log[1], total);
+
+    /* 两种接口交给解析器/Flash 的数据必须相同 */
+    fail = uart[0].check != uart[1].check || uart[0].hash != uart[1].hash ||
+           log[0].check != log[1].check || log[0].hash != log[1].hash;
+    printf("\nparsed frames / flash pages identical: %s\n", fail ? "NO" : "yes");
+    return fail;
+}
@@ -0,0 +1,352 @@
+/**
+ ******************************************************************************
+ * @file    sched_sim.c
+ * @brief   调度器/软件定时器虚拟时钟仿真 - 主机端（Linux）确定性时序回放
+ * @version 1.0.0
+ ******************************************************************************
+ */
+
+#include "sched_sim.h"
+
+/* 当前仿真实例：调度器任务函数没有参数，只能经由全局实例找到执行时间模型 */
+static sim_t *s_sim = NULL;
+
+/* ======================= 任务体 ======================= */
+
+static uint32_t sim_rand(sim_t *sim)
+{
+    /* xorshift32，保证相同种子结果可复现 */
+    uint32_t x = sim->rng;
+    x ^= x << 13;
+    x ^= x >> 17;
+    x ^= x << 5;
+    sim->rng = x;
+    return x;
+}
+
+/**
+ * @brief 执行一次任务：记录启动延迟，按执行时间模型推进虚拟时钟
+ * @note 理想释放时间为 origin + k * period；k 取启动时刻之前最近的一个，
+ *       中间没有启动过的周期计为错过，同一周期内的补跑不计延迟
+ */
+static void sim_body(sim_t *sim, int index)
+{
+    sim_task_t *task = &sim->tasks[index];
+    uint64_t start = sim->now_us;
+    uint64_t release = 0;
+
+    if (task->runs == 0) {
+        task->origin_us = start;
+        task->last_release = 0;
+    } else {
+        if (start - task->last_start_us > task->gap_max_us) {
+            task->gap_max_us = (uint32_t)(start - task->last_start_us);
+        }
+        if (task->period_us > 0) {
+            release = (start - task->origin_us) / task->period_us;
+            if (release <= task->last_release) {
+                release = task->last_release + 1;
+            } else {
+                task->missed += release - task->last_release - 1;
+            }
+            task->last_release = release;
+        }
+    }
+    task->last_start_us = start;
+
+    uint64_t release_us = task->origin_us + release * task->period_us;
+    uint32_t latency = (start > release_us) ? (uint32_t)(start - release_us) : 0;
+
+    uint32_t cost = task->cost.cost_us;
+    if (task->cost.jitter_us > 0) {
+        cost += sim_rand(sim) % (task->cost.jitter_us + 1);
+    }
+    if (task->cost.spike_every > 0 && (task->runs + 1) % task->cost.spike_every == 0) {
+        cost += task->cost.spike_us;
+    }
+
+    sim->now_us += cost;
+    if (task->cost.hook != NULL) {
+        task->cost.hook(task->cost.arg);
+    }
+
+    uint64_t exec = sim->now_us - start;
+
+    task->runs++;
+    task->exec_total_us += exec;
+    if (exec > task->exec_max_us) {
+        task->exec_max_us = (uint32_t)exec;
+    }
+    task->latency_total_us += latency;
+    if (latency > task->latency_max_us) {
+        task->latency_max_us = latency;
+    }
+    if (task->deadline_us > 0 && sim->now_us > release_us + task->deadline_us) {
+        task->missed++;
+    }
+    sim->busy_us += exec;
+}
+
+/* 调度器任务入口：每个调度器任务槽位一个，按槽位找到对应的执行时间模型 */
+#define SIM_ENTRY(n) \
+    static void sim_entry_##n(void) { sim_body(s_sim, s_sim->sched_map[n]); }
+
+SIM_ENTRY(0)  SIM_ENTRY(1)  SIM_ENTRY(2)  SIM_ENTRY(3)
+SIM_ENTRY(4)  SIM_ENTRY(5)  SIM_ENTRY(6)  SIM_ENTRY(7)
+SIM_ENTRY(8)  SIM_ENTRY(9)  SIM_ENTRY(10) SIM_ENTRY(11)
+SIM_ENTRY(12) SIM_ENTRY(13) SIM_ENTRY(14) SIM_ENTRY(15)
+SIM_ENTRY(16) SIM_ENTRY(17) SIM_ENTRY(18) SIM_ENTRY(19)
+SIM_ENTRY(20) SIM_ENTRY(21) SIM_ENTRY(22) SIM_ENTRY(23)
+SIM_ENTRY(24) SIM_ENTRY(25) SIM_ENTRY(26) SIM_ENTRY(27)
+SIM_ENTRY(28) SIM_ENTRY(29) SIM_ENTRY(30) SIM_ENTRY(31)
+
+#if SCHEDULER_MAX_TASKS > 32
+#error "sched_sim supports at most 32 scheduler tasks"
+#endif
+
+static const scheduler_task_fn s_entries[32] = {
+    sim_entry_0,  sim_entry_1,  sim_entry_2,  sim_entry_3,
+    sim_entry_4,  sim_entry_5,  sim_entry_6,  sim_entry_7,
+    sim_entry_8,  sim_entry_9,  sim_entry_10, sim_entry_11,
+    sim_entry_12, sim_entry_13, sim_entry_14, sim_entry_15,
+    sim_entry_16, sim_entry_17, sim_entry_18, sim_entry_19,
+    sim_entry_20, sim_entry_21, sim_entry_22, sim_entry_23,
+    sim_entry_24, sim_entry_25, sim_entry_26, sim_entry_27,
+    sim_entry_28, sim_entry_29, sim_entry_30, sim_entry_31,
+};
+
+static void sim_timer_entry(MultiTimer *timer, void *userData)
+{
+    (void)timer;
+    sim_body(s_sim, (int)(intptr_t)userData);
+}
+
+/* ======================= 对外接口 ======================= */
+
+void sim_init(sim_t *sim, uint32_t seed)
+{
+    if (sim == NULL) {
+        return;
+    }
+
+    sim->now_us = 0;
+    sim->loop_overhead_us = 1;
+    sim->rng = seed ? seed : 1;
+    sim->start_us = 0;
+    sim->busy_us = 0;
+    sim->iterations = 0;
+    sim->wakeups = 0;
+    sim->task_count = 0;
+
+    for (int i = 0; i < 32; i++) {
+        sim->sched_map[i] = -1;
+    }
+
+    s_sim = sim;
+}
+
+uint32_t sim_clock_us(void)
+{
+    return s_sim ? (uint32_t)s_sim->now_us : 0;
+}
+
+uint64_t sim_ticks_ms(void)
+{
+    return s_sim ? s_sim->now_us / 1000u : 0;
+}
+
+void sim_advance(uint32_t us)
+{
+    if (s_sim != NULL) {
+        s_sim->now_us += us;
+    }
+}
+
+/**
+ * @brief 分配一个结果槽位
+ */
+static int sim_new_task(sim_t *sim, const sim_cost_t *cost, uint32_t period_ms, uint8_t is_timer)
+{
+    if (sim == NULL || cost == NULL || sim->task_count >= SIM_MAX_TASKS) {
+        return -1;
+    }
+
+    int index = sim->task_count;
+    sim_task_t *task = &sim->tasks[index];
+
+    task->cost = *cost;
+    task->period_us = period_ms * 1000u;
+    task->deadline_us = task->period_us;
+    task->is_timer = is_timer;
+    task->origin_us = 0;
+    task->last_release = 0;
+    task->runs = 0;
+    task->exec_total_us = 0;
+    task->exec_max_us = 0;
+    task->latency_total_us = 0;
+    task->latency_max_us = 0;
+    task->last_start_us = 0;
+    task->gap_max_us = 0;
+    task->missed = 0;
+
+    sim->task_count++;
+    return index;
+}
+
+int sim_add_task(sim_t *sim, scheduler_t *sched, const sim_cost_t *cost, uint32_t period_ms)
+{
+    if (sched == NULL) {
+        return -1;
+    }
+
+    int sched_index = scheduler_get_task_count(sched);
+    if (sched_index >= SCHEDULER_MAX_TASKS) {
+        return -1;
+    }
+
+    int index = sim_new_task(sim, cost, period_ms, 0);
+    if (index < 0) {
+        return -1;
+    }
+
+    /* 入口按调度器任务槽位绑定，先登记映射再添加任务 */
+    sim->sched_map[sched_index] = index;
+    if (scheduler_add_task(sched, s_entries[sched_index], period_ms) != sched_index) {
+        sim->sched_map[sched_index] = -1;
+        sim->task_count--;
+        return -1;
+    }
+
+    return sched_index;
+}
+
+int sim_add_timer(sim_t *sim, MultiTimerCtx *ctx, MultiTimer *timer, const sim_cost_t *cost, uint32_t period_ms)
+{
+    if (ctx == NULL || timer == NULL) {
+        return -1;
+    }
+
+    int index = sim_new_task(sim, cost, period_ms, 1);
+    if (index < 0) {
+        return -1;
+    }
+
+    if (multiTimerCtxStartPeriodic(ctx, timer, period_ms, sim_timer_entry, (void *)(intptr_t)index) != 0) {
+        sim->task_count--;
+        return -1;
+    }
+
+    return 0;
+}
+
+int sim_set_deadline(sim_t *sim, int sim_index, uint32_t deadline_us)
+{
+    if (sim == NULL || sim_index < 0 || sim_index >= sim->task_count) {
+        return -1;
+    }
+
+    sim->tasks[sim_index].deadline_us = deadline_us;
+    return 0;
+}
+
+int sim_task_index(const sim_t *sim, int sched_index)
+{
+    if (sim == NULL || sched_index < 0 || sched_index >= SCHEDULER_MAX_TASKS) {
+        return -1;
+    }
+
+    return sim->sched_map[sched_index];
+}
+
+void sim_run(sim_t *sim, scheduler_t *sched, MultiTimerCtx *timers, uint64_t duration_us)
+{
+    if (sim == NULL) {
+        return;
+    }
+
+    s_sim = sim;
+    sim->start_us = sim->now_us;
+    uint64_t end = sim->now_us + duration_us;
+
+    while (sim->now_us < end) {
+        uint64_t loop_start = sim->now_us;
+        uint64_t wake_ms = UINT64_MAX;  /* 下一次到期的绝对毫秒时间 */
+
+        sim->iterations++;
+
+        /* 返回的等待时间相对于各自调用时的时间，任务执行期间时钟已前进 */
+        if (sched != NULL) {
+            uint32_t call_ms = (uint32_t)(sim->now_us / 1000u);
+            uint32_t wait = scheduler_run(sched, call_ms);
+            if (wait != SCHEDULER_IDLE_FOREVER) {
+                wake_ms = (uint64_t)call_ms + wait;
+            }
+        }
+
+        if (timers != NULL) {
+            uint64_t call_ms = sim->now_us / 1000u;
+            int wait = multiTimerCtxYield(timers);
+            if (timers->count > 0 && call_ms + (uint64_t)wait < wake_ms) {
+                wake_ms = call_ms + (uint64_t)wait;
+            }
+        }
+
+        sim->now_us += sim->loop_overhead_us;
+        if (sim->now_us == loop_start) {
+            sim->now_us++;  /* 保证时钟前进，避免预算推迟等情况下死循环 */
+        }
+
+        /* 空闲：直接跳到下一次到期的毫秒边界 */
+        uint64_t wake = (wake_ms == UINT64_MAX || wake_ms >= end / 1000u + 1) ? end : wake_ms * 1000u;
+        if (wake > end) {
+            wake = end;
+        }
+        if (wake > sim->now_us) {
+            sim->now_us = wake;
+            sim->wakeups++;
+        }
+    }
+}
+
+uint32_t sim_cpu_load(const sim_t *sim)
+{
+    if (sim == NULL || sim->now_us <= sim->start_us) {
+        return 0;
+    }
+
+    return (uint32_t)(sim->busy_us * 1000u / (sim->now_us - sim->start_us));
+}
+
+void sim_report(const sim_t *sim, FILE *out)
+{
+    if (sim == NULL || out == NULL) {
+        return;
+    }
+
+    uint64_t elapsed = sim->now_us - sim->start_us;
+
+    fprintf(out, "%-12s %5s %10s %10s %10s %10s %10s %10s %8s\n",
+            "task", "kind", "runs", "exec_avg", "lat_max", "lat_avg", "gap_max", "missed", "cpu%");
+
+    for (int i = 0; i < sim->task_count; i++) {
+        const sim_task_t *task = &sim->tasks[i];
+        uint64_t exec_avg = task->runs ? task->exec_total_us / task->runs : 0;
+        uint64_t lat_avg = task->runs ? task->latency_total_us / task->runs : 0;
+        double cpu = elapsed ? 100.0 * (double)task->exec_total_us / (double)elapsed : 0.0;
+
+        fprintf(out, "%-12s %5s %10llu %8lluus %8luus %8lluus %8luus %10llu %7.2f%%\n",
+                task->cost.name ? task->cost.name : "-",
+                task->is_timer ? "timer" : "task",
+                (unsigned long long)task->runs,
+                (unsigned long long)exec_avg,
+                (unsigned long)task->latency_max_us,
+                (unsigned long long)lat_avg,
+                (unsigned long)task->gap_max_us,
+                (unsigned long long)task->missed,
+                cpu);
+    }
+
+    fprintf(out, "virtual %.1fs, cpu load %.1f%%, loop iterations %llu, idle wakeups %llu\n",
+            (double)elapsed / 1e6, sim_cpu_load(sim) / 10.0,
+            (unsigned long long)sim->iterations, (unsigned long long)sim->wakeups);
+}
@@ -0,0 +1,165 @@
+/**
+ ******************************************************************************
+ * @file    sched_sim.h
+ * @brief   调度器/软件定时器虚拟时钟仿真 - 主机端（Linux）确定性时序回放
+ * @version 1.0.0
+ ******************************************************************************
+ * @attention
+ *
+ * 用虚拟微秒时钟驱动 scheduler_run() 和 multiTimerCtxYield()，任务体按设定的
+ * 执行时间推进虚拟时钟，空闲时直接跳到下一次到期，一天的固件时序可在数秒内回放。
+ * 统计每个任务的启动延迟、错过截止时间次数和 CPU 占用，用于在上板前比较调度方案。
+ *
+ * 同一时刻只能有一个仿真实例在运行（任务入口与时钟函数使用全局当前实例）。
+ *
+ ******************************************************************************
+ */
+
+#ifndef _SCHED_SIM_H_
+#define _SCHED_SIM_H_
+
+#include <stdint.h>
+#include <stdio.h>
+
+#include "scheduler.h"
+#include "MultiTimer.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#ifndef SIM_MAX_TASKS
+#define SIM_MAX_TASKS 64  /* 调度器任务与定时器总数上限 */
+#endif
+
+/* 任务执行时间模型 */
+typedef struct {
+    const char *name;           /* 报告中显示的名称 */
+    uint32_t cost_us;           /* 基本执行时间（微秒） */
+    uint32_t jitter_us;         /* 附加随机执行时间，均匀分布于 [0, jitter_us] */
+    uint32_t spike_every;       /* 每 N 次运行出现一次长耗时，0 表示无 */
+    uint32_t spike_us;          /* 长耗时的附加执行时间（微秒） */
+    void (*hook)(void *arg);    /* 可选：任务体中执行的用户代码（如修改调度参数），可为 NULL */
+    void *arg;                  /* hook 参数 */
+} sim_cost_t;
+
+/* 单个任务的仿真结果 */
+typedef struct {
+    sim_cost_t cost;            /* 执行时间模型 */
+    uint32_t period_us;         /* 理想周期 */
+    uint32_t deadline_us;       /* 相对截止时间，默认等于周期 */
+    uint8_t is_timer;           /* 1: MultiTimer 定时器，0: 调度器任务 */
+    uint64_t origin_us;         /* 首次运行时刻，理想释放时间 = origin + k * period */
+    uint64_t last_release;      /* 上次运行对应的释放序号 k */
+    uint64_t runs;              /* 运行次数 */
+    uint64_t exec_total_us;     /* 累计执行时间 */
+    uint32_t exec_max_us;       /* 最长执行时间 */
+    uint64_t latency_total_us;  /* 累计启动延迟（相对理想释放时间） */
+    uint32_t latency_max_us;    /* 最大启动延迟 */
+    uint64_t last_start_us;     /* 上次启动时刻 */
+    uint32_t gap_max_us;        /* 相邻两次启动的最大间隔（周期任务的最坏启动延迟 = 该值 - 周期） */
+    uint64_t missed;            /* 错过截止时间或整周期未运行的次数 */
+} sim_task_t;
+
+/* 仿真实例 */
+typedef struct {
+    uint64_t now_us;            /* 虚拟时钟（微秒） */
+    uint32_t loop_overhead_us;  /* 主循环每次迭代自身的开销（至少 1us） */
+    uint32_t rng;               /* 执行时间随机数状态 */
+    uint64_t start_us;          /* 本次 sim_run() 的起点 */
+    uint64_t busy_us;           /* 任务累计执行时间 */
+    uint64_t iterations;        /* 主循环迭代次数 */
+    uint64_t wakeups;           /* 从空闲跳转中唤醒的次数 */
+    int task_count;
+    sim_task_t tasks[SIM_MAX_TASKS];
+    int sched_map[32];          /* 调度器任务索引 -> tasks[] 索引（最多 32 个调度器任务） */
+} sim_t;
+
+/**
+ * @brief 初始化仿真实例并设为当前实例
+ * @param sim: 仿真实例
+ * @param seed: 执行时间随机数种子，相同种子得到相同的仿真结果
+ */
+void sim_init(sim_t *sim, uint32_t seed);
+
+/**
+ * @brief 当前实例的虚拟时钟（微秒，32 位回绕），可作为调度器统计/时间片预算的时间戳源
+ */
+uint32_t sim_clock_us(void);
+
+/**
+ * @brief 当前实例的虚拟毫秒节拍，可作为 MultiTimer 的时间基准
+ */
+uint64_t sim_ticks_ms(void);
+
+/**
+ * @brief 在任务 hook 中额外推进虚拟时钟（如模拟中断占用）
+ * @param us: 推进的微秒数，计入当前任务的执行时间
+ */
+void sim_advance(uint32_t us);
+
+/**
+ * @brief 向调度器添加一个按执行时间模型运行的任务
+ * @param sim: 仿真实例
+ * @param sched: 调度器
+ * @param cost: 执行时间模型（复制保存）
+ * @param period_ms: 任务周期（毫秒）
+ * @retval 调度器任务索引，-1表示失败
+ */
+int sim_add_task(sim_t *sim, scheduler_t *sched, const sim_cost_t *cost, uint32_t period_ms);
+
+/**
+ * @brief 启动一个按执行时间模型运行的周期定时器
+ * @param sim: 仿真实例
+ * @param ctx: 定时器上下文（时间基准需为 sim_ticks_ms）
+ * @param timer: 定时器句柄（需先调用 multiTimerInit()）
+ * @param cost: 执行时间模型（复制保存）
+ * @param period_ms: 定时周期（毫秒）
+ * @retval 0: 成功, -1: 失败
+ */
+int sim_add_timer(sim_t *sim, MultiTimerCtx *ctx, MultiTimer *timer, const sim_cost_t *cost, uint32_t period_ms);
+
+/**
+ * @brief 设置任务的相对截止时间（默认等于周期）
+ * @param sim: 仿真实例
+ * @param sim_index: sim_task_index() 返回的结果索引
+ * @param deadline_us: 相对截止时间（微秒）
+ * @retval 0: 成功, -1: 失败
+ */
+int sim_set_deadline(sim_t *sim, int sim_index, uint32_t deadline_us);
+
+/**
+ * @brief 获取调度器任务对应的结果索引
+ * @retval 结果索引，-1表示不存在
+ */
+int sim_task_index(const sim_t *sim, int sched_index);
+
+/**
+ * @brief 运行主循环仿真
+ * @param sim: 仿真实例
+ * @param sched: 调度器，可为 NULL
+ * @param timers: 定时器上下文，可为 NULL
+ * @param duration_us: 虚拟运行时长（微秒）
+ * @note 每次迭代依次调用 scheduler_run() 和 multiTimerCtxYield()，
+ *       两者都没有到期任务时虚拟时钟直接跳到最近的到期时间
+ */
+void sim_run(sim_t *sim, scheduler_t *sched, MultiTimerCtx *timers, uint64_t duration_us);
+
+/**
+ * @brief 输出每个任务的延迟、错过截止时间次数和 CPU 占用
+ * @param sim: 仿真实例
+ * @param out: 输出流
+ */
+void sim_report(const sim_t *sim, FILE *out);
+
+/**
+ * @brief 整体 CPU 占用率
+ * @retval 千分比（0~1000）
+ */
+uint32_t sim_cpu_load(const sim_t *sim);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* _SCHED_SIM_H_ */
@@ -0,0 +1,147 @@
+/**
+ ******************************************************************************
+ * @file    sched_sim_bench.c
+ * @brief   调度方案对比基准：同一负载在各调度模式下回放，输出延迟/超时/CPU 占用
+ * @version 1.0.0
+ ******************************************************************************
+ * 用法: ./sched_sim_bench [虚拟小时数，默认 24] [随机种子，默认 1] [负载，默认 firmware]
+ *
+ * 负载 firmware: 典型固件负载（控制、传感器、通信、显示、日志、超时定时器）
+ * 负载 latency:  调度器 README 中控制任务最坏启动延迟的场景
+ *                （1ms 控制任务 + 20ms/8ms 显示任务 + 10ms/3ms 日志任务），看 control 的 gap_max
+ ******************************************************************************
+ */
+
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#include "sched_sim.h"
+
+/* 典型固件负载：1ms 控制环 + 传感器 + 通信（偶发长耗时）+ 显示刷新 + 日志 + 协议超时定时器 */
+static const sim_cost_t s_control = { "control", 80, 40, 0, 0, NULL, NULL };
+static const sim_cost_t s_sensor  = { "sensor", 300, 100, 0, 0, NULL, NULL };
+static const sim_cost_t s_comms   = { "comms", 400, 200, 50, 3000, NULL, NULL };
+static const sim_cost_t s_display = { "display", 6000, 2000, 0, 0, NULL, NULL };
+static const sim_cost_t s_log     = { "log", 1500, 1500, 0, 0, NULL, NULL };
+static const sim_cost_t s_timeout = { "timeouts", 20, 10, 0, 0, NULL, NULL };
+
+/* 最坏延迟负载：显示和日志执行时间固定，不可抢占 */
+static const sim_cost_t s_lat_display = { "display", 8000, 0, 0, 0, NULL, NULL };
+static const sim_cost_t s_lat_log     = { "log", 3000, 0, 0, 0, NULL, NULL };
+
+#define BENCH_TIMERS 4
+
+typedef void (*bench_load_fn)(sim_t *sim, scheduler_t *sched, MultiTimerCtx *timers);
+
+typedef struct {
+    const char *name;
+    scheduler_mode_t mode;
+    uint8_t budget;             /* 是否启用 500us 时间片预算 */
+} bench_case_t;
+
+static const bench_case_t s_cases[] = {
+    { "scan",            SCHEDULER_MODE_SCAN,     0 },
+    { "deadline",        SCHEDULER_MODE_DEADLINE, 0 },
+    { "priority",        SCHEDULER_MODE_PRIORITY, 0 },
+    { "edf",             SCHEDULER_MODE_EDF,      0 },
+    { "priority+budget", SCHEDULER_MODE_PRIORITY, 1 },
+};
+
+static double wall_seconds(void)
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (double)ts.tv_sec + (double)ts.tv_nsec * 1e-9;
+}
+
+static void load_firmware(sim_t *sim, scheduler_t *sched, MultiTimerCtx *timers)
+{
+    static MultiTimer timeout[BENCH_TIMERS];
+
+    int ctrl = sim_add_task(sim, sched, &s_control, 1);
+    int sens = sim_add_task(sim, sched, &s_sensor, 5);
+    int comm = sim_add_task(sim, sched, &s_comms, 10);
+    int disp = sim_add_task(sim, sched, &s_display, 20);
+    int log  = sim_add_task(sim, sched, &s_log, 10);
+
+    for (int i = 0; i < BENCH_TIMERS; i++) {
+        multiTimerInit(&timeout[i]);
+        sim_add_timer(sim, timers, &timeout[i], &s_timeout, 50);
+    }
+
+    scheduler_set_priority(sched, ctrl, 0);
+    scheduler_set_priority(sched, sens, 1);
+    scheduler_set_priority(sched, comm, 2);
+    scheduler_set_priority(sched, disp, 10);
+    scheduler_set_priority(sched, log, 11);
+    scheduler_set_deadline(sched, disp, 50);
+    scheduler_set_deadline(sched, log, 100);
+    sim_set_deadline(sim, sim_task_index(sim, disp), 50000);
+    sim_set_deadline(sim, sim_task_index(sim, log), 100000);
+}
+
+static void load_latency(sim_t *sim, scheduler_t *sched, MultiTimerCtx *timers)
+{
+    (void)timers;
+
+    int ctrl = sim_add_task(sim, sched, &s_control, 1);
+    int disp = sim_add_task(sim, sched, &s_lat_display, 20);
+    int log  = sim_add_task(sim, sched, &s_lat_log, 10);
+
+    scheduler_set_priority(sched, ctrl, 0);
+    scheduler_set_priority(sched, disp, 10);
+    scheduler_set_priority(sched, log, 11);
+}
+
+static void bench_run(const bench_case_t *bc, bench_load_fn load, uint64_t duration_us, uint32_t seed)
+{
+    static sim_t sim;
+    static scheduler_t sched;
+    static MultiTimerCtx timers;
+
+    sim_init(&sim, seed);
+    scheduler_init(&sched);
+    multiTimerCtxInit(&timers, sim_ticks_ms);
+
+    load(&sim, &sched, &timers);
+
+    scheduler_set_mode(&sched, bc->mode);
+    scheduler_set_overrun_policy(&sched, SCHEDULER_OVERRUN_SKIP);
+
+    if (bc->budget) {
+        scheduler_set_budget(&sched, sim_clock_us, 500, 10);
+    }
+
+    double t0 = wall_seconds();
+    sim_run(&sim, &sched, &timers, duration_us);
+    double t1 = wall_seconds();
+
+    printf("== %s ==\n", bc->name);
+    sim_report(&sim, stdout);
+    printf("wall time %.2fs\n\n", t1 - t0);
+}
+
+int main(int argc, char **argv)
+{
+    double hours = (argc > 1) ? atof(argv[1]) : 24.0;
+    uint32_t seed = (argc > 2) ? (uint32_t)strtoul(argv[2], NULL, 0) : 1;
+    const char *load_name = (argc > 3) ? argv[3] : "firmware";
+    uint64_t duration_us = (uint64_t)(hours * 3600.0 * 1e6);
+    bench_load_fn load;
+
+    if (strcmp(load_name, "firmware") == 0) {
+        load = load_firmware;
+    } else if (strcmp(load_name, "latency") == 0) {
+        load = load_latency;
+    } else {
+        fprintf(stderr, "unknown load '%s' (firmware | latency)\n", load_name);
+        return 1;
+    }
+
+    for (size_t i = 0; i < sizeof(s_cases) / sizeof(s_cases[0]); i++) {
+        bench_run(&s_cases[i], load, duration_us, seed);
+    }
+
+    return 0;
+}
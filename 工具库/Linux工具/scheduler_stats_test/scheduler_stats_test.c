@@ -0,0 +1,313 @@
+/**
+ ******************************************************************************
+ * @file    scheduler_stats_test.c
+ * @brief   调度器运行统计主机测试：注入假时钟，按脚本时间线逐项校验统计结果
+ * @version 1.0.0
+ ******************************************************************************
+ * 用法: ./scheduler_stats_test          （SCHEDULER_ENABLE_STATS=1）
+ *       ./scheduler_stats_test_nostats  （同一份源码关闭统计编译，只校验调度结果）
+ *
+ * 假时钟以微秒计（ticks_per_ms = 1000，直方图单位 15us），任务函数按脚本推进时钟，
+ * 主循环以时钟换算出的毫秒调用 scheduler_run()，没有任务运行时空闲到下一毫秒。
+ * 任务 A 周期 10ms，第 3、4 次分别执行 7ms 和 11ms；任务 B 周期 4ms，每次 50us。
+ * 期望值按轮询模式逐次推演得出，见 check_stats() 中的注释；另在四种模式下校验
+ * 调度器晚于 2 个周期才开始运行时，首次运行不计为错过截止时间。任一项不符时程序返回非 0
+ ******************************************************************************
+ */
+
+#include <stdio.h>
+#include <stdint.h>
+
+#include "scheduler.h"
+
+#define TICKS_PER_MS    1000u
+#define END_MS          80u
+#define TASK_B_EXEC     50u
+
+/* 任务 A 各次的执行时间（us），超出脚本后保持最后一个值 */
+static const uint32_t a_exec[] = { 10, 20, 7000, 11000, 100, 500, 40 };
+#define A_RUNS          (sizeof(a_exec) / sizeof(a_exec[0]))
+
+static const char *const s_mode_names[] = { "scan", "deadline", "priority", "edf" };
+
+static scheduler_t s_sched;
+static uint32_t s_ticks;
+static uint32_t s_a_runs, s_b_runs;
+static int s_fail;
+
+static uint32_t fake_clock(void)
+{
+    return s_ticks;
+}
+
+static void task_a(void)
+{
+    uint32_t k = (s_a_runs < A_RUNS) ? s_a_runs : (uint32_t)(A_RUNS - 1);
+
+    s_ticks += a_exec[k];
+    s_a_runs++;
+}
+
+static void task_b(void)
+{
+    s_ticks += TASK_B_EXEC;
+    s_b_runs++;
+}
+
+static void expect(const char *what, uint64_t got, uint64_t want)
+{
+    if (got != want) {
+        printf("  %-24s %llu, expected %llu  FAIL\n", what, (unsigned long long)got, (unsigned long long)want);
+        s_fail = 1;
+    }
+}
+
+/* 建立两个任务，可选安装时间戳源，从时钟 0 跑到 END_MS */
+static void run_timeline(int install, scheduler_timestamp_fn ts)
+{
+    s_ticks = 0;
+    s_a_runs = 0;
+    s_b_runs = 0;
+
+    scheduler_init(&s_sched);
+    scheduler_add_task(&s_sched, task_a, 10);
+    scheduler_add_task(&s_sched, task_b, 4);
+#if SCHEDULER_ENABLE_STATS
+    if (install) {
+        scheduler_stats_install(&s_sched, ts, TICKS_PER_MS);
+    }
+#else
+    (void)install;
+    (void)ts;
+#endif
+
+    while (s_ticks < END_MS * TICKS_PER_MS) {
+        uint32_t before = s_ticks;
+
+        scheduler_run(&s_sched, s_ticks / TICKS_PER_MS);
+        if (s_ticks == before) {
+            s_ticks = (s_ticks / TICKS_PER_MS + 1) * TICKS_PER_MS;
+        }
+    }
+
+    /* 两种编译配置下调度结果相同 */
+    expect("A run count", s_a_runs, 7);
+    expect("B run count", s_b_runs, 16);
+}
+
+#if SCHEDULER_ENABLE_STATS
+/*
+ * 推演（轮询模式，A 先于 B 检查）：
+ *   A 在 10/20/30 ms 运行；30ms 的 7ms 执行使 B（释放 32）推迟到 37ms，抖动 5，错过
+ *   A 在 40ms 运行 11ms，本身错过；时钟到 51ms 时 A（释放 50）抖动 1，
+ *   B（释放 41）抖动 10，错过；之后 A 在 61/71 ms，B 在 55/59/.../79 ms 按时运行
+ *   A: 7 次，执行 10+20+7000+11000+100+500+40 = 18670
+ *   B: 16 次 x 50us
+ *   占用率 (18670 + 800) * 1000 / 80000 = 243‰
+ */
+static void check_stats(int with_clock)
+{
+    const scheduler_stats_t *a = scheduler_get_task_stats(&s_sched, 0);
+    const scheduler_stats_t *b = scheduler_get_task_stats(&s_sched, 1);
+    /* 桶界 15/30/60/120/240/480/960us：10, 20, 40, 100, -, -, 500, 7000+11000 */
+    static const uint32_t a_hist[SCHEDULER_STATS_HIST_BINS] = { 1, 1, 1, 1, 0, 0, 1, 2 };
+
+    expect("A run_count", a->run_count, 7);
+    expect("A jitter_max", a->jitter_max, 1);
+    expect("A jitter_total", a->jitter_total, 1);
+    /* A 第 4 次按时启动，只有计入执行时间才能发现超时 */
+    expect("A missed", a->missed, with_clock ? 1 : 0);
+    expect("A deferred", a->deferred, 0);
+    expect("B run_count", b->run_count, 16);
+    expect("B jitter_max", b->jitter_max, 10);
+    expect("B jitter_total", b->jitter_total, 15);
+    expect("B missed", b->missed, 2);
+
+    if (!with_clock) {
+        /* 没有时间戳源：执行时间和占用率不统计，B 的两次超时仍由抖动发现 */
+        expect("A exec_min", a->exec_min, 0xFFFFFFFFu);
+        expect("A exec_total", a->exec_total, 0);
+        expect("B exec_max", b->exec_max, 0);
+        for (int i = 0; i < SCHEDULER_STATS_HIST_BINS; i++) {
+            expect("A/B exec_hist", a->exec_hist[i] + b->exec_hist[i], 0);
+        }
+        expect("cpu load", scheduler_get_cpu_load(&s_sched), 0);
+        return;
+    }
+
+    expect("A exec_min", a->exec_min, 10);
+    expect("A exec_max", a->exec_max, 11000);
+    expect("A exec_total", a->exec_total, 18670);
+    expect("A exec mean", scheduler_stats_exec_mean(a), 2667);
+    for (int i = 0; i < SCHEDULER_STATS_HIST_BINS; i++) {
+        expect("A exec_hist", a->exec_hist[i], a_hist[i]);
+    }
+    expect("B exec_min", b->exec_min, TASK_B_EXEC);
+    expect("B exec_max", b->exec_max, TASK_B_EXEC);
+    expect("B exec mean", scheduler_stats_exec_mean(b), TASK_B_EXEC);
+    expect("B exec_hist[2]", b->exec_hist[2], 16);
+    expect("cpu load", scheduler_get_cpu_load(&s_sched), 243);
+
+    /* 清空后重新开窗：计数归零，最小值回到哨兵值 */
+    scheduler_stats_reset(&s_sched);
+    expect("reset run_count", a->run_count + b->run_count, 0);
+    expect("reset exec_min", a->exec_min, 0xFFFFFFFFu);
+    expect("reset missed", a->missed + b->missed, 0);
+    expect("reset cpu load", scheduler_get_cpu_load(&s_sched), 0);
+}
+
+/*
+ * 调度器在 1000ms 才开始运行（上电初始化较慢）：轮询模式首次的释放时间为 0 + 周期，
+ * 首次启动"迟到"990ms，不应计入抖动和错过截止时间。每毫秒调用一次，任务 B 按时运行 10 次
+ */
+static void check_late_start(scheduler_mode_t mode)
+{
+    const scheduler_stats_t *b;
+
+    s_ticks = 0;
+    s_b_runs = 0;
+    scheduler_init(&s_sched);
+    scheduler_set_mode(&s_sched, mode);
+    scheduler_add_task(&s_sched, task_b, 10);
+    scheduler_stats_install(&s_sched, fake_clock, TICKS_PER_MS);
+
+    for (uint32_t ms = 1000; ms < 1100; ms++) {
+        s_ticks = ms * TICKS_PER_MS;
+        scheduler_run(&s_sched, ms);
+    }
+
+    b = scheduler_get_task_stats(&s_sched, 0);
+    expect("late start run_count", b->run_count, 10);
+    expect("late start jitter_max", b->jitter_max, 0);
+    expect("late start missed", b->missed, 0);
+}
+#endif
+
+/* ======================= 协程任务 ======================= */
+
+/*
+ * 协程脚本，每毫秒调用一次 scheduler_run()，协程周期 1ms：
+ *   第 1 遍：DELAY 20 -> YIELD -> AWAIT_FLAG（60ms 时置位）-> AWAIT_TIMEOUT 条件不成立 30ms
+ *            -> AWAIT_TIMEOUT 条件在 100ms 成立 -> END，任务自动禁用
+ *   200ms 重新使能，第 2 遍从头开始：AWAIT_TIMEOUT 10ms 超时后 EXIT
+ * 每个等待点之后记录恢复时刻，起点之外的时刻与调度模式无关
+ */
+enum { EV_BEGIN, EV_DELAY, EV_YIELD, EV_FLAG, EV_TIMEOUT, EV_COND, EV_EXIT, EV_COUNT };
+
+static scheduler_coro_t s_co;
+static volatile uint8_t s_flag;
+static uint32_t s_pass;
+static uint32_t s_coro_calls;
+static uint32_t s_ev_ms[2][EV_COUNT];
+static uint8_t s_ev_timed_out[2][EV_COUNT];
+
+static void coro_event(scheduler_coro_t *co, int ev)
+{
+    s_ev_ms[s_pass - 1][ev] = co->now_ms;
+    s_ev_timed_out[s_pass - 1][ev] = co->timed_out;
+}
+
+static scheduler_coro_status_t coro_script(scheduler_coro_t *co)
+{
+    s_coro_calls++;
+
+    SCHEDULER_CORO_BEGIN(co);
+
+    s_pass++;
+    coro_event(co, EV_BEGIN);
+    if (s_pass > 1) {
+        SCHEDULER_CORO_AWAIT_TIMEOUT(co, 0, 10);
+        coro_event(co, EV_EXIT);
+        SCHEDULER_CORO_EXIT(co);
+    }
+
+    SCHEDULER_CORO_DELAY(co, 20);
+    coro_event(co, EV_DELAY);
+    SCHEDULER_CORO_YIELD(co);
+    coro_event(co, EV_YIELD);
+    SCHEDULER_CORO_AWAIT_FLAG(co, &s_flag);
+    coro_event(co, EV_FLAG);
+    SCHEDULER_CORO_AWAIT_TIMEOUT(co, 0, 30);
+    coro_event(co, EV_TIMEOUT);
+    SCHEDULER_CORO_AWAIT_TIMEOUT(co, co->now_ms >= 100, 100);
+    coro_event(co, EV_COND);
+
+    SCHEDULER_CORO_END(co);
+}
+
+static void check_coro(scheduler_mode_t mode)
+{
+    uint32_t calls_at_end = 0;
+    int idx;
+
+    s_flag = 0;
+    s_pass = 0;
+    s_coro_calls = 0;
+    scheduler_init(&s_sched);
+    scheduler_set_mode(&s_sched, mode);
+    idx = scheduler_add_coro(&s_sched, &s_co, coro_script, 1);
+
+    for (uint32_t ms = 0; ms < 300; ms++) {
+        if (ms == 60) {
+            s_flag = 1;
+        }
+        if (ms == 150) {
+            calls_at_end = s_coro_calls;
+        }
+        if (ms == 200) {
+            expect("calls while done", s_coro_calls, calls_at_end);
+            scheduler_enable_task(&s_sched, idx, 1);
+        }
+        scheduler_run(&s_sched, ms);
+    }
+
+    const uint32_t *ev = s_ev_ms[0];
+    expect("passes", s_pass, 2);
+    expect("begin", ev[EV_BEGIN] <= 1, 1);
+    expect("delay 20", ev[EV_DELAY] - ev[EV_BEGIN], 20);
+    expect("yield", ev[EV_YIELD] - ev[EV_DELAY], 1);
+    expect("await flag", ev[EV_FLAG], 60);
+    expect("flag cleared", s_flag, 0);
+    expect("await timeout", ev[EV_TIMEOUT], 90);
+    expect("await timeout timed_out", s_ev_timed_out[0][EV_TIMEOUT], 1);
+    expect("await cond", ev[EV_COND], 100);
+    expect("await cond timed_out", s_ev_timed_out[0][EV_COND], 0);
+
+    ev = s_ev_ms[1];
+    expect("re-enabled begin", ev[EV_BEGIN], 200);
+    expect("exit timeout", ev[EV_EXIT], 210);
+    expect("exit timed_out", s_ev_timed_out[1][EV_EXIT], 1);
+    expect("enabled after exit", s_sched.tasks[idx].enabled, 0);
+}
+
+int main(void)
+{
+#if SCHEDULER_ENABLE_STATS
+    printf("SCHEDULER_ENABLE_STATS=1, fake clock %u ticks/ms, %u bins\n", TICKS_PER_MS, SCHEDULER_STATS_HIST_BINS);
+
+    printf("timeline with timestamp source\n");
+    run_timeline(1, fake_clock);
+    check_stats(1);
+
+    printf("timeline without timestamp source (jitter/missed only)\n");
+    run_timeline(1, NULL);
+    check_stats(0);
+
+    for (int m = SCHEDULER_MODE_SCAN; m <= SCHEDULER_MODE_EDF; m++) {
+        printf("late start at 1000ms, %s mode\n", s_mode_names[m]);
+        check_late_start((scheduler_mode_t)m);
+    }
+#else
+    printf("SCHEDULER_ENABLE_STATS=0, sizeof(scheduler_t) = %zu\n", sizeof(scheduler_t));
+    printf("timeline\n");
+    run_timeline(0, fake_clock);
+#endif
+
+    for (int m = SCHEDULER_MODE_SCAN; m <= SCHEDULER_MODE_EDF; m++) {
+        printf("coroutine script, %s mode\n", s_mode_names[m]);
+        check_coro((scheduler_mode_t)m);
+    }
+
+    printf("result: %s\n", s_fail ? "FAIL" : "ok");
+    return s_fail;
+}
@@ -0,0 +1,398 @@
+/**
+ ******************************************************************************
+ * @file    usart_pack_batch.c
+ * @brief   usart_pack 批量帧主机工具：带宽估算、测试数据生成、解码为时间序列
+ * @version 1.0.0
+ ******************************************************************************
+ * 用法:
+ *   usart_pack_batch rate   [-t 模板] [-c 校验] [-s] [-b 波特率]
+ *   usart_pack_batch gen    [-t 模板] [-c 校验] [-s] [-u] [-z] [-n 每帧样本数] [-r 采样率Hz] [-k 样本总数]
+ *   usart_pack_batch decode [-t 模板] [-c 校验] [-s] [-b 波特率] [文件或串口设备]
+ *
+ * 模板为类型字符串，每个字符一个变量: B=BYTE S=SHORT I=INT F=FLOAT，默认 FFFFFF
+ * 校验: sum8 / crc16 / crc32，-s 启用序号字段，收发两端参数需一致
+ * -u 生成等间隔采样帧（不带逐样本时间偏移），-z 生成增量压缩帧，解码端自动识别
+ ******************************************************************************
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include <unistd.h>
+#include <fcntl.h>
+#include <termios.h>
+
+#include "usart_pack.h"
+
+#define UART_BITS_PER_BYTE  10      /* 8N1: 起始位 + 8 数据位 + 停止位 */
+#define MAX_FRAME           65535
+
+typedef struct {
+    const char *tmpl;
+    usart_pack_check_t check;
+    uint8_t flags;
+    uint8_t uniform;
+    uint8_t delta;
+    uint8_t samples;
+    uint32_t rate;
+    uint32_t total;
+    uint32_t baud;
+    uint8_t header;
+    uint8_t tail;
+} options_t;
+
+/* 模板绑定的变量，按类型各自存放 */
+static usart_pack_type_t s_types[USART_PACK_MAX_VARIABLES];
+static union {
+    uint8_t b;
+    uint16_t s;
+    uint32_t i;
+    float f;
+} s_vars[USART_PACK_MAX_VARIABLES];
+static uint16_t s_var_count;
+
+static usart_pack_t s_pack;
+
+static int template_init(const options_t *opt)
+{
+    usart_pack_init_custom(&s_pack, opt->header, opt->tail);
+
+    s_var_count = 0;
+    for (const char *c = opt->tmpl; *c; c++) {
+        usart_pack_type_t type;
+        switch (*c) {
+            case 'B': type = PACK_TYPE_BYTE; break;
+            case 'S': type = PACK_TYPE_SHORT; break;
+            case 'I': type = PACK_TYPE_INT; break;
+            case 'F': type = PACK_TYPE_FLOAT; break;
+            default:
+                fprintf(stderr, "unknown type '%c' in template\n", *c);
+                return -1;
+        }
+        if (s_var_count >= USART_PACK_MAX_VARIABLES) {
+            fprintf(stderr, "template longer than %d variables\n", USART_PACK_MAX_VARIABLES);
+            return -1;
+        }
+        s_types[s_var_count] = type;
+        usart_pack_add_var(&s_pack, type, &s_vars[s_var_count]);
+        s_var_count++;
+    }
+
+    return usart_pack_set_format(&s_pack, opt->check, opt->flags);
+}
+
+/* ======================= rate ======================= */
+
+static void print_rate_row(const char *name, uint32_t frame, uint32_t samples, double bytes_per_s)
+{
+    double per_sample = (double)frame / samples;
+    printf("%-20s %8u %10.2f %12.0f\n", name, frame, per_sample, bytes_per_s / per_sample);
+}
+
+static int cmd_rate(const options_t *opt)
+{
+    static const uint32_t bauds[] = { 115200, 921600 };
+    static const uint8_t batches[] = { 2, 4, 8, 16, 32, 64, 127 };
+
+    uint16_t data = usart_pack_calc_data_size(&s_pack);
+    uint16_t single = usart_pack_calc_frame_size(&s_pack);
+
+    for (size_t b = 0; b < sizeof(bauds) / sizeof(bauds[0]); b++) {
+        uint32_t baud = opt->baud ? opt->baud : bauds[b];
+        double bytes_per_s = (double)baud / UART_BITS_PER_BYTE;
+
+        printf("== %s, %u data bytes, %u baud 8N1 ==\n", opt->tmpl, data, baud);
+        printf("%-20s %8s %10s %12s\n", "frame", "bytes", "B/sample", "samples/s");
+
+        print_rate_row("single", single, 1, bytes_per_s);
+        /* 单帧要带时间戳只能在模板中加一个 INT */
+        print_rate_row("single + INT stamp", single + 4, 1, bytes_per_s);
+
+        for (size_t i = 0; i < sizeof(batches) / sizeof(batches[0]); i++) {
+            char name[32];
+            snprintf(name, sizeof(name), "batch N=%u", batches[i]);
+            print_rate_row(name, usart_pack_batch_frame_size(&s_pack, batches[i]), batches[i], bytes_per_s);
+        }
+        for (size_t i = 0; i < sizeof(batches) / sizeof(batches[0]); i++) {
+            char name[32];
+            snprintf(name, sizeof(name), "uniform N=%u", batches[i]);
+            print_rate_row(name, usart_pack_batch_frame_size(&s_pack, batches[i] | USART_PACK_BATCH_UNIFORM),
+                           batches[i], bytes_per_s);
+        }
+        printf("\n");
+
+        if (opt->baud) {
+            break;
+        }
+    }
+
+    return 0;
+}
+
+/* ======================= gen ======================= */
+
+/* 合成信号：各通道为不同频率的正弦，整型通道取其缩放值 */
+static void synth_sample(uint32_t n, uint32_t rate)
+{
+    double t = (double)n / rate;
+
+    for (uint16_t i = 0; i < s_var_count; i++) {
+        double v = sin(2.0 * M_PI * (1.0 + i) * t) * (10.0 + i);
+        switch (s_types[i]) {
+            case PACK_TYPE_BYTE:  s_vars[i].b = (uint8_t)(n + i); break;
+            case PACK_TYPE_SHORT: s_vars[i].s = (uint16_t)(int16_t)(v * 1000.0); break;
+            case PACK_TYPE_INT:   s_vars[i].i = (uint32_t)(int32_t)(v * 100000.0); break;
+            case PACK_TYPE_FLOAT: s_vars[i].f = (float)v; break;
+        }
+    }
+}
+
+static int cmd_gen(const options_t *opt)
+{
+    static uint8_t buf[MAX_FRAME];
+    usart_pack_batch_t batch;
+
+    uint16_t period = opt->uniform ? (uint16_t)(1000000u / opt->rate) : 0;
+
+    if (usart_pack_batch_init(&batch, &s_pack, buf, sizeof(buf), opt->samples, period) != 0 ||
+        usart_pack_batch_set_delta(&batch, opt->delta) != 0 ||
+        (opt->delta && opt->samples > USART_PACK_BATCH_MAX_DELTA_SAMPLES)) {
+        fprintf(stderr, "%u samples do not fit in one frame\n", opt->samples);
+        return 1;
+    }
+
+    for (uint32_t n = 0; n < opt->total; n++) {
+        uint32_t stamp = period ? n * period : (uint32_t)((uint64_t)n * 1000000u / opt->rate);   /* us */
+        synth_sample(n, opt->rate);
+
+        int left = usart_pack_batch_add(&batch, stamp);
+        if (left < 0) {
+            /* 时间跨度超出 16 位偏移（或不再等间隔），先发出当前帧 */
+            fwrite(buf, 1, usart_pack_batch_finish(&batch), stdout);
+            left = usart_pack_batch_add(&batch, stamp);
+        }
+        if (left == 0) {
+            fwrite(buf, 1, usart_pack_batch_finish(&batch), stdout);
+        }
+    }
+    fwrite(buf, 1, usart_pack_batch_finish(&batch), stdout);
+
+    return 0;
+}
+
+/* ======================= decode ======================= */
+
+static uint32_t s_samples;
+
+static void print_sample(usart_pack_t *pack, uint32_t timestamp, void *arg)
+{
+    (void)pack;
+    (void)arg;
+
+    printf("%u", timestamp);
+    for (uint16_t i = 0; i < s_var_count; i++) {
+        switch (s_types[i]) {
+            case PACK_TYPE_BYTE:  printf(",%u", s_vars[i].b); break;
+            case PACK_TYPE_SHORT: printf(",%d", (int16_t)s_vars[i].s); break;
+            case PACK_TYPE_INT:   printf(",%d", (int32_t)s_vars[i].i); break;
+            case PACK_TYPE_FLOAT: printf(",%.6g", s_vars[i].f); break;
+        }
+    }
+    printf("\n");
+    s_samples++;
+}
+
+static speed_t baud_to_speed(uint32_t baud)
+{
+    switch (baud) {
+        case 9600:    return B9600;
+        case 19200:   return B19200;
+        case 38400:   return B38400;
+        case 57600:   return B57600;
+        case 115200:  return B115200;
+        case 230400:  return B230400;
+        case 460800:  return B460800;
+        case 921600:  return B921600;
+        case 1000000: return B1000000;
+        case 2000000: return B2000000;
+        default:      return B0;
+    }
+}
+
+static int open_input(const char *path, uint32_t baud)
+{
+    if (path == NULL || strcmp(path, "-") == 0) {
+        return STDIN_FILENO;
+    }
+
+    int fd = open(path, O_RDONLY | O_NOCTTY);
+    if (fd < 0) {
+        perror(path);
+        return -1;
+    }
+
+    /* 串口设备：原始模式，按指定波特率 */
+    struct termios tio;
+    if (isatty(fd) && tcgetattr(fd, &tio) == 0) {
+        speed_t speed = baud_to_speed(baud ? baud : 115200);
+        if (speed == B0) {
+            fprintf(stderr, "unsupported baud rate %u\n", baud);
+            close(fd);
+            return -1;
+        }
+        cfmakeraw(&tio);
+        cfsetspeed(&tio, speed);
+        tio.c_cc[VMIN] = 1;
+        tio.c_cc[VTIME] = 0;
+        tcsetattr(fd, TCSANOW, &tio);
+    }
+
+    return fd;
+}
+
+static int cmd_decode(const options_t *opt, const char *path)
+{
+    static uint8_t buf[2 * MAX_FRAME];
+    size_t have = 0;
+    uint32_t frames = 0, errors = 0, dropped = 0;
+
+    int fd = open_input(path, opt->baud);
+    if (fd < 0) {
+        return 1;
+    }
+
+    printf("timestamp");
+    for (uint16_t i = 0; i < s_var_count; i++) {
+        printf(",%c%u", opt->tmpl[i], i);
+    }
+    printf("\n");
+
+    for (;;) {
+        ssize_t n = read(fd, buf + have, sizeof(buf) - have);
+        if (n <= 0) {
+            break;
+        }
+        have += (size_t)n;
+
+        size_t pos = 0;
+        while (pos < have) {
+            /* 查找帧头 */
+            const uint8_t *head = memchr(buf + pos, s_pack.header, have - pos);
+            if (head == NULL) {
+                dropped += (uint32_t)(have - pos);
+                pos = have;
+                break;
+            }
+            dropped += (uint32_t)(head - (buf + pos));
+            pos = (size_t)(head - buf);
+
+            /* 样本数（压缩帧还有载荷长度）字段到齐后才知道帧长 */
+            uint32_t len = usart_pack_batch_peek_size(&s_pack, buf + pos, (uint32_t)(have - pos));
+            if (len == 0 || have - pos < len) {
+                break;
+            }
+
+            if (usart_pack_batch_parse(&s_pack, buf + pos, len, print_sample, NULL) >= 0) {
+                frames++;
+                pos += len;
+            } else {
+                /* 帧头可能是数据中的同值字节，从下一个字节继续查找 */
+                errors++;
+                dropped++;
+                pos++;
+            }
+        }
+
+        memmove(buf, buf + pos, have - pos);
+        have -= pos;
+    }
+
+    fflush(stdout);
+    fprintf(stderr, "frames %u, samples %u, bad frames %u, dropped bytes %u, lost frames %u\n",
+            frames, s_samples, errors, dropped, usart_pack_get_lost_frames(&s_pack));
+
+    if (fd != STDIN_FILENO) {
+        close(fd);
+    }
+    return 0;
+}
+
+static void usage(void)
+{
+    fprintf(stderr,
+            "usage: usart_pack_batch rate|gen|decode [options] [input]\n"
+            "  -t TYPES   template, one of B/S/I/F per variable (default FFFFFF)\n"
+            "  -c CHECK   sum8 | crc16 | crc32 (default sum8)\n"
+            "  -s         sequence byte enabled\n"
+            "  -u         gen: fixed-period frames without per-sample offsets\n"
+            "  -z         gen: delta/varint compressed frames (max 63 samples per frame)\n"
+            "  -H/-T HEX  header / tail byte (default 0x%02X / 0x%02X)\n"
+            "  -n N       gen: samples per frame, 0 = as many as fit, max 127 (default 16)\n"
+            "  -r HZ      gen: sample rate (default 1000), timestamps in us\n"
+            "  -k COUNT   gen: total samples (default 10000)\n"
+            "  -b BAUD    rate: single baud rate; decode: serial port speed\n",
+            USART_PACK_HEADER, USART_PACK_TAIL);
+}
+
+int main(int argc, char **argv)
+{
+    options_t opt = {
+        .tmpl = "FFFFFF", .check = USART_PACK_CHECK_SUM8, .flags = 0, .uniform = 0, .delta = 0,
+        .samples = 16, .rate = 1000, .total = 10000, .baud = 0,
+        .header = USART_PACK_HEADER, .tail = USART_PACK_TAIL,
+    };
+
+    if (argc < 2) {
+        usage();
+        return 1;
+    }
+    const char *cmd = argv[1];
+    optind = 2;
+
+    int c;
+    while ((c = getopt(argc, argv, "t:c:suzH:T:n:r:k:b:")) != -1) {
+        switch (c) {
+            case 't': opt.tmpl = optarg; break;
+            case 'c':
+                if (strcmp(optarg, "crc16") == 0) {
+                    opt.check = USART_PACK_CHECK_CRC16;
+                } else if (strcmp(optarg, "crc32") == 0) {
+                    opt.check = USART_PACK_CHECK_CRC32;
+                } else if (strcmp(optarg, "sum8") != 0) {
+                    usage();
+                    return 1;
+                }
+                break;
+            case 's': opt.flags |= USART_PACK_FLAG_SEQ; break;
+            case 'u': opt.uniform = 1; break;
+            case 'z': opt.delta = 1; break;
+            case 'H': opt.header = (uint8_t)strtoul(optarg, NULL, 16); break;
+            case 'T': opt.tail = (uint8_t)strtoul(optarg, NULL, 16); break;
+            case 'n': opt.samples = (uint8_t)strtoul(optarg, NULL, 0); break;
+            case 'r': opt.rate = (uint32_t)strtoul(optarg, NULL, 0); break;
+            case 'k': opt.total = (uint32_t)strtoul(optarg, NULL, 0); break;
+            case 'b': opt.baud = (uint32_t)strtoul(optarg, NULL, 0); break;
+            default:
+                usage();
+                return 1;
+        }
+    }
+
+    if (template_init(&opt) != 0 || opt.rate == 0) {
+        return 1;
+    }
+
+    if (strcmp(cmd, "rate") == 0) {
+        return cmd_rate(&opt);
+    }
+    if (strcmp(cmd, "gen") == 0) {
+        return cmd_gen(&opt);
+    }
+    if (strcmp(cmd, "decode") == 0) {
+        return cmd_decode(&opt, (optind < argc) ? argv[optind] : NULL);
+    }
+
+    usage();
+    return 1;
+}
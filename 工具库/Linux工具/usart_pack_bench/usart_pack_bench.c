@@ -0,0 +1,323 @@
+/**
+ ******************************************************************************
+ * @file    usart_pack_bench.c
+ * @brief   usart_pack 流式解码基准：干净/损坏/分片数据流的吞吐量与重新同步
+ * @version 1.0.0
+ ******************************************************************************
+ * 用法: ./usart_pack_bench [帧数，默认 1000000] [随机种子，默认 1] [校验 sum8/crc16/crc32，默认 sum8]
+ ******************************************************************************
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#include "usart_pack.h"
+
+#define BURST_FRAMES    8       /* 对照组：每次串口空闲前连续发送的帧数 */
+#define RB_POOL_SIZE    4096
+
+/* 典型遥测模板：命令 + 状态 + 序号 + 6 个浮点量 */
+static uint8_t  v_cmd;
+static uint16_t v_status;
+static uint32_t v_seq;
+static float    v_f[6];
+
+static usart_pack_t s_pack;
+static uint16_t s_frame_size;
+
+static uint8_t *s_ref;          /* 按序号保存的原始帧 */
+static uint32_t s_ref_count;
+
+/* 一次运行的结果 */
+typedef struct {
+    uint32_t good;              /* 与原始帧一致的帧数 */
+    uint32_t bad;               /* 校验通过但内容错误的帧数 */
+} bench_result_t;
+
+static bench_result_t s_result;
+
+static uint32_t s_rng;
+
+static uint32_t bench_rand(void)
+{
+    uint32_t x = s_rng;
+    x ^= x << 13;
+    x ^= x >> 17;
+    x ^= x << 5;
+    s_rng = x;
+    return x;
+}
+
+static double wall_seconds(void)
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (double)ts.tv_sec + (double)ts.tv_nsec * 1e-9;
+}
+
+static void template_init(void)
+{
+    usart_pack_init(&s_pack);
+    usart_pack_add_var(&s_pack, PACK_TYPE_BYTE, &v_cmd);
+    usart_pack_add_var(&s_pack, PACK_TYPE_SHORT, &v_status);
+    usart_pack_add_var(&s_pack, PACK_TYPE_INT, &v_seq);
+    for (int i = 0; i < 6; i++) {
+        usart_pack_add_var(&s_pack, PACK_TYPE_FLOAT, &v_f[i]);
+    }
+    s_frame_size = usart_pack_calc_frame_size(&s_pack);
+}
+
+/* 帧是否与同序号的原始帧一致 */
+static void check_frame(const uint8_t *frame, uint16_t length)
+{
+    uint32_t seq = ((uint32_t)frame[4] << 24) | ((uint32_t)frame[5] << 16) |
+                   ((uint32_t)frame[6] << 8) | frame[7];
+
+    if (length == s_frame_size && seq < s_ref_count &&
+        memcmp(frame, &s_ref[(size_t)seq * s_frame_size], length) == 0) {
+        s_result.good++;
+    } else {
+        s_result.bad++;
+    }
+}
+
+static void on_frame(usart_pack_stream_t *stream, const uint8_t *frame, uint16_t length, void *arg)
+{
+    (void)stream;
+    (void)arg;
+    check_frame(frame, length);
+}
+
+/* ======================= 数据流生成 ======================= */
+
+typedef enum {
+    FAULT_NONE,
+    FAULT_FLIP,                 /* 单比特翻转 */
+    FAULT_DROP,                 /* 丢字节 */
+    FAULT_GARBAGE,              /* 插入 1~32 个随机字节 */
+} fault_t;
+
+typedef struct {
+    uint8_t *data;
+    size_t len;
+    size_t *bursts;             /* 每个突发（空闲间隔前）的结束偏移 */
+    size_t burst_count;
+    uint32_t events;            /* 注入的故障次数 */
+} stream_t;
+
+/**
+ * @brief 生成 count 帧的数据流，按 1/rate 的字节概率注入故障
+ */
+static void stream_make(stream_t *st, uint32_t count, fault_t fault, uint32_t rate)
+{
+    size_t cap = (size_t)count * s_frame_size * 2 + 64;
+    st->data = malloc(cap);
+    st->bursts = malloc(sizeof(size_t) * (count / BURST_FRAMES + 2));
+    st->len = 0;
+    st->burst_count = 0;
+    st->events = 0;
+
+    uint8_t frame[USART_PACK_MAX_FRAME_LEN];
+
+    for (uint32_t seq = 0; seq < count; seq++) {
+        memcpy(frame, &s_ref[(size_t)seq * s_frame_size], s_frame_size);
+
+        for (uint16_t i = 0; i < s_frame_size; i++) {
+            if (fault == FAULT_NONE || st->len + 40 >= cap || bench_rand() % rate != 0) {
+                st->data[st->len++] = frame[i];
+                continue;
+            }
+
+            st->events++;
+            switch (fault) {
+                case FAULT_FLIP:
+                    st->data[st->len++] = frame[i] ^ (uint8_t)(1u << (bench_rand() % 8));
+                    break;
+                case FAULT_DROP:
+                    break;
+                case FAULT_GARBAGE:
+                {
+                    uint32_t n = 1 + bench_rand() % 32;
+                    for (uint32_t k = 0; k < n; k++) {
+                        st->data[st->len++] = (uint8_t)bench_rand();
+                    }
+                    st->data[st->len++] = frame[i];
+                    break;
+                }
+                default:
+                    break;
+            }
+        }
+
+        if ((seq + 1) % BURST_FRAMES == 0 || seq + 1 == count) {
+            st->bursts[st->burst_count++] = st->len;
+        }
+    }
+}
+
+static void stream_free(stream_t *st)
+{
+    free(st->data);
+    free(st->bursts);
+}
+
+/* ======================= 解码方式 ======================= */
+
+typedef enum {
+    FEED_BULK,                  /* 随机 1~256 字节分片整块喂入 */
+    FEED_BYTE,                  /* 逐字节喂入（接收中断） */
+    FEED_RB,                    /* 经环形缓冲区零拷贝喂入 */
+    FEED_IDLE,                  /* 对照组：按空闲间隔切分后逐帧 usart_pack_parse */
+} feed_t;
+
+static const char *s_feed_names[] = { "stream bulk", "stream putc", "stream rb", "idle+parse" };
+
+/* 返回重新同步时丢弃的字节数，对照组返回 0 */
+static uint32_t decode(const stream_t *st, feed_t feed)
+{
+    static usart_pack_stream_t stream;
+    usart_pack_stream_stats_t stats;
+    usart_pack_stream_init(&stream, &s_pack, on_frame, NULL);
+
+    switch (feed) {
+        case FEED_BULK:
+        {
+            size_t pos = 0;
+            while (pos < st->len) {
+                size_t n = 1 + bench_rand() % 256;
+                if (n > st->len - pos) {
+                    n = st->len - pos;
+                }
+                usart_pack_stream_feed(&stream, &st->data[pos], n);
+                pos += n;
+            }
+            break;
+        }
+        case FEED_BYTE:
+            for (size_t pos = 0; pos < st->len; pos++) {
+                usart_pack_stream_putc(&stream, st->data[pos]);
+            }
+            break;
+        case FEED_RB:
+        {
+            static uint8_t pool[RB_POOL_SIZE];
+            static struct rb_ringbuffer rb;
+            rb_ringbuffer_init(&rb, pool, sizeof(pool));
+
+            size_t pos = 0;
+            while (pos < st->len) {
+                /* 模拟 DMA 每次写入 1~512 字节，主循环随后取走 */
+                size_t n = 1 + bench_rand() % 512;
+                if (n > st->len - pos) {
+                    n = st->len - pos;
+                }
+                pos += rb_ringbuffer_put(&rb, &st->data[pos], (rb_length_t)n);
+                usart_pack_stream_feed_rb(&stream, &rb);
+            }
+            break;
+        }
+        case FEED_IDLE:
+        {
+            size_t start = 0;
+            for (size_t b = 0; b < st->burst_count; b++) {
+                size_t end = st->bursts[b];
+                for (size_t off = start; off + s_frame_size <= end; off += s_frame_size) {
+                    if (usart_pack_parse(&s_pack, &st->data[off], s_frame_size) == 0) {
+                        check_frame(&st->data[off], s_frame_size);
+                    }
+                }
+                start = end;
+            }
+            break;
+        }
+    }
+
+    usart_pack_stream_get_stats(&stream, &stats);
+    return stats.dropped_bytes;
+}
+
+static void bench_case(const char *name, uint32_t count, fault_t fault, uint32_t rate)
+{
+    stream_t st;
+    stream_make(&st, count, fault, rate);
+
+    printf("== %s (%zu bytes, %u fault events) ==\n", name, st.len, st.events);
+    printf("%-12s %10s %10s %10s %8s %12s %12s\n",
+           "decoder", "MB/s", "Mframe/s", "good", "bad", "lost/event", "resync B");
+
+    for (int f = FEED_BULK; f <= FEED_IDLE; f++) {
+        memset(&s_result, 0, sizeof(s_result));
+
+        double t0 = wall_seconds();
+        uint32_t dropped = decode(&st, (feed_t)f);
+        double dt = wall_seconds() - t0;
+
+        /* resync B: 每次故障后丢弃的字节数（帧外垃圾 + 坏帧中帧头之前的部分） */
+        uint32_t lost = count - s_result.good;
+        printf("%-12s %10.1f %10.2f %10u %8u %12.2f %12.1f\n",
+               s_feed_names[f],
+               (double)st.len / dt / 1e6,
+               (double)s_result.good / dt / 1e6,
+               s_result.good, s_result.bad,
+               st.events ? (double)lost / st.events : 0.0,
+               st.events ? (double)dropped / st.events : 0.0);
+    }
+    printf("\n");
+
+    stream_free(&st);
+}
+
+int main(int argc, char **argv)
+{
+    uint32_t count = (argc > 1) ? (uint32_t)strtoul(argv[1], NULL, 0) : 1000000;
+    s_rng = (argc > 2) ? (uint32_t)strtoul(argv[2], NULL, 0) : 1;
+    if (s_rng == 0) {
+        s_rng = 1;
+    }
+
+    template_init();
+
+    const char *check_name = (argc > 3) ? argv[3] : "sum8";
+    if (strcmp(check_name, "crc16") == 0) {
+        usart_pack_set_format(&s_pack, USART_PACK_CHECK_CRC16, 0);
+    } else if (strcmp(check_name, "crc32") == 0) {
+        usart_pack_set_format(&s_pack, USART_PACK_CHECK_CRC32, 0);
+    } else {
+        check_name = "sum8";
+    }
+    s_frame_size = usart_pack_calc_frame_size(&s_pack);
+
+    /* 原始帧：序号写入 INT 字段，浮点量随序号变化 */
+    s_ref_count = count;
+    s_ref = malloc((size_t)count * s_frame_size);
+    for (uint32_t seq = 0; seq < count; seq++) {
+        v_cmd = (uint8_t)(seq & 0x0F);
+        v_status = (uint16_t)(seq * 7u);
+        v_seq = seq;
+        for (int i = 0; i < 6; i++) {
+            v_f[i] = (float)seq * 0.001f * (float)(i + 1);
+        }
+        usart_pack_build(&s_pack, &s_ref[(size_t)seq * s_frame_size], s_frame_size);
+    }
+
+    printf("frame %u bytes (%s), %u frames\n\n", s_frame_size, check_name, count);
+
+    /* 预热：让 CPU 频率和缓存稳定后再计时 */
+    {
+        stream_t warm;
+        stream_make(&warm, count, FAULT_NONE, 1);
+        decode(&warm, FEED_BULK);
+        stream_free(&warm);
+    }
+
+    bench_case("clean", count, FAULT_NONE, 1);
+    bench_case("bit flip 1e-4", count, FAULT_FLIP, 10000);
+    bench_case("byte drop 1e-4", count, FAULT_DROP, 10000);
+    bench_case("garbage 1e-4", count, FAULT_GARBAGE, 10000);
+    bench_case("bit flip 1e-3", count, FAULT_FLIP, 1000);
+
+    free(s_ref);
+    return 0;
+}
@@ -0,0 +1,333 @@
+/**
+ ******************************************************************************
+ * @file    usart_pack_crc_bench.c
+ * @brief   usart_pack 校验方式对比：每字节周期数与各类错误的漏检率
+ * @version 1.0.0
+ ******************************************************************************
+ * 用法: ./usart_pack_crc_bench [每类错误的注入次数，默认 1000000]
+ * 需以 USART_PACK_CRC_SLICES=8 编译，以便所有实现都可用
+ ******************************************************************************
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <x86intrin.h>
+#define HAVE_TSC 1
+#else
+#define HAVE_TSC 0
+#endif
+
+#include "usart_pack.h"
+#include "usart_pack_crc.h"
+
+#if USART_PACK_CRC_SLICES < 8
+#error "build with -DUSART_PACK_CRC_SLICES=8"
+#endif
+
+#define REPEAT  5               /* 取最快一次 */
+
+static double wall_seconds(void)
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (double)ts.tv_sec + (double)ts.tv_nsec * 1e-9;
+}
+
+static uint64_t cycles(void)
+{
+#if HAVE_TSC
+    return __rdtsc();
+#else
+    return 0;
+#endif
+}
+
+static uint32_t s_rng = 1;
+
+static uint32_t bench_rand(void)
+{
+    uint32_t x = s_rng;
+    x ^= x << 13;
+    x ^= x >> 17;
+    x ^= x << 5;
+    s_rng = x;
+    return x;
+}
+
+/* ======================= 速度 ======================= */
+
+/* 统一签名，32 位寄存器足够容纳两种 CRC */
+typedef uint32_t (*kernel_fn)(uint32_t crc, const uint8_t *data, size_t length);
+
+static uint32_t k_sum8(uint32_t crc, const uint8_t *data, size_t length)
+{
+    uint8_t sum = (uint8_t)crc;
+    while (length--) {
+        sum += *data++;
+    }
+    return sum;
+}
+
+#define CRC16_KERNEL(name) \
+    static uint32_t k_##name(uint32_t crc, const uint8_t *data, size_t length) \
+    { return usart_pack_##name((uint16_t)crc, data, length); }
+
+CRC16_KERNEL(crc16_bitwise)
+CRC16_KERNEL(crc16_slice1)
+CRC16_KERNEL(crc16_slice4)
+CRC16_KERNEL(crc16_slice8)
+
+typedef struct {
+    const char *name;
+    kernel_fn fn;
+    const char *table;          /* 表占用 */
+} kernel_t;
+
+static const kernel_t s_kernels[] = {
+    { "sum8",            k_sum8,                   "0" },
+    { "crc16 bitwise",   k_crc16_bitwise,          "0" },
+    { "crc16 table",     k_crc16_slice1,           "512B" },
+    { "crc16 slice-4",   k_crc16_slice4,           "2KB" },
+    { "crc16 slice-8",   k_crc16_slice8,           "4KB" },
+    { "crc32 bitwise",   usart_pack_crc32_bitwise, "0" },
+    { "crc32 table",     usart_pack_crc32_slice1,  "1KB" },
+    { "crc32 slice-4",   usart_pack_crc32_slice4,  "4KB" },
+    { "crc32 slice-8",   usart_pack_crc32_slice8,  "8KB" },
+};
+
+#define KERNEL_COUNT (sizeof(s_kernels) / sizeof(s_kernels[0]))
+
+static volatile uint32_t s_sink;
+
+/**
+ * @brief 对 block 字节的数据块反复计算，返回 周期/字节 和 ns/字节 中最快的一次
+ */
+static void time_kernel(const kernel_t *k, const uint8_t *buf, size_t block, size_t total,
+                        double *cpb, double *npb)
+{
+    size_t iters = total / block;
+    *cpb = 1e9;
+    *npb = 1e9;
+
+    for (int r = 0; r < REPEAT; r++) {
+        uint32_t sink = 0;
+        double t0 = wall_seconds();
+        uint64_t c0 = cycles();
+        for (size_t i = 0; i < iters; i++) {
+            sink ^= k->fn(0xFFFFFFFFul, buf + (i & 63), block);
+        }
+        uint64_t c1 = cycles();
+        double t1 = wall_seconds();
+        s_sink = sink;
+
+        double c = (double)(c1 - c0) / (double)(iters * block);
+        double n = (t1 - t0) * 1e9 / (double)(iters * block);
+        *cpb = (c < *cpb) ? c : *cpb;
+        *npb = (n < *npb) ? n : *npb;
+    }
+}
+
+static void bench_speed(void)
+{
+    static uint8_t buf[4096 + 64];
+    for (size_t i = 0; i < sizeof(buf); i++) {
+        buf[i] = (uint8_t)bench_rand();
+    }
+
+    printf("== speed (best of %d, %s) ==\n", REPEAT,
+           HAVE_TSC ? "cycles = TSC reference cycles" : "no cycle counter");
+    printf("%-16s %6s %14s %14s %14s\n", "kernel", "table", "34B frame c/B", "4KB block c/B", "4KB ns/B");
+
+    for (size_t k = 0; k < KERNEL_COUNT; k++) {
+        double c_frame, n_frame, c_block, n_block;
+        time_kernel(&s_kernels[k], buf, 34, 64u << 20, &c_frame, &n_frame);
+        time_kernel(&s_kernels[k], buf, 4096, 64u << 20, &c_block, &n_block);
+        (void)n_frame;
+        printf("%-16s %6s %14.2f %14.2f %14.3f\n",
+               s_kernels[k].name, s_kernels[k].table, c_frame, c_block, n_block);
+    }
+    printf("\n");
+}
+
+/* ======================= 检错能力 ======================= */
+
+typedef enum {
+    ERR_SWAP,                   /* 相邻两个不同字节交换 */
+    ERR_BIT2,                   /* 任意两个比特翻转 */
+    ERR_BIT4,                   /* 任意四个比特翻转 */
+    ERR_BURST16,                /* 16 位以内的突发错误 */
+    ERR_RANDOM,                 /* 连续 4 个字节随机替换 */
+} error_t;
+
+static const char *s_error_names[] = {
+    "byte swap", "2-bit flip", "4-bit flip", "burst <=16b", "4B random",
+};
+
+static void flip_bit(uint8_t *data, uint16_t bits)
+{
+    uint16_t b = (uint16_t)(bench_rand() % bits);
+    data[b / 8] ^= (uint8_t)(1u << (b % 8));
+}
+
+/**
+ * @brief 在帧的校验覆盖区内注入一次错误（保证数据确实被改变）
+ */
+static void inject(uint8_t *p, uint16_t n, error_t err)
+{
+    uint8_t orig[USART_PACK_MAX_FRAME_LEN];
+    memcpy(orig, p, n);
+
+    do {
+        memcpy(p, orig, n);
+        switch (err) {
+            case ERR_SWAP:
+            {
+                uint16_t i = (uint16_t)(bench_rand() % (n - 1));
+                uint8_t t = p[i];
+                p[i] = p[i + 1];
+                p[i + 1] = t;
+                break;
+            }
+            case ERR_BIT2:
+                flip_bit(p, n * 8);
+                flip_bit(p, n * 8);
+                break;
+            case ERR_BIT4:
+                for (int i = 0; i < 4; i++) {
+                    flip_bit(p, n * 8);
+                }
+                break;
+            case ERR_BURST16:
+            {
+                /* 首尾比特必翻转，中间随机 */
+                uint16_t len = (uint16_t)(2 + bench_rand() % 15);
+                uint16_t start = (uint16_t)(bench_rand() % (n * 8 - len + 1));
+                for (uint16_t b = 0; b < len; b++) {
+                    if (b == 0 || b == len - 1 || (bench_rand() & 1)) {
+                        p[(start + b) / 8] ^= (uint8_t)(1u << ((start + b) % 8));
+                    }
+                }
+                break;
+            }
+            case ERR_RANDOM:
+            {
+                uint16_t i = (uint16_t)(bench_rand() % (n - 3));
+                for (int k = 0; k < 4; k++) {
+                    p[i + k] = (uint8_t)bench_rand();
+                }
+                break;
+            }
+        }
+    } while (memcmp(p, orig, n) == 0);
+}
+
+static void bench_detect(uint32_t trials)
+{
+    static const usart_pack_check_t checks[] = {
+        USART_PACK_CHECK_SUM8, USART_PACK_CHECK_CRC16, USART_PACK_CHECK_CRC32,
+    };
+    static const char *check_names[] = { "sum8", "crc16", "crc32" };
+
+    uint8_t cmd;
+    uint16_t status;
+    uint32_t seq;
+    float f[6];
+    usart_pack_t pack;
+
+    printf("== undetected errors per %u corrupted frames (34B data area) ==\n", trials);
+    printf("%-12s", "error");
+    for (size_t c = 0; c < 3; c++) {
+        printf(" %12s", check_names[c]);
+    }
+    printf("\n");
+
+    for (int err = ERR_SWAP; err <= ERR_RANDOM; err++) {
+        printf("%-12s", s_error_names[err]);
+
+        for (size_t c = 0; c < 3; c++) {
+            uint32_t undetected = 0;
+            uint8_t frame[USART_PACK_MAX_FRAME_LEN];
+
+            usart_pack_init(&pack);
+            usart_pack_add_var(&pack, PACK_TYPE_BYTE, &cmd);
+            usart_pack_add_var(&pack, PACK_TYPE_SHORT, &status);
+            usart_pack_add_var(&pack, PACK_TYPE_INT, &seq);
+            for (int i = 0; i < 6; i++) {
+                usart_pack_add_var(&pack, PACK_TYPE_FLOAT, &f[i]);
+            }
+            usart_pack_set_format(&pack, checks[c], 0);
+
+            s_rng = 12345;
+            for (uint32_t t = 0; t < trials; t++) {
+                cmd = (uint8_t)bench_rand();
+                status = (uint16_t)bench_rand();
+                seq = t;
+                for (int i = 0; i < 6; i++) {
+                    uint32_t r = bench_rand();
+                    memcpy(&f[i], &r, 4);
+                }
+                uint16_t len = usart_pack_build(&pack, frame, sizeof(frame));
+
+                /* 只破坏校验覆盖的数据区，帧头帧尾和校验值保持不变 */
+                inject(&frame[1], pack.data_size, (error_t)err);
+                if (usart_pack_parse(&pack, frame, len) == 0) {
+                    undetected++;
+                }
+            }
+            printf(" %12u", undetected);
+        }
+        printf("\n");
+    }
+    printf("\n");
+}
+
+/* ======================= 可选字段 ======================= */
+
+static void bench_seq(void)
+{
+    uint32_t value = 0;
+    usart_pack_t tx, rx;
+    uint8_t frame[USART_PACK_MAX_FRAME_LEN];
+    uint32_t sent = 100000, dropped = 0;
+
+    usart_pack_init(&tx);
+    usart_pack_add_var(&tx, PACK_TYPE_INT, &value);
+    usart_pack_set_format(&tx, USART_PACK_CHECK_CRC16, USART_PACK_FLAG_LENGTH | USART_PACK_FLAG_SEQ);
+    rx = tx;
+
+    s_rng = 777;
+    for (uint32_t i = 0; i < sent; i++) {
+        value = i;
+        uint16_t len = usart_pack_build(&tx, frame, sizeof(frame));
+        if (bench_rand() % 100 == 0) {
+            dropped++;          /* 模拟整帧丢失 */
+            continue;
+        }
+        usart_pack_parse(&rx, frame, len);
+    }
+
+    printf("== sequence gap detection (crc16 + length + seq, %u frames, 1%% dropped) ==\n", sent);
+    printf("dropped %u, counted lost %u, frame overhead %u bytes\n\n",
+           dropped, usart_pack_get_lost_frames(&rx), tx.overhead);
+}
+
+int main(int argc, char **argv)
+{
+    uint32_t trials = (argc > 1) ? (uint32_t)strtoul(argv[1], NULL, 0) : 1000000;
+
+    const uint8_t check[] = "123456789";
+    if (usart_pack_crc16(check, 9) != 0x29B1 || usart_pack_crc32(check, 9) != 0xCBF43926ul) {
+        printf("check value mismatch\n");
+        return 1;
+    }
+
+    bench_speed();
+    bench_detect(trials);
+    bench_seq();
+
+    return 0;
+}
@@ -0,0 +1,375 @@
+/**
+ ******************************************************************************
+ * @file    usart_pack_layout_bench.c
+ * @brief   usart_pack 打包/解析耗时对比：原模板解释器、预编译布局、USART_PACK_DEFINE 直线代码
+ * @version 1.0.0
+ ******************************************************************************
+ * 用法: ./usart_pack_layout_bench [每项迭代次数，默认 10000000]
+ ******************************************************************************
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#include "usart_pack.h"
+
+#define FRAME_POOL  1024        /* 解析测试循环使用的帧数 */
+#define REPEAT      5           /* 每项重复次数，取最快一次，减小主机调度干扰 */
+
+static double wall_seconds(void)
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (double)ts.tv_sec + (double)ts.tv_nsec * 1e-9;
+}
+
+/* ======================= 原模板解释器（对照组） ======================= */
+
+/* 禁止内联和跨函数优化，与库函数一样按外部调用计时 */
+#define LEGACY __attribute__((noipa))
+
+LEGACY static uint16_t legacy_calc_data_size(usart_pack_t *pack)
+{
+    uint16_t size = 0;
+    for (uint16_t i = 0; i < pack->count; i++) {
+        switch (pack->types[i]) {
+            case PACK_TYPE_BYTE:  size += 1; break;
+            case PACK_TYPE_SHORT: size += 2; break;
+            case PACK_TYPE_INT:   size += 4; break;
+            case PACK_TYPE_FLOAT: size += 4; break;
+        }
+    }
+    return size;
+}
+
+LEGACY static uint16_t legacy_build(usart_pack_t *pack, uint8_t *buffer, uint16_t max_len)
+{
+    uint16_t frame_size = legacy_calc_data_size(pack) + USART_PACK_MIN_FRAME_LEN;
+    if (max_len < frame_size) {
+        return 0;
+    }
+
+    uint16_t idx = 0;
+    buffer[idx++] = pack->header;
+
+    for (uint16_t i = 0; i < pack->count; i++) {
+        switch (pack->types[i]) {
+            case PACK_TYPE_BYTE:
+                buffer[idx++] = *(uint8_t *)pack->vars[i];
+                break;
+            case PACK_TYPE_SHORT:
+            {
+                uint16_t *var = (uint16_t *)pack->vars[i];
+                buffer[idx++] = (*var >> 8) & 0xFF;
+                buffer[idx++] = *var & 0xFF;
+                break;
+            }
+            case PACK_TYPE_INT:
+            {
+                uint32_t *var = (uint32_t *)pack->vars[i];
+                buffer[idx++] = (*var >> 24) & 0xFF;
+                buffer[idx++] = (*var >> 16) & 0xFF;
+                buffer[idx++] = (*var >> 8) & 0xFF;
+                buffer[idx++] = *var & 0xFF;
+                break;
+            }
+            case PACK_TYPE_FLOAT:
+            {
+                uint8_t *bytes = (uint8_t *)pack->vars[i];
+                buffer[idx++] = bytes[0];
+                buffer[idx++] = bytes[1];
+                buffer[idx++] = bytes[2];
+                buffer[idx++] = bytes[3];
+                break;
+            }
+        }
+    }
+
+    uint8_t checksum = 0;
+    for (uint16_t i = 1; i < idx; i++) {
+        checksum += buffer[i];
+    }
+    buffer[idx++] = checksum;
+    buffer[idx++] = pack->tail;
+
+    return idx;
+}
+
+LEGACY static int legacy_parse(usart_pack_t *pack, uint8_t *buffer, uint16_t length)
+{
+    if (length < USART_PACK_MIN_FRAME_LEN ||
+        buffer[0] != pack->header || buffer[length - 1] != pack->tail) {
+        return -1;
+    }
+
+    uint16_t data_len = length - USART_PACK_MIN_FRAME_LEN;
+    uint8_t checksum = 0;
+    for (uint16_t i = 1; i <= data_len; i++) {
+        checksum += buffer[i];
+    }
+    if (checksum != buffer[length - 2]) {
+        return -2;
+    }
+
+    uint16_t idx = 1;
+    for (uint16_t i = 0; i < pack->count && idx < length - 2; i++) {
+        switch (pack->types[i]) {
+            case PACK_TYPE_BYTE:
+                *(uint8_t *)pack->vars[i] = buffer[idx++];
+                break;
+            case PACK_TYPE_SHORT:
+                if (idx + 1 >= length - 2) return -1;
+                *(uint16_t *)pack->vars[i] = (buffer[idx] << 8) | buffer[idx + 1];
+                idx += 2;
+                break;
+            case PACK_TYPE_INT:
+                if (idx + 3 >= length - 2) return -1;
+                *(uint32_t *)pack->vars[i] = ((uint32_t)buffer[idx] << 24) |
+                                             ((uint32_t)buffer[idx + 1] << 16) |
+                                             ((uint32_t)buffer[idx + 2] << 8) |
+                                             buffer[idx + 3];
+                idx += 4;
+                break;
+            case PACK_TYPE_FLOAT:
+                if (idx + 3 >= length - 2) return -1;
+                memcpy(pack->vars[i], &buffer[idx], 4);
+                idx += 4;
+                break;
+        }
+    }
+
+    return 0;
+}
+
+/* ======================= 测试模板 ======================= */
+
+/* 遥测帧：命令 + 状态 + 序号 + 6 个浮点量（浮点量为数组，预编译时合并为一段） */
+#define TELEM_FIELDS(X) \
+    X(BYTE,  cmd)       \
+    X(SHORT, status)    \
+    X(INT,   seq)       \
+    X(FLOAT, f0)        \
+    X(FLOAT, f1)        \
+    X(FLOAT, f2)        \
+    X(FLOAT, f3)        \
+    X(FLOAT, f4)        \
+    X(FLOAT, f5)
+
+USART_PACK_DEFINE(telem, TELEM_FIELDS)
+
+/* 混合帧：16 个类型交错的变量，无法合并 */
+#define MIXED_FIELDS(X)                                                  \
+    X(SHORT, s0) X(FLOAT, f0) X(INT, i0) X(BYTE, b0)                     \
+    X(SHORT, s1) X(FLOAT, f1) X(INT, i1) X(BYTE, b1)                     \
+    X(SHORT, s2) X(FLOAT, f2) X(INT, i2) X(BYTE, b2)                     \
+    X(SHORT, s3) X(FLOAT, f3) X(INT, i3) X(BYTE, b3)
+
+USART_PACK_DEFINE(mixed, MIXED_FIELDS)
+
+static telem_t s_telem;
+static mixed_t s_mixed;
+
+/* 与结构体字段一一对应的模板 */
+#define TEMPLATE_ADD(type, name) usart_pack_add_var(pack, PACK_TYPE_##type, &v->name);
+
+static void telem_template(usart_pack_t *pack, telem_t *v)
+{
+    usart_pack_init(pack);
+    TELEM_FIELDS(TEMPLATE_ADD)
+}
+
+static void mixed_template(usart_pack_t *pack, mixed_t *v)
+{
+    usart_pack_init(pack);
+    MIXED_FIELDS(TEMPLATE_ADD)
+}
+
+static void telem_update(uint32_t i)
+{
+    s_telem.cmd = (uint8_t)i;
+    s_telem.status = (uint16_t)(i * 3u);
+    s_telem.seq = i;
+    s_telem.f0 = (float)i * 0.5f;
+    s_telem.f3 = (float)i * -0.25f;
+}
+
+static void mixed_update(uint32_t i)
+{
+    s_mixed.s0 = (uint16_t)i;
+    s_mixed.i1 = i * 7u;
+    s_mixed.f2 = (float)i;
+    s_mixed.b3 = (uint8_t)(i >> 3);
+}
+
+/* ======================= 计时 ======================= */
+
+typedef enum { IMPL_LEGACY, IMPL_LAYOUT, IMPL_DEFINE } impl_t;
+
+static const char *s_impl_names[] = { "interpreter", "layout", "DEFINE" };
+
+static volatile uint32_t s_sink;
+
+static double time_build(impl_t impl, int mixed, uint32_t iters)
+{
+    static usart_pack_t pack;
+    uint8_t buf[USART_PACK_MAX_FRAME_LEN];
+    uint32_t sink = 0;
+
+    if (mixed) {
+        mixed_template(&pack, &s_mixed);
+    } else {
+        telem_template(&pack, &s_telem);
+    }
+
+    double t0 = wall_seconds();
+    for (uint32_t i = 0; i < iters; i++) {
+        uint16_t len = 0;
+
+        if (mixed) {
+            mixed_update(i);
+        } else {
+            telem_update(i);
+        }
+
+        switch (impl) {
+            case IMPL_LEGACY: len = legacy_build(&pack, buf, sizeof(buf)); break;
+            case IMPL_LAYOUT: len = usart_pack_build(&pack, buf, sizeof(buf)); break;
+            case IMPL_DEFINE:
+                len = mixed ? mixed_build(&s_mixed, buf, sizeof(buf))
+                            : telem_build(&s_telem, buf, sizeof(buf));
+                break;
+        }
+        sink += buf[len - 2];
+    }
+    double dt = wall_seconds() - t0;
+
+    s_sink = sink;
+    return dt * 1e9 / iters;
+}
+
+static double time_parse(impl_t impl, int mixed, uint32_t iters)
+{
+    static usart_pack_t pack;
+    static uint8_t frames[FRAME_POOL][USART_PACK_MAX_FRAME_LEN];
+    uint16_t len = 0;
+    uint32_t sink = 0;
+
+    if (mixed) {
+        mixed_template(&pack, &s_mixed);
+    } else {
+        telem_template(&pack, &s_telem);
+    }
+
+    for (uint32_t i = 0; i < FRAME_POOL; i++) {
+        if (mixed) {
+            mixed_update(i);
+        } else {
+            telem_update(i);
+        }
+        len = usart_pack_build(&pack, frames[i], USART_PACK_MAX_FRAME_LEN);
+    }
+
+    double t0 = wall_seconds();
+    for (uint32_t i = 0; i < iters; i++) {
+        uint8_t *frame = frames[i % FRAME_POOL];
+
+        switch (impl) {
+            case IMPL_LEGACY: sink += legacy_parse(&pack, frame, len); break;
+            case IMPL_LAYOUT: sink += usart_pack_parse(&pack, frame, len); break;
+            case IMPL_DEFINE:
+                sink += mixed ? mixed_parse(&s_mixed, frame, len)
+                              : telem_parse(&s_telem, frame, len);
+                break;
+        }
+        sink += mixed ? s_mixed.s0 : s_telem.seq;
+    }
+    double dt = wall_seconds() - t0;
+
+    s_sink = sink;
+    return dt * 1e9 / iters;
+}
+
+/* 三种实现的帧必须逐字节一致，解析结果必须还原全部字段 */
+static int verify(void)
+{
+    static usart_pack_t pack;
+    uint8_t a[USART_PACK_MAX_FRAME_LEN], b[USART_PACK_MAX_FRAME_LEN], c[USART_PACK_MAX_FRAME_LEN];
+
+    for (int mixed = 0; mixed <= 1; mixed++) {
+        for (uint32_t i = 0; i < 10000; i++) {
+            uint16_t la, lb, lc;
+
+            if (mixed) {
+                mixed_template(&pack, &s_mixed);
+                for (size_t k = 0; k < sizeof(s_mixed); k++) {
+                    ((uint8_t *)&s_mixed)[k] = (uint8_t)(i * 131u + k * 17u);
+                }
+                mixed_t ref = s_mixed;
+                la = legacy_build(&pack, a, sizeof(a));
+                lb = usart_pack_build(&pack, b, sizeof(b));
+                lc = mixed_build(&s_mixed, c, sizeof(c));
+                memset(&s_mixed, 0, sizeof(s_mixed));
+                if (usart_pack_parse(&pack, b, lb) != 0 ||
+                    memcmp(&ref.s0, &s_mixed.s0, sizeof(uint16_t)) != 0 ||
+                    memcmp(&ref.f3, &s_mixed.f3, sizeof(float)) != 0 ||
+                    ref.i2 != s_mixed.i2 || ref.b1 != s_mixed.b1) {
+                    return -1;
+                }
+            } else {
+                telem_template(&pack, &s_telem);
+                for (size_t k = 0; k < sizeof(s_telem); k++) {
+                    ((uint8_t *)&s_telem)[k] = (uint8_t)(i * 131u + k * 17u);
+                }
+                telem_t ref = s_telem;
+                la = legacy_build(&pack, a, sizeof(a));
+                lb = usart_pack_build(&pack, b, sizeof(b));
+                lc = telem_build(&s_telem, c, sizeof(c));
+                memset(&s_telem, 0, sizeof(s_telem));
+                if (telem_parse(&s_telem, c, lc) != 0 ||
+                    ref.seq != s_telem.seq || ref.status != s_telem.status ||
+                    memcmp(&ref.f5, &s_telem.f5, sizeof(float)) != 0) {
+                    return -1;
+                }
+            }
+
+            if (la != lb || la != lc || memcmp(a, b, la) != 0 || memcmp(a, c, la) != 0) {
+                return -1;
+            }
+        }
+    }
+
+    return 0;
+}
+
+int main(int argc, char **argv)
+{
+    uint32_t iters = (argc > 1) ? (uint32_t)strtoul(argv[1], NULL, 0) : 10000000;
+
+    if (verify() != 0) {
+        printf("verify FAILED: implementations disagree\n");
+        return 1;
+    }
+    printf("verify ok: interpreter / layout / DEFINE frames identical\n\n");
+
+    static const char *templates[] = { "telemetry (9 vars, 34B)", "mixed (16 vars, 47B)" };
+
+    for (int mixed = 0; mixed <= 1; mixed++) {
+        printf("== %s ==\n", templates[mixed]);
+        printf("%-12s %12s %12s\n", "impl", "build ns", "parse ns");
+        for (int impl = IMPL_LEGACY; impl <= IMPL_DEFINE; impl++) {
+            double b = 1e9, p = 1e9;
+            for (int r = 0; r < REPEAT; r++) {
+                double t = time_build((impl_t)impl, mixed, iters / REPEAT);
+                b = (t < b) ? t : b;
+                t = time_parse((impl_t)impl, mixed, iters / REPEAT);
+                p = (t < p) ? t : p;
+            }
+            printf("%-12s %12.1f %12.1f\n", s_impl_names[impl], b, p);
+        }
+        printf("\n");
+    }
+
+    return 0;
+}
@@ -74,9 +74,10 @@ static char* trim_whitespace(char* str)
  */
 static int8_t validate_pid_params(float kp, float ki, float kd)
 {
-    if (kp < PID_PARAM_MIN || kp > PID_PARAM_MAX ||
-        ki < PID_PARAM_MIN || ki > PID_PARAM_MAX ||
-        kd < PID_PARAM_MIN || kd > PID_PARAM_MAX)
+    // 写成"不在范围内"，NaN 与任何数比较都为假，也会被拒绝
+    if (!(kp >= PID_PARAM_MIN && kp <= PID_PARAM_MAX) ||
+        !(ki >= PID_PARAM_MIN && ki <= PID_PARAM_MAX) ||
+        !(kd >= PID_PARAM_MIN && kd <= PID_PARAM_MAX))
     {
         return -1;
     }
@@ -429,7 +429,7 @@ uint8_t Emm_V5_Parse_Response(uint8_t *buffer, uint8_t len, Emm_V5_Response_t *r
   case 0x31: // ȡֵ
     if (len >= 6)
     {
-      resp->encoder = (buffer[2] << 24) | (buffer[3] << 16) | (buffer[4] << 8) | buffer[5]; // ȡֵ
+      resp->encoder = ((uint32_t)buffer[2] << 24) | ((uint32_t)buffer[3] << 16) | (buffer[4] << 8) | buffer[5]; // ȡֵ
       resp->valid = 1;                                                                      // Ч
     }
     break;
@@ -458,7 +458,7 @@ uint8_t Emm_V5_Parse_Response(uint8_t *buffer, uint8_t len, Emm_V5_Response_t *r
     {
       resp->dir = buffer[2];                                                                  // 
       // 32λλֵ
-      uint32_t full_position = (buffer[3] << 24) | (buffer[4] << 16) | (buffer[5] << 8) | buffer[6];
+      uint32_t full_position = ((uint32_t)buffer[3] << 24) | ((uint32_t)buffer[4] << 16) | (buffer[5] << 8) | buffer[6];
       // ڽǶȼ16λֵһȦڵλã
       resp->position = full_position % 65536;
       
@@ -473,7 +473,7 @@ uint8_t Emm_V5_Parse_Response(uint8_t *buffer, uint8_t len, Emm_V5_Response_t *r
   case 0x37: // ȡλ
     if (len >= 7)
     {
-      int32_t perr = (buffer[2] << 24) | (buffer[3] << 16) | (buffer[4] << 8) | buffer[5]; // ȡλ
+      int32_t perr = ((uint32_t)buffer[2] << 24) | ((uint32_t)buffer[3] << 16) | (buffer[4] << 8) | buffer[5]; // ȡλ
       resp->position = perr;                                                               // ʹpositionֶδ洢ֵ
       resp->valid = 1;                                                                     // Ч
     }
@@ -506,7 +506,7 @@ uint8_t Emm_V5_Parse_Response(uint8_t *buffer, uint8_t len, Emm_V5_Response_t *r
   case 0x3D: // ȡĿλ
     if (len >= 6)
     {
-      resp->target_pos = (buffer[2] << 24) | (buffer[3] << 16) | (buffer[4] << 8) | buffer[5]; // ȡĿλ
+      resp->target_pos = ((uint32_t)buffer[2] << 24) | ((uint32_t)buffer[3] << 16) | (buffer[4] << 8) | buffer[5]; // ȡĿλ
       resp->valid = 1;                                                                         // Ч
     }
     break;
@@ -47,6 +47,7 @@ QQQQQQQQQQQQQQQQQQQQQQQQQQQQQQQQQQQQQQQQQQQQQQQQQQQQQQQQQQQQQQQ*/
   * @return   
   *
   * @note     ֲʱûӦӦõʹõͨŷʽʵִ˺
+  *           ͣANO_DT_TX_QUEUE Ϊ 1 ʱ ANO_DT_send_int16 ٵ
   *
   * @see      ڲ
   *
@@ -59,60 +60,147 @@ void ANO_DT_Send_Data(unsigned char *dataToSend , unsigned short length)
 	UART4_PutBuff(dataToSend, length);     //޸ĲͬĴڷ
 
 }
-/**  ݻ */
-unsigned char data_to_send[50];
+#if ANO_DT_TX_QUEUE
+/**  ͶУÿ֡ռһۣDMA ֱӴӲڷͣͷ */
+static unsigned char ano_tx_buf[ANO_DT_TX_SLOTS][ANO_DT_TX_FRAME_MAX];
+static unsigned char ano_tx_len[ANO_DT_TX_SLOTS];
+static volatile unsigned char ano_tx_head;      /* һд */
+static volatile unsigned char ano_tx_tail;      /* ڷ/һ͵Ĳ */
+static volatile unsigned char ano_tx_busy;      /* 1ͣȴ ANO_DT_TX_Done */
+static volatile unsigned short ano_tx_dropped;
+
+unsigned char ANO_DT_Queue(const unsigned char *frame, unsigned char length)
+{
+    unsigned char next, i;
+
+    ANO_DT_ENTER_CRITICAL();
+    next = (unsigned char)((ano_tx_head + 1) % ANO_DT_TX_SLOTS);
+    if(length > ANO_DT_TX_FRAME_MAX || next == ano_tx_tail)
+    {
+        ano_tx_dropped++;
+        ANO_DT_EXIT_CRITICAL();
+        return 0;
+    }
+
+    for(i = 0; i < length; i++)
+        ano_tx_buf[ano_tx_head][i] = frame[i];
+    ano_tx_len[ano_tx_head] = length;
+    ano_tx_head = next;
+
+    /* Ϳʱӷɷɻص */
+    if(!ano_tx_busy)
+    {
+        ano_tx_busy = 1;
+        ANO_DT_TX_Start(ano_tx_buf[ano_tx_tail], ano_tx_len[ano_tx_tail]);
+    }
+    ANO_DT_EXIT_CRITICAL();
+    return 1;
+}
+
+void ANO_DT_TX_Done(void)
+{
+    ANO_DT_ENTER_CRITICAL();
+    ano_tx_tail = (unsigned char)((ano_tx_tail + 1) % ANO_DT_TX_SLOTS);
+    if(ano_tx_tail != ano_tx_head)
+        ANO_DT_TX_Start(ano_tx_buf[ano_tx_tail], ano_tx_len[ano_tx_tail]);
+    else
+        ano_tx_busy = 0;
+    ANO_DT_EXIT_CRITICAL();
+}
+
+unsigned char ANO_DT_TX_Pending(void)
+{
+    unsigned char n;
+
+    ANO_DT_ENTER_CRITICAL();
+    n = (unsigned char)((ano_tx_head + ANO_DT_TX_SLOTS - ano_tx_tail) % ANO_DT_TX_SLOTS);
+    ANO_DT_EXIT_CRITICAL();
+    return n;
+}
+
+unsigned short ANO_DT_TX_Dropped(void)
+{
+    return ano_tx_dropped;
+}
+#endif
 
 /*!
-  * @brief    λͷ8int16_t
+  * @brief    ڵṩĻһ֡8int16_t
   *
+  * @param    buf             ֡ ANO_DT_INT16_FRAME_LEN ֽ
   * @param    data1 - data8   ͸λʾ
   *
-  * @return   
+  * @return   ֡
   *
-  * @note     
+  * @note     ȫ״̬
   *
-  * @see      ANO_DT_send_int16(1, 2, 3, 0, 0, 0, 0, 0);
-  *
-  * @date     2019/5/28 ڶ
+  * @see      len = ANO_DT_build_int16(frame, 1, 2, 3, 0, 0, 0, 0, 0);
   */
-void ANO_DT_send_int16(short data1, short data2, short data3, short data4, short data5, short data6, short data7, short data8 )
+unsigned char ANO_DT_build_int16(unsigned char *buf, short data1, short data2, short data3, short data4, short data5, short data6, short data7, short data8)
 {
   unsigned char  _cnt=0;
 	unsigned char  sum = 0, i = 0;
 	
-  data_to_send[_cnt++] = 0xAA;      //Э֡ͷ  0xAAAA
-	data_to_send[_cnt++] = 0xAA;
-	data_to_send[_cnt++] = 0xF1;      //ʹûЭ֡0xF1
-  data_to_send[_cnt++] = 16;        //8int16_t  16ֽ
+  buf[_cnt++] = 0xAA;      //Э֡ͷ  0xAAAA
+	buf[_cnt++] = 0xAA;
+	buf[_cnt++] = 0xF1;      //ʹûЭ֡0xF1
+  buf[_cnt++] = 16;        //8int16_t  16ֽ
 
-	data_to_send[_cnt++]=BYTE1(data1);
-	data_to_send[_cnt++]=BYTE0(data1);
+	buf[_cnt++]=BYTE1(data1);
+	buf[_cnt++]=BYTE0(data1);
 
-	data_to_send[_cnt++]=BYTE1(data2);
-	data_to_send[_cnt++]=BYTE0(data2);
+	buf[_cnt++]=BYTE1(data2);
+	buf[_cnt++]=BYTE0(data2);
 
-	data_to_send[_cnt++]=BYTE1(data3);
-	data_to_send[_cnt++]=BYTE0(data3);
+	buf[_cnt++]=BYTE1(data3);
+	buf[_cnt++]=BYTE0(data3);
 
-  data_to_send[_cnt++]=BYTE1(data4);
-	data_to_send[_cnt++]=BYTE0(data4);
+  buf[_cnt++]=BYTE1(data4);
+	buf[_cnt++]=BYTE0(data4);
 
-	data_to_send[_cnt++]=BYTE1(data5);
-	data_to_send[_cnt++]=BYTE0(data5);
+	buf[_cnt++]=BYTE1(data5);
+	buf[_cnt++]=BYTE0(data5);
 
-	data_to_send[_cnt++]=BYTE1(data6);
-	data_to_send[_cnt++]=BYTE0(data6);
+	buf[_cnt++]=BYTE1(data6);
+	buf[_cnt++]=BYTE0(data6);
 
-  data_to_send[_cnt++]=BYTE1(data7);
-	data_to_send[_cnt++]=BYTE0(data7);
+  buf[_cnt++]=BYTE1(data7);
+	buf[_cnt++]=BYTE0(data7);
 
-	data_to_send[_cnt++]=BYTE1(data8);
-	data_to_send[_cnt++]=BYTE0(data8);
+	buf[_cnt++]=BYTE1(data8);
+	buf[_cnt++]=BYTE0(data8);
 
   sum = 0;
 	for(i=0;i<_cnt;i++)
-		sum += data_to_send[i];
-	data_to_send[_cnt++]=sum;	
+		sum += buf[i];
+	buf[_cnt++]=sum;	
 	
-	ANO_DT_Send_Data(data_to_send ,_cnt);
+	return _cnt;
+}
+
+/*!
+  * @brief    λͷ8int16_t
+  *
+  * @param    data1 - data8   ͸λʾ
+  *
+  * @return   
+  *
+  * @note     ANO_DT_TX_QUEUE Ϊ 1 ʱӺأʱ֡
+  *
+  * @see      ANO_DT_send_int16(1, 2, 3, 0, 0, 0, 0, 0);
+  *
+  * @date     2019/5/28 ڶ
+  */
+void ANO_DT_send_int16(short data1, short data2, short data3, short data4, short data5, short data6, short data7, short data8 )
+{
+  unsigned char frame[ANO_DT_INT16_FRAME_LEN];
+  unsigned char len;
+
+  len = ANO_DT_build_int16(frame, data1, data2, data3, data4, data5, data6, data7, data8);
+
+#if ANO_DT_TX_QUEUE
+  ANO_DT_Queue(frame, len);
+#else
+	ANO_DT_Send_Data(frame, len);
+#endif
 }
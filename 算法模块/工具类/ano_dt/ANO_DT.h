@@ -28,6 +28,101 @@ QQQQQQQQQQQQQQQQQQQQQQQQQQQQQQQQQQQQQQQQQQQQQQQQQQQQQQQQQQQQQQQ*/
 #ifndef SRC_APPSW_TRICORE_USER_ANO_DT_H_
 #define SRC_APPSW_TRICORE_USER_ANO_DT_H_
 
+/* 8int16_t֡ȣ֡ͷ2 + 1 + 1 + 16 + У1 */
+#define ANO_DT_INT16_FRAME_LEN   21
+
+/*
+ * Ͷ
+ * ANO_DT_TX_QUEUE Ϊ 1 ʱ ANO_DT_send_int16 ֻ֡뷢Ͷأ
+ *  DMA/ڷж֡ѭٵȴڣΪ 0 ʱԭ
+ */
+#ifndef ANO_DT_TX_QUEUE
+#define ANO_DT_TX_QUEUE          0
+#endif
+
+#ifndef ANO_DT_TX_SLOTS
+#define ANO_DT_TX_SLOTS          8      /* вͬʱŶ ANO_DT_TX_SLOTS-1 ֡ */
+#endif
+
+#ifndef ANO_DT_TX_FRAME_MAX
+#define ANO_DT_TX_FRAME_MAX      32     /* ÿ۵֡ */
+#endif
+
+/* 뷢ɻص֮ٽĬ STC16 жϣƽ̨ж */
+#ifndef ANO_DT_ENTER_CRITICAL
+#define ANO_DT_ENTER_CRITICAL()  EA = 0
+#define ANO_DT_EXIT_CRITICAL()   EA = 1
+#endif
+
+/*!
+  * @brief    ڵṩĻһ֡8int16_t
+  *
+  * @param    buf             ֡ ANO_DT_INT16_FRAME_LEN ֽ
+  * @param    data1 - data8   ͸λʾ
+  *
+  * @return   ֡
+  *
+  * @note     ʹȫֻڶģѭʱжϣͬʱ
+  *
+  * @see      len = ANO_DT_build_int16(frame, 1, 2, 3, 0, 0, 0, 0, 0);
+  */
+unsigned char ANO_DT_build_int16(unsigned char *buf, short data1, short data2, short data3, short data4, short data5, short data6, short data7, short data8);
+
+/*!
+  * @brief    һݣŷ
+  *
+  * @param    dataToSend   :   Ҫ͵׵ַ
+  * @param    length       :   Ҫ͵ݳ
+  *
+  * @return   
+  */
+void ANO_DT_Send_Data(unsigned char *dataToSend, unsigned short length);
+
+#if ANO_DT_TX_QUEUE
+/*!
+  * @brief    һ֡뷢ͶУͿʱ
+  *
+  * @param    frame    ֡ݣʱغ󼴿ɸ
+  * @param    length   ֡ȣ ANO_DT_TX_FRAME_MAX
+  *
+  * @return   1 ӣ0 ֡֡
+  *
+  * @note     ѭжеãٽ
+  */
+unsigned char ANO_DT_Queue(const unsigned char *frame, unsigned char length);
+
+/*!
+  * @brief    ɻص DMA жϻ򴮿ڷһֽڵже
+  *
+  * @return   
+  *
+  * @note     ͷŸշĲۣзǿʱһ֡
+  */
+void ANO_DT_TX_Done(void);
+
+/*!
+  * @brief    һ֡ DMA/жϷͣûڴʵ
+  *
+  * @param    frame    ֡ݣλڶвڣ ANO_DT_TX_Done ֮ǰЧ
+  * @param    length   ֡
+  *
+  * @return   
+  *
+  * @note     ֻõȴɣٽڱ
+  */
+void ANO_DT_TX_Start(const unsigned char *frame, unsigned char length);
+
+/*!
+  * @brief    еȴ͵֡ڷ͵һ֡
+  */
+unsigned char ANO_DT_TX_Pending(void);
+
+/*!
+  * @brief    ֡֡
+  */
+unsigned short ANO_DT_TX_Dropped(void);
+#endif
+
 /*!
   * @brief    λͷ8int16_t
   *
@@ -35,7 +130,7 @@ QQQQQQQQQQQQQQQQQQQQQQQQQQQQQQQQQQQQQQQQQQQQQQQQQQQQQQQQQQQQQQQ*/
   *
   * @return   
   *
-  * @note     
+  * @note     ANO_DT_TX_QUEUE Ϊ 1 ʱӺأʱ֡
   *
   * @see      ANO_DT_send_int16(1, 2, 3, 0, 0, 0, 0, 0);
   *
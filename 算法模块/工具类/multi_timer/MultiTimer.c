@@ -1,66 +1,610 @@
 #include "MultiTimer.h"
 #include <stdio.h>
+#include <limits.h>
+#include <string.h>
 
-static MultiTimer* timerList = NULL;
-static PlatformTicksFunction_t platformTicksFunction = NULL;
+#if MULTITIMER_WHEEL_BITS < 1 || MULTITIMER_WHEEL_BITS > 6
+#error "MULTITIMER_WHEEL_BITS must be in 1..6"
+#endif
 
-int multiTimerInstall(PlatformTicksFunction_t ticksFunc) {
-    if (ticksFunc == NULL) {
-        return -1; // Indicate error if ticksFunc is NULL
+#if MULTITIMER_WHEEL_LEVELS < 2 || MULTITIMER_WHEEL_BITS * MULTITIMER_WHEEL_LEVELS > 63
+#error "MULTITIMER_WHEEL_LEVELS out of range"
+#endif
+
+#define WHEEL_SLOTS         (1u << MULTITIMER_WHEEL_BITS)
+#define WHEEL_MASK          ((uint64_t)WHEEL_SLOTS - 1)
+#define WHEEL_SHIFT(level)  ((level) * MULTITIMER_WHEEL_BITS)
+#define WHEEL_SPAN          ((uint64_t)1 << WHEEL_SHIFT(MULTITIMER_WHEEL_LEVELS))
+#define WHEEL_FULL          (WHEEL_SLOTS == 64 ? ~(uint64_t)0 : (((uint64_t)1 << WHEEL_SLOTS) - 1))
+
+#define QUEUE_MASK          ((uint32_t)MULTITIMER_ISR_QUEUE_SIZE - 1)
+
+#if (MULTITIMER_ISR_QUEUE_SIZE & (MULTITIMER_ISR_QUEUE_SIZE - 1)) != 0
+#error "MULTITIMER_ISR_QUEUE_SIZE must be a power of two"
+#endif
+
+/*
+ * Hierarchical timing wheel. Level 0 holds timers due within the next
+ * WHEEL_SLOTS ticks, one slot per tick; each higher level covers WHEEL_SLOTS
+ * times the range of the one below. When level 0 wraps, the matching slot of
+ * the next level is cascaded down. Every level keeps an occupancy bitmap so
+ * empty slots are skipped and the next expiry is found without a list walk.
+ * Timers whose deadline has already been passed wait in a separate list that
+ * is run at the start of the next yield.
+ *
+ * Interrupts never touch the wheel. They post requests into a bounded
+ * multi-producer queue (one CAS to claim a slot, a release store to publish
+ * it) that only the yield drains, so no interrupt masking is needed.
+ */
+
+enum {
+    REQUEST_START = 1,
+    REQUEST_STOP,
+};
+
+#ifndef MULTITIMER_NO_C11_ATOMICS
+#define ATOMIC_LOAD_RELAXED(p)      atomic_load_explicit((p), memory_order_relaxed)
+#define ATOMIC_LOAD_ACQUIRE(p)      atomic_load_explicit((p), memory_order_acquire)
+#define ATOMIC_STORE_RELEASE(p, v)  atomic_store_explicit((p), (v), memory_order_release)
+
+static int atomicClaim(MultiTimerAtomic_t* p, uint32_t expected) {
+    return atomic_compare_exchange_weak_explicit(p, &expected, expected + 1,
+                                                 memory_order_relaxed, memory_order_relaxed);
+}
+#else
+/*
+ * No C11 atomics (ARMCC5, GCC/Clang in C99 mode): aligned word loads and
+ * stores are atomic, acquire/release only need a barrier, and the slot claim
+ * is a compare-and-increment of queueTail. It uses, in this order:
+ * MULTITIMER_ENTER_CRITICAL()/MULTITIMER_EXIT_CRITICAL(state) when defined,
+ * LDREX/STREX on ARMCC5, a PRIMASK critical section on GCC/Clang for
+ * Cortex-M, and the __sync builtins elsewhere (hosts).
+ */
+#if defined(MULTITIMER_ENTER_CRITICAL) || \
+    (!defined(__CC_ARM) && defined(__ARM_ARCH_PROFILE) && __ARM_ARCH_PROFILE == 'M')
+#ifndef MULTITIMER_ENTER_CRITICAL
+static uint32_t criticalEnter(void) {
+    uint32_t primask;
+    __asm volatile("mrs %0, primask\n\tcpsid i" : "=r"(primask) :: "memory");
+    return primask;
+}
+
+static void criticalExit(uint32_t primask) {
+    __asm volatile("msr primask, %0" :: "r"(primask) : "memory");
+}
+
+#define MULTITIMER_ENTER_CRITICAL()         criticalEnter()
+#define MULTITIMER_EXIT_CRITICAL(state)     criticalExit(state)
+#endif
+
+// Short critical section, nesting-safe because the previous mask is restored
+static int atomicClaim(MultiTimerAtomic_t* p, uint32_t expected) {
+    uint32_t state = MULTITIMER_ENTER_CRITICAL();
+    int claimed = (*p == expected);
+    if (claimed) {
+        *p = expected + 1;
+    }
+    MULTITIMER_EXIT_CRITICAL(state);
+    return claimed;
+}
+#elif defined(__CC_ARM)
+// Cortex-M3 and above; Cortex-M0 needs MULTITIMER_ENTER_CRITICAL()
+#ifndef MULTITIMER_BARRIER
+#define MULTITIMER_BARRIER()    __dmb(0xF)
+#endif
+
+static int atomicClaim(MultiTimerAtomic_t* p, uint32_t expected) {
+    if (__ldrex(p) != expected) {
+        __clrex();
+        return 0;
+    }
+    return __strex(expected + 1, p) == 0;
+}
+#elif defined(__GNUC__)
+#ifndef MULTITIMER_BARRIER
+#define MULTITIMER_BARRIER()    __sync_synchronize()
+#endif
+
+static int atomicClaim(MultiTimerAtomic_t* p, uint32_t expected) {
+    return __sync_bool_compare_and_swap(p, expected, expected + 1);
+}
+#else
+#error "MultiTimer: define MULTITIMER_ENTER_CRITICAL()/MULTITIMER_EXIT_CRITICAL(state) for this compiler"
+#endif
+
+// Single core: keeping the compiler from reordering is enough
+#ifndef MULTITIMER_BARRIER
+#define MULTITIMER_BARRIER()    __asm volatile("" ::: "memory")
+#endif
+
+static uint32_t atomicLoadAcquire(MultiTimerAtomic_t* p) {
+    uint32_t v = *p;
+    MULTITIMER_BARRIER();
+    return v;
+}
+
+static void atomicStoreRelease(MultiTimerAtomic_t* p, uint32_t v) {
+    MULTITIMER_BARRIER();
+    *p = v;
+}
+
+#define ATOMIC_LOAD_RELAXED(p)      (*(p))
+#define ATOMIC_LOAD_ACQUIRE(p)      atomicLoadAcquire(p)
+#define ATOMIC_STORE_RELEASE(p, v)  atomicStoreRelease((p), (v))
+#endif
+
+static MultiTimerCtx defaultCtx;
+
+static unsigned lowestBit(uint64_t bits) {
+#if defined(__GNUC__) || defined(__clang__)
+    return (unsigned)__builtin_ctzll(bits);
+#else
+    unsigned n = 0;
+    while (!(bits & 1u)) {
+        bits >>= 1;
+        n++;
+    }
+    return n;
+#endif
+}
+
+static unsigned highestBit(uint64_t bits) {
+#if defined(__GNUC__) || defined(__clang__)
+    return 63u - (unsigned)__builtin_clzll(bits);
+#else
+    unsigned n = 0;
+    while (bits >>= 1) {
+        n++;
+    }
+    return n;
+#endif
+}
+
+/* Rotate a slot bitmap right so that slot 'start' becomes bit 0. */
+static uint64_t rotateSlots(uint64_t bits, unsigned start) {
+    if (start == 0) {
+        return bits;
+    }
+    return ((bits >> start) | (bits << (WHEEL_SLOTS - start))) & WHEEL_FULL;
+}
+
+static void listPush(MultiTimer** head, MultiTimer* timer) {
+    timer->next = *head;
+    if (*head) {
+        (*head)->pprev = &timer->next;
+    }
+    timer->pprev = head;
+    *head = timer;
+}
+
+/*
+ * Pick the expiry inside [deadline, deadline + slack] with the most trailing
+ * zero bits. Let k be the highest bit in which the limit differs from the
+ * deadline: the limit with bits below k cleared is a multiple of 2^k inside
+ * the window, unless the deadline already has those bits clear, in which case
+ * it is a multiple of 2^(k+1) and stays put. The choice is unique, so timers
+ * whose windows contain each other's choice share a tick; overlapping windows
+ * usually, but not always, end up on the same tick.
+ */
+static uint64_t applySlack(uint64_t deadline, uint32_t slack) {
+    uint64_t limit = deadline + slack;
+    uint64_t diff = deadline ^ limit;
+
+    if (slack == 0 || diff == 0) {
+        return deadline;
+    }
+    uint64_t low = ((uint64_t)1 << highestBit(diff)) - 1;
+    if ((deadline & low) == 0) {
+        return deadline;
+    }
+    return limit & ~low;
+}
+
+static void wheelLink(MultiTimerCtx* ctx, MultiTimer* timer) {
+    uint64_t expires = applySlack(timer->deadline, timer->slack);
+    ctx->count++;
+
+    if (expires < ctx->wheelTime) {
+        listPush(&ctx->expired, timer); // Tick already processed: run on the next yield
+        return;
+    }
+
+    uint64_t delta = expires - ctx->wheelTime;
+    if (delta >= WHEEL_SPAN) {
+        expires = ctx->wheelTime + WHEEL_SPAN - 1; // Park in the top level, re-cascaded later
+        delta = WHEEL_SPAN - 1;
+    }
+
+    unsigned level = 0;
+    while (level < MULTITIMER_WHEEL_LEVELS - 1 && delta >= ((uint64_t)1 << WHEEL_SHIFT(level + 1))) {
+        level++;
+    }
+    unsigned idx = (unsigned)((expires >> WHEEL_SHIFT(level)) & WHEEL_MASK);
+
+    listPush(&ctx->slots[level][idx], timer);
+    ctx->pending[level] |= (uint64_t)1 << idx;
+}
+
+static void wheelUnlink(MultiTimerCtx* ctx, MultiTimer* timer) {
+    *timer->pprev = timer->next;
+    if (timer->next) {
+        timer->next->pprev = timer->pprev;
+    }
+    timer->next = NULL;
+    timer->pprev = NULL;
+    ctx->count--;
+}
+
+/* Move a whole list from *from to *to, which becomes its new head. */
+static void listMove(MultiTimer** from, MultiTimer** to) {
+    *to = *from;
+    *from = NULL;
+    if (*to) {
+        (*to)->pprev = to;
+    }
+}
+
+/* Detach a slot list and clear its pending bit; the list head is moved into *list. */
+static void wheelTakeSlot(MultiTimerCtx* ctx, unsigned level, unsigned idx, MultiTimer** list) {
+    listMove(&ctx->slots[level][idx], list);
+    ctx->pending[level] &= ~((uint64_t)1 << idx);
+}
+
+/* Move one higher-level slot down; returns the slot index so the caller can cascade further on wrap. */
+static unsigned wheelCascade(MultiTimerCtx* ctx, unsigned level) {
+    unsigned idx = (unsigned)((ctx->wheelTime >> WHEEL_SHIFT(level)) & WHEEL_MASK);
+    MultiTimer* list;
+
+    wheelTakeSlot(ctx, level, idx, &list);
+    while (list) {
+        MultiTimer* timer = list;
+        wheelUnlink(ctx, timer);
+        wheelLink(ctx, timer);
+    }
+    return idx;
+}
+
+/* Lower bound of the next expiry: exact for level 0, the next cascade point for higher levels. */
+static uint64_t wheelNextExpiry(MultiTimerCtx* ctx) {
+    uint64_t next = UINT64_MAX;
+
+    if (ctx->expired) {
+        return 0;
+    }
+
+    for (unsigned level = 0; level < MULTITIMER_WHEEL_LEVELS; level++) {
+        if (!ctx->pending[level]) {
+            continue;
+        }
+        uint64_t base = ctx->wheelTime >> WHEEL_SHIFT(level);
+        uint64_t candidate;
+        if (level == 0) {
+            unsigned start = (unsigned)(base & WHEEL_MASK);
+            candidate = ctx->wheelTime + lowestBit(rotateSlots(ctx->pending[0], start));
+        } else {
+            // The current slot of a higher level is one full rotation away
+            unsigned start = (unsigned)((base + 1) & WHEEL_MASK);
+            uint64_t steps = lowestBit(rotateSlots(ctx->pending[level], start)) + 1;
+            candidate = (base + steps) << WHEEL_SHIFT(level);
+        }
+        if (candidate < next) {
+            next = candidate;
+        }
+    }
+    return next;
+}
+
+/* Run every timer of a detached list. Callbacks may stop or restart any timer, including ones still in the list. */
+static void wheelRun(MultiTimerCtx* ctx, MultiTimer** list) {
+    while (*list) {
+        MultiTimer* timer = *list;
+        wheelUnlink(ctx, timer); // Remove expired timer
+        if (timer->period) {
+            timer->deadline += timer->period; // Drift-free: next deadline follows the previous one
+        }
+
+        if (timer->callback) {
+            timer->callback(timer, timer->userData); // Execute callback
+            ctx->expirations++;
+        }
+
+        // Re-arm unless the callback stopped or restarted the timer
+        if (timer->period && timer->pprev == NULL) {
+            wheelLink(ctx, timer);
+        }
     }
-    platformTicksFunction = ticksFunc;
-    return 0;
 }
 
-static void removeTimer(MultiTimer* timer) {
-    MultiTimer** current = &timerList;
-    while (*current) {
-        if (*current == timer) {
-            *current = timer->next;
+static void wheelExpire(MultiTimerCtx* ctx, uint64_t currentTicks) {
+    MultiTimer* list;
+
+    // Overdue timers first; ones that become overdue from here on wait for the next yield
+    listMove(&ctx->expired, &list);
+    wheelRun(ctx, &list);
+
+    while (ctx->wheelTime <= currentTicks) {
+        if (ctx->count == 0) {
+            ctx->wheelTime = currentTicks + 1;
             break;
         }
-        current = &(*current)->next;
+
+        uint64_t tick = ctx->wheelTime;
+        unsigned idx = (unsigned)(tick & WHEEL_MASK);
+        if (idx == 0) {
+            for (unsigned level = 1; level < MULTITIMER_WHEEL_LEVELS && wheelCascade(ctx, level) == 0; level++) {
+            }
+        }
+
+        wheelTakeSlot(ctx, 0, idx, &list);
+
+        // Advance first so timers re-armed by callbacks land on a later tick
+        ctx->wheelTime = tick + 1;
+
+        wheelRun(ctx, &list);
+
+        // Skip empty level-0 slots up to the next occupied slot or wrap point
+        if (ctx->wheelTime <= currentTicks) {
+            idx = (unsigned)(ctx->wheelTime & WHEEL_MASK);
+            if (idx != 0) {
+                uint64_t bits = ctx->pending[0] >> idx;
+                uint64_t next = ctx->wheelTime + (bits ? lowestBit(bits) : (WHEEL_SLOTS - idx));
+                ctx->wheelTime = (next > currentTicks) ? currentTicks + 1 : next;
+            }
+        }
     }
 }
 
-int multiTimerStart(MultiTimer* timer, uint64_t timing, MultiTimerCallback_t callback, void* userData) {
-    if (!timer || !callback || platformTicksFunction == NULL) {
+static void removeTimer(MultiTimerCtx* ctx, MultiTimer* timer) {
+    if (timer->pprev) {
+        wheelUnlink(ctx, timer);
+    }
+}
+
+static void linkTimer(MultiTimerCtx* ctx, MultiTimer* timer, uint64_t currentTicks) {
+    // Nothing is pending: catch the wheel up so it does not walk idle ticks later
+    if (ctx->count == 0 && ctx->wheelTime < currentTicks) {
+        ctx->wheelTime = currentTicks;
+    }
+    wheelLink(ctx, timer);
+}
+
+static int startTimer(MultiTimerCtx* ctx, MultiTimer* timer, uint64_t timing, uint64_t period, MultiTimerCallback_t callback, void* userData) {
+    if (!ctx || !timer || !callback || ctx->ticksFunc == NULL) {
         return -1; // Return error if any parameter is invalid
     }
 
-    removeTimer(timer); // Centralize removal logic
+    removeTimer(ctx, timer); // Centralize removal logic
 
-    timer->deadline = platformTicksFunction() + timing;
+    uint64_t currentTicks = ctx->ticksFunc();
+
+    timer->deadline = currentTicks + timing;
+    timer->period = period;
     timer->callback = callback;
     timer->userData = userData;
 
-    MultiTimer** current = &timerList;
-    while (*current && ((*current)->deadline < timer->deadline)) {
-        current = &(*current)->next;
+    linkTimer(ctx, timer, currentTicks);
+
+    return 0;
+}
+
+/* Claim a queue slot, fill it and publish it; safe from any interrupt priority. */
+static int queuePost(MultiTimerCtx* ctx, uint8_t op, MultiTimer* timer, uint64_t timing, uint64_t period,
+                     MultiTimerCallback_t callback, void* userData) {
+    if (!ctx || !timer || ctx->ticksFunc == NULL || (op == REQUEST_START && !callback)) {
+        return -1;
+    }
+
+    uint32_t pos = ATOMIC_LOAD_RELAXED(&ctx->queueTail);
+    for (;;) {
+        MultiTimerRequest* req = &ctx->queue[pos & QUEUE_MASK];
+        int32_t diff = (int32_t)(ATOMIC_LOAD_ACQUIRE(&req->sequence) - pos);
+
+        if (diff == 0) {
+            if (atomicClaim(&ctx->queueTail, pos)) {
+                req->op = op;
+                req->timer = timer;
+                req->deadline = ctx->ticksFunc() + timing; // Deadline counts from the interrupt, not the drain
+                req->period = period;
+                req->callback = callback;
+                req->userData = userData;
+                ATOMIC_STORE_RELEASE(&req->sequence, pos + 1);
+                return 0;
+            }
+        } else if (diff < 0) {
+            return -1; // Queue full: the yield has not drained older requests yet
+        }
+        pos = ATOMIC_LOAD_RELAXED(&ctx->queueTail);
+    }
+}
+
+/* Apply published requests in order; stops at a slot that is claimed but not yet published. */
+static void queueDrain(MultiTimerCtx* ctx, uint64_t currentTicks) {
+    for (;;) {
+        MultiTimerRequest* req = &ctx->queue[ctx->queueHead & QUEUE_MASK];
+        if (ATOMIC_LOAD_ACQUIRE(&req->sequence) != ctx->queueHead + 1) {
+            break;
+        }
+
+        MultiTimer* timer = req->timer;
+        uint8_t op = req->op;
+        uint64_t deadline = req->deadline;
+        uint64_t period = req->period;
+        MultiTimerCallback_t callback = req->callback;
+        void* userData = req->userData;
+
+        ATOMIC_STORE_RELEASE(&req->sequence, ctx->queueHead + MULTITIMER_ISR_QUEUE_SIZE);
+        ctx->queueHead++;
+
+        removeTimer(ctx, timer);
+        if (op == REQUEST_START) {
+            timer->deadline = deadline;
+            timer->period = period;
+            timer->callback = callback;
+            timer->userData = userData;
+            linkTimer(ctx, timer, currentTicks);
+        } else {
+            timer->period = 0;
+        }
+    }
+}
+
+int multiTimerCtxInit(MultiTimerCtx* ctx, PlatformTicksFunction_t ticksFunc) {
+    if (!ctx || ticksFunc == NULL) {
+        return -1;
+    }
+
+    memset(ctx->slots, 0, sizeof(ctx->slots));
+    memset(ctx->pending, 0, sizeof(ctx->pending));
+    ctx->expired = NULL;
+    ctx->count = 0;
+    ctx->ticksFunc = ticksFunc;
+    ctx->wheelTime = ticksFunc();
+
+    for (uint32_t i = 0; i < MULTITIMER_ISR_QUEUE_SIZE; i++) {
+        ATOMIC_STORE_RELEASE(&ctx->queue[i].sequence, i);
     }
-    timer->next = *current;
-    *current = timer;
+    ctx->queueHead = 0;
+    ATOMIC_STORE_RELEASE(&ctx->queueTail, 0);
+
+    multiTimerCtxResetStats(ctx);
 
     return 0;
 }
 
-int multiTimerStop(MultiTimer* timer) {
-    removeTimer(timer); // Use centralized removal function
+int multiTimerCtxStart(MultiTimerCtx* ctx, MultiTimer* timer, uint64_t timing, MultiTimerCallback_t callback, void* userData) {
+    return startTimer(ctx, timer, timing, 0, callback, userData);
+}
+
+int multiTimerCtxStartPeriodic(MultiTimerCtx* ctx, MultiTimer* timer, uint64_t period, MultiTimerCallback_t callback, void* userData) {
+    if (period == 0) {
+        return -1;
+    }
+    return startTimer(ctx, timer, period, period, callback, userData);
+}
+
+int multiTimerCtxStop(MultiTimerCtx* ctx, MultiTimer* timer) {
+    if (!ctx || !timer) {
+        return -1;
+    }
+    removeTimer(ctx, timer); // Use centralized removal function
+    timer->period = 0;
     return 0;
 }
 
-int multiTimerYield(void) {
-    if (platformTicksFunction == NULL) {
-        return -1; // Indicate error if platformTicksFunction is NULL
+int multiTimerCtxStartFromISR(MultiTimerCtx* ctx, MultiTimer* timer, uint64_t timing, MultiTimerCallback_t callback, void* userData) {
+    return queuePost(ctx, REQUEST_START, timer, timing, 0, callback, userData);
+}
+
+int multiTimerCtxStartPeriodicFromISR(MultiTimerCtx* ctx, MultiTimer* timer, uint64_t period, MultiTimerCallback_t callback, void* userData) {
+    if (period == 0) {
+        return -1;
     }
-    uint64_t currentTicks = platformTicksFunction();
-    while (timerList && (currentTicks >= timerList->deadline)) {
-        MultiTimer* timer = timerList;
-        timerList = timer->next; // Remove expired timer
+    return queuePost(ctx, REQUEST_START, timer, period, period, callback, userData);
+}
 
-        if (timer->callback) {
-            timer->callback(timer, timer->userData); // Execute callback
-        }
+int multiTimerCtxStopFromISR(MultiTimerCtx* ctx, MultiTimer* timer) {
+    return queuePost(ctx, REQUEST_STOP, timer, 0, 0, NULL, NULL);
+}
+
+int multiTimerCtxYield(MultiTimerCtx* ctx) {
+    if (!ctx || ctx->ticksFunc == NULL) {
+        return -1; // Indicate error if the context has no ticks function
+    }
+    uint64_t currentTicks = ctx->ticksFunc();
+
+    uint32_t expirations = ctx->expirations;
+
+    queueDrain(ctx, currentTicks);
+    wheelExpire(ctx, currentTicks);
+
+    if (ctx->expirations != expirations) {
+        ctx->wakeups++;
+    }
+
+    if (ctx->count == 0) {
+        return 0;
+    }
+    uint64_t next = wheelNextExpiry(ctx);
+    if (next <= currentTicks) {
+        return 0;
+    }
+    return (next - currentTicks > INT_MAX) ? INT_MAX : (int)(next - currentTicks);
+}
+
+int multiTimerCtxGetStats(MultiTimerCtx* ctx, MultiTimerStats* stats) {
+    if (!ctx || !stats || ctx->ticksFunc == NULL) {
+        return -1;
+    }
+    stats->wakeups = ctx->wakeups;
+    stats->expirations = ctx->expirations;
+    stats->ticks = ctx->ticksFunc() - ctx->statsStart;
+    return 0;
+}
+
+void multiTimerCtxResetStats(MultiTimerCtx* ctx) {
+    if (!ctx || ctx->ticksFunc == NULL) {
+        return;
+    }
+    ctx->wakeups = 0;
+    ctx->expirations = 0;
+    ctx->statsStart = ctx->ticksFunc();
+}
+
+int multiTimerInit(MultiTimer* timer) {
+    if (!timer) {
+        return -1;
+    }
+    memset(timer, 0, sizeof(*timer)); // pprev == NULL marks the handle as not linked
+    return 0;
+}
+
+int multiTimerSetSlack(MultiTimer* timer, uint32_t slack) {
+    if (!timer) {
+        return -1;
+    }
+    timer->slack = slack;
+    return 0;
+}
+
+int multiTimerInstall(PlatformTicksFunction_t ticksFunc) {
+    if (ticksFunc == NULL) {
+        return -1; // Indicate error if ticksFunc is NULL
     }
-    return timerList ? (int)(timerList->deadline - currentTicks) : 0;
+    if (defaultCtx.ticksFunc == NULL) {
+        return multiTimerCtxInit(&defaultCtx, ticksFunc);
+    }
+    defaultCtx.ticksFunc = ticksFunc;
+    return 0;
+}
+
+int multiTimerStart(MultiTimer* timer, uint64_t timing, MultiTimerCallback_t callback, void* userData) {
+    return multiTimerCtxStart(&defaultCtx, timer, timing, callback, userData);
+}
+
+int multiTimerStartPeriodic(MultiTimer* timer, uint64_t period, MultiTimerCallback_t callback, void* userData) {
+    return multiTimerCtxStartPeriodic(&defaultCtx, timer, period, callback, userData);
+}
+
+int multiTimerStop(MultiTimer* timer) {
+    return multiTimerCtxStop(&defaultCtx, timer);
+}
+
+int multiTimerStartFromISR(MultiTimer* timer, uint64_t timing, MultiTimerCallback_t callback, void* userData) {
+    return multiTimerCtxStartFromISR(&defaultCtx, timer, timing, callback, userData);
+}
+
+int multiTimerStopFromISR(MultiTimer* timer) {
+    return multiTimerCtxStopFromISR(&defaultCtx, timer);
+}
+
+int multiTimerYield(void) {
+    return multiTimerCtxYield(&defaultCtx);
+}
+
+int multiTimerGetStats(MultiTimerStats* stats) {
+    return multiTimerCtxGetStats(&defaultCtx, stats);
+}
+
+void multiTimerResetStats(void) {
+    multiTimerCtxResetStats(&defaultCtx);
 }
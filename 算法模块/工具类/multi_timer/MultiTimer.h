@@ -25,23 +25,210 @@
 
 #include <stdint.h>
 
+/* The ISR request queue uses C11 atomics when available. Without them (ARMCC5,
+ * C99) the claim falls back to LDREX/STREX, a PRIMASK critical section on
+ * Cortex-M or the GCC __sync builtins; define MULTITIMER_ENTER_CRITICAL() and
+ * MULTITIMER_EXIT_CRITICAL(state) to supply your own critical section. */
+#if !defined(MULTITIMER_NO_C11_ATOMICS) && \
+    (!defined(__STDC_VERSION__) || __STDC_VERSION__ < 201112L || defined(__STDC_NO_ATOMICS__))
+#define MULTITIMER_NO_C11_ATOMICS
+#endif
+
+#ifndef MULTITIMER_NO_C11_ATOMICS
+#include <stdatomic.h>
+#endif
+
 #ifdef __cplusplus  
 extern "C" {  
 #endif
 
+/* Timing wheel geometry: 2^MULTITIMER_WHEEL_BITS slots per level (at most 64). */
+#ifndef MULTITIMER_WHEEL_BITS
+#define MULTITIMER_WHEEL_BITS 6
+#endif
+
+/* Number of wheel levels (at least 2). Default 6 x 4 covers 2^24 ticks (about 4.6 hours at 1 kHz);
+ * longer timeouts are parked in the top level and re-cascaded until due. */
+#ifndef MULTITIMER_WHEEL_LEVELS
+#define MULTITIMER_WHEEL_LEVELS 4
+#endif
+
+/* Depth of the per-context ISR request queue, must be a power of two. */
+#ifndef MULTITIMER_ISR_QUEUE_SIZE
+#define MULTITIMER_ISR_QUEUE_SIZE 16
+#endif
+
+#ifndef MULTITIMER_NO_C11_ATOMICS
+typedef _Atomic uint32_t MultiTimerAtomic_t;
+#else
+typedef volatile uint32_t MultiTimerAtomic_t;
+#endif
+
 typedef uint64_t (*PlatformTicksFunction_t)(void);
 
 typedef struct MultiTimerHandle MultiTimer;
 
 typedef void (*MultiTimerCallback_t)(MultiTimer* timer, void* userData);
 
+/* Handles must be initialized with multiTimerInit() (or live in zeroed static storage) before the first start. */
 struct MultiTimerHandle {
     MultiTimer* next;
+    MultiTimer** pprev;     /* Link that points at this handle, NULL when not running. */
     uint64_t deadline;
+    uint64_t period;        /* Re-arm interval of a periodic timer, 0 for one-shot. */
+    uint32_t slack;         /* Allowed lateness in ticks, used to batch expiries. */
     MultiTimerCallback_t callback;
     void* userData;
 };
 
+/* A start or stop posted from an interrupt, applied by the next yield. */
+typedef struct {
+    MultiTimerAtomic_t sequence;    /* Slot state for the bounded MPSC queue. */
+    uint8_t op;
+    MultiTimer* timer;
+    uint64_t deadline;
+    uint64_t period;
+    MultiTimerCallback_t callback;
+    void* userData;
+} MultiTimerRequest;
+
+/* Wakeup accounting of a context since init or the last reset. */
+typedef struct {
+    uint32_t wakeups;       /* Yields that ran at least one callback. */
+    uint32_t expirations;   /* Callbacks run. */
+    uint64_t ticks;         /* Length of the window in ticks. */
+} MultiTimerStats;
+
+/*
+ * Timer domain: one timing wheel with its own tick source. Each subsystem
+ * may own a context; a handle must only ever be used with one context.
+ */
+typedef struct {
+    MultiTimer* slots[MULTITIMER_WHEEL_LEVELS][1u << MULTITIMER_WHEEL_BITS];
+    MultiTimer* expired;                        /* Overdue timers, run on the next yield. */
+    uint64_t pending[MULTITIMER_WHEEL_LEVELS];  /* Bit i set: slot i is non-empty. */
+    uint64_t wheelTime;                         /* Next tick to be processed. */
+    uint32_t count;                             /* Number of running timers. */
+    PlatformTicksFunction_t ticksFunc;
+    MultiTimerRequest queue[MULTITIMER_ISR_QUEUE_SIZE];
+    MultiTimerAtomic_t queueTail;               /* Next slot claimed by a producer. */
+    uint32_t queueHead;                         /* Next slot drained by the yield. */
+    uint32_t wakeups;
+    uint32_t expirations;
+    uint64_t statsStart;                        /* Tick at which the stats window began. */
+} MultiTimerCtx;
+
+/**
+ * @brief Initialize a timer context, discarding every timer it held.
+ * 
+ * @param ctx context to initialize.
+ * @param ticksFunc ticks function of this domain.
+ * @return int 0 on success, -1 on error.
+ */
+int multiTimerCtxInit(MultiTimerCtx* ctx, PlatformTicksFunction_t ticksFunc);
+
+/**
+ * @brief Start a one-shot timer in a context; restarts it if already running.
+ * 
+ * @param ctx owning context.
+ * @param timer target handle strcut.
+ * @param timing ticks from now until expiry.
+ * @param callback deadline callback.
+ * @param userData user data.
+ * @return int 0: success, -1: fail.
+ */
+int multiTimerCtxStart(MultiTimerCtx* ctx, MultiTimer* timer, uint64_t timing, MultiTimerCallback_t callback, void* userData);
+
+/**
+ * @brief Start a periodic timer in a context, see multiTimerStartPeriodic().
+ * 
+ * @return int 0: success, -1: fail.
+ */
+int multiTimerCtxStartPeriodic(MultiTimerCtx* ctx, MultiTimer* timer, uint64_t period, MultiTimerCallback_t callback, void* userData);
+
+/**
+ * @brief Stop a timer in a context.
+ * 
+ * @return int 0: success, -1: fail.
+ */
+int multiTimerCtxStop(MultiTimerCtx* ctx, MultiTimer* timer);
+
+/**
+ * @brief Apply queued ISR requests, then run every expired timer of a context.
+ * 
+ * @param ctx target context.
+ * @return int Ticks until the next expiry, 0 if none is pending, -1 on error.
+ */
+int multiTimerCtxYield(MultiTimerCtx* ctx);
+
+/**
+ * @brief Post a one-shot start from an interrupt. Lock-free and safe against
+ *        nested interrupts; the deadline is taken now and the timer is linked
+ *        by the next yield of the context.
+ * 
+ * @return int 0: success, -1: invalid argument or queue full.
+ */
+int multiTimerCtxStartFromISR(MultiTimerCtx* ctx, MultiTimer* timer, uint64_t timing, MultiTimerCallback_t callback, void* userData);
+
+/**
+ * @brief Post a periodic start from an interrupt.
+ * 
+ * @return int 0: success, -1: invalid argument or queue full.
+ */
+int multiTimerCtxStartPeriodicFromISR(MultiTimerCtx* ctx, MultiTimer* timer, uint64_t period, MultiTimerCallback_t callback, void* userData);
+
+/**
+ * @brief Post a stop from an interrupt.
+ * 
+ * @return int 0: success, -1: invalid argument or queue full.
+ */
+int multiTimerCtxStopFromISR(MultiTimerCtx* ctx, MultiTimer* timer);
+
+/**
+ * @brief Read the wakeup statistics of a context.
+ * 
+ * @param ctx target context.
+ * @param stats receives wakeups, expirations and the window length.
+ * @return int 0: success, -1: fail.
+ */
+int multiTimerCtxGetStats(MultiTimerCtx* ctx, MultiTimerStats* stats);
+
+/**
+ * @brief Clear the wakeup statistics and start a new window.
+ * 
+ * @param ctx target context.
+ */
+void multiTimerCtxResetStats(MultiTimerCtx* ctx);
+
+/**
+ * @brief Initialize a timer handle as stopped with no slack. Every handle that
+ *        is not in zeroed static storage (stack, malloc, reused memory) must be
+ *        initialized before its first start; never call it on a running timer.
+ * 
+ * @param timer target handle strcut.
+ * @return int 0: success, -1: fail.
+ */
+int multiTimerInit(MultiTimer* timer);
+
+/**
+ * @brief Let a timer fire up to 'slack' ticks late. The expiry is moved to the
+ *        most aligned tick inside [deadline, deadline + slack], so timers with
+ *        overlapping windows usually land on the same tick and run in one
+ *        dispatch (not always: [63,65] picks 64 while [65,70] picks 68).
+ *        The deadline itself is unchanged and periodic timers keep their phase.
+ *        Takes effect from the next start; the setting survives restarts.
+ * 
+ * @param timer target handle strcut.
+ * @param slack allowed lateness in ticks, 0 for exact expiry (default).
+ * @return int 0: success, -1: fail.
+ */
+int multiTimerSetSlack(MultiTimer* timer, uint32_t slack);
+
+/*
+ * The functions below operate on a built-in default context and keep the
+ * original single-domain API.
+ */
+
 /**
  * @brief Platform ticks function.
  * 
@@ -61,6 +248,19 @@ int multiTimerInstall(PlatformTicksFunction_t ticksFunc);
  */
 int multiTimerStart(MultiTimer* timer, uint64_t timing, MultiTimerCallback_t callback, void* userData);
 
+/**
+ * @brief Start a periodic timer. The first expiry is one period from now and
+ *        every later deadline is the previous deadline plus the period, so a
+ *        late yield does not shift the phase.
+ * 
+ * @param timer target handle strcut.
+ * @param period re-arm interval in ticks, must be non-zero.
+ * @param callback deadline callback, may stop or restart the timer.
+ * @param userData user data.
+ * @return int 0: success, -1: fail.
+ */
+int multiTimerStartPeriodic(MultiTimer* timer, uint64_t period, MultiTimerCallback_t callback, void* userData);
+
 /**
  * @brief Stop the timer work, remove the handle off work list.
  * 
@@ -69,6 +269,32 @@ int multiTimerStart(MultiTimer* timer, uint64_t timing, MultiTimerCallback_t cal
  */
 int multiTimerStop(MultiTimer* timer);
 
+/**
+ * @brief Post a one-shot start to the default context from an interrupt.
+ * 
+ * @return int 0: success, -1: invalid argument or queue full.
+ */
+int multiTimerStartFromISR(MultiTimer* timer, uint64_t timing, MultiTimerCallback_t callback, void* userData);
+
+/**
+ * @brief Post a stop to the default context from an interrupt.
+ * 
+ * @return int 0: success, -1: invalid argument or queue full.
+ */
+int multiTimerStopFromISR(MultiTimer* timer);
+
+/**
+ * @brief Read the wakeup statistics of the default context.
+ * 
+ * @return int 0: success, -1: fail.
+ */
+int multiTimerGetStats(MultiTimerStats* stats);
+
+/**
+ * @brief Clear the wakeup statistics of the default context.
+ */
+void multiTimerResetStats(void);
+
 /**
  * @brief Check the timer expried and call callback.
  * 
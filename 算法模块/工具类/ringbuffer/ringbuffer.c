@@ -14,6 +14,286 @@
 
 #include "ringbuffer.h"
 
+#ifdef RB_USING_WIDE_INDEX
+
+/* ============== 宽索引实现：32 位自由运行索引 + 2 的幂掩码 ============== */
+
+#define RB_WIDE_LEN(rb)     ((rb_uint32_t)((rb)->write_index - (rb)->read_index))
+
+enum rb_ringbuffer_state rb_ringbuffer_status(struct rb_ringbuffer *rb)
+{
+    rb_uint32_t len = RB_WIDE_LEN(rb);
+
+    if (len == 0)
+        return RB_RINGBUFFER_EMPTY;
+    if (len == rb->buffer_size)
+        return RB_RINGBUFFER_FULL;
+    return RB_RINGBUFFER_HALFFULL;
+}
+
+void rb_ringbuffer_init(struct rb_ringbuffer *rb, rb_uint8_t *pool, rb_bufsize_t size)
+{
+    RB_ASSERT(rb != RB_NULL);
+    RB_ASSERT(size > 0 && (size & (size - 1)) == 0 && size <= 0x80000000u);
+
+    rb->read_index = 0;
+    rb->write_index = 0;
+
+    rb->buffer_ptr = pool;
+    rb->buffer_size = size;
+    rb->buffer_mask = size - 1;
+}
+
+/* 从 index 处写入 length 字节，自动处理回绕 */
+static void rb_wide_copy_in(struct rb_ringbuffer *rb, rb_uint32_t index, const rb_uint8_t *ptr, rb_uint32_t length)
+{
+    rb_uint32_t offset = index & rb->buffer_mask;
+    rb_uint32_t first = rb->buffer_size - offset;
+
+    if (first >= length)
+    {
+        rb_memcpy(&rb->buffer_ptr[offset], ptr, length);
+        return;
+    }
+
+    rb_memcpy(&rb->buffer_ptr[offset], &ptr[0], first);
+    rb_memcpy(&rb->buffer_ptr[0], &ptr[first], length - first);
+}
+
+rb_size_t rb_ringbuffer_put(struct rb_ringbuffer *rb, const rb_uint8_t *ptr, rb_length_t length)
+{
+    rb_uint32_t size;
+
+    RB_ASSERT(rb != RB_NULL);
+
+    size = rb->buffer_size - RB_WIDE_LEN(rb);
+
+    if (size < length)
+        length = size;
+
+    rb_wide_copy_in(rb, rb->write_index, ptr, length);
+    rb->write_index += length;
+
+    return length;
+}
+
+rb_size_t rb_ringbuffer_put_force(struct rb_ringbuffer *rb, const rb_uint8_t *ptr, rb_length_t length)
+{
+    RB_ASSERT(rb != RB_NULL);
+
+    if (length > rb->buffer_size)
+    {
+        ptr = &ptr[length - rb->buffer_size];
+        length = rb->buffer_size;
+    }
+
+    rb_wide_copy_in(rb, rb->write_index, ptr, length);
+    rb->write_index += length;
+
+    /* 覆盖了最旧的数据，读索引跟进 */
+    if (RB_WIDE_LEN(rb) > rb->buffer_size)
+        rb->read_index = rb->write_index - rb->buffer_size;
+
+    return length;
+}
+
+rb_size_t rb_ringbuffer_get(struct rb_ringbuffer *rb, rb_uint8_t *ptr, rb_length_t length)
+{
+    rb_uint32_t size, offset, first;
+
+    RB_ASSERT(rb != RB_NULL);
+
+    size = RB_WIDE_LEN(rb);
+
+    if (size < length)
+        length = size;
+
+    offset = rb->read_index & rb->buffer_mask;
+    first = rb->buffer_size - offset;
+
+    if (first >= length)
+    {
+        rb_memcpy(ptr, &rb->buffer_ptr[offset], length);
+    }
+    else
+    {
+        rb_memcpy(&ptr[0], &rb->buffer_ptr[offset], first);
+        rb_memcpy(&ptr[first], &rb->buffer_ptr[0], length - first);
+    }
+
+    rb->read_index += length;
+
+    return length;
+}
+
+rb_size_t rb_ringbuffer_peek(struct rb_ringbuffer *rb, rb_uint8_t **ptr)
+{
+    rb_uint32_t size, offset;
+
+    RB_ASSERT(rb != RB_NULL);
+
+    *ptr = RB_NULL;
+
+    size = RB_WIDE_LEN(rb);
+
+    if (size == 0)
+        return 0;
+
+    offset = rb->read_index & rb->buffer_mask;
+    *ptr = &rb->buffer_ptr[offset];
+
+    if (size > rb->buffer_size - offset)
+        size = rb->buffer_size - offset;
+
+    rb->read_index += size;
+
+    return size;
+}
+
+rb_size_t rb_ringbuffer_peek_spans(struct rb_ringbuffer *rb,
+                                   rb_uint8_t **ptr0, rb_size_t *len0,
+                                   rb_uint8_t **ptr1, rb_size_t *len1)
+{
+    rb_uint32_t size, offset, first;
+
+    RB_ASSERT(rb != RB_NULL);
+
+    *ptr0 = RB_NULL;
+    *len0 = 0;
+    *ptr1 = RB_NULL;
+    *len1 = 0;
+
+    size = RB_WIDE_LEN(rb);
+
+    if (size == 0)
+        return 0;
+
+    offset = rb->read_index & rb->buffer_mask;
+    first = rb->buffer_size - offset;
+
+    *ptr0 = &rb->buffer_ptr[offset];
+
+    if (first >= size)
+    {
+        *len0 = size;
+        return size;
+    }
+
+    *len0 = first;
+    *ptr1 = &rb->buffer_ptr[0];
+    *len1 = size - first;
+
+    return size;
+}
+
+rb_size_t rb_ringbuffer_consume(struct rb_ringbuffer *rb, rb_size_t length)
+{
+    rb_uint32_t size;
+
+    RB_ASSERT(rb != RB_NULL);
+
+    size = RB_WIDE_LEN(rb);
+
+    if (size < length)
+        length = size;
+
+    rb->read_index += (rb_uint32_t)length;
+
+    return length;
+}
+
+rb_size_t rb_ringbuffer_reserve(struct rb_ringbuffer *rb, rb_uint8_t **ptr)
+{
+    rb_uint32_t size, offset;
+
+    RB_ASSERT(rb != RB_NULL);
+
+    *ptr = RB_NULL;
+
+    size = rb->buffer_size - RB_WIDE_LEN(rb);
+
+    if (size == 0)
+        return 0;
+
+    offset = rb->write_index & rb->buffer_mask;
+    *ptr = &rb->buffer_ptr[offset];
+
+    return (size < rb->buffer_size - offset) ? size : rb->buffer_size - offset;
+}
+
+rb_size_t rb_ringbuffer_commit(struct rb_ringbuffer *rb, rb_size_t length)
+{
+    rb_uint32_t size;
+
+    RB_ASSERT(rb != RB_NULL);
+
+    size = rb->buffer_size - RB_WIDE_LEN(rb);
+
+    if (size < length)
+        length = size;
+
+    /* 预留区域是连续的，最多恰好写到缓冲区末尾 */
+    RB_ASSERT(rb->buffer_size - (rb->write_index & rb->buffer_mask) >= length);
+
+    rb->write_index += (rb_uint32_t)length;
+
+    return length;
+}
+
+rb_size_t rb_ringbuffer_putchar(struct rb_ringbuffer *rb, const rb_uint8_t ch)
+{
+    RB_ASSERT(rb != RB_NULL);
+
+    if (RB_WIDE_LEN(rb) == rb->buffer_size)
+        return 0;
+
+    rb->buffer_ptr[rb->write_index & rb->buffer_mask] = ch;
+    rb->write_index++;
+
+    return 1;
+}
+
+rb_size_t rb_ringbuffer_putchar_force(struct rb_ringbuffer *rb, const rb_uint8_t ch)
+{
+    RB_ASSERT(rb != RB_NULL);
+
+    if (RB_WIDE_LEN(rb) == rb->buffer_size)
+        rb->read_index++;
+
+    rb->buffer_ptr[rb->write_index & rb->buffer_mask] = ch;
+    rb->write_index++;
+
+    return 1;
+}
+
+rb_size_t rb_ringbuffer_getchar(struct rb_ringbuffer *rb, rb_uint8_t *ch)
+{
+    RB_ASSERT(rb != RB_NULL);
+
+    if (rb->write_index == rb->read_index)
+        return 0;
+
+    *ch = rb->buffer_ptr[rb->read_index & rb->buffer_mask];
+    rb->read_index++;
+
+    return 1;
+}
+
+rb_size_t rb_ringbuffer_data_len(struct rb_ringbuffer *rb)
+{
+    return RB_WIDE_LEN(rb);
+}
+
+void rb_ringbuffer_reset(struct rb_ringbuffer *rb)
+{
+    RB_ASSERT(rb != RB_NULL);
+
+    rb->read_index = 0;
+    rb->write_index = 0;
+}
+
+#else /* RB_USING_WIDE_INDEX */
+
 enum rb_ringbuffer_state rb_ringbuffer_status(struct rb_ringbuffer *rb)
 {
     if (rb->read_index == rb->write_index)
@@ -26,7 +306,7 @@ enum rb_ringbuffer_state rb_ringbuffer_status(struct rb_ringbuffer *rb)
     return RB_RINGBUFFER_HALFFULL;
 }
 
-void rb_ringbuffer_init(struct rb_ringbuffer *rb, rb_uint8_t *pool, rb_int16_t size)
+void rb_ringbuffer_init(struct rb_ringbuffer *rb, rb_uint8_t *pool, rb_bufsize_t size)
 {
     RB_ASSERT(rb != RB_NULL);
     RB_ASSERT(size > 0);
@@ -38,7 +318,7 @@ void rb_ringbuffer_init(struct rb_ringbuffer *rb, rb_uint8_t *pool, rb_int16_t s
     rb->buffer_size = RB_ALIGN_DOWN(size, 4);
 }
 
-rb_size_t rb_ringbuffer_put(struct rb_ringbuffer *rb, const rb_uint8_t *ptr, rb_uint16_t length)
+rb_size_t rb_ringbuffer_put(struct rb_ringbuffer *rb, const rb_uint8_t *ptr, rb_length_t length)
 {
     rb_uint16_t size;
 
@@ -69,7 +349,7 @@ rb_size_t rb_ringbuffer_put(struct rb_ringbuffer *rb, const rb_uint8_t *ptr, rb_
     return length;
 }
 
-rb_size_t rb_ringbuffer_put_force(struct rb_ringbuffer *rb, const rb_uint8_t *ptr, rb_uint16_t length)
+rb_size_t rb_ringbuffer_put_force(struct rb_ringbuffer *rb, const rb_uint8_t *ptr, rb_length_t length)
 {
     rb_uint16_t space_length;
 
@@ -111,7 +391,7 @@ rb_size_t rb_ringbuffer_put_force(struct rb_ringbuffer *rb, const rb_uint8_t *pt
     return length;
 }
 
-rb_size_t rb_ringbuffer_get(struct rb_ringbuffer *rb, rb_uint8_t *ptr, rb_uint16_t length)
+rb_size_t rb_ringbuffer_get(struct rb_ringbuffer *rb, rb_uint8_t *ptr, rb_length_t length)
 {
     rb_size_t size;
 
@@ -171,6 +451,115 @@ rb_size_t rb_ringbuffer_peek(struct rb_ringbuffer *rb, rb_uint8_t **ptr)
     return size;
 }
 
+rb_size_t rb_ringbuffer_peek_spans(struct rb_ringbuffer *rb,
+                                   rb_uint8_t **ptr0, rb_size_t *len0,
+                                   rb_uint8_t **ptr1, rb_size_t *len1)
+{
+    rb_size_t size, first;
+
+    RB_ASSERT(rb != RB_NULL);
+
+    *ptr0 = RB_NULL;
+    *len0 = 0;
+    *ptr1 = RB_NULL;
+    *len1 = 0;
+
+    size = rb_ringbuffer_data_len(rb);
+
+    if (size == 0)
+        return 0;
+
+    *ptr0 = &rb->buffer_ptr[rb->read_index];
+
+    first = rb->buffer_size - rb->read_index;
+    if (first >= size)
+    {
+        *len0 = size;
+        return size;
+    }
+
+    *len0 = first;
+    *ptr1 = &rb->buffer_ptr[0];
+    *len1 = size - first;
+
+    return size;
+}
+
+rb_size_t rb_ringbuffer_consume(struct rb_ringbuffer *rb, rb_size_t length)
+{
+    rb_size_t size;
+
+    RB_ASSERT(rb != RB_NULL);
+
+    size = rb_ringbuffer_data_len(rb);
+
+    if (size < length)
+        length = size;
+
+    if (length == 0)
+        return 0;
+
+    if ((rb_size_t)(rb->buffer_size - rb->read_index) > length)
+    {
+        rb->read_index += length;
+        return length;
+    }
+
+    rb->read_mirror = ~rb->read_mirror;
+    rb->read_index = length - (rb->buffer_size - rb->read_index);
+
+    return length;
+}
+
+rb_size_t rb_ringbuffer_reserve(struct rb_ringbuffer *rb, rb_uint8_t **ptr)
+{
+    rb_size_t size, first;
+
+    RB_ASSERT(rb != RB_NULL);
+
+    *ptr = RB_NULL;
+
+    size = rb_ringbuffer_space_len(rb);
+
+    if (size == 0)
+        return 0;
+
+    *ptr = &rb->buffer_ptr[rb->write_index];
+
+    first = rb->buffer_size - rb->write_index;
+
+    return (first < size) ? first : size;
+}
+
+rb_size_t rb_ringbuffer_commit(struct rb_ringbuffer *rb, rb_size_t length)
+{
+    rb_size_t size;
+
+    RB_ASSERT(rb != RB_NULL);
+
+    size = rb_ringbuffer_space_len(rb);
+
+    if (size < length)
+        length = size;
+
+    if (length == 0)
+        return 0;
+
+    /* 预留区域是连续的，最多恰好写到缓冲区末尾 */
+    RB_ASSERT((rb_size_t)(rb->buffer_size - rb->write_index) >= length);
+
+    if ((rb_size_t)(rb->buffer_size - rb->write_index) > length)
+    {
+        rb->write_index += length;
+        return length;
+    }
+
+    rb->write_mirror = ~rb->write_mirror;
+    rb->write_index = 0;
+
+    return length;
+}
+
 rb_size_t rb_ringbuffer_putchar(struct rb_ringbuffer *rb, const rb_uint8_t ch)
 {
     RB_ASSERT(rb != RB_NULL);
@@ -275,3 +664,5 @@ void rb_ringbuffer_reset(struct rb_ringbuffer *rb)
     rb->write_mirror = 0;
     rb->write_index = 0;
 }
+
+#endif /* RB_USING_WIDE_INDEX */
@@ -28,16 +28,42 @@ extern "C" {
 typedef uint8_t     rb_uint8_t;
 typedef uint16_t    rb_uint16_t;
 typedef int16_t     rb_int16_t;
+typedef uint32_t    rb_uint32_t;
 typedef size_t      rb_size_t;
 
+/*
+ * 宽索引配置：定义 RB_USING_WIDE_INDEX 后使用 32 位自由运行索引 + 2 的幂掩码，
+ * 去掉 32KB 容量上限，data_len/space_len 只需一次减法。
+ * 此时缓冲区大小必须为 2 的幂，不再做 4 字节对齐裁剪。
+ */
+#ifdef RB_USING_WIDE_INDEX
+typedef rb_uint32_t rb_bufsize_t;   /* 缓冲区大小 */
+typedef rb_uint32_t rb_length_t;    /* 读写长度 */
+#else
+typedef rb_int16_t  rb_bufsize_t;
+typedef rb_uint16_t rb_length_t;
+#endif
+
 /* 宏定义 */
 #define RB_ASSERT(x)    assert(x)
 #define RB_NULL         NULL
-#define rb_memcpy       memcpy
+#ifndef rb_memcpy
+#define rb_memcpy       memcpy      /* 可在编译选项中替换，如统计拷贝量 */
+#endif
 
 #define RB_ALIGN_DOWN(size, align)  ((size) & ~((align) - 1))
 
 /* 环形缓冲区结构体 */
+#ifdef RB_USING_WIDE_INDEX
+struct rb_ringbuffer
+{
+    rb_uint8_t *buffer_ptr;
+    rb_uint32_t read_index;     /* 自由运行，取模用 buffer_mask */
+    rb_uint32_t write_index;    /* 自由运行，write - read 即数据长度 */
+    rb_uint32_t buffer_size;
+    rb_uint32_t buffer_mask;
+};
+#else
 struct rb_ringbuffer
 {
     rb_uint8_t *buffer_ptr;
@@ -47,6 +73,7 @@ struct rb_ringbuffer
     rb_uint16_t write_index : 15;
     rb_int16_t buffer_size;
 };
+#endif
 
 /* 环形缓冲区状态枚举 */
 enum rb_ringbuffer_state
@@ -60,9 +87,9 @@ enum rb_ringbuffer_state
  * @brief 初始化环形缓冲区
  * @param rb 环形缓冲区指针
  * @param pool 缓冲区内存
- * @param size 缓冲区大小
+ * @param size 缓冲区大小（宽索引模式下必须为 2 的幂）
  */
-void rb_ringbuffer_init(struct rb_ringbuffer *rb, rb_uint8_t *pool, rb_int16_t size);
+void rb_ringbuffer_init(struct rb_ringbuffer *rb, rb_uint8_t *pool, rb_bufsize_t size);
 
 /**
  * @brief 重置环形缓冲区
@@ -84,7 +111,7 @@ enum rb_ringbuffer_state rb_ringbuffer_status(struct rb_ringbuffer *rb);
  * @param length 数据长度
  * @return 实际写入的字节数
  */
-rb_size_t rb_ringbuffer_put(struct rb_ringbuffer *rb, const rb_uint8_t *ptr, rb_uint16_t length);
+rb_size_t rb_ringbuffer_put(struct rb_ringbuffer *rb, const rb_uint8_t *ptr, rb_length_t length);
 
 /**
  * @brief 强制写入数据到环形缓冲区（覆盖旧数据）
@@ -93,7 +120,7 @@ rb_size_t rb_ringbuffer_put(struct rb_ringbuffer *rb, const rb_uint8_t *ptr, rb_
  * @param length 数据长度
  * @return 实际写入的字节数
  */
-rb_size_t rb_ringbuffer_put_force(struct rb_ringbuffer *rb, const rb_uint8_t *ptr, rb_uint16_t length);
+rb_size_t rb_ringbuffer_put_force(struct rb_ringbuffer *rb, const rb_uint8_t *ptr, rb_length_t length);
 
 /**
  * @brief 写入单个字节（不覆盖）
@@ -118,7 +145,7 @@ rb_size_t rb_ringbuffer_putchar_force(struct rb_ringbuffer *rb, const rb_uint8_t
  * @param length 读取长度
  * @return 实际读取的字节数
  */
-rb_size_t rb_ringbuffer_get(struct rb_ringbuffer *rb, rb_uint8_t *ptr, rb_uint16_t length);
+rb_size_t rb_ringbuffer_get(struct rb_ringbuffer *rb, rb_uint8_t *ptr, rb_length_t length);
 
 /**
  * @brief 获取可读数据的指针
@@ -128,6 +155,45 @@ rb_size_t rb_ringbuffer_get(struct rb_ringbuffer *rb, rb_uint8_t *ptr, rb_uint16
  */
 rb_size_t rb_ringbuffer_peek(struct rb_ringbuffer *rb, rb_uint8_t **ptr);
 
+/**
+ * @brief 获取可读数据的两段指针（不移动读索引）
+ * @param rb 环形缓冲区指针
+ * @param ptr0 返回第一段数据指针
+ * @param len0 返回第一段长度
+ * @param ptr1 返回回绕后第二段数据指针（无回绕时为 RB_NULL）
+ * @param len1 返回第二段长度
+ * @return 可读数据总长度
+ * @note 处理完成后调用 rb_ringbuffer_consume() 释放
+ */
+rb_size_t rb_ringbuffer_peek_spans(struct rb_ringbuffer *rb,
+                                   rb_uint8_t **ptr0, rb_size_t *len0,
+                                   rb_uint8_t **ptr1, rb_size_t *len1);
+
+/**
+ * @brief 释放已处理的数据（移动读索引）
+ * @param rb 环形缓冲区指针
+ * @param length 释放长度
+ * @return 实际释放的字节数
+ */
+rb_size_t rb_ringbuffer_consume(struct rb_ringbuffer *rb, rb_size_t length);
+
+/**
+ * @brief 预留一段连续可写空间（不移动写索引）
+ * @param rb 环形缓冲区指针
+ * @param ptr 返回可写区域指针
+ * @return 可连续写入的字节数
+ * @note 直接写入（如 DMA 目标地址）后调用 rb_ringbuffer_commit() 提交
+ */
+rb_size_t rb_ringbuffer_reserve(struct rb_ringbuffer *rb, rb_uint8_t **ptr);
+
+/**
+ * @brief 提交已写入预留区域的数据（移动写索引）
+ * @param rb 环形缓冲区指针
+ * @param length 提交长度，不得超过 rb_ringbuffer_reserve() 返回值
+ * @return 实际提交的字节数
+ */
+rb_size_t rb_ringbuffer_commit(struct rb_ringbuffer *rb, rb_size_t length);
+
 /**
  * @brief 读取单个字节
  * @param rb 环形缓冲区指针
@@ -148,7 +214,7 @@ rb_size_t rb_ringbuffer_data_len(struct rb_ringbuffer *rb);
  * @param rb 环形缓冲区指针
  * @return 缓冲区大小
  */
-static inline rb_uint16_t rb_ringbuffer_get_size(struct rb_ringbuffer *rb)
+static inline rb_length_t rb_ringbuffer_get_size(struct rb_ringbuffer *rb)
 {
     RB_ASSERT(rb != RB_NULL);
     return rb->buffer_size;
@@ -0,0 +1,219 @@
+/*
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * 变长消息队列实现
+ *
+ * 单条记录总长 T 不超过 size/2 时，无论写索引停在哪里，
+ * 末尾剩余空间与开头空间必有一段能容纳 T，因此队列排空后记录总能写入。
+ */
+
+#include "ringbuffer_msgq.h"
+
+#define RB_MSGQ_ALIGN_UP(x)     (((x) + RB_MSGQ_ALIGN - 1) & ~(rb_uint32_t)(RB_MSGQ_ALIGN - 1))
+#define RB_MSGQ_RECORD_SIZE(len) (RB_MSGQ_HDR_SIZE + RB_MSGQ_ALIGN_UP(len))
+
+static inline rb_uint32_t rb_msgq_distance(const struct rb_msgq *q, rb_uint32_t wi, rb_uint32_t ri)
+{
+    return (wi >= ri) ? (wi - ri) : (wi + 2 * q->buffer_size - ri);
+}
+
+static inline rb_uint32_t rb_msgq_offset(const struct rb_msgq *q, rb_uint32_t index)
+{
+    return (index >= q->buffer_size) ? (index - q->buffer_size) : index;
+}
+
+static inline rb_uint32_t rb_msgq_advance(const struct rb_msgq *q, rb_uint32_t index, rb_uint32_t n)
+{
+    index += n;
+    if (index >= 2 * q->buffer_size)
+        index -= 2 * q->buffer_size;
+    return index;
+}
+
+static inline rb_uint32_t rb_msgq_hdr_get(const struct rb_msgq *q, rb_uint32_t offset)
+{
+    return *(const rb_uint32_t *)&q->buffer_ptr[offset];
+}
+
+static inline void rb_msgq_hdr_set(struct rb_msgq *q, rb_uint32_t offset, rb_uint32_t hdr)
+{
+    *(rb_uint32_t *)&q->buffer_ptr[offset] = hdr;
+}
+
+/* 查找队首记录，跳过填充；返回负载长度，index 返回记录头所在索引 */
+static rb_uint32_t rb_msgq_front(struct rb_msgq *q, rb_uint32_t *index)
+{
+    rb_uint32_t wi, ri, offset, hdr;
+
+    ri = RB_SPSC_LOAD_RELAXED(&q->read_index);
+    wi = RB_SPSC_LOAD_ACQUIRE(&q->write_index);
+
+    if (ri == wi)
+        return 0;
+
+    offset = rb_msgq_offset(q, ri);
+    hdr = rb_msgq_hdr_get(q, offset);
+
+    if (hdr == RB_MSGQ_PAD_MARK)
+    {
+        /* 填充与其后的记录一起发布，跳过后必有一条记录 */
+        ri = rb_msgq_advance(q, ri, q->buffer_size - offset);
+        RB_ASSERT(ri != wi);
+        hdr = rb_msgq_hdr_get(q, 0);
+    }
+
+    *index = ri;
+    return hdr;
+}
+
+void rb_msgq_init(struct rb_msgq *q, void *pool, rb_uint32_t size)
+{
+    RB_ASSERT(q != RB_NULL);
+    RB_ASSERT(pool != RB_NULL);
+    RB_ASSERT(((rb_size_t)pool & (RB_MSGQ_ALIGN - 1)) == 0);
+    RB_ASSERT(size >= 4 * RB_MSGQ_ALIGN && (size & (RB_MSGQ_ALIGN - 1)) == 0 && size <= 0x7FFFFFFFu);
+
+    q->buffer_ptr = (rb_uint8_t *)pool;
+    q->buffer_size = size;
+    rb_msgq_reset(q);
+}
+
+void rb_msgq_reset(struct rb_msgq *q)
+{
+    RB_ASSERT(q != RB_NULL);
+
+    q->reserve_pad = 0;
+    q->reserve_len = 0;
+    RB_SPSC_STORE_RELEASE(&q->write_index, 0);
+    RB_SPSC_STORE_RELEASE(&q->read_index, 0);
+}
+
+rb_size_t rb_msgq_reserve(struct rb_msgq *q, rb_size_t len, rb_uint8_t **ptr)
+{
+    rb_uint32_t wi, ri, space, offset, tail, total;
+
+    RB_ASSERT(q != RB_NULL);
+
+    *ptr = RB_NULL;
+    q->reserve_len = 0;
+
+    if (len == 0 || len > rb_msgq_max_len(q))
+        return 0;
+
+    wi = RB_SPSC_LOAD_RELAXED(&q->write_index);
+    ri = RB_SPSC_LOAD_ACQUIRE(&q->read_index);
+
+    space = q->buffer_size - rb_msgq_distance(q, wi, ri);
+    offset = rb_msgq_offset(q, wi);
+    tail = q->buffer_size - offset;
+    total = RB_MSGQ_RECORD_SIZE((rb_uint32_t)len);
+
+    if (total <= tail)
+    {
+        if (space < total)
+            return 0;
+        q->reserve_pad = 0;
+        *ptr = &q->buffer_ptr[offset + RB_MSGQ_HDR_SIZE];
+    }
+    else
+    {
+        /* 末尾放不下：末尾整段作为填充，记录从头开始 */
+        if (space < tail + total)
+            return 0;
+        q->reserve_pad = tail;
+        *ptr = &q->buffer_ptr[RB_MSGQ_HDR_SIZE];
+    }
+
+    q->reserve_len = (rb_uint32_t)len;
+
+    return len;
+}
+
+rb_size_t rb_msgq_commit(struct rb_msgq *q, rb_size_t len)
+{
+    rb_uint32_t wi;
+
+    RB_ASSERT(q != RB_NULL);
+    RB_ASSERT(len <= q->reserve_len);
+
+    if (len == 0 || q->reserve_len == 0)
+    {
+        q->reserve_len = 0;
+        return 0;
+    }
+
+    wi = RB_SPSC_LOAD_RELAXED(&q->write_index);
+
+    if (q->reserve_pad)
+    {
+        rb_msgq_hdr_set(q, rb_msgq_offset(q, wi), RB_MSGQ_PAD_MARK);
+        wi = rb_msgq_advance(q, wi, q->reserve_pad);
+    }
+
+    rb_msgq_hdr_set(q, rb_msgq_offset(q, wi), (rb_uint32_t)len);
+    wi = rb_msgq_advance(q, wi, RB_MSGQ_RECORD_SIZE((rb_uint32_t)len));
+
+    q->reserve_len = 0;
+    RB_SPSC_STORE_RELEASE(&q->write_index, wi);
+
+    return len;
+}
+
+rb_size_t rb_msgq_peek(struct rb_msgq *q, rb_uint8_t **ptr)
+{
+    rb_uint32_t ri, len;
+
+    RB_ASSERT(q != RB_NULL);
+
+    *ptr = RB_NULL;
+
+    len = rb_msgq_front(q, &ri);
+    if (len == 0)
+        return 0;
+
+    *ptr = &q->buffer_ptr[rb_msgq_offset(q, ri) + RB_MSGQ_HDR_SIZE];
+
+    return len;
+}
+
+rb_size_t rb_msgq_release(struct rb_msgq *q)
+{
+    rb_uint32_t ri, len;
+
+    RB_ASSERT(q != RB_NULL);
+
+    len = rb_msgq_front(q, &ri);
+    if (len == 0)
+        return 0;
+
+    RB_SPSC_STORE_RELEASE(&q->read_index, rb_msgq_advance(q, ri, RB_MSGQ_RECORD_SIZE(len)));
+
+    return len;
+}
+
+rb_size_t rb_msgq_put(struct rb_msgq *q, const rb_uint8_t *data, rb_size_t len)
+{
+    rb_uint8_t *ptr;
+
+    if (rb_msgq_reserve(q, len, &ptr) == 0)
+        return 0;
+
+    rb_memcpy(ptr, data, len);
+
+    return rb_msgq_commit(q, len);
+}
+
+rb_size_t rb_msgq_get(struct rb_msgq *q, rb_uint8_t *buf, rb_size_t max_len)
+{
+    rb_uint8_t *ptr;
+    rb_size_t len;
+
+    len = rb_msgq_peek(q, &ptr);
+    if (len == 0 || len > max_len)
+        return 0;
+
+    rb_memcpy(buf, ptr, len);
+    rb_msgq_release(q);
+
+    return len;
+}
@@ -0,0 +1,123 @@
+/*
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * 变长消息队列
+ *
+ * 在环形存储上按“记录”存取整帧数据（usart_pack 帧、JY901S 数据包、shell 行、日志等），
+ * 消费者直接拿到完整的一帧，不必在字节流里重新找帧边界。
+ *
+ * 记录格式: [长度头 4B][负载 len 字节][补齐到 4 字节]
+ * 记录写到缓冲区末尾放不下时，写入一个填充头并从头开始，保证每条记录在内存中连续，
+ * 可以直接交给 DMA 发送或按结构体访问。
+ *
+ * 读写索引沿用 rb_spsc 的原子发布方式，一个生产者 + 一个消费者时无需关中断。
+ */
+
+#ifndef RINGBUFFER_MSGQ_H__
+#define RINGBUFFER_MSGQ_H__
+
+#include "ringbuffer_spsc.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define RB_MSGQ_ALIGN       4                   /* 记录对齐字节数 */
+#define RB_MSGQ_HDR_SIZE    4                   /* 长度头字节数 */
+#define RB_MSGQ_PAD_MARK    0xFFFFFFFFu         /* 填充记录标记 */
+
+/* 变长消息队列结构体 */
+struct rb_msgq
+{
+    rb_uint8_t *buffer_ptr;
+    rb_uint32_t buffer_size;
+    rb_uint32_t reserve_pad;        /* 当前预留需要的末尾填充字节数（仅生产者使用） */
+    rb_uint32_t reserve_len;        /* 当前预留的负载长度（仅生产者使用） */
+    rb_spsc_index_t write_index;    /* 范围 [0, 2 * size)，仅生产者写 */
+    rb_spsc_index_t read_index;     /* 范围 [0, 2 * size)，仅消费者写 */
+};
+
+/**
+ * @brief 初始化消息队列
+ * @param q 队列指针
+ * @param pool 存储区，须 4 字节对齐
+ * @param size 存储区大小，须为 4 的倍数
+ * @note 单条记录负载最大为 rb_msgq_max_len()，约为 size/2 - 4
+ */
+void rb_msgq_init(struct rb_msgq *q, void *pool, rb_uint32_t size);
+
+/**
+ * @brief 重置队列（调用时两端都不得在访问）
+ * @param q 队列指针
+ */
+void rb_msgq_reset(struct rb_msgq *q);
+
+/**
+ * @brief 预留一条记录的连续空间（生产者端）
+ * @param q 队列指针
+ * @param len 负载长度（大于0）
+ * @param ptr 返回负载写入地址
+ * @return 成功返回 len，空间不足返回0
+ * @note 写入后调用 rb_msgq_commit() 提交；未提交前再次预留会覆盖本次预留
+ */
+rb_size_t rb_msgq_reserve(struct rb_msgq *q, rb_size_t len, rb_uint8_t **ptr);
+
+/**
+ * @brief 提交已预留的记录（生产者端）
+ * @param q 队列指针
+ * @param len 实际负载长度，不得超过预留长度；为0时放弃本次预留
+ * @return 实际提交的负载长度
+ */
+rb_size_t rb_msgq_commit(struct rb_msgq *q, rb_size_t len);
+
+/**
+ * @brief 获取队首记录（消费者端，不出队）
+ * @param q 队列指针
+ * @param ptr 返回记录负载地址
+ * @return 记录负载长度，队列空返回0
+ */
+rb_size_t rb_msgq_peek(struct rb_msgq *q, rb_uint8_t **ptr);
+
+/**
+ * @brief 释放队首记录（消费者端）
+ * @param q 队列指针
+ * @return 释放的记录负载长度，队列空返回0
+ */
+rb_size_t rb_msgq_release(struct rb_msgq *q);
+
+/**
+ * @brief 拷贝方式写入一条记录（reserve + memcpy + commit）
+ * @return 成功返回 len，空间不足返回0
+ */
+rb_size_t rb_msgq_put(struct rb_msgq *q, const rb_uint8_t *data, rb_size_t len);
+
+/**
+ * @brief 拷贝方式读出一条记录（peek + memcpy + release）
+ * @param q 队列指针
+ * @param buf 目标缓冲区
+ * @param max_len 目标缓冲区大小
+ * @return 记录负载长度；队列空或 buf 放不下返回0（记录保留在队列中）
+ */
+rb_size_t rb_msgq_get(struct rb_msgq *q, rb_uint8_t *buf, rb_size_t max_len);
+
+/**
+ * @brief 队列是否为空
+ */
+static inline int rb_msgq_is_empty(struct rb_msgq *q)
+{
+    return RB_SPSC_LOAD_ACQUIRE(&q->read_index) == RB_SPSC_LOAD_ACQUIRE(&q->write_index);
+}
+
+/**
+ * @brief 单条记录允许的最大负载长度
+ */
+static inline rb_size_t rb_msgq_max_len(const struct rb_msgq *q)
+{
+    return RB_ALIGN_DOWN(q->buffer_size / 2, RB_MSGQ_ALIGN) - RB_MSGQ_HDR_SIZE;
+}
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* RINGBUFFER_MSGQ_H__ */
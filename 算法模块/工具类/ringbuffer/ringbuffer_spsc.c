@@ -0,0 +1,175 @@
+/*
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * 单生产者/单消费者(SPSC)无锁环形缓冲区实现
+ *
+ * 内存序约定：
+ *   生产者: 拷贝数据 -> release 发布 write_index
+ *   消费者: acquire 读取 write_index -> 拷贝数据 -> release 发布 read_index
+ *   生产者 acquire 读取 read_index 后才会覆写已被消费的空间
+ */
+
+#include "ringbuffer_spsc.h"
+
+/* 索引范围 [0, 2 * size)，两个索引之差即数据长度 */
+static inline rb_uint32_t rb_spsc_distance(const struct rb_spsc *rb, rb_uint32_t wi, rb_uint32_t ri)
+{
+    return (wi >= ri) ? (wi - ri) : (wi + 2 * rb->buffer_size - ri);
+}
+
+static inline rb_uint32_t rb_spsc_offset(const struct rb_spsc *rb, rb_uint32_t index)
+{
+    return (index >= rb->buffer_size) ? (index - rb->buffer_size) : index;
+}
+
+static inline rb_uint32_t rb_spsc_advance(const struct rb_spsc *rb, rb_uint32_t index, rb_uint32_t n)
+{
+    index += n;
+    if (index >= 2 * rb->buffer_size)
+        index -= 2 * rb->buffer_size;
+    return index;
+}
+
+void rb_spsc_init(struct rb_spsc *rb, rb_uint8_t *pool, rb_uint32_t size)
+{
+    RB_ASSERT(rb != RB_NULL);
+    RB_ASSERT(pool != RB_NULL);
+    RB_ASSERT(size > 0 && size <= 0x7FFFFFFFu);
+
+    rb->buffer_ptr = pool;
+    rb->buffer_size = size;
+    rb_spsc_reset(rb);
+}
+
+void rb_spsc_reset(struct rb_spsc *rb)
+{
+    RB_ASSERT(rb != RB_NULL);
+
+    RB_SPSC_STORE_RELEASE(&rb->write_index, 0);
+    RB_SPSC_STORE_RELEASE(&rb->read_index, 0);
+}
+
+rb_size_t rb_spsc_put(struct rb_spsc *rb, const rb_uint8_t *ptr, rb_size_t length)
+{
+    rb_uint32_t wi, ri, space, offset, first;
+
+    RB_ASSERT(rb != RB_NULL);
+
+    wi = RB_SPSC_LOAD_RELAXED(&rb->write_index);
+    ri = RB_SPSC_LOAD_ACQUIRE(&rb->read_index);
+
+    space = rb->buffer_size - rb_spsc_distance(rb, wi, ri);
+    if (space == 0)
+        return 0;
+
+    if (space < length)
+        length = space;
+
+    offset = rb_spsc_offset(rb, wi);
+    first = rb->buffer_size - offset;
+
+    if (first >= length)
+    {
+        rb_memcpy(&rb->buffer_ptr[offset], ptr, length);
+    }
+    else
+    {
+        rb_memcpy(&rb->buffer_ptr[offset], &ptr[0], first);
+        rb_memcpy(&rb->buffer_ptr[0], &ptr[first], length - first);
+    }
+
+    RB_SPSC_STORE_RELEASE(&rb->write_index, rb_spsc_advance(rb, wi, (rb_uint32_t)length));
+
+    return length;
+}
+
+rb_size_t rb_spsc_putchar(struct rb_spsc *rb, const rb_uint8_t ch)
+{
+    rb_uint32_t wi, ri;
+
+    RB_ASSERT(rb != RB_NULL);
+
+    wi = RB_SPSC_LOAD_RELAXED(&rb->write_index);
+    ri = RB_SPSC_LOAD_ACQUIRE(&rb->read_index);
+
+    if (rb_spsc_distance(rb, wi, ri) == rb->buffer_size)
+        return 0;
+
+    rb->buffer_ptr[rb_spsc_offset(rb, wi)] = ch;
+
+    RB_SPSC_STORE_RELEASE(&rb->write_index, rb_spsc_advance(rb, wi, 1));
+
+    return 1;
+}
+
+rb_size_t rb_spsc_get(struct rb_spsc *rb, rb_uint8_t *ptr, rb_size_t length)
+{
+    rb_uint32_t wi, ri, size, offset, first;
+
+    RB_ASSERT(rb != RB_NULL);
+
+    ri = RB_SPSC_LOAD_RELAXED(&rb->read_index);
+    wi = RB_SPSC_LOAD_ACQUIRE(&rb->write_index);
+
+    size = rb_spsc_distance(rb, wi, ri);
+    if (size == 0)
+        return 0;
+
+    if (size < length)
+        length = size;
+
+    offset = rb_spsc_offset(rb, ri);
+    first = rb->buffer_size - offset;
+
+    if (first >= length)
+    {
+        rb_memcpy(ptr, &rb->buffer_ptr[offset], length);
+    }
+    else
+    {
+        rb_memcpy(&ptr[0], &rb->buffer_ptr[offset], first);
+        rb_memcpy(&ptr[first], &rb->buffer_ptr[0], length - first);
+    }
+
+    RB_SPSC_STORE_RELEASE(&rb->read_index, rb_spsc_advance(rb, ri, (rb_uint32_t)length));
+
+    return length;
+}
+
+rb_size_t rb_spsc_getchar(struct rb_spsc *rb, rb_uint8_t *ch)
+{
+    rb_uint32_t wi, ri;
+
+    RB_ASSERT(rb != RB_NULL);
+
+    ri = RB_SPSC_LOAD_RELAXED(&rb->read_index);
+    wi = RB_SPSC_LOAD_ACQUIRE(&rb->write_index);
+
+    if (wi == ri)
+        return 0;
+
+    *ch = rb->buffer_ptr[rb_spsc_offset(rb, ri)];
+
+    RB_SPSC_STORE_RELEASE(&rb->read_index, rb_spsc_advance(rb, ri, 1));
+
+    return 1;
+}
+
+rb_size_t rb_spsc_data_len(struct rb_spsc *rb)
+{
+    rb_uint32_t wi, ri, size;
+
+    RB_ASSERT(rb != RB_NULL);
+
+    ri = RB_SPSC_LOAD_ACQUIRE(&rb->read_index);
+    wi = RB_SPSC_LOAD_ACQUIRE(&rb->write_index);
+
+    /* 第三方上下文读取时两次加载之间索引可能前进，结果需钳位 */
+    size = rb_spsc_distance(rb, wi, ri);
+    return (size > rb->buffer_size) ? rb->buffer_size : size;
+}
+
+rb_size_t rb_spsc_space_len(struct rb_spsc *rb)
+{
+    return rb->buffer_size - rb_spsc_data_len(rb);
+}
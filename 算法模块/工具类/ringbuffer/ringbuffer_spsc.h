@@ -0,0 +1,150 @@
+/*
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * 单生产者/单消费者(SPSC)无锁环形缓冲区
+ *
+ * 与 rb_ringbuffer 使用相同的镜像索引思路，但读写索引各自独占一个字，
+ * 写端只修改 write_index，读端只修改 read_index，索引取值范围为
+ * [0, 2 * buffer_size)，最高一圈即镜像位。
+ *
+ * 典型场景：UART/DMA 中断写入、主循环读取，两端均无需关中断。
+ * 注意：同一端只能有一个上下文调用（一个生产者 + 一个消费者）。
+ */
+
+#ifndef RINGBUFFER_SPSC_H__
+#define RINGBUFFER_SPSC_H__
+
+#include "ringbuffer.h"
+
+#if !defined(RB_SPSC_NO_C11_ATOMICS) && \
+    (!defined(__STDC_VERSION__) || __STDC_VERSION__ < 201112L || defined(__STDC_NO_ATOMICS__))
+#define RB_SPSC_NO_C11_ATOMICS
+#endif
+
+#ifndef RB_SPSC_NO_C11_ATOMICS
+#include <stdatomic.h>
+#endif
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#ifndef RB_SPSC_NO_C11_ATOMICS
+typedef _Atomic rb_uint32_t rb_spsc_index_t;
+#else
+/* 无 C11 原子支持的编译器(如 ARMCC5)：单字读写本身是原子的，只需内存屏障 */
+typedef volatile rb_uint32_t rb_spsc_index_t;
+#ifndef RB_SPSC_BARRIER
+#define RB_SPSC_BARRIER()   __asm volatile("" ::: "memory")
+#endif
+#endif
+
+/* 索引读写原语，供 SPSC 及基于它的模块(如 rb_msgq)使用 */
+#ifndef RB_SPSC_NO_C11_ATOMICS
+#define RB_SPSC_LOAD_RELAXED(p)     atomic_load_explicit((p), memory_order_relaxed)
+#define RB_SPSC_LOAD_ACQUIRE(p)     atomic_load_explicit((p), memory_order_acquire)
+#define RB_SPSC_STORE_RELEASE(p, v) atomic_store_explicit((p), (v), memory_order_release)
+#else
+static inline rb_uint32_t rb_spsc_load_acquire(rb_spsc_index_t *p)
+{
+    rb_uint32_t v = *p;
+    RB_SPSC_BARRIER();
+    return v;
+}
+
+static inline void rb_spsc_store_release(rb_spsc_index_t *p, rb_uint32_t v)
+{
+    RB_SPSC_BARRIER();
+    *p = v;
+}
+
+#define RB_SPSC_LOAD_RELAXED(p)     (*(p))
+#define RB_SPSC_LOAD_ACQUIRE(p)     rb_spsc_load_acquire(p)
+#define RB_SPSC_STORE_RELEASE(p, v) rb_spsc_store_release((p), (v))
+#endif
+
+/* SPSC 环形缓冲区结构体 */
+struct rb_spsc
+{
+    rb_uint8_t *buffer_ptr;
+    rb_uint32_t buffer_size;
+    rb_spsc_index_t write_index;    /* 仅生产者写 */
+    rb_spsc_index_t read_index;     /* 仅消费者写 */
+};
+
+/**
+ * @brief 初始化 SPSC 环形缓冲区
+ * @param rb 缓冲区指针
+ * @param pool 缓冲区内存
+ * @param size 缓冲区大小（不做对齐裁剪，最大 0x7FFFFFFF）
+ */
+void rb_spsc_init(struct rb_spsc *rb, rb_uint8_t *pool, rb_uint32_t size);
+
+/**
+ * @brief 重置缓冲区（调用时两端都不得在访问）
+ * @param rb 缓冲区指针
+ */
+void rb_spsc_reset(struct rb_spsc *rb);
+
+/**
+ * @brief 写入数据（生产者端，不覆盖）
+ * @param rb 缓冲区指针
+ * @param ptr 数据指针
+ * @param length 数据长度
+ * @return 实际写入的字节数
+ */
+rb_size_t rb_spsc_put(struct rb_spsc *rb, const rb_uint8_t *ptr, rb_size_t length);
+
+/**
+ * @brief 写入单个字节（生产者端）
+ * @param rb 缓冲区指针
+ * @param ch 字节
+ * @return 成功返回1，缓冲区满返回0
+ */
+rb_size_t rb_spsc_putchar(struct rb_spsc *rb, const rb_uint8_t ch);
+
+/**
+ * @brief 读取数据（消费者端）
+ * @param rb 缓冲区指针
+ * @param ptr 目标缓冲区
+ * @param length 读取长度
+ * @return 实际读取的字节数
+ */
+rb_size_t rb_spsc_get(struct rb_spsc *rb, rb_uint8_t *ptr, rb_size_t length);
+
+/**
+ * @brief 读取单个字节（消费者端）
+ * @param rb 缓冲区指针
+ * @param ch 目标字节指针
+ * @return 成功返回1，缓冲区空返回0
+ */
+rb_size_t rb_spsc_getchar(struct rb_spsc *rb, rb_uint8_t *ch);
+
+/**
+ * @brief 获取可读数据长度（任意一端均可调用，结果为瞬时快照）
+ * @param rb 缓冲区指针
+ * @return 数据长度
+ */
+rb_size_t rb_spsc_data_len(struct rb_spsc *rb);
+
+/**
+ * @brief 获取剩余空间（任意一端均可调用，结果为瞬时快照）
+ * @param rb 缓冲区指针
+ * @return 剩余空间
+ */
+rb_size_t rb_spsc_space_len(struct rb_spsc *rb);
+
+/**
+ * @brief 获取缓冲区大小
+ */
+static inline rb_uint32_t rb_spsc_get_size(struct rb_spsc *rb)
+{
+    RB_ASSERT(rb != RB_NULL);
+    return rb->buffer_size;
+}
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* RINGBUFFER_SPSC_H__ */
@@ -0,0 +1,199 @@
+/*
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * 定长元素环形缓冲区实现
+ */
+
+#include "ringbuffer_typed.h"
+
+static inline rb_uint32_t rb_typed_offset(const struct rb_typed_ringbuffer *rb, rb_uint32_t index)
+{
+    return (index >= rb->capacity) ? (index - rb->capacity) : index;
+}
+
+static inline rb_uint32_t rb_typed_advance(const struct rb_typed_ringbuffer *rb, rb_uint32_t index, rb_uint32_t n)
+{
+    index += n;
+    if (index >= 2 * rb->capacity)
+        index -= 2 * rb->capacity;
+    return index;
+}
+
+/* 从元素位置 index 开始写入 count 个元素，自动处理回绕 */
+static void rb_typed_copy_in(struct rb_typed_ringbuffer *rb, rb_uint32_t index,
+                             const rb_uint8_t *src, rb_uint32_t count)
+{
+    rb_uint32_t offset = rb_typed_offset(rb, index);
+    rb_uint32_t first = rb->capacity - offset;
+
+    if (first >= count)
+    {
+        rb_memcpy(&rb->buffer_ptr[offset * rb->elem_size], src, count * rb->elem_size);
+        return;
+    }
+
+    rb_memcpy(&rb->buffer_ptr[offset * rb->elem_size], src, first * rb->elem_size);
+    rb_memcpy(&rb->buffer_ptr[0], &src[first * rb->elem_size], (count - first) * rb->elem_size);
+}
+
+/* 从元素位置 index 开始读出 count 个元素，自动处理回绕 */
+static void rb_typed_copy_out(const struct rb_typed_ringbuffer *rb, rb_uint32_t index,
+                              rb_uint8_t *dst, rb_uint32_t count)
+{
+    rb_uint32_t offset = rb_typed_offset(rb, index);
+    rb_uint32_t first = rb->capacity - offset;
+
+    if (first >= count)
+    {
+        rb_memcpy(dst, &rb->buffer_ptr[offset * rb->elem_size], count * rb->elem_size);
+        return;
+    }
+
+    rb_memcpy(dst, &rb->buffer_ptr[offset * rb->elem_size], first * rb->elem_size);
+    rb_memcpy(&dst[first * rb->elem_size], &rb->buffer_ptr[0], (count - first) * rb->elem_size);
+}
+
+void rb_typed_init(struct rb_typed_ringbuffer *rb, void *pool, rb_uint32_t elem_size, rb_uint32_t capacity)
+{
+    RB_ASSERT(rb != RB_NULL);
+    RB_ASSERT(pool != RB_NULL);
+    RB_ASSERT(elem_size > 0);
+    RB_ASSERT(capacity > 0 && capacity <= 0x7FFFFFFFu);
+
+    rb->buffer_ptr = (rb_uint8_t *)pool;
+    rb->elem_size = elem_size;
+    rb->capacity = capacity;
+    rb->read_index = 0;
+    rb->write_index = 0;
+}
+
+void rb_typed_reset(struct rb_typed_ringbuffer *rb)
+{
+    RB_ASSERT(rb != RB_NULL);
+
+    rb->read_index = 0;
+    rb->write_index = 0;
+}
+
+rb_size_t rb_typed_push(struct rb_typed_ringbuffer *rb, const void *elem)
+{
+    RB_ASSERT(rb != RB_NULL);
+
+    if (rb_typed_count(rb) == rb->capacity)
+        return 0;
+
+    rb_memcpy(&rb->buffer_ptr[rb_typed_offset(rb, rb->write_index) * rb->elem_size], elem, rb->elem_size);
+    rb->write_index = rb_typed_advance(rb, rb->write_index, 1);
+
+    return 1;
+}
+
+rb_size_t rb_typed_push_n(struct rb_typed_ringbuffer *rb, const void *elems, rb_size_t count)
+{
+    rb_size_t space;
+
+    RB_ASSERT(rb != RB_NULL);
+
+    space = rb_typed_space(rb);
+    if (space < count)
+        count = space;
+
+    if (count == 0)
+        return 0;
+
+    rb_typed_copy_in(rb, rb->write_index, (const rb_uint8_t *)elems, (rb_uint32_t)count);
+    rb->write_index = rb_typed_advance(rb, rb->write_index, (rb_uint32_t)count);
+
+    return count;
+}
+
+rb_size_t rb_typed_push_n_force(struct rb_typed_ringbuffer *rb, const void *elems, rb_size_t count)
+{
+    const rb_uint8_t *src = (const rb_uint8_t *)elems;
+    rb_size_t space;
+
+    RB_ASSERT(rb != RB_NULL);
+
+    /* 与 rb_ringbuffer_put_force 相同：只保留最后 capacity 个元素 */
+    if (count > rb->capacity)
+    {
+        src = &src[(count - rb->capacity) * rb->elem_size];
+        count = rb->capacity;
+    }
+
+    if (count == 0)
+        return 0;
+
+    space = rb_typed_space(rb);
+
+    rb_typed_copy_in(rb, rb->write_index, src, (rb_uint32_t)count);
+    rb->write_index = rb_typed_advance(rb, rb->write_index, (rb_uint32_t)count);
+
+    /* 覆盖了最旧的元素，读索引跟进 */
+    if (count > space)
+        rb->read_index = rb_typed_advance(rb, rb->read_index, (rb_uint32_t)(count - space));
+
+    return count;
+}
+
+rb_size_t rb_typed_pop(struct rb_typed_ringbuffer *rb, void *elem)
+{
+    RB_ASSERT(rb != RB_NULL);
+
+    if (rb->read_index == rb->write_index)
+        return 0;
+
+    rb_memcpy(elem, &rb->buffer_ptr[rb_typed_offset(rb, rb->read_index) * rb->elem_size], rb->elem_size);
+    rb->read_index = rb_typed_advance(rb, rb->read_index, 1);
+
+    return 1;
+}
+
+rb_size_t rb_typed_pop_n(struct rb_typed_ringbuffer *rb, void *elems, rb_size_t count)
+{
+    rb_size_t size;
+
+    RB_ASSERT(rb != RB_NULL);
+
+    size = rb_typed_count(rb);
+    if (size < count)
+        count = size;
+
+    if (count == 0)
+        return 0;
+
+    rb_typed_copy_out(rb, rb->read_index, (rb_uint8_t *)elems, (rb_uint32_t)count);
+    rb->read_index = rb_typed_advance(rb, rb->read_index, (rb_uint32_t)count);
+
+    return count;
+}
+
+rb_size_t rb_typed_snapshot(struct rb_typed_ringbuffer *rb, void *elems, rb_size_t count)
+{
+    rb_size_t size;
+
+    RB_ASSERT(rb != RB_NULL);
+
+    size = rb_typed_count(rb);
+    if (size < count)
+        count = size;
+
+    if (count == 0)
+        return 0;
+
+    /* 从倒数第 count 个元素开始拷贝 */
+    rb_typed_copy_out(rb, rb_typed_advance(rb, rb->read_index, (rb_uint32_t)(size - count)),
+                      (rb_uint8_t *)elems, (rb_uint32_t)count);
+
+    return count;
+}
+
+void *rb_typed_at(struct rb_typed_ringbuffer *rb, rb_size_t i)
+{
+    RB_ASSERT(rb != RB_NULL);
+
+    if (i >= rb_typed_count(rb))
+        return RB_NULL;
+
+    return &rb->buffer_ptr[rb_typed_offset(rb, rb_typed_advance(rb, rb->read_index, (rb_uint32_t)i)) * rb->elem_size];
+}
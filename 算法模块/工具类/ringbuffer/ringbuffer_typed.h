@@ -0,0 +1,142 @@
+/*
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * 定长元素环形缓冲区
+ *
+ * 以“元素”为单位存取 float 采样、Axis3f、定长帧等数据，免去字节缓冲区的手动强转。
+ * 索引使用与 rb_ringbuffer 相同的镜像思路：取值范围 [0, 2 * capacity)，
+ * 容量不要求为 2 的幂；批量操作只做一次空间检查，最多两次 memcpy。
+ */
+
+#ifndef RINGBUFFER_TYPED_H__
+#define RINGBUFFER_TYPED_H__
+
+#include "ringbuffer.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* 定长元素环形缓冲区结构体 */
+struct rb_typed_ringbuffer
+{
+    rb_uint8_t *buffer_ptr;
+    rb_uint32_t elem_size;      /* 单个元素字节数 */
+    rb_uint32_t capacity;       /* 最大元素个数 */
+    rb_uint32_t read_index;     /* 范围 [0, 2 * capacity) */
+    rb_uint32_t write_index;    /* 范围 [0, 2 * capacity) */
+};
+
+/**
+ * @brief 编译期定义一个定长元素环形缓冲区（含存储区，无需调用 init）
+ * @param name 缓冲区变量名
+ * @param type 元素类型
+ * @param cap 元素个数
+ * @note 例: RB_TYPED_DEFINE(adc_rb, float, 256);
+ */
+#define RB_TYPED_DEFINE(name, type, cap)                                \
+    static type name##_pool[cap];                                       \
+    static struct rb_typed_ringbuffer name = {                          \
+        (rb_uint8_t *)name##_pool, sizeof(type), (cap), 0, 0            \
+    }
+
+/**
+ * @brief 初始化定长元素环形缓冲区
+ * @param rb 缓冲区指针
+ * @param pool 存储区，大小至少为 elem_size * capacity
+ * @param elem_size 单个元素字节数
+ * @param capacity 元素个数
+ */
+void rb_typed_init(struct rb_typed_ringbuffer *rb, void *pool, rb_uint32_t elem_size, rb_uint32_t capacity);
+
+/**
+ * @brief 重置缓冲区
+ * @param rb 缓冲区指针
+ */
+void rb_typed_reset(struct rb_typed_ringbuffer *rb);
+
+/**
+ * @brief 写入单个元素（不覆盖）
+ * @param rb 缓冲区指针
+ * @param elem 元素指针
+ * @return 成功返回1，缓冲区满返回0
+ */
+rb_size_t rb_typed_push(struct rb_typed_ringbuffer *rb, const void *elem);
+
+/**
+ * @brief 批量写入元素（不覆盖）
+ * @param rb 缓冲区指针
+ * @param elems 元素数组
+ * @param count 元素个数
+ * @return 实际写入的元素个数
+ */
+rb_size_t rb_typed_push_n(struct rb_typed_ringbuffer *rb, const void *elems, rb_size_t count);
+
+/**
+ * @brief 批量写入元素（覆盖最旧的数据）
+ * @param rb 缓冲区指针
+ * @param elems 元素数组
+ * @param count 元素个数
+ * @return 实际写入的元素个数（超过容量时只保留最后 capacity 个）
+ */
+rb_size_t rb_typed_push_n_force(struct rb_typed_ringbuffer *rb, const void *elems, rb_size_t count);
+
+/**
+ * @brief 读取单个元素
+ * @param rb 缓冲区指针
+ * @param elem 目标元素指针
+ * @return 成功返回1，缓冲区空返回0
+ */
+rb_size_t rb_typed_pop(struct rb_typed_ringbuffer *rb, void *elem);
+
+/**
+ * @brief 批量读取元素
+ * @param rb 缓冲区指针
+ * @param elems 目标数组
+ * @param count 最多读取的元素个数
+ * @return 实际读取的元素个数
+ */
+rb_size_t rb_typed_pop_n(struct rb_typed_ringbuffer *rb, void *elems, rb_size_t count);
+
+/**
+ * @brief 拷贝最新的 N 个元素（不移动读索引）
+ * @param rb 缓冲区指针
+ * @param elems 目标数组，按时间顺序由旧到新排列
+ * @param count 需要的元素个数
+ * @return 实际拷贝的元素个数
+ * @note 用于波形显示、滑动窗口 FFT 等只读取历史数据的场景
+ */
+rb_size_t rb_typed_snapshot(struct rb_typed_ringbuffer *rb, void *elems, rb_size_t count);
+
+/**
+ * @brief 获取第 i 个元素的指针（0 为最旧）
+ * @param rb 缓冲区指针
+ * @param i 元素序号
+ * @return 元素指针，越界返回 RB_NULL
+ */
+void *rb_typed_at(struct rb_typed_ringbuffer *rb, rb_size_t i);
+
+/**
+ * @brief 获取当前元素个数
+ */
+static inline rb_size_t rb_typed_count(const struct rb_typed_ringbuffer *rb)
+{
+    RB_ASSERT(rb != RB_NULL);
+    return (rb->write_index >= rb->read_index) ?
+           (rb->write_index - rb->read_index) :
+           (rb->write_index + 2 * rb->capacity - rb->read_index);
+}
+
+/**
+ * @brief 获取剩余可写元素个数
+ */
+static inline rb_size_t rb_typed_space(const struct rb_typed_ringbuffer *rb)
+{
+    return rb->capacity - rb_typed_count(rb);
+}
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* RINGBUFFER_TYPED_H__ */
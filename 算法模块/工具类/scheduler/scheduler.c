@@ -8,6 +8,330 @@
 
 #include "scheduler.h"
 
+/* 时间比较（支持 32 位毫秒计数回绕） */
+#define SCHED_TIME_BEFORE(a, b)   ((int32_t)((a) - (b)) < 0)
+
+/* 截止时间/优先级/EDF 模式均使用最小堆查找到期任务 */
+#define SCHED_USE_HEAP(sched)     ((sched)->mode != SCHEDULER_MODE_SCAN)
+
+/* ======================= 截止时间模式：最小堆 ======================= */
+
+static void heap_swap(scheduler_t *sched, uint8_t a, uint8_t b)
+{
+    uint8_t tmp = sched->heap[a];
+    sched->heap[a] = sched->heap[b];
+    sched->heap[b] = tmp;
+}
+
+static int heap_less(scheduler_t *sched, uint8_t a, uint8_t b)
+{
+    return SCHED_TIME_BEFORE(sched->tasks[sched->heap[a]].next_run,
+                             sched->tasks[sched->heap[b]].next_run);
+}
+
+static void heap_sift_up(scheduler_t *sched, uint8_t pos)
+{
+    while (pos > 0) {
+        uint8_t parent = (pos - 1) / 2;
+        if (!heap_less(sched, pos, parent)) {
+            break;
+        }
+        heap_swap(sched, pos, parent);
+        pos = parent;
+    }
+}
+
+static void heap_sift_down(scheduler_t *sched, uint8_t pos)
+{
+    for (;;) {
+        uint8_t left = 2 * pos + 1;
+        uint8_t right = left + 1;
+        uint8_t smallest = pos;
+
+        if (left < sched->heap_size && heap_less(sched, left, smallest)) {
+            smallest = left;
+        }
+        if (right < sched->heap_size && heap_less(sched, right, smallest)) {
+            smallest = right;
+        }
+        if (smallest == pos) {
+            break;
+        }
+        heap_swap(sched, pos, smallest);
+        pos = smallest;
+    }
+}
+
+static void heap_push(scheduler_t *sched, uint8_t task_index)
+{
+    sched->heap[sched->heap_size] = task_index;
+    sched->heap_size++;
+    heap_sift_up(sched, sched->heap_size - 1);
+}
+
+static uint8_t heap_pop(scheduler_t *sched)
+{
+    uint8_t top = sched->heap[0];
+
+    sched->heap_size--;
+    if (sched->heap_size > 0) {
+        sched->heap[0] = sched->heap[sched->heap_size];
+        heap_sift_down(sched, 0);
+    }
+    return top;
+}
+
+/**
+ * @brief 用全部使能的任务重建堆
+ * @note 分发期间（任务函数内）修改任务表时延迟到本轮分发结束后重建
+ */
+static void heap_rebuild(scheduler_t *sched)
+{
+    if (!SCHED_USE_HEAP(sched)) {
+        return;
+    }
+
+    if (sched->in_run) {
+        sched->heap_dirty = 1;
+        return;
+    }
+
+    sched->heap_size = 0;
+    for (uint8_t i = 0; i < sched->task_count; i++) {
+        if (sched->tasks[i].enabled && sched->tasks[i].task_func != NULL) {
+            sched->heap[sched->heap_size++] = i;
+        }
+    }
+    for (int i = sched->heap_size / 2 - 1; i >= 0; i--) {
+        heap_sift_down(sched, (uint8_t)i);
+    }
+    sched->heap_dirty = 0;
+}
+
+/**
+ * @brief 计算任务的下一次运行时间（无漂移）
+ */
+static void task_advance(scheduler_t *sched, scheduler_task_t *task, uint32_t now)
+{
+    task->next_run += task->period_ms;
+
+    if (task->period_ms == 0) {
+        task->next_run = now;
+        return;
+    }
+
+    /* 跳过策略：丢弃已错过的周期，保持原有相位 */
+    if (sched->overrun == SCHEDULER_OVERRUN_SKIP && !SCHED_TIME_BEFORE(now, task->next_run)) {
+        uint32_t missed = (now - task->next_run) / task->period_ms + 1;
+        task->next_run += missed * task->period_ms;
+    }
+}
+
+/* ======================= 优先级/EDF 排序与预算保护 ======================= */
+
+/**
+ * @brief 任务的绝对截止时间 = 本次释放时间 + 相对截止时间（默认为周期）
+ */
+static uint32_t task_abs_deadline(const scheduler_task_t *task)
+{
+    return task->next_run + (task->deadline_ms ? task->deadline_ms : task->period_ms);
+}
+
+/**
+ * @brief 判断任务 a 是否应先于任务 b 运行
+ */
+static int task_runs_before(scheduler_t *sched, uint8_t a, uint8_t b)
+{
+    const scheduler_task_t *ta = &sched->tasks[a];
+    const scheduler_task_t *tb = &sched->tasks[b];
+
+    if (sched->mode == SCHEDULER_MODE_EDF) {
+        uint32_t da = task_abs_deadline(ta);
+        uint32_t db = task_abs_deadline(tb);
+        if (da != db) {
+            return SCHED_TIME_BEFORE(da, db);
+        }
+    }
+
+    if (ta->priority != tb->priority) {
+        return ta->priority < tb->priority;
+    }
+    if (ta->next_run != tb->next_run) {
+        return SCHED_TIME_BEFORE(ta->next_run, tb->next_run);
+    }
+    return a < b;
+}
+
+/**
+ * @brief 按优先级或截止时间对本轮到期任务排序（任务数少，插入排序即可）
+ */
+static void due_sort(scheduler_t *sched, uint8_t *due, uint8_t count)
+{
+    for (uint8_t i = 1; i < count; i++) {
+        uint8_t key = due[i];
+        uint8_t j = i;
+        while (j > 0 && task_runs_before(sched, key, due[j - 1])) {
+            due[j] = due[j - 1];
+            j--;
+        }
+        due[j] = key;
+    }
+}
+
+/**
+ * @brief 本次 scheduler_run() 的时间片预算是否已用完（仅对受限优先级的任务）
+ * @param start: 本次 scheduler_run() 开始时的计时值
+ */
+static int budget_exhausted(scheduler_t *sched, const scheduler_task_t *task, uint32_t start)
+{
+    if (sched->budget_clock == NULL || task->priority < sched->budget_priority) {
+        return 0;
+    }
+
+    return (uint32_t)(sched->budget_clock() - start) >= sched->budget_ticks;
+}
+
+/* ======================= 运行统计 ======================= */
+
+#if SCHEDULER_ENABLE_STATS
+static void stats_clear(scheduler_stats_t *stats)
+{
+    stats->run_count = 0;
+    stats->exec_min = 0xFFFFFFFFu;
+    stats->exec_max = 0;
+    stats->exec_total = 0;
+    for (int i = 0; i < SCHEDULER_STATS_HIST_BINS; i++) {
+        stats->exec_hist[i] = 0;
+    }
+    stats->jitter_max = 0;
+    stats->jitter_total = 0;
+    stats->missed = 0;
+    stats->deferred = 0;
+}
+
+/**
+ * @brief 记录一次任务运行
+ * @param release_ms: 本次的理想释放时间
+ * @param exec_ticks: 执行时间（时间戳单位），未安装时间戳源时为 0
+ */
+static void stats_record(scheduler_t *sched, scheduler_task_t *task, uint32_t release_ms,
+                         uint32_t now_ms, uint32_t exec_ticks)
+{
+    scheduler_stats_t *stats = &task->stats;
+    uint32_t jitter = SCHED_TIME_BEFORE(release_ms, now_ms) ? (now_ms - release_ms) : 0;
+
+    /* 首次运行的释放时间是人为设定的起点（轮询模式为 0 + 周期），启动延迟不计入抖动，
+     * 也不作为错过截止时间的依据，只看执行时间 */
+    if (stats->run_count > 0) {
+        if (jitter > stats->jitter_max) {
+            stats->jitter_max = jitter;
+        }
+        stats->jitter_total += jitter;
+    } else {
+        jitter = 0;
+    }
+    stats->run_count++;
+
+    /* 启动延迟 + 执行时间超过一个周期即视为错过截止时间 */
+    if (task->period_ms > 0 &&
+        (uint64_t)jitter * sched->ticks_per_ms + exec_ticks > (uint64_t)task->period_ms * sched->ticks_per_ms) {
+        stats->missed++;
+    }
+
+    if (sched->timestamp == NULL) {
+        return;
+    }
+
+    if (exec_ticks < stats->exec_min) {
+        stats->exec_min = exec_ticks;
+    }
+    if (exec_ticks > stats->exec_max) {
+        stats->exec_max = exec_ticks;
+    }
+    stats->exec_total += exec_ticks;
+    sched->busy_ticks += exec_ticks;
+
+    int bin = 0;
+    uint32_t limit = sched->hist_unit;
+    while (bin < SCHEDULER_STATS_HIST_BINS - 1 && exec_ticks >= limit) {
+        limit <<= 1;
+        bin++;
+    }
+    stats->exec_hist[bin]++;
+}
+#endif
+
+/* ======================= 协程任务 ======================= */
+
+/**
+ * @brief 协程任务占位函数，使协程任务通过 task_func != NULL 的有效性检查，不会被调用
+ */
+static void coro_entry(void)
+{
+}
+
+/**
+ * @brief 运行一次协程，并按返回状态调整下次运行时间
+ * @note 调用前下次运行时间已按周期推进，让出时保持不变
+ */
+static void coro_step(scheduler_task_t *task, uint32_t now_ms)
+{
+    scheduler_coro_t *co = task->coro;
+
+    co->now_ms = now_ms;
+
+    switch (co->func(co)) {
+    case SCHEDULER_CORO_SLEEP:
+        /* 截止时间类模式按 next_run 唤醒，轮询模式按 last_run + period_ms 唤醒 */
+        task->next_run = co->wake_ms;
+        task->last_run = co->wake_ms - task->period_ms;
+        break;
+    case SCHEDULER_CORO_DONE:
+        co->lc = 0;
+        task->enabled = 0;
+        break;
+    default:
+        break;
+    }
+}
+
+/**
+ * @brief 执行任务并记录统计
+ * @param release_ms: 本次的理想释放时间（仅统计使用）
+ */
+static void task_dispatch(scheduler_t *sched, scheduler_task_t *task, uint32_t release_ms,
+                          uint32_t now_ms)
+{
+#if SCHEDULER_ENABLE_STATS
+    scheduler_task_fn func = task->task_func;
+    scheduler_coro_t *co = task->coro;
+    uint32_t start = (sched->timestamp != NULL) ? sched->timestamp() : 0;
+
+    if (co != NULL) {
+        coro_step(task, now_ms);
+    } else {
+        func();
+    }
+
+    uint32_t exec_ticks = (sched->timestamp != NULL) ? (sched->timestamp() - start) : 0;
+
+    /* 任务函数移除/移动了任务时，该位置已不是原任务，丢弃本次统计 */
+    if (task->task_func == func && task->coro == co) {
+        stats_record(sched, task, release_ms, now_ms, exec_ticks);
+    }
+#else
+    (void)sched;
+    (void)release_ms;
+    if (task->coro != NULL) {
+        coro_step(task, now_ms);
+    } else {
+        task->task_func();
+    }
+#endif
+}
+
+/* ======================= 对外接口 ======================= */
+
 /**
  * @brief 初始化调度器
  */
@@ -18,13 +342,38 @@ void scheduler_init(scheduler_t *sched)
     }
 
     sched->task_count = 0;
+    sched->mode = SCHEDULER_MODE_SCAN;
+    sched->overrun = SCHEDULER_OVERRUN_CATCH_UP;
+    sched->heap_size = 0;
+    sched->in_run = 0;
+    sched->heap_dirty = 0;
+    sched->started = 0;
+    sched->now_ms = 0;
+    sched->budget_clock = NULL;
+    sched->budget_ticks = 0;
+    sched->budget_priority = SCHEDULER_PRIORITY_LOWEST;
 
     for (int i = 0; i < SCHEDULER_MAX_TASKS; i++) {
         sched->tasks[i].task_func = NULL;
+        sched->tasks[i].coro = NULL;
         sched->tasks[i].period_ms = 0;
         sched->tasks[i].last_run = 0;
+        sched->tasks[i].next_run = 0;
+        sched->tasks[i].deadline_ms = 0;
+        sched->tasks[i].priority = SCHEDULER_PRIORITY_HIGHEST;
         sched->tasks[i].enabled = 0;
+#if SCHEDULER_ENABLE_STATS
+        stats_clear(&sched->tasks[i].stats);
+#endif
     }
+
+#if SCHEDULER_ENABLE_STATS
+    sched->timestamp = NULL;
+    sched->ticks_per_ms = 1;
+    sched->hist_unit = 1;
+    sched->window_start = 0;
+    sched->busy_ticks = 0;
+#endif
 }
 
 /**
@@ -43,12 +392,50 @@ int scheduler_add_task(scheduler_t *sched, scheduler_task_fn task_func, uint32_t
     int index = sched->task_count;
 
     sched->tasks[index].task_func = task_func;
+    sched->tasks[index].coro = NULL;
     sched->tasks[index].period_ms = period_ms;
     sched->tasks[index].last_run = 0;
+    sched->tasks[index].next_run = sched->now_ms;  /* 截止时间模式下尽快首次运行 */
+    sched->tasks[index].deadline_ms = 0;
+    sched->tasks[index].priority = SCHEDULER_PRIORITY_HIGHEST;
     sched->tasks[index].enabled = 1;
+#if SCHEDULER_ENABLE_STATS
+    stats_clear(&sched->tasks[index].stats);
+#endif
 
     sched->task_count++;
 
+    if (SCHED_USE_HEAP(sched)) {
+        if (sched->in_run) {
+            sched->heap_dirty = 1;
+        } else {
+            heap_push(sched, (uint8_t)index);
+        }
+    }
+
+    return index;
+}
+
+/**
+ * @brief 添加协程任务到调度器
+ */
+int scheduler_add_coro(scheduler_t *sched, scheduler_coro_t *co, scheduler_coro_fn func, uint32_t period_ms)
+{
+    if (sched == NULL || co == NULL || func == NULL) {
+        return -1;
+    }
+
+    co->func = func;
+    co->now_ms = sched->now_ms;
+    co->wake_ms = sched->now_ms;
+    co->lc = 0;
+    co->timed_out = 0;
+
+    int index = scheduler_add_task(sched, coro_entry, period_ms);
+    if (index >= 0) {
+        sched->tasks[index].coro = co;
+    }
+
     return index;
 }
 
@@ -68,12 +455,19 @@ int scheduler_remove_task(scheduler_t *sched, int task_index)
 
     /* 清空最后一个位置 */
     sched->tasks[sched->task_count - 1].task_func = NULL;
+    sched->tasks[sched->task_count - 1].coro = NULL;
     sched->tasks[sched->task_count - 1].period_ms = 0;
     sched->tasks[sched->task_count - 1].last_run = 0;
+    sched->tasks[sched->task_count - 1].next_run = 0;
+    sched->tasks[sched->task_count - 1].deadline_ms = 0;
+    sched->tasks[sched->task_count - 1].priority = SCHEDULER_PRIORITY_HIGHEST;
     sched->tasks[sched->task_count - 1].enabled = 0;
 
     sched->task_count--;
 
+    /* 任务索引已变化，重建堆 */
+    heap_rebuild(sched);
+
     return 0;
 }
 
@@ -86,7 +480,15 @@ int scheduler_enable_task(scheduler_t *sched, int task_index, uint8_t enabled)
         return -1;
     }
 
-    sched->tasks[task_index].enabled = enabled ? 1 : 0;
+    enabled = enabled ? 1 : 0;
+
+    if (sched->tasks[task_index].enabled != enabled) {
+        sched->tasks[task_index].enabled = enabled;
+        if (enabled) {
+            sched->tasks[task_index].next_run = sched->now_ms;
+        }
+        heap_rebuild(sched);
+    }
 
     return 0;
 }
@@ -105,13 +507,189 @@ int scheduler_set_period(scheduler_t *sched, int task_index, uint32_t period_ms)
     return 0;
 }
 
+/**
+ * @brief 设置任务优先级
+ */
+int scheduler_set_priority(scheduler_t *sched, int task_index, uint8_t priority)
+{
+    if (sched == NULL || task_index < 0 || task_index >= sched->task_count) {
+        return -1;
+    }
+
+    sched->tasks[task_index].priority = priority;
+
+    return 0;
+}
+
+/**
+ * @brief 设置任务相对截止时间
+ */
+int scheduler_set_deadline(scheduler_t *sched, int task_index, uint32_t deadline_ms)
+{
+    if (sched == NULL || task_index < 0 || task_index >= sched->task_count) {
+        return -1;
+    }
+
+    sched->tasks[task_index].deadline_ms = deadline_ms;
+
+    return 0;
+}
+
+/**
+ * @brief 设置时间片预算保护
+ */
+int scheduler_set_budget(scheduler_t *sched, scheduler_timestamp_fn clock,
+                         uint32_t budget_ticks, uint8_t min_priority)
+{
+    if (sched == NULL) {
+        return -1;
+    }
+
+    sched->budget_clock = clock;
+    sched->budget_ticks = budget_ticks;
+    sched->budget_priority = min_priority;
+
+    return 0;
+}
+
+/**
+ * @brief 设置调度模式
+ */
+int scheduler_set_mode(scheduler_t *sched, scheduler_mode_t mode)
+{
+    if (sched == NULL || sched->in_run) {
+        return -1;
+    }
+
+    if (mode != SCHEDULER_MODE_SCAN && mode != SCHEDULER_MODE_DEADLINE &&
+        mode != SCHEDULER_MODE_PRIORITY && mode != SCHEDULER_MODE_EDF) {
+        return -1;
+    }
+
+    sched->mode = (uint8_t)mode;
+
+    if (SCHED_USE_HEAP(sched)) {
+        for (int i = 0; i < sched->task_count; i++) {
+            sched->tasks[i].next_run = sched->now_ms;
+        }
+        heap_rebuild(sched);
+    } else {
+        sched->heap_size = 0;
+    }
+
+    return 0;
+}
+
+/**
+ * @brief 设置超时处理策略
+ */
+int scheduler_set_overrun_policy(scheduler_t *sched, scheduler_overrun_t policy)
+{
+    if (sched == NULL) {
+        return -1;
+    }
+
+    if (policy != SCHEDULER_OVERRUN_CATCH_UP && policy != SCHEDULER_OVERRUN_SKIP) {
+        return -1;
+    }
+
+    sched->overrun = (uint8_t)policy;
+
+    return 0;
+}
+
+/**
+ * @brief 截止时间模式：只处理堆顶已到期的任务
+ */
+static uint32_t scheduler_run_deadline(scheduler_t *sched, uint32_t current_time_ms, uint32_t budget_start)
+{
+    uint8_t due[SCHEDULER_MAX_TASKS];
+    uint8_t due_count = 0;
+
+    /* 先取出全部到期任务，保证每个任务每次调用最多运行一次 */
+    while (sched->heap_size > 0 &&
+           !SCHED_TIME_BEFORE(current_time_ms, sched->tasks[sched->heap[0]].next_run)) {
+        due[due_count++] = heap_pop(sched);
+    }
+
+    /* 优先级/EDF 模式：同一轮到期的任务重新排序，堆顺序即为截止时间模式的顺序 */
+    if (sched->mode != SCHEDULER_MODE_DEADLINE) {
+        due_sort(sched, due, due_count);
+    }
+
+    sched->in_run = 1;
+
+    for (uint8_t i = 0; i < due_count; i++) {
+        scheduler_task_t *task = &sched->tasks[due[i]];
+
+        /* 预算用完：低优先级任务保持到期状态，推迟到下一次调用 */
+        if (budget_exhausted(sched, task, budget_start)) {
+#if SCHEDULER_ENABLE_STATS
+            task->stats.deferred++;
+#endif
+            heap_push(sched, due[i]);
+            continue;
+        }
+
+        uint32_t release = task->next_run;
+
+        task->last_run = current_time_ms;
+        task_advance(sched, task, current_time_ms);
+
+        /* 执行任务 */
+        task_dispatch(sched, task, release, current_time_ms);
+
+        /* 任务函数修改了任务表：剩余到期任务留待重建后的下一轮 */
+        if (sched->heap_dirty) {
+            break;
+        }
+
+        /* 协程结束时任务被禁用，不再入堆 */
+        if (task->enabled) {
+            heap_push(sched, due[i]);
+        }
+    }
+
+    sched->in_run = 0;
+
+    if (sched->heap_dirty) {
+        heap_rebuild(sched);
+    }
+
+    if (sched->heap_size == 0) {
+        return SCHEDULER_IDLE_FOREVER;
+    }
+
+    uint32_t next_run = sched->tasks[sched->heap[0]].next_run;
+    return SCHED_TIME_BEFORE(current_time_ms, next_run) ? (next_run - current_time_ms) : 0;
+}
+
 /**
  * @brief 运行调度器
  */
-void scheduler_run(scheduler_t *sched, uint32_t current_time_ms)
+uint32_t scheduler_run(scheduler_t *sched, uint32_t current_time_ms)
 {
+    uint32_t next_wait = SCHEDULER_IDLE_FOREVER;
+
     if (sched == NULL) {
-        return;
+        return SCHEDULER_IDLE_FOREVER;
+    }
+
+    uint32_t budget_start = (sched->budget_clock != NULL) ? sched->budget_clock() : 0;
+
+    sched->now_ms = current_time_ms;
+
+    /* 首次运行前 now_ms 无效，以首次调用时间作为所有任务的起点，避免追赶开机前的周期 */
+    if (!sched->started) {
+        sched->started = 1;
+        for (int i = 0; i < sched->task_count; i++) {
+            sched->tasks[i].next_run = current_time_ms;
+        }
+        heap_rebuild(sched);
+    }
+
+    if (SCHED_USE_HEAP(sched)) {
+        return scheduler_run_deadline(sched, current_time_ms, budget_start);
     }
 
     for (int i = 0; i < sched->task_count; i++) {
@@ -124,14 +702,123 @@ void scheduler_run(scheduler_t *sched, uint32_t current_time_ms)
 
         /* 检查是否到达执行时间 */
         if (current_time_ms >= task->last_run + task->period_ms) {
+            /* 预算用完：低优先级任务保持到期状态，推迟到下一次调用 */
+            if (budget_exhausted(sched, task, budget_start)) {
+#if SCHEDULER_ENABLE_STATS
+                task->stats.deferred++;
+#endif
+                next_wait = 0;
+                continue;
+            }
+
+            uint32_t release = task->last_run + task->period_ms;
+
             /* 更新上次运行时间 */
             task->last_run = current_time_ms;
 
             /* 执行任务 */
-            task->task_func();
+            task_dispatch(sched, task, release, current_time_ms);
+
+            /* 协程已结束，任务被禁用 */
+            if (!task->enabled) {
+                continue;
+            }
+        }
+
+        /* 记录最近的到期时间 */
+        uint32_t due_time = task->last_run + task->period_ms;
+        uint32_t wait = (current_time_ms >= due_time) ? 0 : (due_time - current_time_ms);
+        if (wait < next_wait) {
+            next_wait = wait;
         }
     }
+
+    return next_wait;
+}
+
+#if SCHEDULER_ENABLE_STATS
+/**
+ * @brief 安装统计用时间戳源
+ */
+int scheduler_stats_install(scheduler_t *sched, scheduler_timestamp_fn timestamp, uint32_t ticks_per_ms)
+{
+    if (sched == NULL || ticks_per_ms == 0) {
+        return -1;
+    }
+
+    sched->timestamp = timestamp;
+    sched->ticks_per_ms = ticks_per_ms;
+
+    /* 直方图第 0 桶为 1/64 毫秒以内 */
+    sched->hist_unit = ticks_per_ms / 64;
+    if (sched->hist_unit == 0) {
+        sched->hist_unit = 1;
+    }
+
+    scheduler_stats_reset(sched);
+
+    return 0;
+}
+
+/**
+ * @brief 清空统计数据
+ */
+void scheduler_stats_reset(scheduler_t *sched)
+{
+    if (sched == NULL) {
+        return;
+    }
+
+    for (int i = 0; i < sched->task_count; i++) {
+        stats_clear(&sched->tasks[i].stats);
+    }
+
+    sched->busy_ticks = 0;
+    sched->window_start = (sched->timestamp != NULL) ? sched->timestamp() : 0;
+}
+
+/**
+ * @brief 获取任务统计数据
+ */
+const scheduler_stats_t *scheduler_get_task_stats(scheduler_t *sched, int task_index)
+{
+    if (sched == NULL || task_index < 0 || task_index >= sched->task_count) {
+        return NULL;
+    }
+
+    return &sched->tasks[task_index].stats;
+}
+
+/**
+ * @brief 获取任务平均执行时间
+ */
+uint32_t scheduler_stats_exec_mean(const scheduler_stats_t *stats)
+{
+    if (stats == NULL || stats->run_count == 0) {
+        return 0;
+    }
+
+    return (uint32_t)(stats->exec_total / stats->run_count);
+}
+
+/**
+ * @brief 获取 CPU 占用率
+ */
+uint16_t scheduler_get_cpu_load(scheduler_t *sched)
+{
+    if (sched == NULL || sched->timestamp == NULL) {
+        return 0;
+    }
+
+    uint32_t elapsed = sched->timestamp() - sched->window_start;
+    if (elapsed == 0) {
+        return 0;
+    }
+
+    uint64_t load = sched->busy_ticks * 1000u / elapsed;
+    return (uint16_t)(load > 1000u ? 1000u : load);
 }
+#endif
 
 /**
  * @brief 获取任务数量
@@ -27,21 +27,194 @@ extern "C" {
 #define SCHEDULER_MAX_TASKS 16  /* 最大任务数量 */
 #endif
 
+/* 任务运行统计（执行时间/抖动/超时/CPU 占用），关闭时不占用任何空间和时间 */
+#ifndef SCHEDULER_ENABLE_STATS
+#define SCHEDULER_ENABLE_STATS 0
+#endif
+
+#ifndef SCHEDULER_STATS_HIST_BINS
+#define SCHEDULER_STATS_HIST_BINS 8  /* 执行时间直方图桶数（按 2 的幂划分，最后一桶为溢出桶） */
+#endif
+
+/* 任务优先级：数值越小优先级越高 */
+#define SCHEDULER_PRIORITY_HIGHEST  0
+#define SCHEDULER_PRIORITY_LOWEST   255
+
+/* scheduler_run() 返回值：没有待运行的任务，可无限期休眠 */
+#define SCHEDULER_IDLE_FOREVER 0xFFFFFFFFu
+
+/* 调度模式 */
+typedef enum {
+    SCHEDULER_MODE_SCAN = 0,    /* 轮询模式：每次遍历全部任务，last_run 对齐到当前时间（默认） */
+    SCHEDULER_MODE_DEADLINE,    /* 截止时间模式：按下次运行时间排序的最小堆，next_run += period 无漂移 */
+    SCHEDULER_MODE_PRIORITY,    /* 优先级模式：同截止时间模式，同一轮到期的任务按优先级先后运行 */
+    SCHEDULER_MODE_EDF          /* 最早截止优先：同截止时间模式，同一轮到期的任务按绝对截止时间先后运行 */
+} scheduler_mode_t;
+
+/* 截止时间模式下任务超时（错过一个或多个周期）的处理策略 */
+typedef enum {
+    SCHEDULER_OVERRUN_CATCH_UP = 0, /* 追赶：每次调用补跑一次，直到追上原有节拍 */
+    SCHEDULER_OVERRUN_SKIP          /* 跳过：丢弃错过的周期，保持原有相位 */
+} scheduler_overrun_t;
+
 /* 任务函数类型 */
 typedef void (*scheduler_task_fn)(void);
 
+/* 高精度时间戳函数类型（如 DWT->CYCCNT、微秒定时器） */
+typedef uint32_t (*scheduler_timestamp_fn)(void);
+
+/* 协程任务单次运行的返回状态 */
+typedef enum {
+    SCHEDULER_CORO_YIELDED = 0, /* 让出：按周期再次运行（条件等待在此时重新判断） */
+    SCHEDULER_CORO_SLEEP,       /* 休眠：到 wake_ms 时再次运行 */
+    SCHEDULER_CORO_DONE         /* 结束：任务被禁用，重新使能后从头开始 */
+} scheduler_coro_status_t;
+
+typedef struct scheduler_coro scheduler_coro_t;
+
+/* 协程任务函数类型 */
+typedef scheduler_coro_status_t (*scheduler_coro_fn)(scheduler_coro_t *co);
+
+/* 协程控制块（无独立栈，局部变量在让出后不保留，需放在 static 或 arg 指向的结构体中） */
+struct scheduler_coro {
+    scheduler_coro_fn func;       /* 协程函数 */
+    void *arg;                    /* 用户参数，调度器不访问 */
+    uint32_t now_ms;              /* 本次运行时的调度时间（由调度器填写） */
+    uint32_t wake_ms;             /* 休眠唤醒时间 / 等待超时时间 */
+    uint16_t lc;                  /* 恢复位置（行号），0 表示从头开始 */
+    uint8_t timed_out;            /* 最近一次 SCHEDULER_CORO_AWAIT_TIMEOUT 是否超时 */
+};
+
+/*
+ * 协程宏（protothread 风格，基于 switch/__LINE__）
+ * - 协程函数体必须以 SCHEDULER_CORO_BEGIN 开始、SCHEDULER_CORO_END 结束
+ * - 协程函数内不能再使用 switch 跨越等待点
+ * - 条件等待的轮询间隔为任务周期（0 表示每次 scheduler_run() 都判断）
+ */
+#define SCHEDULER_CORO_BEGIN(co)        switch ((co)->lc) { case 0:
+
+/* 等待宏记录恢复位置后有意落入下一个 case，宏内的注释无法抑制 -Wimplicit-fallthrough，需用属性标注 */
+#if defined(__has_attribute)
+#if __has_attribute(fallthrough)
+#define SCHEDULER_CORO_FALLTHROUGH      __attribute__((fallthrough))
+#endif
+#endif
+#ifndef SCHEDULER_CORO_FALLTHROUGH
+#define SCHEDULER_CORO_FALLTHROUGH      ((void)0)
+#endif
+
+#define SCHEDULER_CORO_END(co)          } (co)->lc = 0; return SCHEDULER_CORO_DONE
+
+/* 让出一次，下个周期继续 */
+#define SCHEDULER_CORO_YIELD(co)                        \
+    do {                                                \
+        (co)->lc = __LINE__;                            \
+        return SCHEDULER_CORO_YIELDED;                  \
+        case __LINE__:;                                 \
+    } while (0)
+
+/* 休眠 ms 毫秒后继续（不占用 CPU，替代 HAL_Delay） */
+#define SCHEDULER_CORO_DELAY(co, ms)                    \
+    do {                                                \
+        (co)->wake_ms = (co)->now_ms + (uint32_t)(ms);  \
+        (co)->lc = __LINE__;                            \
+        return SCHEDULER_CORO_SLEEP;                    \
+        case __LINE__:;                                 \
+    } while (0)
+
+/* 等待条件成立（如标志位、环形缓冲区数据长度） */
+#define SCHEDULER_CORO_AWAIT(co, cond)                  \
+    do {                                                \
+        (co)->lc = __LINE__;                            \
+        SCHEDULER_CORO_FALLTHROUGH;                     \
+        case __LINE__:                                  \
+        if (!(cond)) {                                  \
+            return SCHEDULER_CORO_YIELDED;              \
+        }                                               \
+    } while (0)
+
+/* 等待条件成立，最多 ms 毫秒；超时后 (co)->timed_out 置 1 */
+#define SCHEDULER_CORO_AWAIT_TIMEOUT(co, cond, ms)      \
+    do {                                                \
+        (co)->wake_ms = (co)->now_ms + (uint32_t)(ms);  \
+        (co)->timed_out = 0;                            \
+        (co)->lc = __LINE__;                            \
+        SCHEDULER_CORO_FALLTHROUGH;                     \
+        case __LINE__:                                  \
+        if (!(cond)) {                                  \
+            if ((int32_t)((co)->now_ms - (co)->wake_ms) < 0) { \
+                return SCHEDULER_CORO_YIELDED;          \
+            }                                           \
+            (co)->timed_out = 1;                        \
+        }                                               \
+    } while (0)
+
+/* 等待标志位非 0 并清零（标志位通常由中断置位） */
+#define SCHEDULER_CORO_AWAIT_FLAG(co, flag)             \
+    do {                                                \
+        SCHEDULER_CORO_AWAIT(co, *(flag));              \
+        *(flag) = 0;                                    \
+    } while (0)
+
+/* 提前结束协程 */
+#define SCHEDULER_CORO_EXIT(co)                         \
+    do {                                                \
+        (co)->lc = 0;                                   \
+        return SCHEDULER_CORO_DONE;                     \
+    } while (0)
+
+#if SCHEDULER_ENABLE_STATS
+/* 任务运行统计 */
+typedef struct {
+    uint32_t run_count;                         /* 运行次数 */
+    uint32_t exec_min;                          /* 最短执行时间（时间戳单位） */
+    uint32_t exec_max;                          /* 最长执行时间（时间戳单位） */
+    uint64_t exec_total;                        /* 累计执行时间（时间戳单位） */
+    uint32_t exec_hist[SCHEDULER_STATS_HIST_BINS]; /* 执行时间直方图，第 i 桶 < hist_unit * 2^i */
+    uint32_t jitter_max;                        /* 相对理想释放时间的最大启动延迟（毫秒） */
+    uint32_t jitter_total;                      /* 累计启动延迟（毫秒） */
+    uint32_t missed;                            /* 错过截止时间（释放时间 + 周期）的次数 */
+    uint32_t deferred;                          /* 因时间片预算用完被推迟的次数 */
+} scheduler_stats_t;
+#endif
+
 /* 任务结构体 */
 typedef struct {
     scheduler_task_fn task_func;  /* 任务函数指针 */
+    scheduler_coro_t *coro;       /* 协程控制块，NULL 表示普通任务 */
     uint32_t period_ms;           /* 执行周期（毫秒） */
     uint32_t last_run;            /* 上次执行时间 */
+    uint32_t next_run;            /* 下次计划执行时间（截止时间模式） */
+    uint32_t deadline_ms;         /* 相对截止时间（EDF 模式），0 表示等于周期 */
+    uint8_t priority;             /* 优先级，0 最高（默认） */
     uint8_t enabled;              /* 任务使能标志 */
+#if SCHEDULER_ENABLE_STATS
+    scheduler_stats_t stats;      /* 运行统计 */
+#endif
 } scheduler_task_t;
 
 /* 调度器结构体 */
 typedef struct {
     scheduler_task_t tasks[SCHEDULER_MAX_TASKS];  /* 任务数组 */
     uint8_t task_count;                           /* 当前任务数量 */
+    uint8_t mode;                                 /* 调度模式 scheduler_mode_t */
+    uint8_t overrun;                              /* 超时策略 scheduler_overrun_t */
+    uint8_t heap_size;                            /* 堆中任务数（截止时间模式） */
+    uint8_t in_run;                               /* 正在 scheduler_run() 中分发任务 */
+    uint8_t heap_dirty;                           /* 分发期间任务表被修改，需要重建堆 */
+    uint8_t started;                              /* 已调用过 scheduler_run()，now_ms 有效 */
+    uint8_t heap[SCHEDULER_MAX_TASKS];            /* 按 next_run 排序的任务索引最小堆 */
+    uint32_t now_ms;                              /* 最近一次 scheduler_run() 的时间 */
+    scheduler_timestamp_fn budget_clock;          /* 时间片预算计时源，NULL 表示不限制 */
+    uint32_t budget_ticks;                        /* 每次 scheduler_run() 的时间片预算 */
+    uint8_t budget_priority;                      /* 优先级数值 >= 该值的任务受预算限制 */
+#if SCHEDULER_ENABLE_STATS
+    scheduler_timestamp_fn timestamp;             /* 时间戳源，NULL 时只统计抖动和超时 */
+    uint32_t ticks_per_ms;                        /* 每毫秒的时间戳计数 */
+    uint32_t hist_unit;                           /* 直方图基本单位（时间戳计数） */
+    uint32_t window_start;                        /* 统计窗口起点（时间戳） */
+    uint64_t busy_ticks;                          /* 统计窗口内任务累计执行时间 */
+#endif
 } scheduler_t;
 
 /**
@@ -59,6 +232,18 @@ void scheduler_init(scheduler_t *sched);
  */
 int scheduler_add_task(scheduler_t *sched, scheduler_task_fn task_func, uint32_t period_ms);
 
+/**
+ * @brief 添加协程任务到调度器
+ * @param sched: 调度器指针
+ * @param co: 协程控制块（需长期有效，如 static 变量）
+ * @param func: 协程函数
+ * @param period_ms: 让出/条件等待时的轮询周期（毫秒），0 表示每次 scheduler_run() 都运行
+ * @retval 任务索引，-1表示失败
+ * @note 协程从头开始运行；返回 SCHEDULER_CORO_DONE 后任务被禁用，
+ *       scheduler_enable_task() 重新使能后再次从头运行
+ */
+int scheduler_add_coro(scheduler_t *sched, scheduler_coro_t *co, scheduler_coro_fn func, uint32_t period_ms);
+
 /**
  * @brief 移除任务
  * @param sched: 调度器指针
@@ -85,12 +270,105 @@ int scheduler_enable_task(scheduler_t *sched, int task_index, uint8_t enabled);
  */
 int scheduler_set_period(scheduler_t *sched, int task_index, uint32_t period_ms);
 
+/**
+ * @brief 设置调度模式
+ * @param sched: 调度器指针
+ * @param mode: 调度模式
+ * @retval 0: 成功, -1: 失败
+ * @note 切换到截止时间/优先级/EDF 模式后，各任务在下一次 scheduler_run() 时立即运行一次，
+ *       之后按 next_run += period_ms 无漂移地周期运行
+ */
+int scheduler_set_mode(scheduler_t *sched, scheduler_mode_t mode);
+
+/**
+ * @brief 设置任务优先级
+ * @param sched: 调度器指针
+ * @param task_index: 任务索引
+ * @param priority: 优先级，0 最高
+ * @retval 0: 成功, -1: 失败
+ * @note 优先级模式下决定同一轮到期任务的运行顺序，EDF 模式下截止时间相同时使用；
+ *       各模式下均用于时间片预算保护
+ */
+int scheduler_set_priority(scheduler_t *sched, int task_index, uint8_t priority);
+
+/**
+ * @brief 设置任务相对截止时间（EDF 模式）
+ * @param sched: 调度器指针
+ * @param task_index: 任务索引
+ * @param deadline_ms: 释放后须在多少毫秒内完成，0 表示等于周期
+ * @retval 0: 成功, -1: 失败
+ */
+int scheduler_set_deadline(scheduler_t *sched, int task_index, uint32_t deadline_ms);
+
+/**
+ * @brief 设置时间片预算保护
+ * @param sched: 调度器指针
+ * @param clock: 计时源（如 DWT->CYCCNT），NULL 表示关闭预算保护
+ * @param budget_ticks: 每次 scheduler_run() 允许的分发时间（计时源单位）
+ * @param min_priority: 优先级数值 >= min_priority 的任务在预算用完后推迟到下一次调用
+ * @retval 0: 成功, -1: 失败
+ * @note 被推迟的任务保持到期状态，scheduler_run() 返回 0；高于 min_priority 的任务不受影响
+ */
+int scheduler_set_budget(scheduler_t *sched, scheduler_timestamp_fn clock,
+                         uint32_t budget_ticks, uint8_t min_priority);
+
+/**
+ * @brief 设置截止时间模式下的超时处理策略
+ * @param sched: 调度器指针
+ * @param policy: 超时策略
+ * @retval 0: 成功, -1: 失败
+ */
+int scheduler_set_overrun_policy(scheduler_t *sched, scheduler_overrun_t policy);
+
 /**
  * @brief 运行调度器（需周期性调用）
  * @param sched: 调度器指针
  * @param current_time_ms: 当前系统时间（毫秒）
+ * @retval 距离下一个任务到期的毫秒数，0表示已有任务到期，
+ *         SCHEDULER_IDLE_FOREVER 表示没有使能的任务；主循环可据此进入 WFI/休眠
+ */
+uint32_t scheduler_run(scheduler_t *sched, uint32_t current_time_ms);
+
+#if SCHEDULER_ENABLE_STATS
+/**
+ * @brief 安装统计用时间戳源
+ * @param sched: 调度器指针
+ * @param timestamp: 时间戳函数，NULL 表示只统计抖动和超时
+ * @param ticks_per_ms: 每毫秒的时间戳计数（如 CYCCNT 在 168MHz 下为 168000）
+ * @retval 0: 成功, -1: 失败
+ * @note 同时清空所有统计数据
  */
-void scheduler_run(scheduler_t *sched, uint32_t current_time_ms);
+int scheduler_stats_install(scheduler_t *sched, scheduler_timestamp_fn timestamp, uint32_t ticks_per_ms);
+
+/**
+ * @brief 清空所有任务的统计数据并开始新的 CPU 占用统计窗口
+ * @param sched: 调度器指针
+ * @note 32 位时间戳回绕前应调用一次（如遥测任务每秒上报后调用）
+ */
+void scheduler_stats_reset(scheduler_t *sched);
+
+/**
+ * @brief 获取任务统计数据
+ * @param sched: 调度器指针
+ * @param task_index: 任务索引
+ * @retval 统计数据指针，失败返回 NULL
+ */
+const scheduler_stats_t *scheduler_get_task_stats(scheduler_t *sched, int task_index);
+
+/**
+ * @brief 获取任务平均执行时间
+ * @param stats: 统计数据指针
+ * @retval 平均执行时间（时间戳单位）
+ */
+uint32_t scheduler_stats_exec_mean(const scheduler_stats_t *stats);
+
+/**
+ * @brief 获取统计窗口内的 CPU 占用率
+ * @param sched: 调度器指针
+ * @retval 千分比（0~1000），未安装时间戳源时返回 0
+ */
+uint16_t scheduler_get_cpu_load(scheduler_t *sched);
+#endif
 
 /**
  * @brief 获取任务数量
@@ -7,8 +7,90 @@
  */
 
 #include "usart_pack.h"
+#include "usart_pack_crc.h"
 #include <string.h>
 
+/**
+ * @brief 校验字段字节数
+ */
+static uint8_t usart_pack_check_size(uint8_t check)
+{
+    switch (check) {
+        case USART_PACK_CHECK_CRC16: return 2;
+        case USART_PACK_CHECK_CRC32: return 4;
+        default:                     return 1;
+    }
+}
+
+/**
+ * @brief 计算校验值（覆盖帧头之后、校验字段之前的全部字节）
+ */
+static uint32_t usart_pack_check_calc(const usart_pack_t *pack, const uint8_t *data, uint16_t length)
+{
+    switch (pack->check) {
+        case USART_PACK_CHECK_CRC16: return usart_pack_crc16(data, length);
+        case USART_PACK_CHECK_CRC32: return usart_pack_crc32(data, length);
+        default:                     return usart_pack_sum(data, length);
+    }
+}
+
+/**
+ * @brief 按格式写出校验字段（大端）
+ */
+static void usart_pack_check_put(uint8_t check, uint8_t *p, uint32_t value)
+{
+    switch (check) {
+        case USART_PACK_CHECK_CRC16: usart_pack_put_SHORT(p, (uint16_t)value); break;
+        case USART_PACK_CHECK_CRC32: usart_pack_put_INT(p, value); break;
+        default:                     p[0] = (uint8_t)value; break;
+    }
+}
+
+/**
+ * @brief 类型字节数，未知类型为 0
+ */
+static uint8_t usart_pack_type_size(usart_pack_type_t type)
+{
+    switch (type) {
+        case PACK_TYPE_BYTE:  return 1;
+        case PACK_TYPE_SHORT: return 2;
+        case PACK_TYPE_INT:   return 4;
+        case PACK_TYPE_FLOAT: return 4;
+    }
+    return 0;
+}
+
+/**
+ * @brief 把模板编译为偏移表，打包/解析时不再逐个变量判断类型和计算大小
+ * @note 地址相邻的同类型变量（如 float 数组）合并为一项，一次分支处理整段
+ */
+static void usart_pack_compile(usart_pack_t *pack)
+{
+    uint16_t offset = 0;
+    uint16_t n = 0;
+
+    for (uint16_t i = 0; i < pack->count; i++) {
+        uint8_t size = usart_pack_type_size(pack->types[i]);
+        usart_pack_field_t *last = (n > 0) ? &pack->layout[n - 1] : NULL;
+
+        if (last != NULL && last->type == (uint8_t)pack->types[i] && last->count < 255 &&
+            last->var != NULL && pack->vars[i] != NULL &&
+            (uint8_t *)last->var + (size_t)last->count * size == (uint8_t *)pack->vars[i]) {
+            last->count++;
+        } else {
+            pack->layout[n].var = pack->vars[i];
+            pack->layout[n].offset = offset;
+            pack->layout[n].type = (uint8_t)pack->types[i];
+            pack->layout[n].count = 1;
+            n++;
+        }
+        offset += size;
+    }
+
+    pack->layout_count = n;
+    pack->data_size = offset;
+}
+
 /**
  * @brief 初始化协议实例
  */
@@ -26,6 +108,11 @@ void usart_pack_init(usart_pack_t *pack)
         pack->types[i] = PACK_TYPE_BYTE;
         pack->vars[i] = NULL;
     }
+
+    pack->layout_count = 0;
+    pack->data_size = 0;
+
+    usart_pack_set_format(pack, USART_PACK_CHECK_SUM8, 0);
 }
 
 /**
@@ -40,6 +127,45 @@ void usart_pack_init_custom(usart_pack_t *pack, uint8_t header, uint8_t tail)
     }
 }
 
+/**
+ * @brief 设置帧格式
+ */
+int usart_pack_set_format(usart_pack_t *pack, usart_pack_check_t check, uint8_t flags)
+{
+    if (pack == NULL) {
+        return -1;
+    }
+
+    if (check != USART_PACK_CHECK_SUM8 && check != USART_PACK_CHECK_CRC16 &&
+        check != USART_PACK_CHECK_CRC32) {
+        return -1;
+    }
+
+    if (flags & ~(USART_PACK_FLAG_LENGTH | USART_PACK_FLAG_SEQ)) {
+        return -1;
+    }
+
+    pack->check = (uint8_t)check;
+    pack->flags = flags;
+    pack->overhead = 2 + usart_pack_check_size(pack->check) +
+                     ((flags & USART_PACK_FLAG_LENGTH) ? 1 : 0) +
+                     ((flags & USART_PACK_FLAG_SEQ) ? 1 : 0);
+    pack->tx_seq = 0;
+    pack->rx_seq = 0;
+    pack->rx_seq_valid = 0;
+    pack->rx_lost = 0;
+
+    return 0;
+}
+
+/**
+ * @brief 获取按序号缺口统计的丢帧数
+ */
+uint32_t usart_pack_get_lost_frames(const usart_pack_t *pack)
+{
+    return pack ? pack->rx_lost : 0;
+}
+
 /**
  * @brief 设置解析/打包模板
  */
@@ -62,6 +188,7 @@ int usart_pack_set_template(usart_pack_t *pack,
     }
 
     pack->count = count;
+    usart_pack_compile(pack);
     return 0;
 }
 
@@ -81,6 +208,7 @@ int usart_pack_add_var(usart_pack_t *pack, usart_pack_type_t type, void *var)
     pack->types[pack->count] = type;
     pack->vars[pack->count] = var;
     pack->count++;
+    usart_pack_compile(pack);
 
     return 0;
 }
@@ -94,6 +222,8 @@ void usart_pack_clear(usart_pack_t *pack)
         return;
     }
     pack->count = 0;
+    pack->layout_count = 0;
+    pack->data_size = 0;
 }
 
 /**
@@ -105,16 +235,7 @@ uint16_t usart_pack_calc_data_size(usart_pack_t *pack)
         return 0;
     }
 
-    uint16_t size = 0;
-    for (uint16_t i = 0; i < pack->count; i++) {
-        switch (pack->types[i]) {
-            case PACK_TYPE_BYTE:  size += 1; break;
-            case PACK_TYPE_SHORT: size += 2; break;
-            case PACK_TYPE_INT:   size += 4; break;
-            case PACK_TYPE_FLOAT: size += 4; break;
-        }
-    }
-    return size;
+    return pack->data_size;
 }
 
 /**
@@ -122,153 +243,1048 @@ uint16_t usart_pack_calc_data_size(usart_pack_t *pack)
  */
 uint16_t usart_pack_calc_frame_size(usart_pack_t *pack)
 {
-    return usart_pack_calc_data_size(pack) + USART_PACK_MIN_FRAME_LEN;
+    if (pack == NULL) {
+        return 0;
+    }
+
+    return pack->data_size + pack->overhead;
 }
 
 /**
- * @brief 解析接收到的数据帧
+ * @brief 按预编译布局写出数据区，地址为 NULL 的变量写 0
  */
-int usart_pack_parse(usart_pack_t *pack, uint8_t *buffer, uint16_t length)
+static void usart_pack_pack_fields(const usart_pack_t *pack, uint8_t *data)
 {
-    if (pack == NULL || buffer == NULL) {
-        return -1;
-    }
-
-    /* 检查最小长度 */
-    if (length < USART_PACK_MIN_FRAME_LEN) {
-        return -1;
-    }
+    const usart_pack_field_t *f = pack->layout;
+    const usart_pack_field_t *end = f + pack->layout_count;
 
-    /* 检查帧头帧尾 */
-    if (buffer[0] != pack->header || buffer[length - 1] != pack->tail) {
-        return -1;
-    }
+    for (; f < end; f++) {
+        /* 先取到局部变量：经 uint8_t 指针的写入可能与布局表别名，否则每次都要重新读取 */
+        const void *var = f->var;
+        uint8_t count = f->count;
+        uint8_t *p = data + f->offset;
 
-    /* 校验和验证 */
-    uint16_t data_len = length - USART_PACK_MIN_FRAME_LEN;
-    uint8_t checksum = 0;
-    for (uint16_t i = 1; i <= data_len; i++) {
-        checksum += buffer[i];
-    }
-    if ((checksum & 0xFF) != buffer[length - 2]) {
-        return -2;
-    }
+        if (var == NULL) {
+            memset(p, 0, usart_pack_type_size((usart_pack_type_t)f->type));
+            continue;
+        }
 
-    /* 解析数据区 */
-    uint16_t idx = 1;  /* 跳过帧头 */
-    for (uint16_t i = 0; i < pack->count && idx < length - 2; i++) {
-        switch (pack->types[i]) {
+        switch (f->type) {
             case PACK_TYPE_BYTE:
             {
-                uint8_t *var = (uint8_t *)pack->vars[i];
-                *var = buffer[idx++];
+                const uint8_t *v = (const uint8_t *)var;
+                for (uint8_t k = 0; k < count; k++) {
+                    p[k] = v[k];
+                }
                 break;
             }
             case PACK_TYPE_SHORT:
             {
-                if (idx + 1 >= length - 2) return -1;
-                uint16_t *var = (uint16_t *)pack->vars[i];
-                /* 大端模式 */
-                *var = (buffer[idx] << 8) | buffer[idx + 1];
-                idx += 2;
+                const uint16_t *v = (const uint16_t *)var;
+                for (uint8_t k = 0; k < count; k++) {
+                    p = usart_pack_put_SHORT(p, v[k]);
+                }
                 break;
             }
             case PACK_TYPE_INT:
             {
-                if (idx + 3 >= length - 2) return -1;
-                uint32_t *var = (uint32_t *)pack->vars[i];
-                /* 大端模式 */
-                *var = ((uint32_t)buffer[idx] << 24) |
-                       ((uint32_t)buffer[idx + 1] << 16) |
-                       ((uint32_t)buffer[idx + 2] << 8) |
-                       buffer[idx + 3];
-                idx += 4;
+                const uint32_t *v = (const uint32_t *)var;
+                for (uint8_t k = 0; k < count; k++) {
+                    p = usart_pack_put_INT(p, v[k]);
+                }
                 break;
             }
             case PACK_TYPE_FLOAT:
             {
-                if (idx + 3 >= length - 2) return -1;
-                float *var = (float *)pack->vars[i];
-                /* 直接内存拷贝 (小端模式) */
-                memcpy(var, &buffer[idx], 4);
-                idx += 4;
+                const float *v = (const float *)var;
+                for (uint8_t k = 0; k < count; k++) {
+                    p = usart_pack_put_FLOAT(p, v[k]);
+                }
                 break;
             }
         }
     }
-
-    return 0;
 }
 
 /**
- * @brief 打包数据帧
+ * @brief 按预编译布局解析完整数据区，地址为 NULL 的变量跳过
  */
-uint16_t usart_pack_build(usart_pack_t *pack, uint8_t *buffer, uint16_t max_len)
+static void usart_pack_unpack_fields(const usart_pack_t *pack, const uint8_t *data)
 {
-    if (pack == NULL || buffer == NULL) {
-        return 0;
+    const usart_pack_field_t *f = pack->layout;
+    const usart_pack_field_t *end = f + pack->layout_count;
+
+    for (; f < end; f++) {
+        void *var = f->var;
+        uint8_t count = f->count;
+        const uint8_t *p = data + f->offset;
+
+        if (var == NULL) {
+            continue;
+        }
+
+        switch (f->type) {
+            case PACK_TYPE_BYTE:
+            {
+                uint8_t *v = (uint8_t *)var;
+                for (uint8_t k = 0; k < count; k++) {
+                    v[k] = p[k];
+                }
+                break;
+            }
+            case PACK_TYPE_SHORT:
+            {
+                uint16_t *v = (uint16_t *)var;
+                for (uint8_t k = 0; k < count; k++) {
+                    p = usart_pack_get_SHORT(p, &v[k]);
+                }
+                break;
+            }
+            case PACK_TYPE_INT:
+            {
+                uint32_t *v = (uint32_t *)var;
+                for (uint8_t k = 0; k < count; k++) {
+                    p = usart_pack_get_INT(p, &v[k]);
+                }
+                break;
+            }
+            case PACK_TYPE_FLOAT:
+            {
+                float *v = (float *)var;
+                for (uint8_t k = 0; k < count; k++) {
+                    p = usart_pack_get_FLOAT(p, &v[k]);
+                }
+                break;
+            }
+        }
     }
+}
 
-    uint16_t frame_size = usart_pack_calc_frame_size(pack);
-    if (max_len < frame_size) {
+/**
+ * @brief 按模板解析数据区，地址为 NULL 的变量跳过
+ * @retval 0: 成功, -1: 数据区长度不足
+ * @note 数据区不短于模板时走预编译布局，否则逐个变量解析到数据区结束为止
+ */
+static int usart_pack_unpack(usart_pack_t *pack, const uint8_t *data, uint16_t data_len)
+{
+    if (data_len >= pack->data_size) {
+        usart_pack_unpack_fields(pack, data);
         return 0;
     }
 
     uint16_t idx = 0;
+    for (uint16_t i = 0; i < pack->count && idx < data_len; i++) {
+        void *var = pack->vars[i];
 
-    /* 帧头 */
-    buffer[idx++] = pack->header;
-
-    /* 数据区 */
-    for (uint16_t i = 0; i < pack->count; i++) {
         switch (pack->types[i]) {
             case PACK_TYPE_BYTE:
             {
-                uint8_t *var = (uint8_t *)pack->vars[i];
-                buffer[idx++] = *var;
+                if (var != NULL) {
+                    *(uint8_t *)var = data[idx];
+                }
+                idx++;
                 break;
             }
             case PACK_TYPE_SHORT:
             {
-                uint16_t *var = (uint16_t *)pack->vars[i];
-                /* 大端模式 */
-                buffer[idx++] = (*var >> 8) & 0xFF;
-                buffer[idx++] = *var & 0xFF;
+                if (idx + 2 > data_len) return -1;
+                if (var != NULL) {
+                    /* 大端模式 */
+                    *(uint16_t *)var = (data[idx] << 8) | data[idx + 1];
+                }
+                idx += 2;
                 break;
             }
             case PACK_TYPE_INT:
             {
-                uint32_t *var = (uint32_t *)pack->vars[i];
-                /* 大端模式 */
-                buffer[idx++] = (*var >> 24) & 0xFF;
-                buffer[idx++] = (*var >> 16) & 0xFF;
-                buffer[idx++] = (*var >> 8) & 0xFF;
-                buffer[idx++] = *var & 0xFF;
+                if (idx + 4 > data_len) return -1;
+                if (var != NULL) {
+                    /* 大端模式 */
+                    *(uint32_t *)var = ((uint32_t)data[idx] << 24) |
+                                       ((uint32_t)data[idx + 1] << 16) |
+                                       ((uint32_t)data[idx + 2] << 8) |
+                                       data[idx + 3];
+                }
+                idx += 4;
                 break;
             }
             case PACK_TYPE_FLOAT:
             {
-                float *var = (float *)pack->vars[i];
-                /* 直接内存拷贝 (小端模式) */
-                uint8_t *bytes = (uint8_t *)var;
-                buffer[idx++] = bytes[0];
-                buffer[idx++] = bytes[1];
-                buffer[idx++] = bytes[2];
-                buffer[idx++] = bytes[3];
+                if (idx + 4 > data_len) return -1;
+                if (var != NULL) {
+                    /* 直接内存拷贝 (小端模式) */
+                    memcpy(var, &data[idx], 4);
+                }
+                idx += 4;
                 break;
             }
         }
     }
 
-    /* 校验和 */
-    uint8_t checksum = 0;
-    for (uint16_t i = 1; i < idx; i++) {
-        checksum += buffer[i];
+    return 0;
+}
+
+/**
+ * @brief 核对校验字段（覆盖帧头之后、校验字段之前的全部字节）
+ * @retval 0: 一致, -2: 校验错误
+ */
+static int usart_pack_check_verify(const usart_pack_t *pack, const uint8_t *buffer, uint32_t length)
+{
+    uint8_t check_size = usart_pack_check_size(pack->check);
+    uint16_t covered = (uint16_t)(length - 2 - check_size);
+    const uint8_t *p = &buffer[1 + covered];
+    uint32_t expect = usart_pack_check_calc(pack, &buffer[1], covered);
+    uint32_t actual;
+
+    switch (pack->check) {
+        case USART_PACK_CHECK_CRC16:
+        {
+            uint16_t v;
+            usart_pack_get_SHORT(p, &v);
+            actual = v;
+            break;
+        }
+        case USART_PACK_CHECK_CRC32:
+            usart_pack_get_INT(p, &actual);
+            break;
+        default:
+            actual = p[0];
+            break;
+    }
+
+    return (expect == actual) ? 0 : -2;
+}
+
+/**
+ * @brief 检查帧头、帧尾、长度字段和校验
+ * @param data_len: 输出数据区长度
+ * @retval 0: 成功, -1: 帧格式错误, -2: 校验错误
+ */
+static int usart_pack_verify(const usart_pack_t *pack, const uint8_t *buffer, uint16_t length,
+                             uint16_t *data_len)
+{
+    /* 检查最小长度 */
+    if (length < pack->overhead) {
+        return -1;
+    }
+
+    /* 检查帧头帧尾 */
+    if (buffer[0] != pack->header || buffer[length - 1] != pack->tail) {
+        return -1;
+    }
+
+    *data_len = length - pack->overhead;
+
+    /* 长度字段必须与实际数据区长度一致 */
+    if ((pack->flags & USART_PACK_FLAG_LENGTH) && buffer[1] != *data_len) {
+        return -1;
+    }
+
+    /* 校验（覆盖长度、序号和数据区） */
+    return usart_pack_check_verify(pack, buffer, length);
+}
+
+/**
+ * @brief 记录接收序号，缺口计入丢帧
+ * @note 序号回退（重复帧或对端重启）不计为丢帧
+ */
+static void usart_pack_rx_seq(usart_pack_t *pack, uint8_t seq)
+{
+    if (pack->rx_seq_valid) {
+        uint8_t gap = (uint8_t)(seq - pack->rx_seq - 1);
+        if (gap < 128) {
+            pack->rx_lost += gap;
+        }
+    }
+
+    pack->rx_seq = seq;
+    pack->rx_seq_valid = 1;
+}
+
+/**
+ * @brief 校验通过的帧：处理序号并解析数据区
+ */
+static int usart_pack_accept(usart_pack_t *pack, const uint8_t *buffer, uint16_t data_len)
+{
+    const uint8_t *p = &buffer[1];
+
+    if (pack->flags & USART_PACK_FLAG_LENGTH) {
+        p++;
+    }
+    if (pack->flags & USART_PACK_FLAG_SEQ) {
+        usart_pack_rx_seq(pack, *p++);
+    }
+
+    return usart_pack_unpack(pack, p, data_len);
+}
+
+/**
+ * @brief 解析接收到的数据帧
+ */
+int usart_pack_parse(usart_pack_t *pack, uint8_t *buffer, uint16_t length)
+{
+    uint16_t data_len;
+
+    if (pack == NULL || buffer == NULL) {
+        return -1;
+    }
+
+    int ret = usart_pack_verify(pack, buffer, length, &data_len);
+    if (ret != 0) {
+        return ret;
+    }
+
+    return usart_pack_accept(pack, buffer, data_len);
+}
+
+/**
+ * @brief 打包数据帧
+ */
+uint16_t usart_pack_build(usart_pack_t *pack, uint8_t *buffer, uint16_t max_len)
+{
+    if (pack == NULL || buffer == NULL) {
+        return 0;
+    }
+
+    uint16_t frame_size = usart_pack_calc_frame_size(pack);
+    if (max_len < frame_size) {
+        return 0;
+    }
+
+    /* 长度字段只有 1 字节 */
+    if ((pack->flags & USART_PACK_FLAG_LENGTH) && pack->data_size > 0xFF) {
+        return 0;
+    }
+
+    uint16_t idx = 0;
+
+    /* 帧头 */
+    buffer[idx++] = pack->header;
+
+    /* 可选字段 */
+    if (pack->flags & USART_PACK_FLAG_LENGTH) {
+        buffer[idx++] = (uint8_t)pack->data_size;
+    }
+    if (pack->flags & USART_PACK_FLAG_SEQ) {
+        buffer[idx++] = pack->tx_seq++;
     }
-    buffer[idx++] = checksum & 0xFF;
+
+    /* 数据区 */
+    usart_pack_pack_fields(pack, &buffer[idx]);
+    idx += pack->data_size;
+
+    /* 校验 */
+    usart_pack_check_put(pack->check, &buffer[idx], usart_pack_check_calc(pack, &buffer[1], idx - 1));
+    idx += usart_pack_check_size(pack->check);
 
     /* 帧尾 */
     buffer[idx++] = pack->tail;
 
     return idx;
 }
+
+/* ======================= 批量帧 ======================= */
+
+/**
+ * @brief 批量帧中样本区之前的字节数：帧头、序号、样本数、起始时间戳
+ */
+static uint16_t usart_pack_batch_prefix(const usart_pack_t *pack)
+{
+    return 1 + ((pack->flags & USART_PACK_FLAG_SEQ) ? 1 : 0) + USART_PACK_BATCH_HEAD_LEN;
+}
+
+/**
+ * @brief 样本区之前的全部字节数（含采样周期和载荷长度字段）
+ */
+static uint16_t usart_pack_batch_body(const usart_pack_t *pack, uint8_t count)
+{
+    return usart_pack_batch_prefix(pack) +
+           ((count & USART_PACK_BATCH_UNIFORM) ? USART_PACK_BATCH_STAMP_LEN : 0) +
+           ((count & USART_PACK_BATCH_DELTA) ? USART_PACK_BATCH_STAMP_LEN : 0);
+}
+
+/**
+ * @brief 变量位宽
+ */
+static uint8_t usart_pack_type_bits(usart_pack_type_t type)
+{
+    return (uint8_t)(usart_pack_type_size(type) * 8);
+}
+
+/**
+ * @brief 读取变量的原始位（float 按位读取），地址为 NULL 时为 0
+ */
+static uint32_t usart_pack_var_load(const usart_pack_t *pack, uint16_t i)
+{
+    const void *var = pack->vars[i];
+    uint32_t v = 0;
+
+    if (var == NULL) {
+        return 0;
+    }
+
+    switch (pack->types[i]) {
+        case PACK_TYPE_BYTE:  v = *(const uint8_t *)var; break;
+        case PACK_TYPE_SHORT: v = *(const uint16_t *)var; break;
+        case PACK_TYPE_INT:   v = *(const uint32_t *)var; break;
+        case PACK_TYPE_FLOAT: memcpy(&v, var, 4); break;
+    }
+    return v;
+}
+
+/**
+ * @brief 按原始位写回变量，地址为 NULL 时跳过
+ */
+static void usart_pack_var_store(usart_pack_t *pack, uint16_t i, uint32_t v)
+{
+    void *var = pack->vars[i];
+
+    if (var == NULL) {
+        return;
+    }
+
+    switch (pack->types[i]) {
+        case PACK_TYPE_BYTE:  *(uint8_t *)var = (uint8_t)v; break;
+        case PACK_TYPE_SHORT: *(uint16_t *)var = (uint16_t)v; break;
+        case PACK_TYPE_INT:   *(uint32_t *)var = v; break;
+        case PACK_TYPE_FLOAT: memcpy(var, &v, 4); break;
+    }
+}
+
+/**
+ * @brief 从数据区读取一个变量的原始位（SHORT/INT 大端，FLOAT 按内存布局）
+ */
+static const uint8_t *usart_pack_raw_load(usart_pack_type_t type, const uint8_t *p, uint32_t *v)
+{
+    switch (type) {
+        case PACK_TYPE_BYTE:
+            *v = p[0];
+            return p + 1;
+        case PACK_TYPE_SHORT:
+        {
+            uint16_t s;
+            p = usart_pack_get_SHORT(p, &s);
+            *v = s;
+            return p;
+        }
+        case PACK_TYPE_INT:
+            return usart_pack_get_INT(p, v);
+        case PACK_TYPE_FLOAT:
+            memcpy(v, p, 4);
+            return p + 4;
+    }
+    *v = 0;
+    return p;
+}
+
+/**
+ * @brief 写出 LEB128 变长整数，每字节 7 位，低位在前
+ */
+static uint8_t *usart_pack_put_varint(uint8_t *p, uint32_t v)
+{
+    while (v >= 0x80) {
+        *p++ = (uint8_t)(v | 0x80);
+        v >>= 7;
+    }
+    *p++ = (uint8_t)v;
+    return p;
+}
+
+/**
+ * @brief 读取 LEB128 变长整数
+ * @retval 下一个字节的位置, NULL 表示越界或超过 5 字节
+ */
+static const uint8_t *usart_pack_get_varint(const uint8_t *p, const uint8_t *end, uint32_t *v)
+{
+    uint32_t value = 0;
+
+    for (uint8_t shift = 0; shift < 35 && p < end; shift += 7) {
+        uint8_t b = *p++;
+        value |= (uint32_t)(b & 0x7F) << shift;
+        if ((b & 0x80) == 0) {
+            *v = value;
+            return p;
+        }
+    }
+    return NULL;
+}
+
+/**
+ * @brief 按位宽求差并做 zig-zag 映射：绝对值小的正负差都变成小的无符号数
+ */
+static uint32_t usart_pack_zigzag(uint32_t cur, uint32_t prev, uint8_t bits)
+{
+    uint32_t mask = (bits >= 32) ? 0xFFFFFFFFul : ((1ul << bits) - 1);
+    uint32_t d = (cur - prev) & mask;
+    uint32_t sign = (d >> (bits - 1)) & 1;
+
+    return ((d << 1) & mask) ^ (sign ? mask : 0);
+}
+
+static uint32_t usart_pack_unzigzag(uint32_t zz, uint32_t prev, uint8_t bits)
+{
+    uint32_t mask = (bits >= 32) ? 0xFFFFFFFFul : ((1ul << bits) - 1);
+    uint32_t d = (zz >> 1) ^ ((zz & 1) ? mask : 0);
+
+    return (prev + d) & mask;
+}
+
+/**
+ * @brief 计算未压缩批量帧字节数
+ */
+uint32_t usart_pack_batch_frame_size(const usart_pack_t *pack, uint8_t count)
+{
+    if (pack == NULL) {
+        return 0;
+    }
+
+    uint32_t samples = count & ~(USART_PACK_BATCH_UNIFORM | USART_PACK_BATCH_DELTA);
+    uint32_t size = usart_pack_batch_body(pack, count & USART_PACK_BATCH_UNIFORM) +
+                    usart_pack_check_size(pack->check) + 1;
+
+    if (count & USART_PACK_BATCH_UNIFORM) {
+        size += samples * pack->data_size;
+    } else {
+        size += samples * (USART_PACK_BATCH_STAMP_LEN + pack->data_size);
+    }
+
+    return size;
+}
+
+/**
+ * @brief 根据帧开头计算批量帧长度
+ */
+uint32_t usart_pack_batch_peek_size(const usart_pack_t *pack, const uint8_t *buffer, uint32_t avail)
+{
+    if (pack == NULL || buffer == NULL) {
+        return 0;
+    }
+
+    uint16_t count_pos = (pack->flags & USART_PACK_FLAG_SEQ) ? 2 : 1;
+    if (avail <= count_pos) {
+        return 0;
+    }
+
+    uint8_t count = buffer[count_pos];
+    if ((count & USART_PACK_BATCH_DELTA) == 0) {
+        return usart_pack_batch_frame_size(pack, count);
+    }
+
+    /* 压缩帧：载荷长度在样本区之前 */
+    uint16_t body = usart_pack_batch_body(pack, count);
+    if (avail < body) {
+        return 0;
+    }
+
+    uint16_t payload;
+    usart_pack_get_SHORT(&buffer[body - USART_PACK_BATCH_STAMP_LEN], &payload);
+
+    return (uint32_t)body + payload + usart_pack_check_size(pack->check) + 1;
+}
+
+/**
+ * @brief 样本区起始位置
+ */
+static uint16_t usart_pack_batch_start(const usart_pack_batch_t *batch)
+{
+    return usart_pack_batch_body(batch->pack, (batch->period ? USART_PACK_BATCH_UNIFORM : 0) |
+                                              (batch->delta ? USART_PACK_BATCH_DELTA : 0));
+}
+
+/**
+ * @brief 初始化批量帧发送端
+ */
+int usart_pack_batch_init(usart_pack_batch_t *batch, usart_pack_t *pack,
+                          uint8_t *buffer, uint16_t size, uint8_t max_samples, uint16_t period)
+{
+    if (batch == NULL || pack == NULL || buffer == NULL) {
+        return -1;
+    }
+
+    uint8_t uniform = period ? USART_PACK_BATCH_UNIFORM : 0;
+    uint32_t empty = usart_pack_batch_frame_size(pack, uniform);
+    uint32_t sample = usart_pack_batch_frame_size(pack, uniform | 1) - empty;
+    if (sample == 0) {
+        return -1;      /* 模板为空，样本没有数据 */
+    }
+
+    uint32_t fit = (size > empty) ? (size - empty) / sample : 0;
+    if (fit > USART_PACK_BATCH_MAX_SAMPLES) {
+        fit = USART_PACK_BATCH_MAX_SAMPLES;
+    }
+
+    if (fit == 0 || max_samples > fit) {
+        return -1;
+    }
+
+    batch->pack = pack;
+    batch->buf = buffer;
+    batch->size = size;
+    batch->max_samples = max_samples ? max_samples : (uint8_t)fit;
+    batch->count = 0;
+    batch->period = period;
+    batch->t0 = 0;
+    batch->delta = 0;
+    batch->idx = usart_pack_batch_start(batch);
+
+    return 0;
+}
+
+/**
+ * @brief 开启/关闭增量压缩
+ */
+int usart_pack_batch_set_delta(usart_pack_batch_t *batch, uint8_t enable)
+{
+    if (batch == NULL || batch->count != 0) {
+        return -1;
+    }
+
+    if (!enable) {
+        batch->delta = 0;
+        batch->idx = usart_pack_batch_start(batch);
+        return 0;
+    }
+
+    /* 最坏情况：每个变量的变长整数比原始数据多 1 字节，时间偏移增量 3 字节 */
+    const usart_pack_t *pack = batch->pack;
+    uint16_t worst = pack->data_size + pack->count + (batch->period ? 0 : 3);
+    uint16_t tail = usart_pack_check_size(pack->check) + 1;
+
+    batch->delta = 1;
+    batch->worst = worst;
+    batch->idx = usart_pack_batch_start(batch);
+
+    if ((uint32_t)batch->idx + worst + tail > batch->size) {
+        batch->delta = 0;
+        batch->idx = usart_pack_batch_start(batch);
+        return -1;
+    }
+
+    if (batch->max_samples > USART_PACK_BATCH_MAX_DELTA_SAMPLES) {
+        batch->max_samples = USART_PACK_BATCH_MAX_DELTA_SAMPLES;
+    }
+
+    return 0;
+}
+
+/**
+ * @brief 增量压缩一个样本：首个样本写原始数据区，之后写各变量差值的变长整数
+ */
+static uint8_t *usart_pack_batch_encode(usart_pack_batch_t *batch, uint8_t *p, uint16_t dt)
+{
+    const usart_pack_t *pack = batch->pack;
+    uint32_t *prev = batch->prev;
+
+    if (batch->period == 0) {
+        p = usart_pack_put_varint(p, (uint16_t)(dt - batch->last_dt));
+        batch->last_dt = dt;
+    }
+
+    if (batch->count == 0) {
+        /* 关键帧：基准值从刚写出的数据区取回，与解码端一致；
+         * 不再读一次变量，避免中断在两次读取之间改写变量使后续差值整体错位 */
+        const uint8_t *q = p;
+
+        usart_pack_pack_fields(pack, p);
+        for (uint16_t i = 0; i < pack->count; i++) {
+            q = usart_pack_raw_load(pack->types[i], q, &prev[i]);
+        }
+        return p + pack->data_size;
+    }
+
+    for (uint16_t i = 0; i < pack->count; i++) {
+        uint32_t cur = usart_pack_var_load(pack, i);
+        p = usart_pack_put_varint(p, usart_pack_zigzag(cur, prev[i], usart_pack_type_bits(pack->types[i])));
+        prev[i] = cur;
+    }
+    return p;
+}
+
+/**
+ * @brief 采集一个样本
+ */
+int usart_pack_batch_add(usart_pack_batch_t *batch, uint32_t timestamp)
+{
+    if (batch == NULL || batch->count >= batch->max_samples) {
+        return -1;
+    }
+
+    /* 压缩后的长度取决于数据，剩余空间放不下最坏情况的样本时拒绝加入（返回 0 后仍继续调用的情况） */
+    if (batch->delta &&
+        (uint32_t)batch->idx + batch->worst + usart_pack_check_size(batch->pack->check) + 1 > batch->size) {
+        return -1;
+    }
+
+    uint32_t dt = 0;
+
+    if (batch->count == 0) {
+        batch->t0 = timestamp;
+        batch->last_dt = 0;
+    } else {
+        dt = timestamp - batch->t0;
+        if (batch->period ? (dt != (uint32_t)batch->count * batch->period) : (dt > 0xFFFF)) {
+            return -1;
+        }
+    }
+
+    uint8_t *p = &batch->buf[batch->idx];
+    if (batch->delta) {
+        p = usart_pack_batch_encode(batch, p, (uint16_t)dt);
+    } else {
+        if (batch->period == 0) {
+            p = usart_pack_put_SHORT(p, (uint16_t)dt);
+        }
+        usart_pack_pack_fields(batch->pack, p);
+        p += batch->pack->data_size;
+    }
+
+    batch->idx = (uint16_t)(p - batch->buf);
+    batch->count++;
+
+    /* 剩余空间放不下最坏情况的下一个样本时提前报告已满 */
+    if (batch->delta &&
+        (uint32_t)batch->idx + batch->worst + usart_pack_check_size(batch->pack->check) + 1 > batch->size) {
+        return 0;
+    }
+
+    return batch->max_samples - batch->count;
+}
+
+/**
+ * @brief 完成当前帧
+ */
+uint16_t usart_pack_batch_finish(usart_pack_batch_t *batch)
+{
+    if (batch == NULL || batch->count == 0) {
+        return 0;
+    }
+
+    usart_pack_t *pack = batch->pack;
+    uint8_t *buf = batch->buf;
+    uint16_t start = usart_pack_batch_start(batch);
+    uint8_t *p = buf;
+
+    /* 样本区之前的字段 */
+    *p++ = pack->header;
+    if (pack->flags & USART_PACK_FLAG_SEQ) {
+        *p++ = pack->tx_seq++;
+    }
+    *p++ = batch->count | (batch->period ? USART_PACK_BATCH_UNIFORM : 0) |
+           (batch->delta ? USART_PACK_BATCH_DELTA : 0);
+    p = usart_pack_put_INT(p, batch->t0);
+    if (batch->period) {
+        p = usart_pack_put_SHORT(p, batch->period);
+    }
+    if (batch->delta) {
+        usart_pack_put_SHORT(p, (uint16_t)(batch->idx - start));
+    }
+
+    /* 校验和帧尾 */
+    uint16_t idx = batch->idx;
+    usart_pack_check_put(pack->check, &buf[idx], usart_pack_check_calc(pack, &buf[1], idx - 1));
+    idx += usart_pack_check_size(pack->check);
+    buf[idx++] = pack->tail;
+
+    batch->count = 0;
+    batch->idx = start;
+
+    return idx;
+}
+
+/**
+ * @brief 解析增量压缩的载荷
+ * @retval 0: 成功, -1: 载荷与样本数不符
+ */
+static int usart_pack_batch_decode(usart_pack_t *pack, const uint8_t *p, const uint8_t *end,
+                                   uint8_t samples, uint32_t t0, uint16_t period,
+                                   usart_pack_sample_cb callback, void *arg)
+{
+    uint32_t prev[USART_PACK_MAX_VARIABLES];
+    uint16_t dt = 0;
+
+    for (uint8_t n = 0; n < samples; n++) {
+        uint32_t timestamp = t0 + (uint32_t)n * period;
+        if (period == 0) {
+            uint32_t step;
+            p = usart_pack_get_varint(p, end, &step);
+            if (p == NULL) {
+                return -1;
+            }
+            dt = (uint16_t)(dt + step);
+            timestamp = t0 + dt;
+        }
+
+        if (n == 0) {
+            /* 关键帧：原始数据区，基准值直接从数据区取（变量地址可能为 NULL） */
+            if (end - p < pack->data_size) {
+                return -1;
+            }
+            for (uint16_t i = 0; i < pack->count; i++) {
+                p = usart_pack_raw_load(pack->types[i], p, &prev[i]);
+                usart_pack_var_store(pack, i, prev[i]);
+            }
+        } else {
+            for (uint16_t i = 0; i < pack->count; i++) {
+                uint32_t zz;
+                p = usart_pack_get_varint(p, end, &zz);
+                if (p == NULL) {
+                    return -1;
+                }
+                prev[i] = usart_pack_unzigzag(zz, prev[i], usart_pack_type_bits(pack->types[i]));
+                usart_pack_var_store(pack, i, prev[i]);
+            }
+        }
+
+        if (callback != NULL) {
+            callback(pack, timestamp, arg);
+        }
+    }
+
+    return (p == end) ? 0 : -1;
+}
+
+/**
+ * @brief 解析批量帧
+ */
+int usart_pack_batch_parse(usart_pack_t *pack, const uint8_t *buffer, uint32_t length,
+                           usart_pack_sample_cb callback, void *arg)
+{
+    if (pack == NULL || buffer == NULL) {
+        return -1;
+    }
+
+    if (length < usart_pack_batch_frame_size(pack, 0) || length > 0xFFFF ||
+        buffer[0] != pack->header || buffer[length - 1] != pack->tail ||
+        length != usart_pack_batch_peek_size(pack, buffer, length)) {
+        return -1;
+    }
+
+    const uint8_t *p = &buffer[1];
+    uint8_t seq = 0;
+    if (pack->flags & USART_PACK_FLAG_SEQ) {
+        seq = *p++;
+    }
+
+    uint8_t count = *p++;
+    uint8_t samples = count & ~(USART_PACK_BATCH_UNIFORM | USART_PACK_BATCH_DELTA);
+
+    int ret = usart_pack_check_verify(pack, buffer, length);
+    if (ret != 0) {
+        return ret;
+    }
+
+    if (pack->flags & USART_PACK_FLAG_SEQ) {
+        usart_pack_rx_seq(pack, seq);
+    }
+
+    uint32_t t0;
+    uint16_t period = 0;
+    p = usart_pack_get_INT(p, &t0);
+    if (count & USART_PACK_BATCH_UNIFORM) {
+        p = usart_pack_get_SHORT(p, &period);
+    }
+
+    if (count & USART_PACK_BATCH_DELTA) {
+        const uint8_t *end = &buffer[length - 1 - usart_pack_check_size(pack->check)];
+        p += USART_PACK_BATCH_STAMP_LEN;
+        if (usart_pack_batch_decode(pack, p, end, samples, t0, period, callback, arg) != 0) {
+            return -1;
+        }
+        return samples;
+    }
+
+    for (uint8_t i = 0; i < samples; i++) {
+        uint32_t timestamp = t0 + (uint32_t)i * period;
+        if (period == 0) {
+            uint16_t dt;
+            p = usart_pack_get_SHORT(p, &dt);
+            timestamp = t0 + dt;
+        }
+        usart_pack_unpack_fields(pack, p);
+        p += pack->data_size;
+
+        if (callback != NULL) {
+            callback(pack, timestamp, arg);
+        }
+    }
+
+    return samples;
+}
+
+/* ======================= 流式解码 ======================= */
+
+/**
+ * @brief 初始化流式解码器
+ */
+int usart_pack_stream_init(usart_pack_stream_t *stream, usart_pack_t *pack,
+                           usart_pack_frame_cb callback, void *arg)
+{
+    if (stream == NULL || pack == NULL) {
+        return -1;
+    }
+
+    stream->pack = pack;
+    stream->callback = callback;
+    stream->arg = arg;
+    memset(&stream->stats, 0, sizeof(stream->stats));
+    usart_pack_stream_reset(stream);
+
+    return 0;
+}
+
+/**
+ * @brief 丢弃未完成的帧并按当前模板和帧格式重新计算帧长
+ */
+void usart_pack_stream_reset(usart_pack_stream_t *stream)
+{
+    if (stream == NULL || stream->pack == NULL) {
+        return;
+    }
+
+    stream->frame_len = usart_pack_calc_frame_size(stream->pack);
+    stream->idx = 0;
+}
+
+/**
+ * @brief 缓存已满一帧：校验并分发，失败时从缓存中下一个帧头处重新同步
+ * @retval 1: 完成一帧, 0: 校验失败
+ */
+static int stream_complete(usart_pack_stream_t *stream)
+{
+    usart_pack_t *pack = stream->pack;
+    uint8_t *buf = stream->buf;
+    uint16_t len = stream->frame_len;
+    uint16_t data_len;
+
+    int ret = usart_pack_verify(pack, buf, len, &data_len);
+    if (ret == 0) {
+        usart_pack_accept(pack, buf, data_len);
+        stream->idx = 0;
+        stream->stats.frames++;
+        if (stream->callback != NULL) {
+            stream->callback(stream, buf, len, stream->arg);
+        }
+        return 1;
+    }
+
+    if (ret == -2) {
+        stream->stats.checksum_errors++;
+    } else {
+        stream->stats.format_errors++;
+    }
+
+    /* 帧头可能是数据区中的同值字节，真正的帧头在缓存内部，不能整帧丢弃 */
+    const uint8_t *next = memchr(&buf[1], pack->header, len - 1);
+    uint16_t skip = next ? (uint16_t)(next - buf) : len;
+
+    memmove(buf, &buf[skip], len - skip);
+    stream->idx = len - skip;
+    stream->stats.dropped_bytes += skip;
+
+    return 0;
+}
+
+/**
+ * @brief 喂入单个字节
+ */
+int usart_pack_stream_putc(usart_pack_stream_t *stream, uint8_t byte)
+{
+    if (stream == NULL || stream->pack == NULL) {
+        return 0;
+    }
+
+    if (stream->idx == 0 && byte != stream->pack->header) {
+        stream->stats.dropped_bytes++;
+        return 0;
+    }
+
+    stream->buf[stream->idx++] = byte;
+    if (stream->idx < stream->frame_len) {
+        return 0;
+    }
+
+    return stream_complete(stream);
+}
+
+/**
+ * @brief 喂入一段数据
+ */
+int usart_pack_stream_feed(usart_pack_stream_t *stream, const uint8_t *data, size_t length)
+{
+    if (stream == NULL || stream->pack == NULL || data == NULL) {
+        return 0;
+    }
+
+    int frames = 0;
+
+    while (length > 0) {
+        /* 帧外：整块查找帧头 */
+        if (stream->idx == 0) {
+            const uint8_t *head = memchr(data, stream->pack->header, length);
+            if (head == NULL) {
+                stream->stats.dropped_bytes += length;
+                break;
+            }
+            stream->stats.dropped_bytes += (uint32_t)(head - data);
+            length -= (size_t)(head - data);
+            data = head;
+        }
+
+        /* 帧内：一次拷贝到帧尾 */
+        size_t n = stream->frame_len - stream->idx;
+        if (n > length) {
+            n = length;
+        }
+        memcpy(&stream->buf[stream->idx], data, n);
+        stream->idx += (uint16_t)n;
+        data += n;
+        length -= n;
+
+        if (stream->idx == stream->frame_len) {
+            frames += stream_complete(stream);
+        }
+    }
+
+    return frames;
+}
+
+#ifdef USART_PACK_USING_RINGBUFFER
+/**
+ * @brief 直接从环形缓冲区喂入全部可读数据
+ */
+int usart_pack_stream_feed_rb(usart_pack_stream_t *stream, struct rb_ringbuffer *rb)
+{
+    rb_uint8_t *p0, *p1;
+    rb_size_t n0, n1;
+
+    if (stream == NULL || rb == NULL) {
+        return 0;
+    }
+
+    if (rb_ringbuffer_peek_spans(rb, &p0, &n0, &p1, &n1) == 0) {
+        return 0;
+    }
+
+    /* 未完成的帧缓存在解码器内部，两段数据可以全部释放 */
+    int frames = usart_pack_stream_feed(stream, p0, n0);
+    if (n1 > 0) {
+        frames += usart_pack_stream_feed(stream, p1, n1);
+    }
+    rb_ringbuffer_consume(rb, n0 + n1);
+
+    return frames;
+}
+#endif
+
+/**
+ * @brief 获取解码统计
+ */
+void usart_pack_stream_get_stats(const usart_pack_stream_t *stream, usart_pack_stream_stats_t *stats)
+{
+    if (stream == NULL || stats == NULL) {
+        return;
+    }
+
+    *stats = stream->stats;
+    stats->lost_frames = stream->pack ? stream->pack->rx_lost : 0;
+}
@@ -8,7 +8,11 @@
  *
  * 基于模板的串口通信协议模块
  * 支持 BYTE/SHORT/INT/FLOAT 等数据类型的灵活组合
- * 帧格式: [帧头] [数据区] [校验和] [帧尾]
+ * 帧格式: [帧头] [长度]? [序号]? [数据区] [校验] [帧尾]
+ * 校验可选 8 位累加和（默认）、CRC-16/CCITT、CRC-32，长度和序号字段可选
+ * 提供流式解码器，按字节或整块喂入数据，自动按帧头重新同步
+ * 模板在设置时预编译为偏移表；固定布局可用 USART_PACK_DEFINE 生成直线代码
+ * 批量帧在一帧中携带 N 个带时间戳的样本，摊薄帧头、校验和帧尾的开销
  *
  ******************************************************************************
  */
@@ -22,6 +26,11 @@ extern "C" {
 
 #include <stdint.h>
 #include <stddef.h>
+#include <string.h>
+
+#ifdef USART_PACK_USING_RINGBUFFER
+#include "ringbuffer.h"
+#endif
 
 /* 配置选项 */
 #ifndef USART_PACK_MAX_VARIABLES
@@ -39,6 +48,23 @@ extern "C" {
 /* 最小帧长度: 帧头(1) + 校验和(1) + 帧尾(1) */
 #define USART_PACK_MIN_FRAME_LEN 3
 
+/* 最大帧开销: 帧头(1) + 长度(1) + 序号(1) + CRC-32(4) + 帧尾(1) */
+#define USART_PACK_MAX_OVERHEAD 8
+
+/* 最大帧长度: 全部变量均为 4 字节类型 */
+#define USART_PACK_MAX_FRAME_LEN (USART_PACK_MAX_VARIABLES * 4 + USART_PACK_MAX_OVERHEAD)
+
+/* 校验方式 */
+typedef enum {
+    USART_PACK_CHECK_SUM8,      /* 8位累加和（默认，兼容原帧格式） */
+    USART_PACK_CHECK_CRC16,     /* CRC-16/CCITT-FALSE，大端 */
+    USART_PACK_CHECK_CRC32      /* CRC-32 (IEEE 802.3)，大端 */
+} usart_pack_check_t;
+
+/* 可选帧字段（usart_pack_set_format 的 flags） */
+#define USART_PACK_FLAG_LENGTH  0x01    /* 帧头后加 1 字节数据区长度 */
+#define USART_PACK_FLAG_SEQ     0x02    /* 加 1 字节发送序号，接收端据此统计丢帧 */
+
 /* 数据类型枚举 */
 typedef enum {
     PACK_TYPE_BYTE,     /* 1字节 (uint8_t / int8_t) */
@@ -47,6 +73,14 @@ typedef enum {
     PACK_TYPE_FLOAT     /* 4字节浮点数 (float) */
 } usart_pack_type_t;
 
+/* 预编译布局中的一项：地址相邻的同类型变量合并为一段 */
+typedef struct {
+    void *var;          /* 首个变量地址 */
+    uint16_t offset;    /* 在数据区中的偏移 */
+    uint8_t type;       /* usart_pack_type_t */
+    uint8_t count;      /* 连续变量个数 */
+} usart_pack_field_t;
+
 /* 协议实例结构体 */
 typedef struct {
     usart_pack_type_t types[USART_PACK_MAX_VARIABLES];  /* 类型模板 */
@@ -54,8 +88,78 @@ typedef struct {
     uint16_t count;                                      /* 变量数量 */
     uint8_t header;                                      /* 帧头 */
     uint8_t tail;                                        /* 帧尾 */
+    usart_pack_field_t layout[USART_PACK_MAX_VARIABLES]; /* 预编译布局 */
+    uint16_t layout_count;                               /* 布局项数 */
+    uint16_t data_size;                                  /* 数据区字节数 */
+    uint8_t check;                                       /* 校验方式 usart_pack_check_t */
+    uint8_t flags;                                       /* 可选字段 USART_PACK_FLAG_* */
+    uint8_t overhead;                                    /* 帧头、可选字段、校验、帧尾的总字节数 */
+    uint8_t tx_seq;                                      /* 下一帧发送序号 */
+    uint8_t rx_seq;                                      /* 上一帧接收序号 */
+    uint8_t rx_seq_valid;                                /* 是否已收到过带序号的帧 */
+    uint32_t rx_lost;                                    /* 按序号缺口统计的丢帧数 */
 } usart_pack_t;
 
+typedef struct usart_pack_stream usart_pack_stream_t;
+
+/* 完整帧回调：变量已更新，frame 指向整帧（含帧头帧尾） */
+typedef void (*usart_pack_frame_cb)(usart_pack_stream_t *stream,
+                                    const uint8_t *frame, uint16_t length, void *arg);
+
+/* 流式解码统计 */
+typedef struct {
+    uint32_t frames;            /* 成功解析的帧数 */
+    uint32_t checksum_errors;   /* 校验和错误次数 */
+    uint32_t format_errors;     /* 帧尾/长度字段错误次数 */
+    uint32_t dropped_bytes;     /* 重新同步时丢弃的字节数 */
+    uint32_t lost_frames;       /* 按序号缺口统计的丢帧数（需启用 USART_PACK_FLAG_SEQ） */
+} usart_pack_stream_stats_t;
+
+/* 流式解码器 */
+struct usart_pack_stream {
+    usart_pack_t *pack;                         /* 绑定的协议实例（模板决定帧长） */
+    usart_pack_frame_cb callback;               /* 完整帧回调，可为 NULL */
+    void *arg;                                  /* 回调参数 */
+    uint16_t frame_len;                         /* 期望帧长 */
+    uint16_t idx;                               /* 已缓存字节数 */
+    uint8_t buf[USART_PACK_MAX_FRAME_LEN];      /* 当前帧缓存 */
+    usart_pack_stream_stats_t stats;            /* 统计 */
+};
+
+/*
+ * 批量帧:
+ *   逐样本时间戳: [帧头] [序号]? [N] [起始时间戳 4B] { [时间偏移 2B] [数据区] } × N [校验] [帧尾]
+ *   等间隔采样:   [帧头] [序号]? [0x80 | N] [起始时间戳 4B] [采样周期 2B] { [数据区] } × N [校验] [帧尾]
+ *   增量压缩:     [帧头] [序号]? [0x40 | 0x80? | N] [起始时间戳 4B] [采样周期 2B]? [载荷长度 2B] [载荷] [校验] [帧尾]
+ *                 载荷中首个样本为原始数据区（关键帧），之后每个变量为与上一样本之差的 zig-zag 变长整数，
+ *                 逐样本时间戳模式下每个样本前另有时间偏移增量（变长整数）
+ */
+#define USART_PACK_BATCH_HEAD_LEN    5      /* 样本数 + 起始时间戳 */
+#define USART_PACK_BATCH_STAMP_LEN   2      /* 时间偏移、采样周期或载荷长度 */
+#define USART_PACK_BATCH_UNIFORM     0x80   /* 样本数字段中的等间隔标志 */
+#define USART_PACK_BATCH_DELTA       0x40   /* 样本数字段中的增量压缩标志 */
+#define USART_PACK_BATCH_MAX_SAMPLES 127
+#define USART_PACK_BATCH_MAX_DELTA_SAMPLES 63
+
+/* 批量帧发送端：样本直接写入调用者提供的帧缓冲区 */
+typedef struct {
+    usart_pack_t *pack;         /* 模板与帧格式 */
+    uint8_t *buf;               /* 帧缓冲区 */
+    uint16_t size;              /* 缓冲区大小 */
+    uint8_t max_samples;        /* 每帧样本数上限 */
+    uint8_t count;              /* 已加入的样本数 */
+    uint16_t idx;               /* 下一个样本的写入位置 */
+    uint16_t period;            /* 等间隔采样周期，0 表示逐样本记录时间偏移 */
+    uint32_t t0;                /* 首个样本的时间戳 */
+    uint8_t delta;              /* 是否增量压缩 */
+    uint16_t last_dt;           /* 增量压缩：上一样本的时间偏移 */
+    uint16_t worst;             /* 增量压缩：单个样本的最大编码长度 */
+    uint32_t prev[USART_PACK_MAX_VARIABLES];    /* 增量压缩：上一样本各变量的原始位 */
+} usart_pack_batch_t;
+
+/* 批量帧解析回调：样本已解析到模板绑定的变量中 */
+typedef void (*usart_pack_sample_cb)(usart_pack_t *pack, uint32_t timestamp, void *arg);
+
 /**
  * @brief 初始化协议实例
  * @param pack: 协议实例指针
@@ -70,6 +174,23 @@ void usart_pack_init(usart_pack_t *pack);
  */
 void usart_pack_init_custom(usart_pack_t *pack, uint8_t header, uint8_t tail);
 
+/**
+ * @brief 设置帧格式（收发双方需一致）
+ * @param pack: 协议实例指针
+ * @param check: 校验方式
+ * @param flags: 可选字段，USART_PACK_FLAG_LENGTH / USART_PACK_FLAG_SEQ 的组合，0 表示无
+ * @retval 0: 成功, -1: 参数错误
+ * @note 默认为 8 位累加和、无可选字段，即原帧格式；设置后序号和丢帧统计清零
+ */
+int usart_pack_set_format(usart_pack_t *pack, usart_pack_check_t check, uint8_t flags);
+
+/**
+ * @brief 获取按序号缺口统计的丢帧数
+ * @param pack: 协议实例指针
+ * @retval 丢帧数（需启用 USART_PACK_FLAG_SEQ）
+ */
+uint32_t usart_pack_get_lost_frames(const usart_pack_t *pack);
+
 /**
  * @brief 设置解析/打包模板
  * @param pack: 协议实例指针
@@ -104,6 +225,7 @@ void usart_pack_clear(usart_pack_t *pack);
  * @param buffer: 接收缓冲区
  * @param length: 数据长度
  * @retval 0: 成功, -1: 帧格式错误, -2: 校验和错误
+ * @note 启用序号字段时，序号缺口计入丢帧统计
  */
 int usart_pack_parse(usart_pack_t *pack, uint8_t *buffer, uint16_t length);
 
@@ -119,17 +241,276 @@ uint16_t usart_pack_build(usart_pack_t *pack, uint8_t *buffer, uint16_t max_len)
 /**
  * @brief 计算数据区所需字节数
  * @param pack: 协议实例指针
- * @retval 数据区字节数
+ * @retval 数据区字节数（模板设置时已算好，O(1)）
  */
 uint16_t usart_pack_calc_data_size(usart_pack_t *pack);
 
 /**
  * @brief 计算完整帧所需字节数
  * @param pack: 协议实例指针
- * @retval 完整帧字节数 (数据区 + 帧头 + 校验和 + 帧尾)
+ * @retval 完整帧字节数 (数据区 + 帧头 + 可选字段 + 校验 + 帧尾)
  */
 uint16_t usart_pack_calc_frame_size(usart_pack_t *pack);
 
+/**
+ * @brief 初始化流式解码器
+ * @param stream: 解码器实例指针
+ * @param pack: 协议实例指针（需已设置模板）
+ * @param callback: 完整帧回调，NULL 表示只更新绑定变量
+ * @param arg: 回调参数
+ * @retval 0: 成功, -1: 失败
+ * @note 模板中地址为 NULL 的变量解析时跳过，可只用回调读取原始帧
+ */
+int usart_pack_stream_init(usart_pack_stream_t *stream, usart_pack_t *pack,
+                           usart_pack_frame_cb callback, void *arg);
+
+/**
+ * @brief 丢弃未完成的帧并按当前模板和帧格式重新计算帧长
+ * @param stream: 解码器实例指针
+ * @note 修改模板或帧格式后需要调用
+ */
+void usart_pack_stream_reset(usart_pack_stream_t *stream);
+
+/**
+ * @brief 喂入单个字节（可在串口接收中断中调用）
+ * @param stream: 解码器实例指针
+ * @param byte: 接收到的字节
+ * @retval 1: 完成一帧, 0: 未完成
+ */
+int usart_pack_stream_putc(usart_pack_stream_t *stream, uint8_t byte);
+
+/**
+ * @brief 喂入一段数据
+ * @param stream: 解码器实例指针
+ * @param data: 数据指针
+ * @param length: 数据长度
+ * @retval 本次完成的帧数
+ * @note 不要求数据按帧对齐，未完成的帧留到下次继续
+ */
+int usart_pack_stream_feed(usart_pack_stream_t *stream, const uint8_t *data, size_t length);
+
+#ifdef USART_PACK_USING_RINGBUFFER
+/**
+ * @brief 直接从环形缓冲区喂入全部可读数据（零拷贝读取两段，完成后释放）
+ * @param stream: 解码器实例指针
+ * @param rb: 环形缓冲区指针
+ * @retval 本次完成的帧数
+ */
+int usart_pack_stream_feed_rb(usart_pack_stream_t *stream, struct rb_ringbuffer *rb);
+#endif
+
+/**
+ * @brief 获取解码统计
+ * @param stream: 解码器实例指针
+ * @param stats: 输出统计
+ */
+void usart_pack_stream_get_stats(const usart_pack_stream_t *stream, usart_pack_stream_stats_t *stats);
+
+/* ======================= 批量帧 ======================= */
+
+/**
+ * @brief 计算未压缩批量帧字节数
+ * @param pack: 协议实例指针（需已设置模板和帧格式）
+ * @param count: 样本数字段，即样本数，等间隔帧再或上 USART_PACK_BATCH_UNIFORM
+ * @retval 帧字节数
+ */
+uint32_t usart_pack_batch_frame_size(const usart_pack_t *pack, uint8_t count);
+
+/**
+ * @brief 根据已收到的帧开头计算批量帧长度（含压缩帧），用于在数据流中切分
+ * @param pack: 协议实例指针
+ * @param buffer: 从帧头开始的数据
+ * @param avail: 已收到的字节数
+ * @retval 帧字节数, 0 表示还需要更多字节才能确定
+ */
+uint32_t usart_pack_batch_peek_size(const usart_pack_t *pack, const uint8_t *buffer, uint32_t avail);
+
+/**
+ * @brief 初始化批量帧发送端
+ * @param batch: 批量帧实例指针
+ * @param pack: 协议实例指针（需已设置模板和帧格式）
+ * @param buffer: 帧缓冲区
+ * @param size: 缓冲区大小
+ * @param max_samples: 每帧样本数上限，0 表示按缓冲区大小尽量多放（最多 127）
+ * @param period: 等间隔采样周期（与时间戳同单位），0 表示每个样本单独记录时间偏移
+ * @retval 0: 成功, -1: 参数错误、模板为空或缓冲区放不下一个样本
+ * @note 等间隔模式每个样本省去 2 字节时间偏移，适合定时器中断中的固定频率采样
+ */
+int usart_pack_batch_init(usart_pack_batch_t *batch, usart_pack_t *pack,
+                          uint8_t *buffer, uint16_t size, uint8_t max_samples, uint16_t period);
+
+/**
+ * @brief 开启/关闭增量压缩
+ * @param batch: 批量帧实例指针
+ * @param enable: 1 开启, 0 关闭
+ * @retval 0: 成功, -1: 当前帧已有样本或缓冲区放不下一个样本
+ * @note 每帧首个样本为关键帧，各帧可独立解码；每帧样本数上限降为 63。
+ *       变化缓慢的整型通道（编码器计数、量化后的角度、PID 输出）压缩效果最好，
+ *       float 按位求差，只能省去不变的高位
+ */
+int usart_pack_batch_set_delta(usart_pack_batch_t *batch, uint8_t enable);
+
+/**
+ * @brief 采集一个样本：按模板读取绑定变量的当前值写入帧缓冲区
+ * @param batch: 批量帧实例指针
+ * @param timestamp: 样本时间戳（单位自定，如 ms 或 us）
+ * @retval 剩余可加入的样本数，0 表示已满（压缩时也可能是缓冲区剩余空间不足）需调用 usart_pack_batch_finish(), -1: 失败
+ * @note 时间戳与本帧首个样本相差超过 65535 或回退时返回 -1；
+ *       等间隔模式下时间戳不等于 首个样本 + 已有样本数 × 周期（如漏采）时也返回 -1；
+ *       已满后继续调用同样返回 -1，不会越过缓冲区。
+ *       返回 -1 时样本未加入，先发送当前帧再重新加入即可
+ */
+int usart_pack_batch_add(usart_pack_batch_t *batch, uint32_t timestamp);
+
+/**
+ * @brief 写入样本数、校验和帧尾，完成当前帧
+ * @param batch: 批量帧实例指针
+ * @retval 帧长度（帧位于 batch->buf），0 表示没有样本
+ * @note 之后的 usart_pack_batch_add() 会覆盖缓冲区，DMA 发送时需等发送完成或使用两个实例交替
+ */
+uint16_t usart_pack_batch_finish(usart_pack_batch_t *batch);
+
+/**
+ * @brief 解析批量帧，逐个样本更新绑定变量并回调
+ * @param pack: 协议实例指针
+ * @param buffer: 完整帧
+ * @param length: 帧长度
+ * @param callback: 每个样本解析后调用，可为 NULL
+ * @param arg: 回调参数
+ * @retval 样本数, -1: 帧格式错误, -2: 校验错误
+ * @note 长度字段标志对批量帧无效，样本数字段决定帧长；两种时间戳形式和增量压缩帧都能解析
+ */
+int usart_pack_batch_parse(usart_pack_t *pack, const uint8_t *buffer, uint32_t length,
+                           usart_pack_sample_cb callback, void *arg);
+
+/* ======================= 固定布局直线代码 ======================= */
+
+/*
+ * 布局在编译期已知时，用字段列表宏生成结构体和打包/解包函数，
+ * 偏移全部为常量，没有模板解释开销，帧格式与同类型模板完全一致：
+ *
+ *   #define IMU_FIELDS(X) \
+ *       X(BYTE,  cmd)    \
+ *       X(SHORT, status) \
+ *       X(FLOAT, roll)   \
+ *       X(FLOAT, pitch)
+ *
+ *   USART_PACK_DEFINE(imu, IMU_FIELDS)
+ *
+ * 生成:
+ *   typedef struct { uint8_t cmd; uint16_t status; float roll; float pitch; } imu_t;
+ *   enum { imu_FRAME_SIZE = 14 };
+ *   uint16_t imu_build(const imu_t *v, uint8_t *buffer, uint16_t max_len);   // 返回帧长，0 表示失败
+ *   int imu_parse(imu_t *v, const uint8_t *buffer, uint16_t length);         // 0 / -1 / -2，同 usart_pack_parse
+ *
+ * 帧头帧尾使用 USART_PACK_HEADER / USART_PACK_TAIL，帧格式固定为默认格式（8 位累加和、无可选字段）。
+ */
+
+#define USART_PACK_CTYPE_BYTE   uint8_t
+#define USART_PACK_CTYPE_SHORT  uint16_t
+#define USART_PACK_CTYPE_INT    uint32_t
+#define USART_PACK_CTYPE_FLOAT  float
+
+#define USART_PACK_SIZE_BYTE    1
+#define USART_PACK_SIZE_SHORT   2
+#define USART_PACK_SIZE_INT     4
+#define USART_PACK_SIZE_FLOAT   4
+
+static inline uint8_t *usart_pack_put_BYTE(uint8_t *p, uint8_t v)
+{
+    p[0] = v;
+    return p + 1;
+}
+
+static inline uint8_t *usart_pack_put_SHORT(uint8_t *p, uint16_t v)
+{
+    p[0] = (uint8_t)(v >> 8);
+    p[1] = (uint8_t)v;
+    return p + 2;
+}
+
+static inline uint8_t *usart_pack_put_INT(uint8_t *p, uint32_t v)
+{
+    p[0] = (uint8_t)(v >> 24);
+    p[1] = (uint8_t)(v >> 16);
+    p[2] = (uint8_t)(v >> 8);
+    p[3] = (uint8_t)v;
+    return p + 4;
+}
+
+static inline uint8_t *usart_pack_put_FLOAT(uint8_t *p, float v)
+{
+    memcpy(p, &v, 4);
+    return p + 4;
+}
+
+static inline const uint8_t *usart_pack_get_BYTE(const uint8_t *p, uint8_t *v)
+{
+    *v = p[0];
+    return p + 1;
+}
+
+static inline const uint8_t *usart_pack_get_SHORT(const uint8_t *p, uint16_t *v)
+{
+    *v = (uint16_t)((p[0] << 8) | p[1]);
+    return p + 2;
+}
+
+static inline const uint8_t *usart_pack_get_INT(const uint8_t *p, uint32_t *v)
+{
+    *v = ((uint32_t)p[0] << 24) | ((uint32_t)p[1] << 16) | ((uint32_t)p[2] << 8) | p[3];
+    return p + 4;
+}
+
+static inline const uint8_t *usart_pack_get_FLOAT(const uint8_t *p, float *v)
+{
+    memcpy(v, p, 4);
+    return p + 4;
+}
+
+static inline uint8_t usart_pack_sum(const uint8_t *data, uint16_t length)
+{
+    uint8_t sum = 0;
+    for (uint16_t i = 0; i < length; i++) {
+        sum += data[i];
+    }
+    return sum;
+}
+
+#define USART_PACK_FIELD_DECL(type, name)   USART_PACK_CTYPE_##type name;
+#define USART_PACK_FIELD_SIZE(type, name)   + USART_PACK_SIZE_##type
+#define USART_PACK_FIELD_PUT(type, name)    p = usart_pack_put_##type(p, v->name);
+#define USART_PACK_FIELD_GET(type, name)    q = usart_pack_get_##type(q, &v->name);
+
+#define USART_PACK_DEFINE(name, FIELDS)                                                 \
+    typedef struct { FIELDS(USART_PACK_FIELD_DECL) } name##_t;                          \
+    enum { name##_FRAME_SIZE = USART_PACK_MIN_FRAME_LEN FIELDS(USART_PACK_FIELD_SIZE) }; \
+    static inline uint16_t name##_build(const name##_t *v, uint8_t *buffer, uint16_t max_len) \
+    {                                                                                   \
+        if (max_len < name##_FRAME_SIZE) {                                              \
+            return 0;                                                                   \
+        }                                                                               \
+        uint8_t *p = buffer + 1;                                                        \
+        buffer[0] = USART_PACK_HEADER;                                                  \
+        FIELDS(USART_PACK_FIELD_PUT)                                                    \
+        p[0] = usart_pack_sum(buffer + 1, name##_FRAME_SIZE - USART_PACK_MIN_FRAME_LEN); \
+        p[1] = USART_PACK_TAIL;                                                         \
+        return name##_FRAME_SIZE;                                                       \
+    }                                                                                   \
+    static inline int name##_parse(name##_t *v, const uint8_t *buffer, uint16_t length) \
+    {                                                                                   \
+        const uint8_t *q = buffer + 1;                                                  \
+        if (length != name##_FRAME_SIZE || buffer[0] != USART_PACK_HEADER ||            \
+            buffer[length - 1] != USART_PACK_TAIL) {                                    \
+            return -1;                                                                  \
+        }                                                                               \
+        if (usart_pack_sum(q, length - USART_PACK_MIN_FRAME_LEN) != buffer[length - 2]) { \
+            return -2;                                                                  \
+        }                                                                               \
+        FIELDS(USART_PACK_FIELD_GET)                                                    \
+        return 0;                                                                       \
+    }
+
 #ifdef __cplusplus
 }
 #endif
@@ -0,0 +1,168 @@
+/**
+ ******************************************************************************
+ * @file    usart_pack_crc.c
+ * @brief   usart_pack 帧校验 - CRC-16/CCITT-FALSE 与 CRC-32 查表计算实现
+ * @version 1.0.0
+ ******************************************************************************
+ */
+
+#include "usart_pack_crc.h"
+#include "usart_pack_crc_table.h"
+
+/* ======================= 逐位计算 ======================= */
+
+uint16_t usart_pack_crc16_bitwise(uint16_t crc, const uint8_t *data, size_t length)
+{
+    while (length--) {
+        crc ^= (uint16_t)(*data++ << 8);
+        for (int i = 0; i < 8; i++) {
+            crc = (crc & 0x8000) ? (uint16_t)((crc << 1) ^ 0x1021) : (uint16_t)(crc << 1);
+        }
+    }
+    return crc;
+}
+
+uint32_t usart_pack_crc32_bitwise(uint32_t crc, const uint8_t *data, size_t length)
+{
+    while (length--) {
+        crc ^= *data++;
+        for (int i = 0; i < 8; i++) {
+            crc = (crc & 1) ? (crc >> 1) ^ 0xEDB88320ul : (crc >> 1);
+        }
+    }
+    return crc;
+}
+
+/* ======================= 每次 1 字节 ======================= */
+
+#if USART_PACK_CRC_SLICES >= 1
+uint16_t usart_pack_crc16_slice1(uint16_t crc, const uint8_t *data, size_t length)
+{
+    while (length--) {
+        crc = (uint16_t)(crc << 8) ^ s_crc16_table[0][(crc >> 8) ^ *data++];
+    }
+    return crc;
+}
+
+uint32_t usart_pack_crc32_slice1(uint32_t crc, const uint8_t *data, size_t length)
+{
+    while (length--) {
+        crc = (crc >> 8) ^ s_crc32_table[0][(crc ^ *data++) & 0xFF];
+    }
+    return crc;
+}
+#endif
+
+/* ======================= slicing-by-4 ======================= */
+
+#if USART_PACK_CRC_SLICES >= 4
+uint16_t usart_pack_crc16_slice4(uint16_t crc, const uint8_t *data, size_t length)
+{
+    /* 高位先行：CRC 与前两个字节异或，后两个字节直接查表 */
+    while (length >= 4) {
+        crc = s_crc16_table[3][(crc >> 8) ^ data[0]] ^
+              s_crc16_table[2][(crc & 0xFF) ^ data[1]] ^
+              s_crc16_table[1][data[2]] ^
+              s_crc16_table[0][data[3]];
+        data += 4;
+        length -= 4;
+    }
+    return usart_pack_crc16_slice1(crc, data, length);
+}
+
+uint32_t usart_pack_crc32_slice4(uint32_t crc, const uint8_t *data, size_t length)
+{
+    /* 逐字节组装小端字，不要求对齐，与 CPU 字节序无关 */
+    while (length >= 4) {
+        crc ^= (uint32_t)data[0] | ((uint32_t)data[1] << 8) |
+               ((uint32_t)data[2] << 16) | ((uint32_t)data[3] << 24);
+        crc = s_crc32_table[3][crc & 0xFF] ^
+              s_crc32_table[2][(crc >> 8) & 0xFF] ^
+              s_crc32_table[1][(crc >> 16) & 0xFF] ^
+              s_crc32_table[0][crc >> 24];
+        data += 4;
+        length -= 4;
+    }
+    return usart_pack_crc32_slice1(crc, data, length);
+}
+#endif
+
+/* ======================= slicing-by-8 ======================= */
+
+#if USART_PACK_CRC_SLICES >= 8
+uint16_t usart_pack_crc16_slice8(uint16_t crc, const uint8_t *data, size_t length)
+{
+    while (length >= 8) {
+        crc = s_crc16_table[7][(crc >> 8) ^ data[0]] ^
+              s_crc16_table[6][(crc & 0xFF) ^ data[1]] ^
+              s_crc16_table[5][data[2]] ^
+              s_crc16_table[4][data[3]] ^
+              s_crc16_table[3][data[4]] ^
+              s_crc16_table[2][data[5]] ^
+              s_crc16_table[1][data[6]] ^
+              s_crc16_table[0][data[7]];
+        data += 8;
+        length -= 8;
+    }
+    return usart_pack_crc16_slice4(crc, data, length);
+}
+
+uint32_t usart_pack_crc32_slice8(uint32_t crc, const uint8_t *data, size_t length)
+{
+    while (length >= 8) {
+        uint32_t lo = crc ^ ((uint32_t)data[0] | ((uint32_t)data[1] << 8) |
+                             ((uint32_t)data[2] << 16) | ((uint32_t)data[3] << 24));
+        uint32_t hi = (uint32_t)data[4] | ((uint32_t)data[5] << 8) |
+                      ((uint32_t)data[6] << 16) | ((uint32_t)data[7] << 24);
+        crc = s_crc32_table[7][lo & 0xFF] ^
+              s_crc32_table[6][(lo >> 8) & 0xFF] ^
+              s_crc32_table[5][(lo >> 16) & 0xFF] ^
+              s_crc32_table[4][lo >> 24] ^
+              s_crc32_table[3][hi & 0xFF] ^
+              s_crc32_table[2][(hi >> 8) & 0xFF] ^
+              s_crc32_table[1][(hi >> 16) & 0xFF] ^
+              s_crc32_table[0][hi >> 24];
+        data += 8;
+        length -= 8;
+    }
+    return usart_pack_crc32_slice4(crc, data, length);
+}
+#endif
+
+/* ======================= 对外接口 ======================= */
+
+uint16_t usart_pack_crc16_update(uint16_t crc, const uint8_t *data, size_t length)
+{
+#if USART_PACK_CRC_SLICES == 8
+    return usart_pack_crc16_slice8(crc, data, length);
+#elif USART_PACK_CRC_SLICES == 4
+    return usart_pack_crc16_slice4(crc, data, length);
+#elif USART_PACK_CRC_SLICES == 1
+    return usart_pack_crc16_slice1(crc, data, length);
+#else
+    return usart_pack_crc16_bitwise(crc, data, length);
+#endif
+}
+
+uint32_t usart_pack_crc32_update(uint32_t crc, const uint8_t *data, size_t length)
+{
+#if USART_PACK_CRC_SLICES == 8
+    return usart_pack_crc32_slice8(crc, data, length);
+#elif USART_PACK_CRC_SLICES == 4
+    return usart_pack_crc32_slice4(crc, data, length);
+#elif USART_PACK_CRC_SLICES == 1
+    return usart_pack_crc32_slice1(crc, data, length);
+#else
+    return usart_pack_crc32_bitwise(crc, data, length);
+#endif
+}
+
+uint16_t usart_pack_crc16(const uint8_t *data, size_t length)
+{
+    return usart_pack_crc16_update(USART_PACK_CRC16_INIT, data, length);
+}
+
+uint32_t usart_pack_crc32(const uint8_t *data, size_t length)
+{
+    return usart_pack_crc32_update(USART_PACK_CRC32_INIT, data, length) ^ 0xFFFFFFFFul;
+}
@@ -0,0 +1,100 @@
+/**
+ ******************************************************************************
+ * @file    usart_pack_crc.h
+ * @brief   usart_pack 帧校验 - CRC-16/CCITT-FALSE 与 CRC-32 查表计算
+ * @version 1.0.0
+ ******************************************************************************
+ * @attention
+ *
+ * CRC-16/CCITT-FALSE: 多项式 0x1021，初值 0xFFFF，不反射，无结果异或（"123456789" -> 0x29B1）
+ * CRC-32 (IEEE 802.3): 多项式 0x04C11DB7 反射，初值/结果异或 0xFFFFFFFF（"123456789" -> 0xCBF43926）
+ *
+ * 查表粒度由 USART_PACK_CRC_SLICES 决定（每次处理的字节数）：
+ *   0: 逐位计算，不占用表空间
+ *   1: 每次 1 字节，CRC-16 表 512B + CRC-32 表 1KB（默认）
+ *   4: slicing-by-4，表 2KB + 4KB
+ *   8: slicing-by-8，表 4KB + 8KB
+ *
+ ******************************************************************************
+ */
+
+#ifndef _USART_PACK_CRC_H_
+#define _USART_PACK_CRC_H_
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include <stdint.h>
+#include <stddef.h>
+
+#ifndef USART_PACK_CRC_SLICES
+#define USART_PACK_CRC_SLICES 1
+#endif
+
+#if USART_PACK_CRC_SLICES != 0 && USART_PACK_CRC_SLICES != 1 && \
+    USART_PACK_CRC_SLICES != 4 && USART_PACK_CRC_SLICES != 8
+#error "USART_PACK_CRC_SLICES must be 0, 1, 4 or 8"
+#endif
+
+#define USART_PACK_CRC16_INIT   0xFFFFu
+#define USART_PACK_CRC32_INIT   0xFFFFFFFFul
+
+/**
+ * @brief 计算 CRC-16/CCITT-FALSE
+ * @param data: 数据指针
+ * @param length: 数据长度
+ * @retval CRC 值
+ */
+uint16_t usart_pack_crc16(const uint8_t *data, size_t length);
+
+/**
+ * @brief 分段计算 CRC-16（使用编译时选定的最快实现）
+ * @param crc: 上一段的结果，第一段传 USART_PACK_CRC16_INIT
+ * @param data: 数据指针
+ * @param length: 数据长度
+ * @retval 截至本段的 CRC 值
+ */
+uint16_t usart_pack_crc16_update(uint16_t crc, const uint8_t *data, size_t length);
+
+/**
+ * @brief 计算 CRC-32
+ * @param data: 数据指针
+ * @param length: 数据长度
+ * @retval CRC 值
+ */
+uint32_t usart_pack_crc32(const uint8_t *data, size_t length);
+
+/**
+ * @brief 分段计算 CRC-32（使用编译时选定的最快实现）
+ * @param crc: 上一段 usart_pack_crc32_update() 的返回值，第一段传 USART_PACK_CRC32_INIT
+ * @param data: 数据指针
+ * @param length: 数据长度
+ * @retval 未做结果异或的中间值，最后一段之后异或 0xFFFFFFFF 得到 CRC
+ */
+uint32_t usart_pack_crc32_update(uint32_t crc, const uint8_t *data, size_t length);
+
+/* 各实现单独导出，便于基准对比；表驱动版本只在对应的表被编译时提供 */
+uint16_t usart_pack_crc16_bitwise(uint16_t crc, const uint8_t *data, size_t length);
+uint32_t usart_pack_crc32_bitwise(uint32_t crc, const uint8_t *data, size_t length);
+
+#if USART_PACK_CRC_SLICES >= 1
+uint16_t usart_pack_crc16_slice1(uint16_t crc, const uint8_t *data, size_t length);
+uint32_t usart_pack_crc32_slice1(uint32_t crc, const uint8_t *data, size_t length);
+#endif
+
+#if USART_PACK_CRC_SLICES >= 4
+uint16_t usart_pack_crc16_slice4(uint16_t crc, const uint8_t *data, size_t length);
+uint32_t usart_pack_crc32_slice4(uint32_t crc, const uint8_t *data, size_t length);
+#endif
+
+#if USART_PACK_CRC_SLICES >= 8
+uint16_t usart_pack_crc16_slice8(uint16_t crc, const uint8_t *data, size_t length);
+uint32_t usart_pack_crc32_slice8(uint32_t crc, const uint8_t *data, size_t length);
+#endif
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* _USART_PACK_CRC_H_ */
@@ -0,0 +1,668 @@
+/**
+ ******************************************************************************
+ * @file    usart_pack_crc_table.h
+ * @brief   CRC-16/CCITT-FALSE 与 CRC-32 查找表（由多项式生成，仅供 usart_pack_crc.c 包含）
+ * @version 1.0.0
+ ******************************************************************************
+ * @attention
+ *
+ * 第 k 张表为某字节后再跟 k 个零字节的 CRC，用于一次处理多个字节（slicing-by-N）。
+ * CRC-16: 多项式 0x1021，高位先行；CRC-32: 多项式 0xEDB88320（反射）。
+ *
+ ******************************************************************************
+ */
+
+#ifndef _USART_PACK_CRC_TABLE_H_
+#define _USART_PACK_CRC_TABLE_H_
+
+#if USART_PACK_CRC_SLICES > 0
+
+static const uint16_t s_crc16_table[USART_PACK_CRC_SLICES][256] = {
+    {
+        0x0000, 0x1021, 0x2042, 0x3063, 0x4084, 0x50A5, 0x60C6, 0x70E7,
+        0x8108, 0x9129, 0xA14A, 0xB16B, 0xC18C, 0xD1AD, 0xE1CE, 0xF1EF,
+        0x1231, 0x0210, 0x3273, 0x2252, 0x52B5, 0x4294, 0x72F7, 0x62D6,
+        0x9339, 0x8318, 0xB37B, 0xA35A, 0xD3BD, 0xC39C, 0xF3FF, 0xE3DE,
+        0x2462, 0x3443, 0x0420, 0x1401, 0x64E6, 0x74C7, 0x44A4, 0x5485,
+        0xA56A, 0xB54B, 0x8528, 0x9509, 0xE5EE, 0xF5CF, 0xC5AC, 0xD58D,
+        0x3653, 0x2672, 0x1611, 0x0630, 0x76D7, 0x66F6, 0x5695, 0x46B4,
+        0xB75B, 0xA77A, 0x9719, 0x8738, 0xF7DF, 0xE7FE, 0xD79D, 0xC7BC,
+        0x48C4, 0x58E5, 0x6886, 0x78A7, 0x0840, 0x1861, 0x2802, 0x3823,
+        0xC9CC, 0xD9ED, 0xE98E, 0xF9AF, 0x8948, 0x9969, 0xA90A, 0xB92B,
+        0x5AF5, 0x4AD4, 0x7AB7, 0x6A96, 0x1A71, 0x0A50, 0x3A33, 0x2A12,
+        0xDBFD, 0xCBDC, 0xFBBF, 0xEB9E, 0x9B79, 0x8B58, 0xBB3B, 0xAB1A,
+        0x6CA6, 0x7C87, 0x4CE4, 0x5CC5, 0x2C22, 0x3C03, 0x0C60, 0x1C41,
+        0xEDAE, 0xFD8F, 0xCDEC, 0xDDCD, 0xAD2A, 0xBD0B, 0x8D68, 0x9D49,
+        0x7E97, 0x6EB6, 0x5ED5, 0x4EF4, 0x3E13, 0x2E32, 0x1E51, 0x0E70,
+        0xFF9F, 0xEFBE, 0xDFDD, 0xCFFC, 0xBF1B, 0xAF3A, 0x9F59, 0x8F78,
+        0x9188, 0x81A9, 0xB1CA, 0xA1EB, 0xD10C, 0xC12D, 0xF14E, 0xE16F,
+        0x1080, 0x00A1, 0x30C2, 0x20E3, 0x5004, 0x4025, 0x7046, 0x6067,
+        0x83B9, 0x9398, 0xA3FB, 0xB3DA, 0xC33D, 0xD31C, 0xE37F, 0xF35E,
+        0x02B1, 0x1290, 0x22F3, 0x32D2, 0x4235, 0x5214, 0x6277, 0x7256,
+        0xB5EA, 0xA5CB, 0x95A8, 0x8589, 0xF56E, 0xE54F, 0xD52C, 0xC50D,
+        0x34E2, 0x24C3, 0x14A0, 0x0481, 0x7466, 0x6447, 0x5424, 0x4405,
+        0xA7DB, 0xB7FA, 0x8799, 0x97B8, 0xE75F, 0xF77E, 0xC71D, 0xD73C,
+        0x26D3, 0x36F2, 0x0691, 0x16B0, 0x6657, 0x7676, 0x4615, 0x5634,
+        0xD94C, 0xC96D, 0xF90E, 0xE92F, 0x99C8, 0x89E9, 0xB98A, 0xA9AB,
+        0x5844, 0x4865, 0x7806, 0x6827, 0x18C0, 0x08E1, 0x3882, 0x28A3,
+        0xCB7D, 0xDB5C, 0xEB3F, 0xFB1E, 0x8BF9, 0x9BD8, 0xABBB, 0xBB9A,
+        0x4A75, 0x5A54, 0x6A37, 0x7A16, 0x0AF1, 0x1AD0, 0x2AB3, 0x3A92,
+        0xFD2E, 0xED0F, 0xDD6C, 0xCD4D, 0xBDAA, 0xAD8B, 0x9DE8, 0x8DC9,
+        0x7C26, 0x6C07, 0x5C64, 0x4C45, 0x3CA2, 0x2C83, 0x1CE0, 0x0CC1,
+        0xEF1F, 0xFF3E, 0xCF5D, 0xDF7C, 0xAF9B, 0xBFBA, 0x8FD9, 0x9FF8,
+        0x6E17, 0x7E36, 0x4E55, 0x5E74, 0x2E93, 0x3EB2, 0x0ED1, 0x1EF0,
+    },
+#if USART_PACK_CRC_SLICES >= 4
+    {
+        0x0000, 0x3331, 0x6662, 0x5553, 0xCCC4, 0xFFF5, 0xAAA6, 0x9997,
+        0x89A9, 0xBA98, 0xEFCB, 0xDCFA, 0x456D, 0x765C, 0x230F, 0x103E,
+        0x0373, 0x3042, 0x6511, 0x5620, 0xCFB7, 0xFC86, 0xA9D5, 0x9AE4,
+        0x8ADA, 0xB9EB, 0xECB8, 0xDF89, 0x461E, 0x752F, 0x207C, 0x134D,
+        0x06E6, 0x35D7, 0x6084, 0x53B5, 0xCA22, 0xF913, 0xAC40, 0x9F71,
+        0x8F4F, 0xBC7E, 0xE92D, 0xDA1C, 0x438B, 0x70BA, 0x25E9, 0x16D8,
+        0x0595, 0x36A4, 0x63F7, 0x50C6, 0xC951, 0xFA60, 0xAF33, 0x9C02,
+        0x8C3C, 0xBF0D, 0xEA5E, 0xD96F, 0x40F8, 0x73C9, 0x269A, 0x15AB,
+        0x0DCC, 0x3EFD, 0x6BAE, 0x589F, 0xC108, 0xF239, 0xA76A, 0x945B,
+        0x8465, 0xB754, 0xE207, 0xD136, 0x48A1, 0x7B90, 0x2EC3, 0x1DF2,
+        0x0EBF, 0x3D8E, 0x68DD, 0x5BEC, 0xC27B, 0xF14A, 0xA419, 0x9728,
+        0x8716, 0xB427, 0xE174, 0xD245, 0x4BD2, 0x78E3, 0x2DB0, 0x1E81,
+        0x0B2A, 0x381B, 0x6D48, 0x5E79, 0xC7EE, 0xF4DF, 0xA18C, 0x92BD,
+        0x8283, 0xB1B2, 0xE4E1, 0xD7D0, 0x4E47, 0x7D76, 0x2825, 0x1B14,
+        0x0859, 0x3B68, 0x6E3B, 0x5D0A, 0xC49D, 0xF7AC, 0xA2FF, 0x91CE,
+        0x81F0, 0xB2C1, 0xE792, 0xD4A3, 0x4D34, 0x7E05, 0x2B56, 0x1867,
+        0x1B98, 0x28A9, 0x7DFA, 0x4ECB, 0xD75C, 0xE46D, 0xB13E, 0x820F,
+        0x9231, 0xA100, 0xF453, 0xC762, 0x5EF5, 0x6DC4, 0x3897, 0x0BA6,
+        0x18EB, 0x2BDA, 0x7E89, 0x4DB8, 0xD42F, 0xE71E, 0xB24D, 0x817C,
+        0x9142, 0xA273, 0xF720, 0xC411, 0x5D86, 0x6EB7, 0x3BE4, 0x08D5,
+        0x1D7E, 0x2E4F, 0x7B1C, 0x482D, 0xD1BA, 0xE28B, 0xB7D8, 0x84E9,
+        0x94D7, 0xA7E6, 0xF2B5, 0xC184, 0x5813, 0x6B22, 0x3E71, 0x0D40,
+        0x1E0D, 0x2D3C, 0x786F, 0x4B5E, 0xD2C9, 0xE1F8, 0xB4AB, 0x879A,
+        0x97A4, 0xA495, 0xF1C6, 0xC2F7, 0x5B60, 0x6851, 0x3D02, 0x0E33,
+        0x1654, 0x2565, 0x7036, 0x4307, 0xDA90, 0xE9A1, 0xBCF2, 0x8FC3,
+        0x9FFD, 0xACCC, 0xF99F, 0xCAAE, 0x5339, 0x6008, 0x355B, 0x066A,
+        0x1527, 0x2616, 0x7345, 0x4074, 0xD9E3, 0xEAD2, 0xBF81, 0x8CB0,
+        0x9C8E, 0xAFBF, 0xFAEC, 0xC9DD, 0x504A, 0x637B, 0x3628, 0x0519,
+        0x10B2, 0x2383, 0x76D0, 0x45E1, 0xDC76, 0xEF47, 0xBA14, 0x8925,
+        0x991B, 0xAA2A, 0xFF79, 0xCC48, 0x55DF, 0x66EE, 0x33BD, 0x008C,
+        0x13C1, 0x20F0, 0x75A3, 0x4692, 0xDF05, 0xEC34, 0xB967, 0x8A56,
+        0x9A68, 0xA959, 0xFC0A, 0xCF3B, 0x56AC, 0x659D, 0x30CE, 0x03FF,
+    },
+    {
+        0x0000, 0x3730, 0x6E60, 0x5950, 0xDCC0, 0xEBF0, 0xB2A0, 0x8590,
+        0xA9A1, 0x9E91, 0xC7C1, 0xF0F1, 0x7561, 0x4251, 0x1B01, 0x2C31,
+        0x4363, 0x7453, 0x2D03, 0x1A33, 0x9FA3, 0xA893, 0xF1C3, 0xC6F3,
+        0xEAC2, 0xDDF2, 0x84A2, 0xB392, 0x3602, 0x0132, 0x5862, 0x6F52,
+        0x86C6, 0xB1F6, 0xE8A6, 0xDF96, 0x5A06, 0x6D36, 0x3466, 0x0356,
+        0x2F67, 0x1857, 0x4107, 0x7637, 0xF3A7, 0xC497, 0x9DC7, 0xAAF7,
+        0xC5A5, 0xF295, 0xABC5, 0x9CF5, 0x1965, 0x2E55, 0x7705, 0x4035,
+        0x6C04, 0x5B34, 0x0264, 0x3554, 0xB0C4, 0x87F4, 0xDEA4, 0xE994,
+        0x1DAD, 0x2A9D, 0x73CD, 0x44FD, 0xC16D, 0xF65D, 0xAF0D, 0x983D,
+        0xB40C, 0x833C, 0xDA6C, 0xED5C, 0x68CC, 0x5FFC, 0x06AC, 0x319C,
+        0x5ECE, 0x69FE, 0x30AE, 0x079E, 0x820E, 0xB53E, 0xEC6E, 0xDB5E,
+        0xF76F, 0xC05F, 0x990F, 0xAE3F, 0x2BAF, 0x1C9F, 0x45CF, 0x72FF,
+        0x9B6B, 0xAC5B, 0xF50B, 0xC23B, 0x47AB, 0x709B, 0x29CB, 0x1EFB,
+        0x32CA, 0x05FA, 0x5CAA, 0x6B9A, 0xEE0A, 0xD93A, 0x806A, 0xB75A,
+        0xD808, 0xEF38, 0xB668, 0x8158, 0x04C8, 0x33F8, 0x6AA8, 0x5D98,
+        0x71A9, 0x4699, 0x1FC9, 0x28F9, 0xAD69, 0x9A59, 0xC309, 0xF439,
+        0x3B5A, 0x0C6A, 0x553A, 0x620A, 0xE79A, 0xD0AA, 0x89FA, 0xBECA,
+        0x92FB, 0xA5CB, 0xFC9B, 0xCBAB, 0x4E3B, 0x790B, 0x205B, 0x176B,
+        0x7839, 0x4F09, 0x1659, 0x2169, 0xA4F9, 0x93C9, 0xCA99, 0xFDA9,
+        0xD198, 0xE6A8, 0xBFF8, 0x88C8, 0x0D58, 0x3A68, 0x6338, 0x5408,
+        0xBD9C, 0x8AAC, 0xD3FC, 0xE4CC, 0x615C, 0x566C, 0x0F3C, 0x380C,
+        0x143D, 0x230D, 0x7A5D, 0x4D6D, 0xC8FD, 0xFFCD, 0xA69D, 0x91AD,
+        0xFEFF, 0xC9CF, 0x909F, 0xA7AF, 0x223F, 0x150F, 0x4C5F, 0x7B6F,
+        0x575E, 0x606E, 0x393E, 0x0E0E, 0x8B9E, 0xBCAE, 0xE5FE, 0xD2CE,
+        0x26F7, 0x11C7, 0x4897, 0x7FA7, 0xFA37, 0xCD07, 0x9457, 0xA367,
+        0x8F56, 0xB866, 0xE136, 0xD606, 0x5396, 0x64A6, 0x3DF6, 0x0AC6,
+        0x6594, 0x52A4, 0x0BF4, 0x3CC4, 0xB954, 0x8E64, 0xD734, 0xE004,
+        0xCC35, 0xFB05, 0xA255, 0x9565, 0x10F5, 0x27C5, 0x7E95, 0x49A5,
+        0xA031, 0x9701, 0xCE51, 0xF961, 0x7CF1, 0x4BC1, 0x1291, 0x25A1,
+        0x0990, 0x3EA0, 0x67F0, 0x50C0, 0xD550, 0xE260, 0xBB30, 0x8C00,
+        0xE352, 0xD462, 0x8D32, 0xBA02, 0x3F92, 0x08A2, 0x51F2, 0x66C2,
+        0x4AF3, 0x7DC3, 0x2493, 0x13A3, 0x9633, 0xA103, 0xF853, 0xCF63,
+    },
+    {
+        0x0000, 0x76B4, 0xED68, 0x9BDC, 0xCAF1, 0xBC45, 0x2799, 0x512D,
+        0x85C3, 0xF377, 0x68AB, 0x1E1F, 0x4F32, 0x3986, 0xA25A, 0xD4EE,
+        0x1BA7, 0x6D13, 0xF6CF, 0x807B, 0xD156, 0xA7E2, 0x3C3E, 0x4A8A,
+        0x9E64, 0xE8D0, 0x730C, 0x05B8, 0x5495, 0x2221, 0xB9FD, 0xCF49,
+        0x374E, 0x41FA, 0xDA26, 0xAC92, 0xFDBF, 0x8B0B, 0x10D7, 0x6663,
+        0xB28D, 0xC439, 0x5FE5, 0x2951, 0x787C, 0x0EC8, 0x9514, 0xE3A0,
+        0x2CE9, 0x5A5D, 0xC181, 0xB735, 0xE618, 0x90AC, 0x0B70, 0x7DC4,
+        0xA92A, 0xDF9E, 0x4442, 0x32F6, 0x63DB, 0x156F, 0x8EB3, 0xF807,
+        0x6E9C, 0x1828, 0x83F4, 0xF540, 0xA46D, 0xD2D9, 0x4905, 0x3FB1,
+        0xEB5F, 0x9DEB, 0x0637, 0x7083, 0x21AE, 0x571A, 0xCCC6, 0xBA72,
+        0x753B, 0x038F, 0x9853, 0xEEE7, 0xBFCA, 0xC97E, 0x52A2, 0x2416,
+        0xF0F8, 0x864C, 0x1D90, 0x6B24, 0x3A09, 0x4CBD, 0xD761, 0xA1D5,
+        0x59D2, 0x2F66, 0xB4BA, 0xC20E, 0x9323, 0xE597, 0x7E4B, 0x08FF,
+        0xDC11, 0xAAA5, 0x3179, 0x47CD, 0x16E0, 0x6054, 0xFB88, 0x8D3C,
+        0x4275, 0x34C1, 0xAF1D, 0xD9A9, 0x8884, 0xFE30, 0x65EC, 0x1358,
+        0xC7B6, 0xB102, 0x2ADE, 0x5C6A, 0x0D47, 0x7BF3, 0xE02F, 0x969B,
+        0xDD38, 0xAB8C, 0x3050, 0x46E4, 0x17C9, 0x617D, 0xFAA1, 0x8C15,
+        0x58FB, 0x2E4F, 0xB593, 0xC327, 0x920A, 0xE4BE, 0x7F62, 0x09D6,
+        0xC69F, 0xB02B, 0x2BF7, 0x5D43, 0x0C6E, 0x7ADA, 0xE106, 0x97B2,
+        0x435C, 0x35E8, 0xAE34, 0xD880, 0x89AD, 0xFF19, 0x64C5, 0x1271,
+        0xEA76, 0x9CC2, 0x071E, 0x71AA, 0x2087, 0x5633, 0xCDEF, 0xBB5B,
+        0x6FB5, 0x1901, 0x82DD, 0xF469, 0xA544, 0xD3F0, 0x482C, 0x3E98,
+        0xF1D1, 0x8765, 0x1CB9, 0x6A0D, 0x3B20, 0x4D94, 0xD648, 0xA0FC,
+        0x7412, 0x02A6, 0x997A, 0xEFCE, 0xBEE3, 0xC857, 0x538B, 0x253F,
+        0xB3A4, 0xC510, 0x5ECC, 0x2878, 0x7955, 0x0FE1, 0x943D, 0xE289,
+        0x3667, 0x40D3, 0xDB0F, 0xADBB, 0xFC96, 0x8A22, 0x11FE, 0x674A,
+        0xA803, 0xDEB7, 0x456B, 0x33DF, 0x62F2, 0x1446, 0x8F9A, 0xF92E,
+        0x2DC0, 0x5B74, 0xC0A8, 0xB61C, 0xE731, 0x9185, 0x0A59, 0x7CED,
+        0x84EA, 0xF25E, 0x6982, 0x1F36, 0x4E1B, 0x38AF, 0xA373, 0xD5C7,
+        0x0129, 0x779D, 0xEC41, 0x9AF5, 0xCBD8, 0xBD6C, 0x26B0, 0x5004,
+        0x9F4D, 0xE9F9, 0x7225, 0x0491, 0x55BC, 0x2308, 0xB8D4, 0xCE60,
+        0x1A8E, 0x6C3A, 0xF7E6, 0x8152, 0xD07F, 0xA6CB, 0x3D17, 0x4BA3,
+    },
+#endif
+#if USART_PACK_CRC_SLICES >= 8
+    {
+        0x0000, 0xAA51, 0x4483, 0xEED2, 0x8906, 0x2357, 0xCD85, 0x67D4,
+        0x022D, 0xA87C, 0x46AE, 0xECFF, 0x8B2B, 0x217A, 0xCFA8, 0x65F9,
+        0x045A, 0xAE0B, 0x40D9, 0xEA88, 0x8D5C, 0x270D, 0xC9DF, 0x638E,
+        0x0677, 0xAC26, 0x42F4, 0xE8A5, 0x8F71, 0x2520, 0xCBF2, 0x61A3,
+        0x08B4, 0xA2E5, 0x4C37, 0xE666, 0x81B2, 0x2BE3, 0xC531, 0x6F60,
+        0x0A99, 0xA0C8, 0x4E1A, 0xE44B, 0x839F, 0x29CE, 0xC71C, 0x6D4D,
+        0x0CEE, 0xA6BF, 0x486D, 0xE23C, 0x85E8, 0x2FB9, 0xC16B, 0x6B3A,
+        0x0EC3, 0xA492, 0x4A40, 0xE011, 0x87C5, 0x2D94, 0xC346, 0x6917,
+        0x1168, 0xBB39, 0x55EB, 0xFFBA, 0x986E, 0x323F, 0xDCED, 0x76BC,
+        0x1345, 0xB914, 0x57C6, 0xFD97, 0x9A43, 0x3012, 0xDEC0, 0x7491,
+        0x1532, 0xBF63, 0x51B1, 0xFBE0, 0x9C34, 0x3665, 0xD8B7, 0x72E6,
+        0x171F, 0xBD4E, 0x539C, 0xF9CD, 0x9E19, 0x3448, 0xDA9A, 0x70CB,
+        0x19DC, 0xB38D, 0x5D5F, 0xF70E, 0x90DA, 0x3A8B, 0xD459, 0x7E08,
+        0x1BF1, 0xB1A0, 0x5F72, 0xF523, 0x92F7, 0x38A6, 0xD674, 0x7C25,
+        0x1D86, 0xB7D7, 0x5905, 0xF354, 0x9480, 0x3ED1, 0xD003, 0x7A52,
+        0x1FAB, 0xB5FA, 0x5B28, 0xF179, 0x96AD, 0x3CFC, 0xD22E, 0x787F,
+        0x22D0, 0x8881, 0x6653, 0xCC02, 0xABD6, 0x0187, 0xEF55, 0x4504,
+        0x20FD, 0x8AAC, 0x647E, 0xCE2F, 0xA9FB, 0x03AA, 0xED78, 0x4729,
+        0x268A, 0x8CDB, 0x6209, 0xC858, 0xAF8C, 0x05DD, 0xEB0F, 0x415E,
+        0x24A7, 0x8EF6, 0x6024, 0xCA75, 0xADA1, 0x07F0, 0xE922, 0x4373,
+        0x2A64, 0x8035, 0x6EE7, 0xC4B6, 0xA362, 0x0933, 0xE7E1, 0x4DB0,
+        0x2849, 0x8218, 0x6CCA, 0xC69B, 0xA14F, 0x0B1E, 0xE5CC, 0x4F9D,
+        0x2E3E, 0x846F, 0x6ABD, 0xC0EC, 0xA738, 0x0D69, 0xE3BB, 0x49EA,
+        0x2C13, 0x8642, 0x6890, 0xC2C1, 0xA515, 0x0F44, 0xE196, 0x4BC7,
+        0x33B8, 0x99E9, 0x773B, 0xDD6A, 0xBABE, 0x10EF, 0xFE3D, 0x546C,
+        0x3195, 0x9BC4, 0x7516, 0xDF47, 0xB893, 0x12C2, 0xFC10, 0x5641,
+        0x37E2, 0x9DB3, 0x7361, 0xD930, 0xBEE4, 0x14B5, 0xFA67, 0x5036,
+        0x35CF, 0x9F9E, 0x714C, 0xDB1D, 0xBCC9, 0x1698, 0xF84A, 0x521B,
+        0x3B0C, 0x915D, 0x7F8F, 0xD5DE, 0xB20A, 0x185B, 0xF689, 0x5CD8,
+        0x3921, 0x9370, 0x7DA2, 0xD7F3, 0xB027, 0x1A76, 0xF4A4, 0x5EF5,
+        0x3F56, 0x9507, 0x7BD5, 0xD184, 0xB650, 0x1C01, 0xF2D3, 0x5882,
+        0x3D7B, 0x972A, 0x79F8, 0xD3A9, 0xB47D, 0x1E2C, 0xF0FE, 0x5AAF,
+    },
+    {
+        0x0000, 0x45A0, 0x8B40, 0xCEE0, 0x06A1, 0x4301, 0x8DE1, 0xC841,
+        0x0D42, 0x48E2, 0x8602, 0xC3A2, 0x0BE3, 0x4E43, 0x80A3, 0xC503,
+        0x1A84, 0x5F24, 0x91C4, 0xD464, 0x1C25, 0x5985, 0x9765, 0xD2C5,
+        0x17C6, 0x5266, 0x9C86, 0xD926, 0x1167, 0x54C7, 0x9A27, 0xDF87,
+        0x3508, 0x70A8, 0xBE48, 0xFBE8, 0x33A9, 0x7609, 0xB8E9, 0xFD49,
+        0x384A, 0x7DEA, 0xB30A, 0xF6AA, 0x3EEB, 0x7B4B, 0xB5AB, 0xF00B,
+        0x2F8C, 0x6A2C, 0xA4CC, 0xE16C, 0x292D, 0x6C8D, 0xA26D, 0xE7CD,
+        0x22CE, 0x676E, 0xA98E, 0xEC2E, 0x246F, 0x61CF, 0xAF2F, 0xEA8F,
+        0x6A10, 0x2FB0, 0xE150, 0xA4F0, 0x6CB1, 0x2911, 0xE7F1, 0xA251,
+        0x6752, 0x22F2, 0xEC12, 0xA9B2, 0x61F3, 0x2453, 0xEAB3, 0xAF13,
+        0x7094, 0x3534, 0xFBD4, 0xBE74, 0x7635, 0x3395, 0xFD75, 0xB8D5,
+        0x7DD6, 0x3876, 0xF696, 0xB336, 0x7B77, 0x3ED7, 0xF037, 0xB597,
+        0x5F18, 0x1AB8, 0xD458, 0x91F8, 0x59B9, 0x1C19, 0xD2F9, 0x9759,
+        0x525A, 0x17FA, 0xD91A, 0x9CBA, 0x54FB, 0x115B, 0xDFBB, 0x9A1B,
+        0x459C, 0x003C, 0xCEDC, 0x8B7C, 0x433D, 0x069D, 0xC87D, 0x8DDD,
+        0x48DE, 0x0D7E, 0xC39E, 0x863E, 0x4E7F, 0x0BDF, 0xC53F, 0x809F,
+        0xD420, 0x9180, 0x5F60, 0x1AC0, 0xD281, 0x9721, 0x59C1, 0x1C61,
+        0xD962, 0x9CC2, 0x5222, 0x1782, 0xDFC3, 0x9A63, 0x5483, 0x1123,
+        0xCEA4, 0x8B04, 0x45E4, 0x0044, 0xC805, 0x8DA5, 0x4345, 0x06E5,
+        0xC3E6, 0x8646, 0x48A6, 0x0D06, 0xC547, 0x80E7, 0x4E07, 0x0BA7,
+        0xE128, 0xA488, 0x6A68, 0x2FC8, 0xE789, 0xA229, 0x6CC9, 0x2969,
+        0xEC6A, 0xA9CA, 0x672A, 0x228A, 0xEACB, 0xAF6B, 0x618B, 0x242B,
+        0xFBAC, 0xBE0C, 0x70EC, 0x354C, 0xFD0D, 0xB8AD, 0x764D, 0x33ED,
+        0xF6EE, 0xB34E, 0x7DAE, 0x380E, 0xF04F, 0xB5EF, 0x7B0F, 0x3EAF,
+        0xBE30, 0xFB90, 0x3570, 0x70D0, 0xB891, 0xFD31, 0x33D1, 0x7671,
+        0xB372, 0xF6D2, 0x3832, 0x7D92, 0xB5D3, 0xF073, 0x3E93, 0x7B33,
+        0xA4B4, 0xE114, 0x2FF4, 0x6A54, 0xA215, 0xE7B5, 0x2955, 0x6CF5,
+        0xA9F6, 0xEC56, 0x22B6, 0x6716, 0xAF57, 0xEAF7, 0x2417, 0x61B7,
+        0x8B38, 0xCE98, 0x0078, 0x45D8, 0x8D99, 0xC839, 0x06D9, 0x4379,
+        0x867A, 0xC3DA, 0x0D3A, 0x489A, 0x80DB, 0xC57B, 0x0B9B, 0x4E3B,
+        0x91BC, 0xD41C, 0x1AFC, 0x5F5C, 0x971D, 0xD2BD, 0x1C5D, 0x59FD,
+        0x9CFE, 0xD95E, 0x17BE, 0x521E, 0x9A5F, 0xDFFF, 0x111F, 0x54BF,
+    },
+    {
+        0x0000, 0xB861, 0x60E3, 0xD882, 0xC1C6, 0x79A7, 0xA125, 0x1944,
+        0x93AD, 0x2BCC, 0xF34E, 0x4B2F, 0x526B, 0xEA0A, 0x3288, 0x8AE9,
+        0x377B, 0x8F1A, 0x5798, 0xEFF9, 0xF6BD, 0x4EDC, 0x965E, 0x2E3F,
+        0xA4D6, 0x1CB7, 0xC435, 0x7C54, 0x6510, 0xDD71, 0x05F3, 0xBD92,
+        0x6EF6, 0xD697, 0x0E15, 0xB674, 0xAF30, 0x1751, 0xCFD3, 0x77B2,
+        0xFD5B, 0x453A, 0x9DB8, 0x25D9, 0x3C9D, 0x84FC, 0x5C7E, 0xE41F,
+        0x598D, 0xE1EC, 0x396E, 0x810F, 0x984B, 0x202A, 0xF8A8, 0x40C9,
+        0xCA20, 0x7241, 0xAAC3, 0x12A2, 0x0BE6, 0xB387, 0x6B05, 0xD364,
+        0xDDEC, 0x658D, 0xBD0F, 0x056E, 0x1C2A, 0xA44B, 0x7CC9, 0xC4A8,
+        0x4E41, 0xF620, 0x2EA2, 0x96C3, 0x8F87, 0x37E6, 0xEF64, 0x5705,
+        0xEA97, 0x52F6, 0x8A74, 0x3215, 0x2B51, 0x9330, 0x4BB2, 0xF3D3,
+        0x793A, 0xC15B, 0x19D9, 0xA1B8, 0xB8FC, 0x009D, 0xD81F, 0x607E,
+        0xB31A, 0x0B7B, 0xD3F9, 0x6B98, 0x72DC, 0xCABD, 0x123F, 0xAA5E,
+        0x20B7, 0x98D6, 0x4054, 0xF835, 0xE171, 0x5910, 0x8192, 0x39F3,
+        0x8461, 0x3C00, 0xE482, 0x5CE3, 0x45A7, 0xFDC6, 0x2544, 0x9D25,
+        0x17CC, 0xAFAD, 0x772F, 0xCF4E, 0xD60A, 0x6E6B, 0xB6E9, 0x0E88,
+        0xABF9, 0x1398, 0xCB1A, 0x737B, 0x6A3F, 0xD25E, 0x0ADC, 0xB2BD,
+        0x3854, 0x8035, 0x58B7, 0xE0D6, 0xF992, 0x41F3, 0x9971, 0x2110,
+        0x9C82, 0x24E3, 0xFC61, 0x4400, 0x5D44, 0xE525, 0x3DA7, 0x85C6,
+        0x0F2F, 0xB74E, 0x6FCC, 0xD7AD, 0xCEE9, 0x7688, 0xAE0A, 0x166B,
+        0xC50F, 0x7D6E, 0xA5EC, 0x1D8D, 0x04C9, 0xBCA8, 0x642A, 0xDC4B,
+        0x56A2, 0xEEC3, 0x3641, 0x8E20, 0x9764, 0x2F05, 0xF787, 0x4FE6,
+        0xF274, 0x4A15, 0x9297, 0x2AF6, 0x33B2, 0x8BD3, 0x5351, 0xEB30,
+        0x61D9, 0xD9B8, 0x013A, 0xB95B, 0xA01F, 0x187E, 0xC0FC, 0x789D,
+        0x7615, 0xCE74, 0x16F6, 0xAE97, 0xB7D3, 0x0FB2, 0xD730, 0x6F51,
+        0xE5B8, 0x5DD9, 0x855B, 0x3D3A, 0x247E, 0x9C1F, 0x449D, 0xFCFC,
+        0x416E, 0xF90F, 0x218D, 0x99EC, 0x80A8, 0x38C9, 0xE04B, 0x582A,
+        0xD2C3, 0x6AA2, 0xB220, 0x0A41, 0x1305, 0xAB64, 0x73E6, 0xCB87,
+        0x18E3, 0xA082, 0x7800, 0xC061, 0xD925, 0x6144, 0xB9C6, 0x01A7,
+        0x8B4E, 0x332F, 0xEBAD, 0x53CC, 0x4A88, 0xF2E9, 0x2A6B, 0x920A,
+        0x2F98, 0x97F9, 0x4F7B, 0xF71A, 0xEE5E, 0x563F, 0x8EBD, 0x36DC,
+        0xBC35, 0x0454, 0xDCD6, 0x64B7, 0x7DF3, 0xC592, 0x1D10, 0xA571,
+    },
+    {
+        0x0000, 0x47D3, 0x8FA6, 0xC875, 0x0F6D, 0x48BE, 0x80CB, 0xC718,
+        0x1EDA, 0x5909, 0x917C, 0xD6AF, 0x11B7, 0x5664, 0x9E11, 0xD9C2,
+        0x3DB4, 0x7A67, 0xB212, 0xF5C1, 0x32D9, 0x750A, 0xBD7F, 0xFAAC,
+        0x236E, 0x64BD, 0xACC8, 0xEB1B, 0x2C03, 0x6BD0, 0xA3A5, 0xE476,
+        0x7B68, 0x3CBB, 0xF4CE, 0xB31D, 0x7405, 0x33D6, 0xFBA3, 0xBC70,
+        0x65B2, 0x2261, 0xEA14, 0xADC7, 0x6ADF, 0x2D0C, 0xE579, 0xA2AA,
+        0x46DC, 0x010F, 0xC97A, 0x8EA9, 0x49B1, 0x0E62, 0xC617, 0x81C4,
+        0x5806, 0x1FD5, 0xD7A0, 0x9073, 0x576B, 0x10B8, 0xD8CD, 0x9F1E,
+        0xF6D0, 0xB103, 0x7976, 0x3EA5, 0xF9BD, 0xBE6E, 0x761B, 0x31C8,
+        0xE80A, 0xAFD9, 0x67AC, 0x207F, 0xE767, 0xA0B4, 0x68C1, 0x2F12,
+        0xCB64, 0x8CB7, 0x44C2, 0x0311, 0xC409, 0x83DA, 0x4BAF, 0x0C7C,
+        0xD5BE, 0x926D, 0x5A18, 0x1DCB, 0xDAD3, 0x9D00, 0x5575, 0x12A6,
+        0x8DB8, 0xCA6B, 0x021E, 0x45CD, 0x82D5, 0xC506, 0x0D73, 0x4AA0,
+        0x9362, 0xD4B1, 0x1CC4, 0x5B17, 0x9C0F, 0xDBDC, 0x13A9, 0x547A,
+        0xB00C, 0xF7DF, 0x3FAA, 0x7879, 0xBF61, 0xF8B2, 0x30C7, 0x7714,
+        0xAED6, 0xE905, 0x2170, 0x66A3, 0xA1BB, 0xE668, 0x2E1D, 0x69CE,
+        0xFD81, 0xBA52, 0x7227, 0x35F4, 0xF2EC, 0xB53F, 0x7D4A, 0x3A99,
+        0xE35B, 0xA488, 0x6CFD, 0x2B2E, 0xEC36, 0xABE5, 0x6390, 0x2443,
+        0xC035, 0x87E6, 0x4F93, 0x0840, 0xCF58, 0x888B, 0x40FE, 0x072D,
+        0xDEEF, 0x993C, 0x5149, 0x169A, 0xD182, 0x9651, 0x5E24, 0x19F7,
+        0x86E9, 0xC13A, 0x094F, 0x4E9C, 0x8984, 0xCE57, 0x0622, 0x41F1,
+        0x9833, 0xDFE0, 0x1795, 0x5046, 0x975E, 0xD08D, 0x18F8, 0x5F2B,
+        0xBB5D, 0xFC8E, 0x34FB, 0x7328, 0xB430, 0xF3E3, 0x3B96, 0x7C45,
+        0xA587, 0xE254, 0x2A21, 0x6DF2, 0xAAEA, 0xED39, 0x254C, 0x629F,
+        0x0B51, 0x4C82, 0x84F7, 0xC324, 0x043C, 0x43EF, 0x8B9A, 0xCC49,
+        0x158B, 0x5258, 0x9A2D, 0xDDFE, 0x1AE6, 0x5D35, 0x9540, 0xD293,
+        0x36E5, 0x7136, 0xB943, 0xFE90, 0x3988, 0x7E5B, 0xB62E, 0xF1FD,
+        0x283F, 0x6FEC, 0xA799, 0xE04A, 0x2752, 0x6081, 0xA8F4, 0xEF27,
+        0x7039, 0x37EA, 0xFF9F, 0xB84C, 0x7F54, 0x3887, 0xF0F2, 0xB721,
+        0x6EE3, 0x2930, 0xE145, 0xA696, 0x618E, 0x265D, 0xEE28, 0xA9FB,
+        0x4D8D, 0x0A5E, 0xC22B, 0x85F8, 0x42E0, 0x0533, 0xCD46, 0x8A95,
+        0x5357, 0x1484, 0xDCF1, 0x9B22, 0x5C3A, 0x1BE9, 0xD39C, 0x944F,
+    },
+#endif
+};
+
+static const uint32_t s_crc32_table[USART_PACK_CRC_SLICES][256] = {
+    {
+        0x00000000UL, 0x77073096UL, 0xEE0E612CUL, 0x990951BAUL, 0x076DC419UL, 0x706AF48FUL,
+        0xE963A535UL, 0x9E6495A3UL, 0x0EDB8832UL, 0x79DCB8A4UL, 0xE0D5E91EUL, 0x97D2D988UL,
+        0x09B64C2BUL, 0x7EB17CBDUL, 0xE7B82D07UL, 0x90BF1D91UL, 0x1DB71064UL, 0x6AB020F2UL,
+        0xF3B97148UL, 0x84BE41DEUL, 0x1ADAD47DUL, 0x6DDDE4EBUL, 0xF4D4B551UL, 0x83D385C7UL,
+        0x136C9856UL, 0x646BA8C0UL, 0xFD62F97AUL, 0x8A65C9ECUL, 0x14015C4FUL, 0x63066CD9UL,
+        0xFA0F3D63UL, 0x8D080DF5UL, 0x3B6E20C8UL, 0x4C69105EUL, 0xD56041E4UL, 0xA2677172UL,
+        0x3C03E4D1UL, 0x4B04D447UL, 0xD20D85FDUL, 0xA50AB56BUL, 0x35B5A8FAUL, 0x42B2986CUL,
+        0xDBBBC9D6UL, 0xACBCF940UL, 0x32D86CE3UL, 0x45DF5C75UL, 0xDCD60DCFUL, 0xABD13D59UL,
+        0x26D930ACUL, 0x51DE003AUL, 0xC8D75180UL, 0xBFD06116UL, 0x21B4F4B5UL, 0x56B3C423UL,
+        0xCFBA9599UL, 0xB8BDA50FUL, 0x2802B89EUL, 0x5F058808UL, 0xC60CD9B2UL, 0xB10BE924UL,
+        0x2F6F7C87UL, 0x58684C11UL, 0xC1611DABUL, 0xB6662D3DUL, 0x76DC4190UL, 0x01DB7106UL,
+        0x98D220BCUL, 0xEFD5102AUL, 0x71B18589UL, 0x06B6B51FUL, 0x9FBFE4A5UL, 0xE8B8D433UL,
+        0x7807C9A2UL, 0x0F00F934UL, 0x9609A88EUL, 0xE10E9818UL, 0x7F6A0DBBUL, 0x086D3D2DUL,
+        0x91646C97UL, 0xE6635C01UL, 0x6B6B51F4UL, 0x1C6C6162UL, 0x856530D8UL, 0xF262004EUL,
+        0x6C0695EDUL, 0x1B01A57BUL, 0x8208F4C1UL, 0xF50FC457UL, 0x65B0D9C6UL, 0x12B7E950UL,
+        0x8BBEB8EAUL, 0xFCB9887CUL, 0x62DD1DDFUL, 0x15DA2D49UL, 0x8CD37CF3UL, 0xFBD44C65UL,
+        0x4DB26158UL, 0x3AB551CEUL, 0xA3BC0074UL, 0xD4BB30E2UL, 0x4ADFA541UL, 0x3DD895D7UL,
+        0xA4D1C46DUL, 0xD3D6F4FBUL, 0x4369E96AUL, 0x346ED9FCUL, 0xAD678846UL, 0xDA60B8D0UL,
+        0x44042D73UL, 0x33031DE5UL, 0xAA0A4C5FUL, 0xDD0D7CC9UL, 0x5005713CUL, 0x270241AAUL,
+        0xBE0B1010UL, 0xC90C2086UL, 0x5768B525UL, 0x206F85B3UL, 0xB966D409UL, 0xCE61E49FUL,
+        0x5EDEF90EUL, 0x29D9C998UL, 0xB0D09822UL, 0xC7D7A8B4UL, 0x59B33D17UL, 0x2EB40D81UL,
+        0xB7BD5C3BUL, 0xC0BA6CADUL, 0xEDB88320UL, 0x9ABFB3B6UL, 0x03B6E20CUL, 0x74B1D29AUL,
+        0xEAD54739UL, 0x9DD277AFUL, 0x04DB2615UL, 0x73DC1683UL, 0xE3630B12UL, 0x94643B84UL,
+        0x0D6D6A3EUL, 0x7A6A5AA8UL, 0xE40ECF0BUL, 0x9309FF9DUL, 0x0A00AE27UL, 0x7D079EB1UL,
+        0xF00F9344UL, 0x8708A3D2UL, 0x1E01F268UL, 0x6906C2FEUL, 0xF762575DUL, 0x806567CBUL,
+        0x196C3671UL, 0x6E6B06E7UL, 0xFED41B76UL, 0x89D32BE0UL, 0x10DA7A5AUL, 0x67DD4ACCUL,
+        0xF9B9DF6FUL, 0x8EBEEFF9UL, 0x17B7BE43UL, 0x60B08ED5UL, 0xD6D6A3E8UL, 0xA1D1937EUL,
+        0x38D8C2C4UL, 0x4FDFF252UL, 0xD1BB67F1UL, 0xA6BC5767UL, 0x3FB506DDUL, 0x48B2364BUL,
+        0xD80D2BDAUL, 0xAF0A1B4CUL, 0x36034AF6UL, 0x41047A60UL, 0xDF60EFC3UL, 0xA867DF55UL,
+        0x316E8EEFUL, 0x4669BE79UL, 0xCB61B38CUL, 0xBC66831AUL, 0x256FD2A0UL, 0x5268E236UL,
+        0xCC0C7795UL, 0xBB0B4703UL, 0x220216B9UL, 0x5505262FUL, 0xC5BA3BBEUL, 0xB2BD0B28UL,
+        0x2BB45A92UL, 0x5CB36A04UL, 0xC2D7FFA7UL, 0xB5D0CF31UL, 0x2CD99E8BUL, 0x5BDEAE1DUL,
+        0x9B64C2B0UL, 0xEC63F226UL, 0x756AA39CUL, 0x026D930AUL, 0x9C0906A9UL, 0xEB0E363FUL,
+        0x72076785UL, 0x05005713UL, 0x95BF4A82UL, 0xE2B87A14UL, 0x7BB12BAEUL, 0x0CB61B38UL,
+        0x92D28E9BUL, 0xE5D5BE0DUL, 0x7CDCEFB7UL, 0x0BDBDF21UL, 0x86D3D2D4UL, 0xF1D4E242UL,
+        0x68DDB3F8UL, 0x1FDA836EUL, 0x81BE16CDUL, 0xF6B9265BUL, 0x6FB077E1UL, 0x18B74777UL,
+        0x88085AE6UL, 0xFF0F6A70UL, 0x66063BCAUL, 0x11010B5CUL, 0x8F659EFFUL, 0xF862AE69UL,
+        0x616BFFD3UL, 0x166CCF45UL, 0xA00AE278UL, 0xD70DD2EEUL, 0x4E048354UL, 0x3903B3C2UL,
+        0xA7672661UL, 0xD06016F7UL, 0x4969474DUL, 0x3E6E77DBUL, 0xAED16A4AUL, 0xD9D65ADCUL,
+        0x40DF0B66UL, 0x37D83BF0UL, 0xA9BCAE53UL, 0xDEBB9EC5UL, 0x47B2CF7FUL, 0x30B5FFE9UL,
+        0xBDBDF21CUL, 0xCABAC28AUL, 0x53B39330UL, 0x24B4A3A6UL, 0xBAD03605UL, 0xCDD70693UL,
+        0x54DE5729UL, 0x23D967BFUL, 0xB3667A2EUL, 0xC4614AB8UL, 0x5D681B02UL, 0x2A6F2B94UL,
+        0xB40BBE37UL, 0xC30C8EA1UL, 0x5A05DF1BUL, 0x2D02EF8DUL,
+    },
+#if USART_PACK_CRC_SLICES >= 4
+    {
+        0x00000000UL, 0x191B3141UL, 0x32366282UL, 0x2B2D53C3UL, 0x646CC504UL, 0x7D77F445UL,
+        0x565AA786UL, 0x4F4196C7UL, 0xC8D98A08UL, 0xD1C2BB49UL, 0xFAEFE88AUL, 0xE3F4D9CBUL,
+        0xACB54F0CUL, 0xB5AE7E4DUL, 0x9E832D8EUL, 0x87981CCFUL, 0x4AC21251UL, 0x53D92310UL,
+        0x78F470D3UL, 0x61EF4192UL, 0x2EAED755UL, 0x37B5E614UL, 0x1C98B5D7UL, 0x05838496UL,
+        0x821B9859UL, 0x9B00A918UL, 0xB02DFADBUL, 0xA936CB9AUL, 0xE6775D5DUL, 0xFF6C6C1CUL,
+        0xD4413FDFUL, 0xCD5A0E9EUL, 0x958424A2UL, 0x8C9F15E3UL, 0xA7B24620UL, 0xBEA97761UL,
+        0xF1E8E1A6UL, 0xE8F3D0E7UL, 0xC3DE8324UL, 0xDAC5B265UL, 0x5D5DAEAAUL, 0x44469FEBUL,
+        0x6F6BCC28UL, 0x7670FD69UL, 0x39316BAEUL, 0x202A5AEFUL, 0x0B07092CUL, 0x121C386DUL,
+        0xDF4636F3UL, 0xC65D07B2UL, 0xED705471UL, 0xF46B6530UL, 0xBB2AF3F7UL, 0xA231C2B6UL,
+        0x891C9175UL, 0x9007A034UL, 0x179FBCFBUL, 0x0E848DBAUL, 0x25A9DE79UL, 0x3CB2EF38UL,
+        0x73F379FFUL, 0x6AE848BEUL, 0x41C51B7DUL, 0x58DE2A3CUL, 0xF0794F05UL, 0xE9627E44UL,
+        0xC24F2D87UL, 0xDB541CC6UL, 0x94158A01UL, 0x8D0EBB40UL, 0xA623E883UL, 0xBF38D9C2UL,
+        0x38A0C50DUL, 0x21BBF44CUL, 0x0A96A78FUL, 0x138D96CEUL, 0x5CCC0009UL, 0x45D73148UL,
+        0x6EFA628BUL, 0x77E153CAUL, 0xBABB5D54UL, 0xA3A06C15UL, 0x888D3FD6UL, 0x91960E97UL,
+        0xDED79850UL, 0xC7CCA911UL, 0xECE1FAD2UL, 0xF5FACB93UL, 0x7262D75CUL, 0x6B79E61DUL,
+        0x4054B5DEUL, 0x594F849FUL, 0x160E1258UL, 0x0F152319UL, 0x243870DAUL, 0x3D23419BUL,
+        0x65FD6BA7UL, 0x7CE65AE6UL, 0x57CB0925UL, 0x4ED03864UL, 0x0191AEA3UL, 0x188A9FE2UL,
+        0x33A7CC21UL, 0x2ABCFD60UL, 0xAD24E1AFUL, 0xB43FD0EEUL, 0x9F12832DUL, 0x8609B26CUL,
+        0xC94824ABUL, 0xD05315EAUL, 0xFB7E4629UL, 0xE2657768UL, 0x2F3F79F6UL, 0x362448B7UL,
+        0x1D091B74UL, 0x04122A35UL, 0x4B53BCF2UL, 0x52488DB3UL, 0x7965DE70UL, 0x607EEF31UL,
+        0xE7E6F3FEUL, 0xFEFDC2BFUL, 0xD5D0917CUL, 0xCCCBA03DUL, 0x838A36FAUL, 0x9A9107BBUL,
+        0xB1BC5478UL, 0xA8A76539UL, 0x3B83984BUL, 0x2298A90AUL, 0x09B5FAC9UL, 0x10AECB88UL,
+        0x5FEF5D4FUL, 0x46F46C0EUL, 0x6DD93FCDUL, 0x74C20E8CUL, 0xF35A1243UL, 0xEA412302UL,
+        0xC16C70C1UL, 0xD8774180UL, 0x9736D747UL, 0x8E2DE606UL, 0xA500B5C5UL, 0xBC1B8484UL,
+        0x71418A1AUL, 0x685ABB5BUL, 0x4377E898UL, 0x5A6CD9D9UL, 0x152D4F1EUL, 0x0C367E5FUL,
+        0x271B2D9CUL, 0x3E001CDDUL, 0xB9980012UL, 0xA0833153UL, 0x8BAE6290UL, 0x92B553D1UL,
+        0xDDF4C516UL, 0xC4EFF457UL, 0xEFC2A794UL, 0xF6D996D5UL, 0xAE07BCE9UL, 0xB71C8DA8UL,
+        0x9C31DE6BUL, 0x852AEF2AUL, 0xCA6B79EDUL, 0xD37048ACUL, 0xF85D1B6FUL, 0xE1462A2EUL,
+        0x66DE36E1UL, 0x7FC507A0UL, 0x54E85463UL, 0x4DF36522UL, 0x02B2F3E5UL, 0x1BA9C2A4UL,
+        0x30849167UL, 0x299FA026UL, 0xE4C5AEB8UL, 0xFDDE9FF9UL, 0xD6F3CC3AUL, 0xCFE8FD7BUL,
+        0x80A96BBCUL, 0x99B25AFDUL, 0xB29F093EUL, 0xAB84387FUL, 0x2C1C24B0UL, 0x350715F1UL,
+        0x1E2A4632UL, 0x07317773UL, 0x4870E1B4UL, 0x516BD0F5UL, 0x7A468336UL, 0x635DB277UL,
+        0xCBFAD74EUL, 0xD2E1E60FUL, 0xF9CCB5CCUL, 0xE0D7848DUL, 0xAF96124AUL, 0xB68D230BUL,
+        0x9DA070C8UL, 0x84BB4189UL, 0x03235D46UL, 0x1A386C07UL, 0x31153FC4UL, 0x280E0E85UL,
+        0x674F9842UL, 0x7E54A903UL, 0x5579FAC0UL, 0x4C62CB81UL, 0x8138C51FUL, 0x9823F45EUL,
+        0xB30EA79DUL, 0xAA1596DCUL, 0xE554001BUL, 0xFC4F315AUL, 0xD7626299UL, 0xCE7953D8UL,
+        0x49E14F17UL, 0x50FA7E56UL, 0x7BD72D95UL, 0x62CC1CD4UL, 0x2D8D8A13UL, 0x3496BB52UL,
+        0x1FBBE891UL, 0x06A0D9D0UL, 0x5E7EF3ECUL, 0x4765C2ADUL, 0x6C48916EUL, 0x7553A02FUL,
+        0x3A1236E8UL, 0x230907A9UL, 0x0824546AUL, 0x113F652BUL, 0x96A779E4UL, 0x8FBC48A5UL,
+        0xA4911B66UL, 0xBD8A2A27UL, 0xF2CBBCE0UL, 0xEBD08DA1UL, 0xC0FDDE62UL, 0xD9E6EF23UL,
+        0x14BCE1BDUL, 0x0DA7D0FCUL, 0x268A833FUL, 0x3F91B27EUL, 0x70D024B9UL, 0x69CB15F8UL,
+        0x42E6463BUL, 0x5BFD777AUL, 0xDC656BB5UL, 0xC57E5AF4UL, 0xEE530937UL, 0xF7483876UL,
+        0xB809AEB1UL, 0xA1129FF0UL, 0x8A3FCC33UL, 0x9324FD72UL,
+    },
+    {
+        0x00000000UL, 0x01C26A37UL, 0x0384D46EUL, 0x0246BE59UL, 0x0709A8DCUL, 0x06CBC2EBUL,
+        0x048D7CB2UL, 0x054F1685UL, 0x0E1351B8UL, 0x0FD13B8FUL, 0x0D9785D6UL, 0x0C55EFE1UL,
+        0x091AF964UL, 0x08D89353UL, 0x0A9E2D0AUL, 0x0B5C473DUL, 0x1C26A370UL, 0x1DE4C947UL,
+        0x1FA2771EUL, 0x1E601D29UL, 0x1B2F0BACUL, 0x1AED619BUL, 0x18ABDFC2UL, 0x1969B5F5UL,
+        0x1235F2C8UL, 0x13F798FFUL, 0x11B126A6UL, 0x10734C91UL, 0x153C5A14UL, 0x14FE3023UL,
+        0x16B88E7AUL, 0x177AE44DUL, 0x384D46E0UL, 0x398F2CD7UL, 0x3BC9928EUL, 0x3A0BF8B9UL,
+        0x3F44EE3CUL, 0x3E86840BUL, 0x3CC03A52UL, 0x3D025065UL, 0x365E1758UL, 0x379C7D6FUL,
+        0x35DAC336UL, 0x3418A901UL, 0x3157BF84UL, 0x3095D5B3UL, 0x32D36BEAUL, 0x331101DDUL,
+        0x246BE590UL, 0x25A98FA7UL, 0x27EF31FEUL, 0x262D5BC9UL, 0x23624D4CUL, 0x22A0277BUL,
+        0x20E69922UL, 0x2124F315UL, 0x2A78B428UL, 0x2BBADE1FUL, 0x29FC6046UL, 0x283E0A71UL,
+        0x2D711CF4UL, 0x2CB376C3UL, 0x2EF5C89AUL, 0x2F37A2ADUL, 0x709A8DC0UL, 0x7158E7F7UL,
+        0x731E59AEUL, 0x72DC3399UL, 0x7793251CUL, 0x76514F2BUL, 0x7417F172UL, 0x75D59B45UL,
+        0x7E89DC78UL, 0x7F4BB64FUL, 0x7D0D0816UL, 0x7CCF6221UL, 0x798074A4UL, 0x78421E93UL,
+        0x7A04A0CAUL, 0x7BC6CAFDUL, 0x6CBC2EB0UL, 0x6D7E4487UL, 0x6F38FADEUL, 0x6EFA90E9UL,
+        0x6BB5866CUL, 0x6A77EC5BUL, 0x68315202UL, 0x69F33835UL, 0x62AF7F08UL, 0x636D153FUL,
+        0x612BAB66UL, 0x60E9C151UL, 0x65A6D7D4UL, 0x6464BDE3UL, 0x662203BAUL, 0x67E0698DUL,
+        0x48D7CB20UL, 0x4915A117UL, 0x4B531F4EUL, 0x4A917579UL, 0x4FDE63FCUL, 0x4E1C09CBUL,
+        0x4C5AB792UL, 0x4D98DDA5UL, 0x46C49A98UL, 0x4706F0AFUL, 0x45404EF6UL, 0x448224C1UL,
+        0x41CD3244UL, 0x400F5873UL, 0x4249E62AUL, 0x438B8C1DUL, 0x54F16850UL, 0x55330267UL,
+        0x5775BC3EUL, 0x56B7D609UL, 0x53F8C08CUL, 0x523AAABBUL, 0x507C14E2UL, 0x51BE7ED5UL,
+        0x5AE239E8UL, 0x5B2053DFUL, 0x5966ED86UL, 0x58A487B1UL, 0x5DEB9134UL, 0x5C29FB03UL,
+        0x5E6F455AUL, 0x5FAD2F6DUL, 0xE1351B80UL, 0xE0F771B7UL, 0xE2B1CFEEUL, 0xE373A5D9UL,
+        0xE63CB35CUL, 0xE7FED96BUL, 0xE5B86732UL, 0xE47A0D05UL, 0xEF264A38UL, 0xEEE4200FUL,
+        0xECA29E56UL, 0xED60F461UL, 0xE82FE2E4UL, 0xE9ED88D3UL, 0xEBAB368AUL, 0xEA695CBDUL,
+        0xFD13B8F0UL, 0xFCD1D2C7UL, 0xFE976C9EUL, 0xFF5506A9UL, 0xFA1A102CUL, 0xFBD87A1BUL,
+        0xF99EC442UL, 0xF85CAE75UL, 0xF300E948UL, 0xF2C2837FUL, 0xF0843D26UL, 0xF1465711UL,
+        0xF4094194UL, 0xF5CB2BA3UL, 0xF78D95FAUL, 0xF64FFFCDUL, 0xD9785D60UL, 0xD8BA3757UL,
+        0xDAFC890EUL, 0xDB3EE339UL, 0xDE71F5BCUL, 0xDFB39F8BUL, 0xDDF521D2UL, 0xDC374BE5UL,
+        0xD76B0CD8UL, 0xD6A966EFUL, 0xD4EFD8B6UL, 0xD52DB281UL, 0xD062A404UL, 0xD1A0CE33UL,
+        0xD3E6706AUL, 0xD2241A5DUL, 0xC55EFE10UL, 0xC49C9427UL, 0xC6DA2A7EUL, 0xC7184049UL,
+        0xC25756CCUL, 0xC3953CFBUL, 0xC1D382A2UL, 0xC011E895UL, 0xCB4DAFA8UL, 0xCA8FC59FUL,
+        0xC8C97BC6UL, 0xC90B11F1UL, 0xCC440774UL, 0xCD866D43UL, 0xCFC0D31AUL, 0xCE02B92DUL,
+        0x91AF9640UL, 0x906DFC77UL, 0x922B422EUL, 0x93E92819UL, 0x96A63E9CUL, 0x976454ABUL,
+        0x9522EAF2UL, 0x94E080C5UL, 0x9FBCC7F8UL, 0x9E7EADCFUL, 0x9C381396UL, 0x9DFA79A1UL,
+        0x98B56F24UL, 0x99770513UL, 0x9B31BB4AUL, 0x9AF3D17DUL, 0x8D893530UL, 0x8C4B5F07UL,
+        0x8E0DE15EUL, 0x8FCF8B69UL, 0x8A809DECUL, 0x8B42F7DBUL, 0x89044982UL, 0x88C623B5UL,
+        0x839A6488UL, 0x82580EBFUL, 0x801EB0E6UL, 0x81DCDAD1UL, 0x8493CC54UL, 0x8551A663UL,
+        0x8717183AUL, 0x86D5720DUL, 0xA9E2D0A0UL, 0xA820BA97UL, 0xAA6604CEUL, 0xABA46EF9UL,
+        0xAEEB787CUL, 0xAF29124BUL, 0xAD6FAC12UL, 0xACADC625UL, 0xA7F18118UL, 0xA633EB2FUL,
+        0xA4755576UL, 0xA5B73F41UL, 0xA0F829C4UL, 0xA13A43F3UL, 0xA37CFDAAUL, 0xA2BE979DUL,
+        0xB5C473D0UL, 0xB40619E7UL, 0xB640A7BEUL, 0xB782CD89UL, 0xB2CDDB0CUL, 0xB30FB13BUL,
+        0xB1490F62UL, 0xB08B6555UL, 0xBBD72268UL, 0xBA15485FUL, 0xB853F606UL, 0xB9919C31UL,
+        0xBCDE8AB4UL, 0xBD1CE083UL, 0xBF5A5EDAUL, 0xBE9834EDUL,
+    },
+    {
+        0x00000000UL, 0xB8BC6765UL, 0xAA09C88BUL, 0x12B5AFEEUL, 0x8F629757UL, 0x37DEF032UL,
+        0x256B5FDCUL, 0x9DD738B9UL, 0xC5B428EFUL, 0x7D084F8AUL, 0x6FBDE064UL, 0xD7018701UL,
+        0x4AD6BFB8UL, 0xF26AD8DDUL, 0xE0DF7733UL, 0x58631056UL, 0x5019579FUL, 0xE8A530FAUL,
+        0xFA109F14UL, 0x42ACF871UL, 0xDF7BC0C8UL, 0x67C7A7ADUL, 0x75720843UL, 0xCDCE6F26UL,
+        0x95AD7F70UL, 0x2D111815UL, 0x3FA4B7FBUL, 0x8718D09EUL, 0x1ACFE827UL, 0xA2738F42UL,
+        0xB0C620ACUL, 0x087A47C9UL, 0xA032AF3EUL, 0x188EC85BUL, 0x0A3B67B5UL, 0xB28700D0UL,
+        0x2F503869UL, 0x97EC5F0CUL, 0x8559F0E2UL, 0x3DE59787UL, 0x658687D1UL, 0xDD3AE0B4UL,
+        0xCF8F4F5AUL, 0x7733283FUL, 0xEAE41086UL, 0x525877E3UL, 0x40EDD80DUL, 0xF851BF68UL,
+        0xF02BF8A1UL, 0x48979FC4UL, 0x5A22302AUL, 0xE29E574FUL, 0x7F496FF6UL, 0xC7F50893UL,
+        0xD540A77DUL, 0x6DFCC018UL, 0x359FD04EUL, 0x8D23B72BUL, 0x9F9618C5UL, 0x272A7FA0UL,
+        0xBAFD4719UL, 0x0241207CUL, 0x10F48F92UL, 0xA848E8F7UL, 0x9B14583DUL, 0x23A83F58UL,
+        0x311D90B6UL, 0x89A1F7D3UL, 0x1476CF6AUL, 0xACCAA80FUL, 0xBE7F07E1UL, 0x06C36084UL,
+        0x5EA070D2UL, 0xE61C17B7UL, 0xF4A9B859UL, 0x4C15DF3CUL, 0xD1C2E785UL, 0x697E80E0UL,
+        0x7BCB2F0EUL, 0xC377486BUL, 0xCB0D0FA2UL, 0x73B168C7UL, 0x6104C729UL, 0xD9B8A04CUL,
+        0x446F98F5UL, 0xFCD3FF90UL, 0xEE66507EUL, 0x56DA371BUL, 0x0EB9274DUL, 0xB6054028UL,
+        0xA4B0EFC6UL, 0x1C0C88A3UL, 0x81DBB01AUL, 0x3967D77FUL, 0x2BD27891UL, 0x936E1FF4UL,
+        0x3B26F703UL, 0x839A9066UL, 0x912F3F88UL, 0x299358EDUL, 0xB4446054UL, 0x0CF80731UL,
+        0x1E4DA8DFUL, 0xA6F1CFBAUL, 0xFE92DFECUL, 0x462EB889UL, 0x549B1767UL, 0xEC277002UL,
+        0x71F048BBUL, 0xC94C2FDEUL, 0xDBF98030UL, 0x6345E755UL, 0x6B3FA09CUL, 0xD383C7F9UL,
+        0xC1366817UL, 0x798A0F72UL, 0xE45D37CBUL, 0x5CE150AEUL, 0x4E54FF40UL, 0xF6E89825UL,
+        0xAE8B8873UL, 0x1637EF16UL, 0x048240F8UL, 0xBC3E279DUL, 0x21E91F24UL, 0x99557841UL,
+        0x8BE0D7AFUL, 0x335CB0CAUL, 0xED59B63BUL, 0x55E5D15EUL, 0x47507EB0UL, 0xFFEC19D5UL,
+        0x623B216CUL, 0xDA874609UL, 0xC832E9E7UL, 0x708E8E82UL, 0x28ED9ED4UL, 0x9051F9B1UL,
+        0x82E4565FUL, 0x3A58313AUL, 0xA78F0983UL, 0x1F336EE6UL, 0x0D86C108UL, 0xB53AA66DUL,
+        0xBD40E1A4UL, 0x05FC86C1UL, 0x1749292FUL, 0xAFF54E4AUL, 0x322276F3UL, 0x8A9E1196UL,
+        0x982BBE78UL, 0x2097D91DUL, 0x78F4C94BUL, 0xC048AE2EUL, 0xD2FD01C0UL, 0x6A4166A5UL,
+        0xF7965E1CUL, 0x4F2A3979UL, 0x5D9F9697UL, 0xE523F1F2UL, 0x4D6B1905UL, 0xF5D77E60UL,
+        0xE762D18EUL, 0x5FDEB6EBUL, 0xC2098E52UL, 0x7AB5E937UL, 0x680046D9UL, 0xD0BC21BCUL,
+        0x88DF31EAUL, 0x3063568FUL, 0x22D6F961UL, 0x9A6A9E04UL, 0x07BDA6BDUL, 0xBF01C1D8UL,
+        0xADB46E36UL, 0x15080953UL, 0x1D724E9AUL, 0xA5CE29FFUL, 0xB77B8611UL, 0x0FC7E174UL,
+        0x9210D9CDUL, 0x2AACBEA8UL, 0x38191146UL, 0x80A57623UL, 0xD8C66675UL, 0x607A0110UL,
+        0x72CFAEFEUL, 0xCA73C99BUL, 0x57A4F122UL, 0xEF189647UL, 0xFDAD39A9UL, 0x45115ECCUL,
+        0x764DEE06UL, 0xCEF18963UL, 0xDC44268DUL, 0x64F841E8UL, 0xF92F7951UL, 0x41931E34UL,
+        0x5326B1DAUL, 0xEB9AD6BFUL, 0xB3F9C6E9UL, 0x0B45A18CUL, 0x19F00E62UL, 0xA14C6907UL,
+        0x3C9B51BEUL, 0x842736DBUL, 0x96929935UL, 0x2E2EFE50UL, 0x2654B999UL, 0x9EE8DEFCUL,
+        0x8C5D7112UL, 0x34E11677UL, 0xA9362ECEUL, 0x118A49ABUL, 0x033FE645UL, 0xBB838120UL,
+        0xE3E09176UL, 0x5B5CF613UL, 0x49E959FDUL, 0xF1553E98UL, 0x6C820621UL, 0xD43E6144UL,
+        0xC68BCEAAUL, 0x7E37A9CFUL, 0xD67F4138UL, 0x6EC3265DUL, 0x7C7689B3UL, 0xC4CAEED6UL,
+        0x591DD66FUL, 0xE1A1B10AUL, 0xF3141EE4UL, 0x4BA87981UL, 0x13CB69D7UL, 0xAB770EB2UL,
+        0xB9C2A15CUL, 0x017EC639UL, 0x9CA9FE80UL, 0x241599E5UL, 0x36A0360BUL, 0x8E1C516EUL,
+        0x866616A7UL, 0x3EDA71C2UL, 0x2C6FDE2CUL, 0x94D3B949UL, 0x090481F0UL, 0xB1B8E695UL,
+        0xA30D497BUL, 0x1BB12E1EUL, 0x43D23E48UL, 0xFB6E592DUL, 0xE9DBF6C3UL, 0x516791A6UL,
+        0xCCB0A91FUL, 0x740CCE7AUL, 0x66B96194UL, 0xDE0506F1UL,
+    },
+#endif
+#if USART_PACK_CRC_SLICES >= 8
+    {
+        0x00000000UL, 0x3D6029B0UL, 0x7AC05360UL, 0x47A07AD0UL, 0xF580A6C0UL, 0xC8E08F70UL,
+        0x8F40F5A0UL, 0xB220DC10UL, 0x30704BC1UL, 0x0D106271UL, 0x4AB018A1UL, 0x77D03111UL,
+        0xC5F0ED01UL, 0xF890C4B1UL, 0xBF30BE61UL, 0x825097D1UL, 0x60E09782UL, 0x5D80BE32UL,
+        0x1A20C4E2UL, 0x2740ED52UL, 0x95603142UL, 0xA80018F2UL, 0xEFA06222UL, 0xD2C04B92UL,
+        0x5090DC43UL, 0x6DF0F5F3UL, 0x2A508F23UL, 0x1730A693UL, 0xA5107A83UL, 0x98705333UL,
+        0xDFD029E3UL, 0xE2B00053UL, 0xC1C12F04UL, 0xFCA106B4UL, 0xBB017C64UL, 0x866155D4UL,
+        0x344189C4UL, 0x0921A074UL, 0x4E81DAA4UL, 0x73E1F314UL, 0xF1B164C5UL, 0xCCD14D75UL,
+        0x8B7137A5UL, 0xB6111E15UL, 0x0431C205UL, 0x3951EBB5UL, 0x7EF19165UL, 0x4391B8D5UL,
+        0xA121B886UL, 0x9C419136UL, 0xDBE1EBE6UL, 0xE681C256UL, 0x54A11E46UL, 0x69C137F6UL,
+        0x2E614D26UL, 0x13016496UL, 0x9151F347UL, 0xAC31DAF7UL, 0xEB91A027UL, 0xD6F18997UL,
+        0x64D15587UL, 0x59B17C37UL, 0x1E1106E7UL, 0x23712F57UL, 0x58F35849UL, 0x659371F9UL,
+        0x22330B29UL, 0x1F532299UL, 0xAD73FE89UL, 0x9013D739UL, 0xD7B3ADE9UL, 0xEAD38459UL,
+        0x68831388UL, 0x55E33A38UL, 0x124340E8UL, 0x2F236958UL, 0x9D03B548UL, 0xA0639CF8UL,
+        0xE7C3E628UL, 0xDAA3CF98UL, 0x3813CFCBUL, 0x0573E67BUL, 0x42D39CABUL, 0x7FB3B51BUL,
+        0xCD93690BUL, 0xF0F340BBUL, 0xB7533A6BUL, 0x8A3313DBUL, 0x0863840AUL, 0x3503ADBAUL,
+        0x72A3D76AUL, 0x4FC3FEDAUL, 0xFDE322CAUL, 0xC0830B7AUL, 0x872371AAUL, 0xBA43581AUL,
+        0x9932774DUL, 0xA4525EFDUL, 0xE3F2242DUL, 0xDE920D9DUL, 0x6CB2D18DUL, 0x51D2F83DUL,
+        0x167282EDUL, 0x2B12AB5DUL, 0xA9423C8CUL, 0x9422153CUL, 0xD3826FECUL, 0xEEE2465CUL,
+        0x5CC29A4CUL, 0x61A2B3FCUL, 0x2602C92CUL, 0x1B62E09CUL, 0xF9D2E0CFUL, 0xC4B2C97FUL,
+        0x8312B3AFUL, 0xBE729A1FUL, 0x0C52460FUL, 0x31326FBFUL, 0x7692156FUL, 0x4BF23CDFUL,
+        0xC9A2AB0EUL, 0xF4C282BEUL, 0xB362F86EUL, 0x8E02D1DEUL, 0x3C220DCEUL, 0x0142247EUL,
+        0x46E25EAEUL, 0x7B82771EUL, 0xB1E6B092UL, 0x8C869922UL, 0xCB26E3F2UL, 0xF646CA42UL,
+        0x44661652UL, 0x79063FE2UL, 0x3EA64532UL, 0x03C66C82UL, 0x8196FB53UL, 0xBCF6D2E3UL,
+        0xFB56A833UL, 0xC6368183UL, 0x74165D93UL, 0x49767423UL, 0x0ED60EF3UL, 0x33B62743UL,
+        0xD1062710UL, 0xEC660EA0UL, 0xABC67470UL, 0x96A65DC0UL, 0x248681D0UL, 0x19E6A860UL,
+        0x5E46D2B0UL, 0x6326FB00UL, 0xE1766CD1UL, 0xDC164561UL, 0x9BB63FB1UL, 0xA6D61601UL,
+        0x14F6CA11UL, 0x2996E3A1UL, 0x6E369971UL, 0x5356B0C1UL, 0x70279F96UL, 0x4D47B626UL,
+        0x0AE7CCF6UL, 0x3787E546UL, 0x85A73956UL, 0xB8C710E6UL, 0xFF676A36UL, 0xC2074386UL,
+        0x4057D457UL, 0x7D37FDE7UL, 0x3A978737UL, 0x07F7AE87UL, 0xB5D77297UL, 0x88B75B27UL,
+        0xCF1721F7UL, 0xF2770847UL, 0x10C70814UL, 0x2DA721A4UL, 0x6A075B74UL, 0x576772C4UL,
+        0xE547AED4UL, 0xD8278764UL, 0x9F87FDB4UL, 0xA2E7D404UL, 0x20B743D5UL, 0x1DD76A65UL,
+        0x5A7710B5UL, 0x67173905UL, 0xD537E515UL, 0xE857CCA5UL, 0xAFF7B675UL, 0x92979FC5UL,
+        0xE915E8DBUL, 0xD475C16BUL, 0x93D5BBBBUL, 0xAEB5920BUL, 0x1C954E1BUL, 0x21F567ABUL,
+        0x66551D7BUL, 0x5B3534CBUL, 0xD965A31AUL, 0xE4058AAAUL, 0xA3A5F07AUL, 0x9EC5D9CAUL,
+        0x2CE505DAUL, 0x11852C6AUL, 0x562556BAUL, 0x6B457F0AUL, 0x89F57F59UL, 0xB49556E9UL,
+        0xF3352C39UL, 0xCE550589UL, 0x7C75D999UL, 0x4115F029UL, 0x06B58AF9UL, 0x3BD5A349UL,
+        0xB9853498UL, 0x84E51D28UL, 0xC34567F8UL, 0xFE254E48UL, 0x4C059258UL, 0x7165BBE8UL,
+        0x36C5C138UL, 0x0BA5E888UL, 0x28D4C7DFUL, 0x15B4EE6FUL, 0x521494BFUL, 0x6F74BD0FUL,
+        0xDD54611FUL, 0xE03448AFUL, 0xA794327FUL, 0x9AF41BCFUL, 0x18A48C1EUL, 0x25C4A5AEUL,
+        0x6264DF7EUL, 0x5F04F6CEUL, 0xED242ADEUL, 0xD044036EUL, 0x97E479BEUL, 0xAA84500EUL,
+        0x4834505DUL, 0x755479EDUL, 0x32F4033DUL, 0x0F942A8DUL, 0xBDB4F69DUL, 0x80D4DF2DUL,
+        0xC774A5FDUL, 0xFA148C4DUL, 0x78441B9CUL, 0x4524322CUL, 0x028448FCUL, 0x3FE4614CUL,
+        0x8DC4BD5CUL, 0xB0A494ECUL, 0xF704EE3CUL, 0xCA64C78CUL,
+    },
+    {
+        0x00000000UL, 0xCB5CD3A5UL, 0x4DC8A10BUL, 0x869472AEUL, 0x9B914216UL, 0x50CD91B3UL,
+        0xD659E31DUL, 0x1D0530B8UL, 0xEC53826DUL, 0x270F51C8UL, 0xA19B2366UL, 0x6AC7F0C3UL,
+        0x77C2C07BUL, 0xBC9E13DEUL, 0x3A0A6170UL, 0xF156B2D5UL, 0x03D6029BUL, 0xC88AD13EUL,
+        0x4E1EA390UL, 0x85427035UL, 0x9847408DUL, 0x531B9328UL, 0xD58FE186UL, 0x1ED33223UL,
+        0xEF8580F6UL, 0x24D95353UL, 0xA24D21FDUL, 0x6911F258UL, 0x7414C2E0UL, 0xBF481145UL,
+        0x39DC63EBUL, 0xF280B04EUL, 0x07AC0536UL, 0xCCF0D693UL, 0x4A64A43DUL, 0x81387798UL,
+        0x9C3D4720UL, 0x57619485UL, 0xD1F5E62BUL, 0x1AA9358EUL, 0xEBFF875BUL, 0x20A354FEUL,
+        0xA6372650UL, 0x6D6BF5F5UL, 0x706EC54DUL, 0xBB3216E8UL, 0x3DA66446UL, 0xF6FAB7E3UL,
+        0x047A07ADUL, 0xCF26D408UL, 0x49B2A6A6UL, 0x82EE7503UL, 0x9FEB45BBUL, 0x54B7961EUL,
+        0xD223E4B0UL, 0x197F3715UL, 0xE82985C0UL, 0x23755665UL, 0xA5E124CBUL, 0x6EBDF76EUL,
+        0x73B8C7D6UL, 0xB8E41473UL, 0x3E7066DDUL, 0xF52CB578UL, 0x0F580A6CUL, 0xC404D9C9UL,
+        0x4290AB67UL, 0x89CC78C2UL, 0x94C9487AUL, 0x5F959BDFUL, 0xD901E971UL, 0x125D3AD4UL,
+        0xE30B8801UL, 0x28575BA4UL, 0xAEC3290AUL, 0x659FFAAFUL, 0x789ACA17UL, 0xB3C619B2UL,
+        0x35526B1CUL, 0xFE0EB8B9UL, 0x0C8E08F7UL, 0xC7D2DB52UL, 0x4146A9FCUL, 0x8A1A7A59UL,
+        0x971F4AE1UL, 0x5C439944UL, 0xDAD7EBEAUL, 0x118B384FUL, 0xE0DD8A9AUL, 0x2B81593FUL,
+        0xAD152B91UL, 0x6649F834UL, 0x7B4CC88CUL, 0xB0101B29UL, 0x36846987UL, 0xFDD8BA22UL,
+        0x08F40F5AUL, 0xC3A8DCFFUL, 0x453CAE51UL, 0x8E607DF4UL, 0x93654D4CUL, 0x58399EE9UL,
+        0xDEADEC47UL, 0x15F13FE2UL, 0xE4A78D37UL, 0x2FFB5E92UL, 0xA96F2C3CUL, 0x6233FF99UL,
+        0x7F36CF21UL, 0xB46A1C84UL, 0x32FE6E2AUL, 0xF9A2BD8FUL, 0x0B220DC1UL, 0xC07EDE64UL,
+        0x46EAACCAUL, 0x8DB67F6FUL, 0x90B34FD7UL, 0x5BEF9C72UL, 0xDD7BEEDCUL, 0x16273D79UL,
+        0xE7718FACUL, 0x2C2D5C09UL, 0xAAB92EA7UL, 0x61E5FD02UL, 0x7CE0CDBAUL, 0xB7BC1E1FUL,
+        0x31286CB1UL, 0xFA74BF14UL, 0x1EB014D8UL, 0xD5ECC77DUL, 0x5378B5D3UL, 0x98246676UL,
+        0x852156CEUL, 0x4E7D856BUL, 0xC8E9F7C5UL, 0x03B52460UL, 0xF2E396B5UL, 0x39BF4510UL,
+        0xBF2B37BEUL, 0x7477E41BUL, 0x6972D4A3UL, 0xA22E0706UL, 0x24BA75A8UL, 0xEFE6A60DUL,
+        0x1D661643UL, 0xD63AC5E6UL, 0x50AEB748UL, 0x9BF264EDUL, 0x86F75455UL, 0x4DAB87F0UL,
+        0xCB3FF55EUL, 0x006326FBUL, 0xF135942EUL, 0x3A69478BUL, 0xBCFD3525UL, 0x77A1E680UL,
+        0x6AA4D638UL, 0xA1F8059DUL, 0x276C7733UL, 0xEC30A496UL, 0x191C11EEUL, 0xD240C24BUL,
+        0x54D4B0E5UL, 0x9F886340UL, 0x828D53F8UL, 0x49D1805DUL, 0xCF45F2F3UL, 0x04192156UL,
+        0xF54F9383UL, 0x3E134026UL, 0xB8873288UL, 0x73DBE12DUL, 0x6EDED195UL, 0xA5820230UL,
+        0x2316709EUL, 0xE84AA33BUL, 0x1ACA1375UL, 0xD196C0D0UL, 0x5702B27EUL, 0x9C5E61DBUL,
+        0x815B5163UL, 0x4A0782C6UL, 0xCC93F068UL, 0x07CF23CDUL, 0xF6999118UL, 0x3DC542BDUL,
+        0xBB513013UL, 0x700DE3B6UL, 0x6D08D30EUL, 0xA65400ABUL, 0x20C07205UL, 0xEB9CA1A0UL,
+        0x11E81EB4UL, 0xDAB4CD11UL, 0x5C20BFBFUL, 0x977C6C1AUL, 0x8A795CA2UL, 0x41258F07UL,
+        0xC7B1FDA9UL, 0x0CED2E0CUL, 0xFDBB9CD9UL, 0x36E74F7CUL, 0xB0733DD2UL, 0x7B2FEE77UL,
+        0x662ADECFUL, 0xAD760D6AUL, 0x2BE27FC4UL, 0xE0BEAC61UL, 0x123E1C2FUL, 0xD962CF8AUL,
+        0x5FF6BD24UL, 0x94AA6E81UL, 0x89AF5E39UL, 0x42F38D9CUL, 0xC467FF32UL, 0x0F3B2C97UL,
+        0xFE6D9E42UL, 0x35314DE7UL, 0xB3A53F49UL, 0x78F9ECECUL, 0x65FCDC54UL, 0xAEA00FF1UL,
+        0x28347D5FUL, 0xE368AEFAUL, 0x16441B82UL, 0xDD18C827UL, 0x5B8CBA89UL, 0x90D0692CUL,
+        0x8DD55994UL, 0x46898A31UL, 0xC01DF89FUL, 0x0B412B3AUL, 0xFA1799EFUL, 0x314B4A4AUL,
+        0xB7DF38E4UL, 0x7C83EB41UL, 0x6186DBF9UL, 0xAADA085CUL, 0x2C4E7AF2UL, 0xE712A957UL,
+        0x15921919UL, 0xDECECABCUL, 0x585AB812UL, 0x93066BB7UL, 0x8E035B0FUL, 0x455F88AAUL,
+        0xC3CBFA04UL, 0x089729A1UL, 0xF9C19B74UL, 0x329D48D1UL, 0xB4093A7FUL, 0x7F55E9DAUL,
+        0x6250D962UL, 0xA90C0AC7UL, 0x2F987869UL, 0xE4C4ABCCUL,
+    },
+    {
+        0x00000000UL, 0xA6770BB4UL, 0x979F1129UL, 0x31E81A9DUL, 0xF44F2413UL, 0x52382FA7UL,
+        0x63D0353AUL, 0xC5A73E8EUL, 0x33EF4E67UL, 0x959845D3UL, 0xA4705F4EUL, 0x020754FAUL,
+        0xC7A06A74UL, 0x61D761C0UL, 0x503F7B5DUL, 0xF64870E9UL, 0x67DE9CCEUL, 0xC1A9977AUL,
+        0xF0418DE7UL, 0x56368653UL, 0x9391B8DDUL, 0x35E6B369UL, 0x040EA9F4UL, 0xA279A240UL,
+        0x5431D2A9UL, 0xF246D91DUL, 0xC3AEC380UL, 0x65D9C834UL, 0xA07EF6BAUL, 0x0609FD0EUL,
+        0x37E1E793UL, 0x9196EC27UL, 0xCFBD399CUL, 0x69CA3228UL, 0x582228B5UL, 0xFE552301UL,
+        0x3BF21D8FUL, 0x9D85163BUL, 0xAC6D0CA6UL, 0x0A1A0712UL, 0xFC5277FBUL, 0x5A257C4FUL,
+        0x6BCD66D2UL, 0xCDBA6D66UL, 0x081D53E8UL, 0xAE6A585CUL, 0x9F8242C1UL, 0x39F54975UL,
+        0xA863A552UL, 0x0E14AEE6UL, 0x3FFCB47BUL, 0x998BBFCFUL, 0x5C2C8141UL, 0xFA5B8AF5UL,
+        0xCBB39068UL, 0x6DC49BDCUL, 0x9B8CEB35UL, 0x3DFBE081UL, 0x0C13FA1CUL, 0xAA64F1A8UL,
+        0x6FC3CF26UL, 0xC9B4C492UL, 0xF85CDE0FUL, 0x5E2BD5BBUL, 0x440B7579UL, 0xE27C7ECDUL,
+        0xD3946450UL, 0x75E36FE4UL, 0xB044516AUL, 0x16335ADEUL, 0x27DB4043UL, 0x81AC4BF7UL,
+        0x77E43B1EUL, 0xD19330AAUL, 0xE07B2A37UL, 0x460C2183UL, 0x83AB1F0DUL, 0x25DC14B9UL,
+        0x14340E24UL, 0xB2430590UL, 0x23D5E9B7UL, 0x85A2E203UL, 0xB44AF89EUL, 0x123DF32AUL,
+        0xD79ACDA4UL, 0x71EDC610UL, 0x4005DC8DUL, 0xE672D739UL, 0x103AA7D0UL, 0xB64DAC64UL,
+        0x87A5B6F9UL, 0x21D2BD4DUL, 0xE47583C3UL, 0x42028877UL, 0x73EA92EAUL, 0xD59D995EUL,
+        0x8BB64CE5UL, 0x2DC14751UL, 0x1C295DCCUL, 0xBA5E5678UL, 0x7FF968F6UL, 0xD98E6342UL,
+        0xE86679DFUL, 0x4E11726BUL, 0xB8590282UL, 0x1E2E0936UL, 0x2FC613ABUL, 0x89B1181FUL,
+        0x4C162691UL, 0xEA612D25UL, 0xDB8937B8UL, 0x7DFE3C0CUL, 0xEC68D02BUL, 0x4A1FDB9FUL,
+        0x7BF7C102UL, 0xDD80CAB6UL, 0x1827F438UL, 0xBE50FF8CUL, 0x8FB8E511UL, 0x29CFEEA5UL,
+        0xDF879E4CUL, 0x79F095F8UL, 0x48188F65UL, 0xEE6F84D1UL, 0x2BC8BA5FUL, 0x8DBFB1EBUL,
+        0xBC57AB76UL, 0x1A20A0C2UL, 0x8816EAF2UL, 0x2E61E146UL, 0x1F89FBDBUL, 0xB9FEF06FUL,
+        0x7C59CEE1UL, 0xDA2EC555UL, 0xEBC6DFC8UL, 0x4DB1D47CUL, 0xBBF9A495UL, 0x1D8EAF21UL,
+        0x2C66B5BCUL, 0x8A11BE08UL, 0x4FB68086UL, 0xE9C18B32UL, 0xD82991AFUL, 0x7E5E9A1BUL,
+        0xEFC8763CUL, 0x49BF7D88UL, 0x78576715UL, 0xDE206CA1UL, 0x1B87522FUL, 0xBDF0599BUL,
+        0x8C184306UL, 0x2A6F48B2UL, 0xDC27385BUL, 0x7A5033EFUL, 0x4BB82972UL, 0xEDCF22C6UL,
+        0x28681C48UL, 0x8E1F17FCUL, 0xBFF70D61UL, 0x198006D5UL, 0x47ABD36EUL, 0xE1DCD8DAUL,
+        0xD034C247UL, 0x7643C9F3UL, 0xB3E4F77DUL, 0x1593FCC9UL, 0x247BE654UL, 0x820CEDE0UL,
+        0x74449D09UL, 0xD23396BDUL, 0xE3DB8C20UL, 0x45AC8794UL, 0x800BB91AUL, 0x267CB2AEUL,
+        0x1794A833UL, 0xB1E3A387UL, 0x20754FA0UL, 0x86024414UL, 0xB7EA5E89UL, 0x119D553DUL,
+        0xD43A6BB3UL, 0x724D6007UL, 0x43A57A9AUL, 0xE5D2712EUL, 0x139A01C7UL, 0xB5ED0A73UL,
+        0x840510EEUL, 0x22721B5AUL, 0xE7D525D4UL, 0x41A22E60UL, 0x704A34FDUL, 0xD63D3F49UL,
+        0xCC1D9F8BUL, 0x6A6A943FUL, 0x5B828EA2UL, 0xFDF58516UL, 0x3852BB98UL, 0x9E25B02CUL,
+        0xAFCDAAB1UL, 0x09BAA105UL, 0xFFF2D1ECUL, 0x5985DA58UL, 0x686DC0C5UL, 0xCE1ACB71UL,
+        0x0BBDF5FFUL, 0xADCAFE4BUL, 0x9C22E4D6UL, 0x3A55EF62UL, 0xABC30345UL, 0x0DB408F1UL,
+        0x3C5C126CUL, 0x9A2B19D8UL, 0x5F8C2756UL, 0xF9FB2CE2UL, 0xC813367FUL, 0x6E643DCBUL,
+        0x982C4D22UL, 0x3E5B4696UL, 0x0FB35C0BUL, 0xA9C457BFUL, 0x6C636931UL, 0xCA146285UL,
+        0xFBFC7818UL, 0x5D8B73ACUL, 0x03A0A617UL, 0xA5D7ADA3UL, 0x943FB73EUL, 0x3248BC8AUL,
+        0xF7EF8204UL, 0x519889B0UL, 0x6070932DUL, 0xC6079899UL, 0x304FE870UL, 0x9638E3C4UL,
+        0xA7D0F959UL, 0x01A7F2EDUL, 0xC400CC63UL, 0x6277C7D7UL, 0x539FDD4AUL, 0xF5E8D6FEUL,
+        0x647E3AD9UL, 0xC209316DUL, 0xF3E12BF0UL, 0x55962044UL, 0x90311ECAUL, 0x3646157EUL,
+        0x07AE0FE3UL, 0xA1D90457UL, 0x579174BEUL, 0xF1E67F0AUL, 0xC00E6597UL, 0x66796E23UL,
+        0xA3DE50ADUL, 0x05A95B19UL, 0x34414184UL, 0x92364A30UL,
+    },
+    {
+        0x00000000UL, 0xCCAA009EUL, 0x4225077DUL, 0x8E8F07E3UL, 0x844A0EFAUL, 0x48E00E64UL,
+        0xC66F0987UL, 0x0AC50919UL, 0xD3E51BB5UL, 0x1F4F1B2BUL, 0x91C01CC8UL, 0x5D6A1C56UL,
+        0x57AF154FUL, 0x9B0515D1UL, 0x158A1232UL, 0xD92012ACUL, 0x7CBB312BUL, 0xB01131B5UL,
+        0x3E9E3656UL, 0xF23436C8UL, 0xF8F13FD1UL, 0x345B3F4FUL, 0xBAD438ACUL, 0x767E3832UL,
+        0xAF5E2A9EUL, 0x63F42A00UL, 0xED7B2DE3UL, 0x21D12D7DUL, 0x2B142464UL, 0xE7BE24FAUL,
+        0x69312319UL, 0xA59B2387UL, 0xF9766256UL, 0x35DC62C8UL, 0xBB53652BUL, 0x77F965B5UL,
+        0x7D3C6CACUL, 0xB1966C32UL, 0x3F196BD1UL, 0xF3B36B4FUL, 0x2A9379E3UL, 0xE639797DUL,
+        0x68B67E9EUL, 0xA41C7E00UL, 0xAED97719UL, 0x62737787UL, 0xECFC7064UL, 0x205670FAUL,
+        0x85CD537DUL, 0x496753E3UL, 0xC7E85400UL, 0x0B42549EUL, 0x01875D87UL, 0xCD2D5D19UL,
+        0x43A25AFAUL, 0x8F085A64UL, 0x562848C8UL, 0x9A824856UL, 0x140D4FB5UL, 0xD8A74F2BUL,
+        0xD2624632UL, 0x1EC846ACUL, 0x9047414FUL, 0x5CED41D1UL, 0x299DC2EDUL, 0xE537C273UL,
+        0x6BB8C590UL, 0xA712C50EUL, 0xADD7CC17UL, 0x617DCC89UL, 0xEFF2CB6AUL, 0x2358CBF4UL,
+        0xFA78D958UL, 0x36D2D9C6UL, 0xB85DDE25UL, 0x74F7DEBBUL, 0x7E32D7A2UL, 0xB298D73CUL,
+        0x3C17D0DFUL, 0xF0BDD041UL, 0x5526F3C6UL, 0x998CF358UL, 0x1703F4BBUL, 0xDBA9F425UL,
+        0xD16CFD3CUL, 0x1DC6FDA2UL, 0x9349FA41UL, 0x5FE3FADFUL, 0x86C3E873UL, 0x4A69E8EDUL,
+        0xC4E6EF0EUL, 0x084CEF90UL, 0x0289E689UL, 0xCE23E617UL, 0x40ACE1F4UL, 0x8C06E16AUL,
+        0xD0EBA0BBUL, 0x1C41A025UL, 0x92CEA7C6UL, 0x5E64A758UL, 0x54A1AE41UL, 0x980BAEDFUL,
+        0x1684A93CUL, 0xDA2EA9A2UL, 0x030EBB0EUL, 0xCFA4BB90UL, 0x412BBC73UL, 0x8D81BCEDUL,
+        0x8744B5F4UL, 0x4BEEB56AUL, 0xC561B289UL, 0x09CBB217UL, 0xAC509190UL, 0x60FA910EUL,
+        0xEE7596EDUL, 0x22DF9673UL, 0x281A9F6AUL, 0xE4B09FF4UL, 0x6A3F9817UL, 0xA6959889UL,
+        0x7FB58A25UL, 0xB31F8ABBUL, 0x3D908D58UL, 0xF13A8DC6UL, 0xFBFF84DFUL, 0x37558441UL,
+        0xB9DA83A2UL, 0x7570833CUL, 0x533B85DAUL, 0x9F918544UL, 0x111E82A7UL, 0xDDB48239UL,
+        0xD7718B20UL, 0x1BDB8BBEUL, 0x95548C5DUL, 0x59FE8CC3UL, 0x80DE9E6FUL, 0x4C749EF1UL,
+        0xC2FB9912UL, 0x0E51998CUL, 0x04949095UL, 0xC83E900BUL, 0x46B197E8UL, 0x8A1B9776UL,
+        0x2F80B4F1UL, 0xE32AB46FUL, 0x6DA5B38CUL, 0xA10FB312UL, 0xABCABA0BUL, 0x6760BA95UL,
+        0xE9EFBD76UL, 0x2545BDE8UL, 0xFC65AF44UL, 0x30CFAFDAUL, 0xBE40A839UL, 0x72EAA8A7UL,
+        0x782FA1BEUL, 0xB485A120UL, 0x3A0AA6C3UL, 0xF6A0A65DUL, 0xAA4DE78CUL, 0x66E7E712UL,
+        0xE868E0F1UL, 0x24C2E06FUL, 0x2E07E976UL, 0xE2ADE9E8UL, 0x6C22EE0BUL, 0xA088EE95UL,
+        0x79A8FC39UL, 0xB502FCA7UL, 0x3B8DFB44UL, 0xF727FBDAUL, 0xFDE2F2C3UL, 0x3148F25DUL,
+        0xBFC7F5BEUL, 0x736DF520UL, 0xD6F6D6A7UL, 0x1A5CD639UL, 0x94D3D1DAUL, 0x5879D144UL,
+        0x52BCD85DUL, 0x9E16D8C3UL, 0x1099DF20UL, 0xDC33DFBEUL, 0x0513CD12UL, 0xC9B9CD8CUL,
+        0x4736CA6FUL, 0x8B9CCAF1UL, 0x8159C3E8UL, 0x4DF3C376UL, 0xC37CC495UL, 0x0FD6C40BUL,
+        0x7AA64737UL, 0xB60C47A9UL, 0x3883404AUL, 0xF42940D4UL, 0xFEEC49CDUL, 0x32464953UL,
+        0xBCC94EB0UL, 0x70634E2EUL, 0xA9435C82UL, 0x65E95C1CUL, 0xEB665BFFUL, 0x27CC5B61UL,
+        0x2D095278UL, 0xE1A352E6UL, 0x6F2C5505UL, 0xA386559BUL, 0x061D761CUL, 0xCAB77682UL,
+        0x44387161UL, 0x889271FFUL, 0x825778E6UL, 0x4EFD7878UL, 0xC0727F9BUL, 0x0CD87F05UL,
+        0xD5F86DA9UL, 0x19526D37UL, 0x97DD6AD4UL, 0x5B776A4AUL, 0x51B26353UL, 0x9D1863CDUL,
+        0x1397642EUL, 0xDF3D64B0UL, 0x83D02561UL, 0x4F7A25FFUL, 0xC1F5221CUL, 0x0D5F2282UL,
+        0x079A2B9BUL, 0xCB302B05UL, 0x45BF2CE6UL, 0x89152C78UL, 0x50353ED4UL, 0x9C9F3E4AUL,
+        0x121039A9UL, 0xDEBA3937UL, 0xD47F302EUL, 0x18D530B0UL, 0x965A3753UL, 0x5AF037CDUL,
+        0xFF6B144AUL, 0x33C114D4UL, 0xBD4E1337UL, 0x71E413A9UL, 0x7B211AB0UL, 0xB78B1A2EUL,
+        0x39041DCDUL, 0xF5AE1D53UL, 0x2C8E0FFFUL, 0xE0240F61UL, 0x6EAB0882UL, 0xA201081CUL,
+        0xA8C40105UL, 0x646E019BUL, 0xEAE10678UL, 0x264B06E6UL,
+    },
+#endif
+};
+
+#endif /* USART_PACK_CRC_SLICES > 0 */
+
+#endif /* _USART_PACK_CRC_TABLE_H_ */
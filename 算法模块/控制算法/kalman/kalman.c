@@ -16,11 +16,20 @@
  *    - 状态更新: x(k|k) = x(k|k-1) + K * (z(k) - H * x(k|k-1))
  *    - 协方差更新: P(k|k) = (I - K * H) * P(k|k-1)
  *
+ * 3. 稳态(Steady state):
+ *    Q、R 不变时 P、K 收敛到离散 Riccati 方程的解，与测量值无关
+ *    - 只保留状态预测和状态更新，K 使用稳态值
+ *
  ******************************************************************************
  */
 
+#include <math.h>
+
 #include "kalman.h"
 
+static void kalman_enter_steady(kalman_t *kf);
+static void kalman_params_changed(kalman_t *kf);
+
 /**
  * @brief 初始化卡尔曼滤波器
  */
@@ -37,6 +46,9 @@ void kalman_init(kalman_t *kf, float init_x, float init_p, float q, float r)
     kf->Q = q;          /* 过程噪声协方差 */
     kf->R = r;          /* 测量噪声协方差 */
     kf->K = 0.0f;       /* 卡尔曼增益 */
+    kf->mode = KALMAN_MODE_DYNAMIC;
+    kf->steady = 0;
+    kf->settle = 0;
 }
 
 /**
@@ -56,6 +68,15 @@ float kalman_update(kalman_t *kf, float measurement)
         return measurement;
     }
 
+    /* 稳态: 增益固定，只做状态预测和一次乘加 */
+    if (kf->steady) {
+        float x_pred = kf->A * kf->x;
+        kf->x = x_pred + kf->K * (measurement - kf->H * x_pred);
+        return kf->x;
+    }
+
+    float last_k = kf->K;
+
     /* 1. 预测阶段 */
     /* 状态预测: x(k|k-1) = A * x(k-1|k-1) */
     float x_pred = kf->A * kf->x;
@@ -81,6 +102,21 @@ float kalman_update(kalman_t *kf, float measurement)
     /* 协方差更新: P(k|k) = (I - K * H) * P(k|k-1) */
     kf->P = (1.0f - kf->K * kf->H) * p_pred;
 
+    /* 3. 自动模式: 判断增益是否已收敛 */
+    if (kf->mode == KALMAN_MODE_AUTO) {
+        float diff = kf->K - last_k;
+        if (diff < 0.0f) {
+            diff = -diff;
+        }
+        if (diff <= KALMAN_STEADY_TOL * kf->K) {
+            if (++kf->settle >= KALMAN_STEADY_COUNT) {
+                kalman_enter_steady(kf);
+            }
+        } else {
+            kf->settle = 0;
+        }
+    }
+
     return kf->x;
 }
 
@@ -96,6 +132,7 @@ void kalman_reset(kalman_t *kf, float new_x)
     kf->x = new_x;
     kf->P = 1.0f;
     kf->K = 0.0f;
+    kalman_params_changed(kf);
 }
 
 /**
@@ -107,6 +144,7 @@ void kalman_set_q(kalman_t *kf, float q)
         return;
     }
     kf->Q = q;
+    kalman_params_changed(kf);
 }
 
 /**
@@ -118,6 +156,64 @@ void kalman_set_r(kalman_t *kf, float r)
         return;
     }
     kf->R = r;
+    kalman_params_changed(kf);
+}
+
+/**
+ * @brief 设置增益模式
+ */
+void kalman_set_mode(kalman_t *kf, uint8_t mode)
+{
+    if (kf == NULL) {
+        return;
+    }
+    kf->mode = mode;
+    kalman_params_changed(kf);
+}
+
+/**
+ * @brief 是否已使用稳态增益
+ */
+uint8_t kalman_is_steady(kalman_t *kf)
+{
+    if (kf == NULL) {
+        return 0;
+    }
+    return kf->steady;
+}
+
+/**
+ * @brief 求稳态卡尔曼增益
+ * @note 稳态预测协方差 M = P(k|k-1) 满足 H^2*M^2 + (R*(1-A^2) - Q*H^2)*M - Q*R = 0，取正根
+ */
+float kalman_steady_gain(float A, float H, float Q, float R, float *P)
+{
+    float a = H * H;
+    float b = R * (1.0f - A * A) - Q * H * H;
+    float disc = b * b + 4.0f * a * Q * R;
+    float m, denominator, k;
+
+    if (a == 0.0f || !(disc >= 0.0f)) {
+        return 0.0f;
+    }
+
+    /* 两种写法等价，按 b 的符号选不会相消的一种 */
+    if (b <= 0.0f) {
+        m = (sqrtf(disc) - b) / (2.0f * a);
+    } else {
+        m = 2.0f * Q * R / (b + sqrtf(disc));
+    }
+
+    denominator = a * m + R;
+    if (denominator < 1e-10f && denominator > -1e-10f) {
+        denominator = 1e-10f;
+    }
+    k = m * H / denominator;
+
+    if (P != NULL) {
+        *P = (1.0f - k * H) * m;
+    }
+    return k;
 }
 
 /**
@@ -141,3 +237,26 @@ float kalman_get_gain(kalman_t *kf)
     }
     return kf->K;
 }
+
+/**
+ * @brief 切换到稳态增益
+ */
+static void kalman_enter_steady(kalman_t *kf)
+{
+    kf->K = kalman_steady_gain(kf->A, kf->H, kf->Q, kf->R, &kf->P);
+    kf->steady = 1;
+    kf->settle = 0;
+}
+
+/**
+ * @brief Q、R、模式改变或重置后：稳态模式重新求增益，自动模式重新判断收敛
+ */
+static void kalman_params_changed(kalman_t *kf)
+{
+    kf->settle = 0;
+    if (kf->mode == KALMAN_MODE_STEADY) {
+        kalman_enter_steady(kf);
+    } else {
+        kf->steady = 0;
+    }
+}
@@ -16,10 +16,27 @@
 #ifndef _KALMAN_H_
 #define _KALMAN_H_
 
+#include <stdint.h>
+#include <stddef.h>
+
 #ifdef __cplusplus
 extern "C" {
 #endif
 
+/* 增益模式 */
+#define KALMAN_MODE_DYNAMIC 0   /* 每次重新计算 P 和 K（默认） */
+#define KALMAN_MODE_AUTO    1   /* K 收敛后切换为稳态增益，之后每次只做乘加 */
+#define KALMAN_MODE_STEADY  2   /* 直接求出稳态增益，从第一个采样起只做乘加 */
+
+/* 自动模式的收敛判据：|K(k) - K(k-1)| <= KALMAN_STEADY_TOL * K(k) 连续 KALMAN_STEADY_COUNT 次 */
+#ifndef KALMAN_STEADY_TOL
+#define KALMAN_STEADY_TOL   1e-4f
+#endif
+
+#ifndef KALMAN_STEADY_COUNT
+#define KALMAN_STEADY_COUNT 4
+#endif
+
 /**
  * @brief 卡尔曼滤波器状态结构体
  */
@@ -31,6 +48,9 @@ typedef struct {
     float R;    /* 测量噪声协方差 R */
     float P;    /* 估计误差协方差 P(k|k) */
     float K;    /* 卡尔曼增益 K */
+    uint8_t mode;   /* 增益模式 KALMAN_MODE_xxx */
+    uint8_t steady; /* 1 表示已使用稳态增益 */
+    uint8_t settle; /* 自动模式下连续满足收敛判据的次数 */
 } kalman_t;
 
 /**
@@ -80,6 +100,35 @@ void kalman_set_q(kalman_t *kf, float q);
  */
 void kalman_set_r(kalman_t *kf, float r);
 
+/**
+ * @brief 设置增益模式
+ * @param kf: 滤波器实例指针
+ * @param mode: KALMAN_MODE_DYNAMIC / KALMAN_MODE_AUTO / KALMAN_MODE_STEADY
+ * @note Q、R 不变时 K 在几十个采样内收敛到稳态值，之后重新计算 P 和 K 只是浪费；
+ *       稳态时每个采样只做状态预测和一次乘加，不再计算 P 和 K，没有除法
+ *       修改 Q、R 后：自动模式重新判断收敛，稳态模式立即重新求稳态增益
+ */
+void kalman_set_mode(kalman_t *kf, uint8_t mode);
+
+/**
+ * @brief 是否已使用稳态增益
+ * @param kf: 滤波器实例指针
+ * @retval 1: 稳态, 0: 每次重新计算
+ */
+uint8_t kalman_is_steady(kalman_t *kf);
+
+/**
+ * @brief 求稳态卡尔曼增益（离散 Riccati 方程的解）
+ * @param A: 状态转移系数
+ * @param H: 观测系数
+ * @param Q: 过程噪声协方差
+ * @param R: 测量噪声协方差
+ * @param P: 输出稳态估计误差协方差 P(k|k)，可为 NULL
+ * @retval 稳态卡尔曼增益，H 为 0 或无解时返回 0
+ * @note 使用一次 sqrtf，只在初始化或修改参数时调用
+ */
+float kalman_steady_gain(float A, float H, float Q, float R, float *P);
+
 /**
  * @brief 获取当前状态估计值
  * @param kf: 滤波器实例指针
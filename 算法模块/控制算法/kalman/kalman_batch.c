@@ -0,0 +1,188 @@
+/**
+ ******************************************************************************
+ * @file    kalman_batch.c
+ * @brief   批量一维卡尔曼滤波器实现
+ * @version 1.0.0
+ ******************************************************************************
+ * @note
+ *
+ * A=1, H=1 时 kalman_update() 化简为:
+ *   p = P + Q,  K = p / (p + R),  x = x + K * (z - x),  P = (1 - K) * p
+ * 稳态时只剩 x = x + K * (z - x)
+ *
+ ******************************************************************************
+ */
+
+#include "kalman_batch.h"
+
+static void kalman_batch_enter_steady(kalman_batch_t *kb);
+static void kalman_batch_params_changed(kalman_batch_t *kb);
+
+/**
+ * @brief 初始化批量滤波器
+ */
+void kalman_batch_init(kalman_batch_t *kb, uint16_t count)
+{
+    if (kb == NULL) {
+        return;
+    }
+
+    if (count > KALMAN_BATCH_MAX_CHANNELS) {
+        count = KALMAN_BATCH_MAX_CHANNELS;
+    }
+    kb->count = count;
+    kb->mode = KALMAN_MODE_DYNAMIC;
+    kb->steady = 0;
+    kb->settle = 0;
+    for (uint16_t i = 0; i < KALMAN_BATCH_MAX_CHANNELS; i++) {
+        kb->x[i] = 0.0f;
+        kb->P[i] = 1.0f;
+        kb->Q[i] = 0.01f;
+        kb->R[i] = 0.1f;
+        kb->K[i] = 0.0f;
+    }
+}
+
+/**
+ * @brief 设置某一通道的参数
+ */
+void kalman_batch_setup(kalman_batch_t *kb, uint16_t ch, float init_x, float init_p, float q, float r)
+{
+    if (kb == NULL || ch >= kb->count) {
+        return;
+    }
+
+    kb->x[ch] = init_x;
+    kb->P[ch] = init_p;
+    kb->Q[ch] = q;
+    kb->R[ch] = r;
+    kb->K[ch] = 0.0f;
+    kalman_batch_params_changed(kb);
+}
+
+/**
+ * @brief 设置某一通道的过程噪声协方差
+ */
+void kalman_batch_set_q(kalman_batch_t *kb, uint16_t ch, float q)
+{
+    if (kb == NULL || ch >= kb->count) {
+        return;
+    }
+    kb->Q[ch] = q;
+    kalman_batch_params_changed(kb);
+}
+
+/**
+ * @brief 设置某一通道的测量噪声协方差
+ */
+void kalman_batch_set_r(kalman_batch_t *kb, uint16_t ch, float r)
+{
+    if (kb == NULL || ch >= kb->count) {
+        return;
+    }
+    kb->R[ch] = r;
+    kalman_batch_params_changed(kb);
+}
+
+/**
+ * @brief 重置某一通道
+ */
+void kalman_batch_reset(kalman_batch_t *kb, uint16_t ch, float new_x)
+{
+    if (kb == NULL || ch >= kb->count) {
+        return;
+    }
+    kb->x[ch] = new_x;
+    kb->P[ch] = 1.0f;
+    kb->K[ch] = 0.0f;
+    kalman_batch_params_changed(kb);
+}
+
+/**
+ * @brief 设置增益模式
+ */
+void kalman_batch_set_mode(kalman_batch_t *kb, uint8_t mode)
+{
+    if (kb == NULL) {
+        return;
+    }
+    kb->mode = mode;
+    kalman_batch_params_changed(kb);
+}
+
+/**
+ * @brief 更新全部通道
+ */
+void kalman_batch_update(kalman_batch_t *kb, const float *measurement)
+{
+    if (kb == NULL || measurement == NULL) {
+        return;
+    }
+
+    uint16_t n = kb->count;
+    float *x = kb->x;
+    const float *K = kb->K;
+
+    /* 稳态: 每通道一次乘加 */
+    if (kb->steady) {
+        for (uint16_t i = 0; i < n; i++) {
+            x[i] = x[i] + K[i] * (measurement[i] - x[i]);
+        }
+        return;
+    }
+
+    uint16_t settled = 0;
+    for (uint16_t i = 0; i < n; i++) {
+        float p_pred = kb->P[i] + kb->Q[i];
+        float denominator = p_pred + kb->R[i];
+
+        /* 避免除零，与 kalman_update() 相同 */
+        if (denominator < 1e-10f && denominator > -1e-10f) {
+            denominator = 1e-10f;
+        }
+
+        float k = p_pred / denominator;
+        float diff = k - kb->K[i];
+
+        settled += (diff <= KALMAN_STEADY_TOL * k && -diff <= KALMAN_STEADY_TOL * k);
+        kb->K[i] = k;
+        x[i] = x[i] + k * (measurement[i] - x[i]);
+        kb->P[i] = (1.0f - k) * p_pred;
+    }
+
+    /* 自动模式: 所有通道同时满足收敛判据 */
+    if (kb->mode == KALMAN_MODE_AUTO) {
+        if (settled == n) {
+            if (++kb->settle >= KALMAN_STEADY_COUNT) {
+                kalman_batch_enter_steady(kb);
+            }
+        } else {
+            kb->settle = 0;
+        }
+    }
+}
+
+/**
+ * @brief 所有通道切换到稳态增益
+ */
+static void kalman_batch_enter_steady(kalman_batch_t *kb)
+{
+    for (uint16_t i = 0; i < kb->count; i++) {
+        kb->K[i] = kalman_steady_gain(1.0f, 1.0f, kb->Q[i], kb->R[i], &kb->P[i]);
+    }
+    kb->steady = 1;
+    kb->settle = 0;
+}
+
+/**
+ * @brief 参数、模式改变或重置后：稳态模式重新求增益，自动模式重新判断收敛
+ */
+static void kalman_batch_params_changed(kalman_batch_t *kb)
+{
+    kb->settle = 0;
+    if (kb->mode == KALMAN_MODE_STEADY) {
+        kalman_batch_enter_steady(kb);
+    } else {
+        kb->steady = 0;
+    }
+}
@@ -0,0 +1,101 @@
+/**
+ ******************************************************************************
+ * @file    kalman_batch.h
+ * @brief   批量一维卡尔曼滤波器：N路按数组分别存放，一次调用全部更新
+ * @version 1.0.0
+ ******************************************************************************
+ * @attention
+ *
+ * 模型与 kalman_t 的默认模型相同（A=1, H=1），动态和稳态模式下运算顺序与
+ * kalman_update() 完全相同，同样的输入得到逐位相同的输出
+ * 各通道的同一个量连续存放，稳态时只剩一条乘加循环，-O3 下可被编译器向量化
+ *
+ ******************************************************************************
+ */
+
+#ifndef _KALMAN_BATCH_H_
+#define _KALMAN_BATCH_H_
+
+#include "kalman.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* 最大通道数，可在编译选项中修改 */
+#ifndef KALMAN_BATCH_MAX_CHANNELS
+#define KALMAN_BATCH_MAX_CHANNELS 16
+#endif
+
+/**
+ * @brief 批量卡尔曼滤波器，各量按通道存为数组，可直接读取 x[]
+ */
+typedef struct {
+    float x[KALMAN_BATCH_MAX_CHANNELS];     /* 状态估计值 */
+    float P[KALMAN_BATCH_MAX_CHANNELS];     /* 估计误差协方差 */
+    float Q[KALMAN_BATCH_MAX_CHANNELS];     /* 过程噪声协方差 */
+    float R[KALMAN_BATCH_MAX_CHANNELS];     /* 测量噪声协方差 */
+    float K[KALMAN_BATCH_MAX_CHANNELS];     /* 卡尔曼增益 */
+    uint16_t count;                         /* 通道数 */
+    uint8_t mode;                           /* 增益模式 KALMAN_MODE_xxx，所有通道相同 */
+    uint8_t steady;                         /* 1 表示所有通道已使用稳态增益 */
+    uint8_t settle;                         /* 自动模式下所有通道连续满足收敛判据的次数 */
+} kalman_batch_t;
+
+/**
+ * @brief 初始化批量滤波器，所有通道使用默认参数（x=0, P=1.0, Q=0.01, R=0.1）
+ * @param kb: 批量滤波器指针
+ * @param count: 通道数，超过 KALMAN_BATCH_MAX_CHANNELS 时截断
+ */
+void kalman_batch_init(kalman_batch_t *kb, uint16_t count);
+
+/**
+ * @brief 设置某一通道的参数，相当于对该通道调用 kalman_init()
+ * @param kb: 批量滤波器指针
+ * @param ch: 通道号
+ * @param init_x: 初始状态估计值
+ * @param init_p: 初始估计误差协方差
+ * @param q: 过程噪声协方差
+ * @param r: 测量噪声协方差
+ */
+void kalman_batch_setup(kalman_batch_t *kb, uint16_t ch, float init_x, float init_p, float q, float r);
+
+/**
+ * @brief 设置某一通道的过程噪声协方差
+ */
+void kalman_batch_set_q(kalman_batch_t *kb, uint16_t ch, float q);
+
+/**
+ * @brief 设置某一通道的测量噪声协方差
+ */
+void kalman_batch_set_r(kalman_batch_t *kb, uint16_t ch, float r);
+
+/**
+ * @brief 重置某一通道，相当于 kalman_reset()
+ * @param kb: 批量滤波器指针
+ * @param ch: 通道号
+ * @param new_x: 新的状态估计值
+ */
+void kalman_batch_reset(kalman_batch_t *kb, uint16_t ch, float new_x);
+
+/**
+ * @brief 设置增益模式，所有通道相同
+ * @param kb: 批量滤波器指针
+ * @param mode: KALMAN_MODE_DYNAMIC / KALMAN_MODE_AUTO / KALMAN_MODE_STEADY
+ * @note 自动模式下所有通道都收敛后才一起切换到稳态
+ */
+void kalman_batch_set_mode(kalman_batch_t *kb, uint8_t mode);
+
+/**
+ * @brief 更新全部通道
+ * @param kb: 批量滤波器指针
+ * @param measurement: 各通道的测量值，长度为 count
+ * @note 结果在 kb->x[] 中
+ */
+void kalman_batch_update(kalman_batch_t *kb, const float *measurement);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* _KALMAN_BATCH_H_ */
@@ -0,0 +1,375 @@
+/**
+ ******************************************************************************
+ * @file    kalman_matrix.h
+ * @brief   编译期定维的线性/扩展卡尔曼滤波器模板
+ * @version 1.0.0
+ ******************************************************************************
+ * @attention
+ *
+ * 状态维数、测量维数在编译时确定，所有矩阵都是结构体内的定长数组，不用堆
+ * 每种维数包含一次本文件，生成一个结构体类型和一组 static inline 函数：
+ *
+ *   #define KALMAN_MATRIX_NAME  att_ekf    // 生成 att_ekf_t 和 att_ekf_xxx()
+ *   #define KALMAN_MATRIX_N     7          // 状态维数
+ *   #define KALMAN_MATRIX_M     3          // 测量维数（可选，默认1）
+ *   #include "kalman_matrix.h"
+ *
+ * 本文件没有 include 保护，末尾 #undef 上面三个宏，同一文件中可以包含多次
+ *
+ * - 协方差 P 和过程噪声 Q 是对称矩阵，只存上三角（按行压缩，N*(N+1)/2 个数）
+ * - 测量按标量逐个更新（测量噪声各分量独立，即 R 为对角阵），
+ *   每个分量一次除法，不需要矩阵求逆
+ * - 扩展卡尔曼：非线性的 f(x)、h(x) 和雅可比矩阵由调用者计算，
+ *   本模板只做协方差传播和增益计算
+ *
+ ******************************************************************************
+ */
+
+#if !defined(KALMAN_MATRIX_NAME) || !defined(KALMAN_MATRIX_N)
+#error "kalman_matrix.h: 包含前需定义 KALMAN_MATRIX_NAME 和 KALMAN_MATRIX_N"
+#endif
+
+#ifndef KALMAN_MATRIX_M
+#define KALMAN_MATRIX_M 1
+#endif
+
+#include <stdint.h>
+#include <stddef.h>
+
+/* 名字拼接，只定义一次 */
+#ifndef KALMAN_MATRIX_CAT
+#define KALMAN_MATRIX_CAT_(a, b)    a##_##b
+#define KALMAN_MATRIX_CAT(a, b)     KALMAN_MATRIX_CAT_(a, b)
+#endif
+
+#define KM_N        KALMAN_MATRIX_N
+#define KM_M        KALMAN_MATRIX_M
+#define KM_TRI      (KM_N * (KM_N + 1) / 2)
+#define KM_T        KALMAN_MATRIX_CAT(KALMAN_MATRIX_NAME, t)
+#define KM_FN(f)    KALMAN_MATRIX_CAT(KALMAN_MATRIX_NAME, f)
+
+/* 上三角按行压缩后 (i, j) 的下标，要求 i <= j */
+#define KM_IDX(i, j) ((i) * KM_N - (i) * ((i) - 1) / 2 + (j) - (i))
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief 卡尔曼滤波器状态结构体
+ */
+typedef struct {
+    float x[KM_N];      /* 状态估计值 x(k|k) */
+    float P[KM_TRI];    /* 估计误差协方差 P(k|k)，只存上三角 */
+    float Q[KM_TRI];    /* 过程噪声协方差 Q，只存上三角 */
+} KM_T;
+
+/**
+ * @brief 初始化滤波器，P、Q 设为对角阵
+ * @param kf: 滤波器实例指针
+ * @param init_x: 初始状态，NULL 表示全0
+ * @param init_p: P 的对角元素
+ * @param q: Q 的对角元素
+ */
+static inline void KM_FN(init)(KM_T *kf, const float *init_x, float init_p, float q)
+{
+    int i;
+
+    for (i = 0; i < KM_TRI; i++) {
+        kf->P[i] = 0.0f;
+        kf->Q[i] = 0.0f;
+    }
+    for (i = 0; i < KM_N; i++) {
+        kf->x[i] = init_x ? init_x[i] : 0.0f;
+        kf->P[KM_IDX(i, i)] = init_p;
+        kf->Q[KM_IDX(i, i)] = q;
+    }
+}
+
+/**
+ * @brief 设置 Q 的对角元素（非对角元素不变）
+ * @param kf: 滤波器实例指针
+ * @param q: N 个对角元素
+ */
+static inline void KM_FN(set_q_diag)(KM_T *kf, const float *q)
+{
+    int i;
+
+    for (i = 0; i < KM_N; i++) {
+        kf->Q[KM_IDX(i, i)] = q[i];
+    }
+}
+
+/**
+ * @brief 设置 P 的对角元素（非对角元素不变）
+ * @param kf: 滤波器实例指针
+ * @param p: N 个对角元素
+ */
+static inline void KM_FN(set_p_diag)(KM_T *kf, const float *p)
+{
+    int i;
+
+    for (i = 0; i < KM_N; i++) {
+        kf->P[KM_IDX(i, i)] = p[i];
+    }
+}
+
+/**
+ * @brief 设置 Q 的 (i, j) 和 (j, i) 元素
+ */
+static inline void KM_FN(set_q)(KM_T *kf, int i, int j, float value)
+{
+    kf->Q[i <= j ? KM_IDX(i, j) : KM_IDX(j, i)] = value;
+}
+
+/**
+ * @brief 读取 P 的 (i, j) 元素
+ */
+static inline float KM_FN(get_p)(const KM_T *kf, int i, int j)
+{
+    return kf->P[i <= j ? KM_IDX(i, j) : KM_IDX(j, i)];
+}
+
+/**
+ * @brief 协方差预测 P = F * P * F' + Q
+ * @note 先算 A = F * P（P 的每个上三角元素只读一次），再只算结果的上三角；
+ *       P 先拷到局部数组，编译器不必担心 F 与 kf->P 重叠，可以留在寄存器里
+ */
+static inline void KM_FN(predict_cov)(KM_T *kf, const float F[KM_N][KM_N])
+{
+    float A[KM_N][KM_N];
+    float P[KM_TRI];
+    int i, j, k, idx;
+
+    for (i = 0; i < KM_TRI; i++) {
+        P[i] = kf->P[i];
+    }
+    for (i = 0; i < KM_N; i++) {
+        for (k = 0; k < KM_N; k++) {
+            A[i][k] = 0.0f;
+        }
+        idx = 0;
+        for (j = 0; j < KM_N; j++) {
+            A[i][j] += F[i][j] * P[idx++];
+            for (k = j + 1; k < KM_N; k++, idx++) {
+                A[i][k] += F[i][j] * P[idx];
+                A[i][j] += F[i][k] * P[idx];
+            }
+        }
+    }
+
+    idx = 0;
+    for (i = 0; i < KM_N; i++) {
+        for (k = i; k < KM_N; k++, idx++) {
+            float acc = kf->Q[idx];
+            for (j = 0; j < KM_N; j++) {
+                acc += A[i][j] * F[k][j];
+            }
+            kf->P[idx] = acc;
+        }
+    }
+}
+
+/**
+ * @brief 线性预测 x = F * x, P = F * P * F' + Q
+ * @param kf: 滤波器实例指针
+ * @param F: 状态转移矩阵
+ * @note 有控制输入时，调用后把 B * u 加到 kf->x 上
+ */
+static inline void KM_FN(predict)(KM_T *kf, const float F[KM_N][KM_N])
+{
+    float x[KM_N];
+    int i, j;
+
+    for (i = 0; i < KM_N; i++) {
+        float acc = 0.0f;
+        for (j = 0; j < KM_N; j++) {
+            acc += F[i][j] * kf->x[j];
+        }
+        x[i] = acc;
+    }
+    for (i = 0; i < KM_N; i++) {
+        kf->x[i] = x[i];
+    }
+    KM_FN(predict_cov)(kf, F);
+}
+
+/**
+ * @brief 扩展卡尔曼预测 x = f(x), P = F * P * F' + Q
+ * @param kf: 滤波器实例指针
+ * @param x_pred: 调用者算好的 f(x)，可以就是 kf->x
+ * @param F: f 在当前状态处的雅可比矩阵
+ */
+static inline void KM_FN(predict_ext)(KM_T *kf, const float *x_pred, const float F[KM_N][KM_N])
+{
+    int i;
+
+    if (x_pred != kf->x) {
+        for (i = 0; i < KM_N; i++) {
+            kf->x[i] = x_pred[i];
+        }
+    }
+    KM_FN(predict_cov)(kf, F);
+}
+
+/**
+ * @brief 标量测量更新（扩展形式），测量矩阵的一行 h，新息由调用者给出
+ * @param kf: 滤波器实例指针
+ * @param h: 测量矩阵的一行（N 个数）
+ * @param innovation: 新息 z - h(x)
+ * @param r: 该测量的噪声方差
+ * @retval 新息方差 h * P * h' + r，<= 0 时未更新
+ * @note P*h' 按上三角遍历一次求出；增益 K = P*h'/s，
+ *       P -= K * (P*h')' 只更新上三角，结果保持对称
+ */
+static inline float KM_FN(update_scalar_ext)(KM_T *kf, const float *h, float innovation, float r)
+{
+    float ph[KM_N];
+    float s = r;
+    float inv_s;
+    int i, j, idx;
+
+    for (i = 0; i < KM_N; i++) {
+        ph[i] = 0.0f;
+    }
+    idx = 0;
+    for (i = 0; i < KM_N; i++) {
+        ph[i] += kf->P[idx++] * h[i];
+        for (j = i + 1; j < KM_N; j++, idx++) {
+            ph[i] += kf->P[idx] * h[j];
+            ph[j] += kf->P[idx] * h[i];
+        }
+    }
+    for (i = 0; i < KM_N; i++) {
+        s += h[i] * ph[i];
+    }
+    if (!(s > 0.0f)) {
+        return s;       /* P 失去正定或 r 非法，跳过本次更新 */
+    }
+
+    inv_s = 1.0f / s;
+    for (i = 0; i < KM_N; i++) {
+        kf->x[i] += ph[i] * inv_s * innovation;
+    }
+    idx = 0;
+    for (i = 0; i < KM_N; i++) {
+        float ki = ph[i] * inv_s;
+        for (j = i; j < KM_N; j++, idx++) {
+            kf->P[idx] -= ki * ph[j];
+        }
+    }
+    return s;
+}
+
+/**
+ * @brief 标量测量更新（线性），z = h * x + v
+ * @param kf: 滤波器实例指针
+ * @param h: 测量矩阵的一行（N 个数）
+ * @param z: 测量值
+ * @param r: 测量噪声方差
+ * @retval 新息方差，<= 0 时未更新
+ */
+static inline float KM_FN(update_scalar)(KM_T *kf, const float *h, float z, float r)
+{
+    float innovation = z;
+    int i;
+
+    for (i = 0; i < KM_N; i++) {
+        innovation -= h[i] * kf->x[i];
+    }
+    return KM_FN(update_scalar_ext)(kf, h, innovation, r);
+}
+
+/**
+ * @brief 直接测量某个状态分量，z = x[k] + v
+ * @param kf: 滤波器实例指针
+ * @param k: 状态分量序号
+ * @param z: 测量值
+ * @param r: 测量噪声方差
+ * @retval 新息方差，<= 0 时未更新
+ * @note h 为单位向量，P*h' 就是 P 的第 k 列，不做乘法
+ */
+static inline float KM_FN(update_state)(KM_T *kf, int k, float z, float r)
+{
+    float ph[KM_N];
+    float s, inv_s, innovation;
+    int i, j, idx;
+
+    for (i = 0; i < KM_N; i++) {
+        ph[i] = kf->P[i <= k ? KM_IDX(i, k) : KM_IDX(k, i)];
+    }
+    s = ph[k] + r;
+    if (!(s > 0.0f)) {
+        return s;
+    }
+
+    inv_s = 1.0f / s;
+    innovation = z - kf->x[k];
+    for (i = 0; i < KM_N; i++) {
+        kf->x[i] += ph[i] * inv_s * innovation;
+    }
+    idx = 0;
+    for (i = 0; i < KM_N; i++) {
+        float ki = ph[i] * inv_s;
+        for (j = i; j < KM_N; j++, idx++) {
+            kf->P[idx] -= ki * ph[j];
+        }
+    }
+    return s;
+}
+
+/**
+ * @brief M 维测量更新（线性），z = H * x + v，R 为对角阵
+ * @param kf: 滤波器实例指针
+ * @param H: 测量矩阵
+ * @param z: M 个测量值
+ * @param r: M 个测量噪声方差
+ * @note 逐个分量调用 update_scalar()，结果与一次性矩阵形式的更新在数学上相同
+ */
+static inline void KM_FN(update)(KM_T *kf, const float H[KM_M][KM_N], const float *z, const float *r)
+{
+    int i;
+
+    for (i = 0; i < KM_M; i++) {
+        KM_FN(update_scalar)(kf, H[i], z[i], r[i]);
+    }
+}
+
+/**
+ * @brief M 维测量更新（扩展形式），R 为对角阵
+ * @param kf: 滤波器实例指针
+ * @param H: h(x) 在预测状态处的雅可比矩阵
+ * @param innovation: 在预测状态处算好的 M 个新息 z - h(x)
+ * @param r: M 个测量噪声方差
+ * @note 前面分量的更新会改变 x，后面分量的新息按线性化修正为 innovation[i] - H[i] * dx
+ */
+static inline void KM_FN(update_ext)(KM_T *kf, const float H[KM_M][KM_N], const float *innovation, const float *r)
+{
+    float x0[KM_N];
+    int i, j;
+
+    for (j = 0; j < KM_N; j++) {
+        x0[j] = kf->x[j];
+    }
+    for (i = 0; i < KM_M; i++) {
+        float v = innovation[i];
+        for (j = 0; j < KM_N; j++) {
+            v -= H[i][j] * (kf->x[j] - x0[j]);
+        }
+        KM_FN(update_scalar_ext)(kf, H[i], v, r[i]);
+    }
+}
+
+#ifdef __cplusplus
+}
+#endif
+
+#undef KM_N
+#undef KM_M
+#undef KM_TRI
+#undef KM_T
+#undef KM_FN
+#undef KM_IDX
+#undef KALMAN_MATRIX_NAME
+#undef KALMAN_MATRIX_N
+#undef KALMAN_MATRIX_M
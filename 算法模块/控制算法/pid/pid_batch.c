@@ -0,0 +1,381 @@
+/**
+ ******************************************************************************
+ * @file    pid_batch.c
+ * @brief   批量PID控制器实现
+ * @author  XiFeng
+ * @version 1.0.0
+ ******************************************************************************
+ */
+
+#include <string.h>
+#include "pid_batch.h"
+
+/* ======================= 向量实现选择 ======================= */
+
+/*
+ * 每种指令集提供同一组4路运算，下面的计算循环只写一遍
+ * 只用乘、加、减、比较和按位选择，不用乘加融合，保证与 pid.c 的逐路计算逐位一致
+ */
+#if defined(PID_BATCH_SCALAR)
+
+#elif defined(__SSE__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 1)
+
+#include <xmmintrin.h>
+#define PID_BATCH_SIMD  "sse"
+typedef __m128 pid_vf;
+#define VLD(p)          _mm_loadu_ps(p)
+#define VST(p, v)       _mm_storeu_ps((p), (v))
+#define VDUP(x)         _mm_set1_ps(x)
+#define VADD(a, b)      _mm_add_ps((a), (b))
+#define VSUB(a, b)      _mm_sub_ps((a), (b))
+#define VMUL(a, b)      _mm_mul_ps((a), (b))
+
+static inline pid_vf v_out_limit(pid_vf out, pid_vf limit)
+{
+    pid_vf neg = _mm_xor_ps(limit, _mm_set1_ps(-0.0f));
+    pid_vf gt = _mm_cmpgt_ps(out, limit);
+    pid_vf lt = _mm_cmplt_ps(out, neg);
+
+    out = _mm_or_ps(_mm_and_ps(lt, neg), _mm_andnot_ps(lt, out));
+    return _mm_or_ps(_mm_and_ps(gt, limit), _mm_andnot_ps(gt, out));
+}
+
+#elif defined(__ARM_FEATURE_MVE) && (__ARM_FEATURE_MVE & 2)
+
+#include <arm_mve.h>
+#define PID_BATCH_SIMD  "helium"
+typedef float32x4_t pid_vf;
+#define VLD(p)          vld1q_f32(p)
+#define VST(p, v)       vst1q_f32((p), (v))
+#define VDUP(x)         vdupq_n_f32(x)
+#define VADD(a, b)      vaddq_f32((a), (b))
+#define VSUB(a, b)      vsubq_f32((a), (b))
+#define VMUL(a, b)      vmulq_f32((a), (b))
+
+static inline pid_vf v_out_limit(pid_vf out, pid_vf limit)
+{
+    pid_vf neg = vnegq_f32(limit);
+    mve_pred16_t gt = vcmpgtq_f32(out, limit);
+    mve_pred16_t lt = vcmpltq_f32(out, neg);
+
+    out = vpselq_f32(neg, out, lt);
+    return vpselq_f32(limit, out, gt);
+}
+
+#elif defined(__ARM_NEON) || defined(__ARM_NEON__)
+
+#include <arm_neon.h>
+#define PID_BATCH_SIMD  "neon"
+typedef float32x4_t pid_vf;
+#define VLD(p)          vld1q_f32(p)
+#define VST(p, v)       vst1q_f32((p), (v))
+#define VDUP(x)         vdupq_n_f32(x)
+#define VADD(a, b)      vaddq_f32((a), (b))
+#define VSUB(a, b)      vsubq_f32((a), (b))
+#define VMUL(a, b)      vmulq_f32((a), (b))
+
+static inline pid_vf v_out_limit(pid_vf out, pid_vf limit)
+{
+    pid_vf neg = vnegq_f32(limit);
+    uint32x4_t gt = vcgtq_f32(out, limit);
+    uint32x4_t lt = vcltq_f32(out, neg);
+
+    out = vbslq_f32(lt, neg, out);
+    return vbslq_f32(gt, limit, out);
+}
+
+#endif
+
+/* ======================= 逐路计算 ======================= */
+
+/**
+ * @brief 输出限幅，与 pid_out_limit 相同
+ */
+static inline float pid_batch_out_limit(float out, float limit)
+{
+    if (out > limit)
+        return limit;
+    else if (out < -limit)
+        return -limit;
+    return out;
+}
+
+/**
+ * @brief 一路位置式PID，与 pid_formula_positional 相同
+ */
+static inline void pid_batch_positional_one(PID_BATCH_T *_tpBatch, uint16_t i, float _current)
+{
+    float error = _tpBatch->target[i] - _current;
+    float p_out, i_out, d_out;
+
+    _tpBatch->integral[i] += error;
+
+    p_out = _tpBatch->kp[i] * error;
+    i_out = _tpBatch->ki[i] * _tpBatch->integral[i];
+    d_out = _tpBatch->kd[i] * (error - _tpBatch->last_error[i]);
+
+    _tpBatch->out[i] = pid_batch_out_limit(p_out + i_out + d_out, _tpBatch->limit[i]);
+    _tpBatch->last_error[i] = error;
+#if PID_BATCH_DEBUG
+    _tpBatch->p_out[i] = p_out;
+    _tpBatch->i_out[i] = i_out;
+    _tpBatch->d_out[i] = d_out;
+#endif
+}
+
+/**
+ * @brief 一路增量式PID，与 pid_formula_incremental 相同
+ */
+static inline void pid_batch_incremental_one(PID_BATCH_T *_tpBatch, uint16_t i, float _current)
+{
+    float error = _tpBatch->target[i] - _current;
+    float p_out, i_out, d_out;
+
+    p_out = _tpBatch->kp[i] * (error - _tpBatch->last_error[i]);
+    i_out = _tpBatch->ki[i] * error;
+    d_out = _tpBatch->kd[i] * (error - 2 * _tpBatch->last_error[i] + _tpBatch->last2_error[i]);
+
+    _tpBatch->out[i] = pid_batch_out_limit(_tpBatch->out[i] + (p_out + i_out + d_out), _tpBatch->limit[i]);
+    _tpBatch->last2_error[i] = _tpBatch->last_error[i];
+    _tpBatch->last_error[i] = error;
+#if PID_BATCH_DEBUG
+    _tpBatch->p_out[i] = p_out;
+    _tpBatch->i_out[i] = i_out;
+    _tpBatch->d_out[i] = d_out;
+#endif
+}
+
+/* ======================= 接口实现 ======================= */
+
+/**
+ * @brief 批量PID初始化
+ */
+int pid_batch_init(PID_BATCH_T *_tpBatch, uint16_t _count)
+{
+    if (_count > PID_BATCH_MAX_CHANNELS)
+        return -1;
+
+    memset(_tpBatch, 0, sizeof(PID_BATCH_T));
+    _tpBatch->count = _count;
+    return 0;
+}
+
+/**
+ * @brief 设置一路PID
+ */
+void pid_batch_setup(PID_BATCH_T *_tpBatch, uint16_t _ch,
+                     float _kp, float _ki, float _kd, float _target, float _limit)
+{
+    if (_ch >= _tpBatch->count)
+        return;
+
+    _tpBatch->kp[_ch] = _kp;
+    _tpBatch->ki[_ch] = _ki;
+    _tpBatch->kd[_ch] = _kd;
+    _tpBatch->target[_ch] = _target;
+    _tpBatch->limit[_ch] = _limit;
+    pid_batch_reset(_tpBatch, _ch);
+}
+
+/**
+ * @brief 设置一路目标值
+ */
+void pid_batch_set_target(PID_BATCH_T *_tpBatch, uint16_t _ch, float _target)
+{
+    if (_ch >= _tpBatch->count)
+        return;
+
+    pid_batch_setup(_tpBatch, _ch,
+                    _tpBatch->kp[_ch], _tpBatch->ki[_ch], _tpBatch->kd[_ch],
+                    _target, _tpBatch->limit[_ch]);
+}
+
+/**
+ * @brief 设置一路PID参数
+ */
+void pid_batch_set_params(PID_BATCH_T *_tpBatch, uint16_t _ch, float _kp, float _ki, float _kd)
+{
+    if (_ch >= _tpBatch->count)
+        return;
+
+    _tpBatch->kp[_ch] = _kp;
+    _tpBatch->ki[_ch] = _ki;
+    _tpBatch->kd[_ch] = _kd;
+}
+
+/**
+ * @brief 设置一路输出限幅
+ */
+void pid_batch_set_limit(PID_BATCH_T *_tpBatch, uint16_t _ch, float _limit)
+{
+    if (_ch >= _tpBatch->count)
+        return;
+
+    _tpBatch->limit[_ch] = _limit;
+}
+
+/**
+ * @brief 重置一路PID
+ */
+void pid_batch_reset(PID_BATCH_T *_tpBatch, uint16_t _ch)
+{
+    if (_ch >= _tpBatch->count)
+        return;
+
+    _tpBatch->integral[_ch] = 0;
+    _tpBatch->last_error[_ch] = 0;
+    _tpBatch->last2_error[_ch] = 0;
+    _tpBatch->out[_ch] = 0;
+#if PID_BATCH_DEBUG
+    _tpBatch->p_out[_ch] = 0;
+    _tpBatch->i_out[_ch] = 0;
+    _tpBatch->d_out[_ch] = 0;
+#endif
+}
+
+/**
+ * @brief 计算全部通道的位置式PID
+ */
+void pid_batch_positional(PID_BATCH_T *_tpBatch, const float *_current)
+{
+    uint16_t i = 0;
+
+#ifdef PID_BATCH_SIMD
+    for (; i + 4 <= _tpBatch->count; i += 4)
+    {
+        pid_vf error = VSUB(VLD(&_tpBatch->target[i]), VLD(&_current[i]));
+        pid_vf integral = VADD(VLD(&_tpBatch->integral[i]), error);
+        pid_vf p_out = VMUL(VLD(&_tpBatch->kp[i]), error);
+        pid_vf i_out = VMUL(VLD(&_tpBatch->ki[i]), integral);
+        pid_vf d_out = VMUL(VLD(&_tpBatch->kd[i]), VSUB(error, VLD(&_tpBatch->last_error[i])));
+        pid_vf out = VADD(VADD(p_out, i_out), d_out);
+
+        VST(&_tpBatch->out[i], v_out_limit(out, VLD(&_tpBatch->limit[i])));
+        VST(&_tpBatch->integral[i], integral);
+        VST(&_tpBatch->last_error[i], error);
+#if PID_BATCH_DEBUG
+        VST(&_tpBatch->p_out[i], p_out);
+        VST(&_tpBatch->i_out[i], i_out);
+        VST(&_tpBatch->d_out[i], d_out);
+#endif
+    }
+#endif
+
+    for (; i < _tpBatch->count; i++)
+        pid_batch_positional_one(_tpBatch, i, _current[i]);
+}
+
+/**
+ * @brief 计算全部通道的增量式PID
+ */
+void pid_batch_incremental(PID_BATCH_T *_tpBatch, const float *_current)
+{
+    uint16_t i = 0;
+
+#ifdef PID_BATCH_SIMD
+    const pid_vf two = VDUP(2.0f);
+
+    for (; i + 4 <= _tpBatch->count; i += 4)
+    {
+        pid_vf error = VSUB(VLD(&_tpBatch->target[i]), VLD(&_current[i]));
+        pid_vf last = VLD(&_tpBatch->last_error[i]);
+        pid_vf p_out = VMUL(VLD(&_tpBatch->kp[i]), VSUB(error, last));
+        pid_vf i_out = VMUL(VLD(&_tpBatch->ki[i]), error);
+        pid_vf d_out = VMUL(VLD(&_tpBatch->kd[i]),
+                            VADD(VSUB(error, VMUL(two, last)), VLD(&_tpBatch->last2_error[i])));
+        pid_vf out = VADD(VLD(&_tpBatch->out[i]), VADD(VADD(p_out, i_out), d_out));
+
+        VST(&_tpBatch->out[i], v_out_limit(out, VLD(&_tpBatch->limit[i])));
+        VST(&_tpBatch->last2_error[i], last);
+        VST(&_tpBatch->last_error[i], error);
+#if PID_BATCH_DEBUG
+        VST(&_tpBatch->p_out[i], p_out);
+        VST(&_tpBatch->i_out[i], i_out);
+        VST(&_tpBatch->d_out[i], d_out);
+#endif
+    }
+#endif
+
+    for (; i < _tpBatch->count; i++)
+        pid_batch_incremental_one(_tpBatch, i, _current[i]);
+}
+
+/**
+ * @brief 一路积分限幅
+ */
+void pid_batch_limit_integral(PID_BATCH_T *_tpBatch, uint16_t _ch, float min, float max)
+{
+    if (_ch >= _tpBatch->count)
+        return;
+
+    if (_tpBatch->integral[_ch] > max)
+    {
+        _tpBatch->integral[_ch] = max;
+    }
+    else if (_tpBatch->integral[_ch] < min)
+    {
+        _tpBatch->integral[_ch] = min;
+    }
+}
+
+/**
+ * @brief 从 PID_T 导入一路
+ */
+void pid_batch_load(PID_BATCH_T *_tpBatch, uint16_t _ch, const PID_T *_tpPID)
+{
+    if (_ch >= _tpBatch->count)
+        return;
+
+    _tpBatch->kp[_ch] = _tpPID->kp;
+    _tpBatch->ki[_ch] = _tpPID->ki;
+    _tpBatch->kd[_ch] = _tpPID->kd;
+    _tpBatch->target[_ch] = _tpPID->target;
+    _tpBatch->limit[_ch] = _tpPID->limit;
+    _tpBatch->out[_ch] = _tpPID->out;
+    _tpBatch->last_error[_ch] = _tpPID->last_error;
+    _tpBatch->last2_error[_ch] = _tpPID->last2_error;
+    _tpBatch->integral[_ch] = _tpPID->integral;
+#if PID_BATCH_DEBUG
+    _tpBatch->p_out[_ch] = _tpPID->p_out;
+    _tpBatch->i_out[_ch] = _tpPID->i_out;
+    _tpBatch->d_out[_ch] = _tpPID->d_out;
+#endif
+}
+
+/**
+ * @brief 导出一路为 PID_T
+ */
+void pid_batch_store(const PID_BATCH_T *_tpBatch, uint16_t _ch, PID_T *_tpPID)
+{
+    if (_ch >= _tpBatch->count)
+        return;
+
+    memset(_tpPID, 0, sizeof(PID_T));
+    _tpPID->kp = _tpBatch->kp[_ch];
+    _tpPID->ki = _tpBatch->ki[_ch];
+    _tpPID->kd = _tpBatch->kd[_ch];
+    _tpPID->target = _tpBatch->target[_ch];
+    _tpPID->limit = _tpBatch->limit[_ch];
+    _tpPID->out = _tpBatch->out[_ch];
+    _tpPID->error = _tpBatch->last_error[_ch];
+    _tpPID->last_error = _tpBatch->last_error[_ch];
+    _tpPID->last2_error = _tpBatch->last2_error[_ch];
+    _tpPID->integral = _tpBatch->integral[_ch];
+#if PID_BATCH_DEBUG
+    _tpPID->p_out = _tpBatch->p_out[_ch];
+    _tpPID->i_out = _tpBatch->i_out[_ch];
+    _tpPID->d_out = _tpBatch->d_out[_ch];
+#endif
+}
+
+/**
+ * @brief 当前使用的计算实现
+ */
+const char *pid_batch_kernel(void)
+{
+#ifdef PID_BATCH_SIMD
+    return PID_BATCH_SIMD;
+#else
+    return "scalar";
+#endif
+}
@@ -0,0 +1,166 @@
+/**
+ ******************************************************************************
+ * @file    pid_batch.h
+ * @brief   批量PID控制器：N路PID按数组分别存放，一次调用全部更新
+ * @author  XiFeng
+ * @version 1.0.0
+ ******************************************************************************
+ * @attention
+ *
+ * 计算公式、运算顺序与 pid.c 完全相同，同样的输入得到逐位相同的输出
+ * 有 SSE / NEON / Helium(MVE) 时每次处理4路，否则逐路计算
+ * 定义 PID_BATCH_SCALAR 可强制使用逐路计算
+ *
+ ******************************************************************************
+ */
+
+#ifndef __PID_BATCH_H
+#define __PID_BATCH_H
+
+#include <stdint.h>
+#include "pid.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* 最大通道数，可在编译选项中修改 */
+#ifndef PID_BATCH_MAX_CHANNELS
+#define PID_BATCH_MAX_CHANNELS  16
+#endif
+
+/* 为1时保存每路的比例、积分、微分分量（对应 PID_T 的 p_out/i_out/d_out），会多3次写数组 */
+#ifndef PID_BATCH_DEBUG
+#define PID_BATCH_DEBUG         0
+#endif
+
+/* 批量PID结构体，各量按通道存为数组，可直接读写 target[]、out[] 等 */
+typedef struct
+{
+    float kp[PID_BATCH_MAX_CHANNELS];           /* 比例系数 */
+    float ki[PID_BATCH_MAX_CHANNELS];           /* 积分系数 */
+    float kd[PID_BATCH_MAX_CHANNELS];           /* 微分系数 */
+    float target[PID_BATCH_MAX_CHANNELS];       /* 目标值 */
+    float limit[PID_BATCH_MAX_CHANNELS];        /* 输出限幅值 */
+    float out[PID_BATCH_MAX_CHANNELS];          /* 执行量(输出) */
+
+    float last_error[PID_BATCH_MAX_CHANNELS];   /* 上一次误差（更新后即本次误差） */
+    float last2_error[PID_BATCH_MAX_CHANNELS];  /* 上上次误差 */
+    float integral[PID_BATCH_MAX_CHANNELS];     /* 积分项（累加） */
+#if PID_BATCH_DEBUG
+    float p_out[PID_BATCH_MAX_CHANNELS];        /* 比例分量 */
+    float i_out[PID_BATCH_MAX_CHANNELS];        /* 积分分量 */
+    float d_out[PID_BATCH_MAX_CHANNELS];        /* 微分分量 */
+#endif
+    uint16_t count;                             /* 通道数 */
+} PID_BATCH_T;
+
+/**
+ * @brief 批量PID初始化
+ * @param _tpBatch 指向批量PID结构体的指针
+ * @param _count 通道数，不超过 PID_BATCH_MAX_CHANNELS
+ * @return 0成功，-1通道数超出
+ * @note 所有通道的参数和状态清零，之后用 pid_batch_setup() 逐路设置
+ */
+int pid_batch_init(PID_BATCH_T *_tpBatch, uint16_t _count);
+
+/**
+ * @brief 设置一路PID，等同于对该路调用 pid_init()
+ * @param _tpBatch 指向批量PID结构体的指针
+ * @param _ch 通道号
+ * @param _kp 比例系数
+ * @param _ki 积分系数
+ * @param _kd 微分系数
+ * @param _target 目标值
+ * @param _limit 输出限幅值
+ */
+void pid_batch_setup(PID_BATCH_T *_tpBatch, uint16_t _ch,
+                     float _kp, float _ki, float _kd, float _target, float _limit);
+
+/**
+ * @brief 设置一路目标值，等同于 pid_set_target()
+ * @param _tpBatch 指向批量PID结构体的指针
+ * @param _ch 通道号
+ * @param _target 目标值
+ * @note 与 pid_set_target() 一样会清除该路的历史状态；每周期都改目标值时直接写 target[_ch]
+ */
+void pid_batch_set_target(PID_BATCH_T *_tpBatch, uint16_t _ch, float _target);
+
+/**
+ * @brief 设置一路PID参数
+ * @param _tpBatch 指向批量PID结构体的指针
+ * @param _ch 通道号
+ * @param _kp 比例系数
+ * @param _ki 积分系数
+ * @param _kd 微分系数
+ */
+void pid_batch_set_params(PID_BATCH_T *_tpBatch, uint16_t _ch, float _kp, float _ki, float _kd);
+
+/**
+ * @brief 设置一路输出限幅
+ * @param _tpBatch 指向批量PID结构体的指针
+ * @param _ch 通道号
+ * @param _limit 限幅值
+ */
+void pid_batch_set_limit(PID_BATCH_T *_tpBatch, uint16_t _ch, float _limit);
+
+/**
+ * @brief 重置一路PID，清除历史误差数据
+ * @param _tpBatch 指向批量PID结构体的指针
+ * @param _ch 通道号
+ */
+void pid_batch_reset(PID_BATCH_T *_tpBatch, uint16_t _ch);
+
+/**
+ * @brief 计算全部通道的位置式PID
+ * @param _tpBatch 指向批量PID结构体的指针
+ * @param _current 各路当前值，长度为通道数
+ * @note 输出在 out[]，每路结果与 pid_calculate_positional() 相同
+ */
+void pid_batch_positional(PID_BATCH_T *_tpBatch, const float *_current);
+
+/**
+ * @brief 计算全部通道的增量式PID
+ * @param _tpBatch 指向批量PID结构体的指针
+ * @param _current 各路当前值，长度为通道数
+ * @note 输出在 out[]，每路结果与 pid_calculate_incremental() 相同
+ */
+void pid_batch_incremental(PID_BATCH_T *_tpBatch, const float *_current);
+
+/**
+ * @brief 一路积分限幅，等同于 pid_limit_integral()
+ * @param _tpBatch 指向批量PID结构体的指针
+ * @param _ch 通道号
+ * @param min 最小值
+ * @param max 最大值
+ */
+void pid_batch_limit_integral(PID_BATCH_T *_tpBatch, uint16_t _ch, float min, float max);
+
+/**
+ * @brief 从 PID_T 导入一路的参数和状态
+ * @param _tpBatch 指向批量PID结构体的指针
+ * @param _ch 通道号
+ * @param _tpPID 源PID
+ */
+void pid_batch_load(PID_BATCH_T *_tpBatch, uint16_t _ch, const PID_T *_tpPID);
+
+/**
+ * @brief 把一路的参数和状态导出为 PID_T，便于调试打印或切回逐路计算
+ * @param _tpBatch 指向批量PID结构体的指针
+ * @param _ch 通道号
+ * @param _tpPID 目标PID
+ * @note current 不保存，导出为0；PID_BATCH_DEBUG 为0时 p_out/i_out/d_out 导出为0
+ */
+void pid_batch_store(const PID_BATCH_T *_tpBatch, uint16_t _ch, PID_T *_tpPID);
+
+/**
+ * @brief 当前使用的计算实现
+ * @return "sse"、"neon"、"helium" 或 "scalar"
+ */
+const char *pid_batch_kernel(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* __PID_BATCH_H */
@@ -0,0 +1,235 @@
+/**
+ ******************************************************************************
+ * @file    pid_cascade.c
+ * @brief   多速率串级PID实现
+ * @author  XiFeng
+ * @version 1.0.0
+ ******************************************************************************
+ * @attention
+ *
+ * 分频用递减计数实现，不做除法（Cortex-M0、8051 没有硬件除法）
+ * 同一节拍内从外到内依次计算，内环当拍就能用上外环的新输出
+ *
+ ******************************************************************************
+ */
+
+#include "pid_cascade.h"
+
+/**
+ * @brief 串级控制器初始化
+ */
+void pid_cascade_init(PID_CASCADE_T *_tpCascade)
+{
+    _tpCascade->count = 0;
+    _tpCascade->tick_count = 0;
+#if PID_CASCADE_ENABLE_STATS
+    _tpCascade->clock = 0;
+    _tpCascade->tick_exec_last = 0;
+    _tpCascade->tick_exec_max = 0;
+#endif
+}
+
+/**
+ * @brief 追加一级
+ */
+int pid_cascade_add_stage(PID_CASCADE_T *_tpCascade, PID_T *_tpPID, uint8_t _form, uint16_t _divisor)
+{
+    PID_CASCADE_STAGE_T *stage;
+
+    if (_tpCascade->count >= PID_CASCADE_MAX_STAGES || _tpPID == 0)
+        return -1;
+
+    stage = &_tpCascade->stage[_tpCascade->count];
+    stage->pid = _tpPID;
+    stage->form = _form;
+    stage->divisor = _divisor ? _divisor : 1;
+    stage->countdown = 0;
+#if PID_CASCADE_ENABLE_STATS
+    stage->run_count = 0;
+    stage->exec_last = 0;
+    stage->exec_max = 0;
+    stage->exec_total = 0;
+#endif
+    return _tpCascade->count++;
+}
+
+/**
+ * @brief 设置某级的相位
+ */
+int pid_cascade_set_phase(PID_CASCADE_T *_tpCascade, uint8_t _stage, uint16_t _phase)
+{
+    if (_stage >= _tpCascade->count)
+        return -1;
+
+    _tpCascade->stage[_stage].countdown = _phase % _tpCascade->stage[_stage].divisor;
+    return 0;
+}
+
+/**
+ * @brief 设置最外环目标值
+ */
+void pid_cascade_set_target(PID_CASCADE_T *_tpCascade, float _target)
+{
+    if (_tpCascade->count > 0)
+        _tpCascade->stage[0].pid->target = _target;
+}
+
+/**
+ * @brief 重置所有级
+ */
+void pid_cascade_reset(PID_CASCADE_T *_tpCascade)
+{
+    uint8_t i;
+
+    for (i = 0; i < _tpCascade->count; i++)
+    {
+        pid_reset(_tpCascade->stage[i].pid);
+        _tpCascade->stage[i].countdown = 0;
+    }
+    _tpCascade->tick_count = 0;
+}
+
+/**
+ * @brief 运行一个基本节拍
+ */
+float pid_cascade_tick(PID_CASCADE_T *_tpCascade, const float *_feedback)
+{
+    PID_CASCADE_STAGE_T *stage;
+    uint8_t i;
+#if PID_CASCADE_ENABLE_STATS
+    PID_CASCADE_CLOCK_FN clock = _tpCascade->clock;
+    uint32_t tick_start = clock ? clock() : 0;
+#endif
+
+    if (_tpCascade->count == 0)
+        return 0;
+
+    for (i = 0; i < _tpCascade->count; i++)
+    {
+        stage = &_tpCascade->stage[i];
+        if (stage->countdown > 0)
+        {
+            stage->countdown--;
+            continue;
+        }
+        stage->countdown = stage->divisor - 1;
+
+#if PID_CASCADE_ENABLE_STATS
+        if (clock)
+        {
+            uint32_t start = clock();
+            uint32_t exec;
+
+            if (stage->form == PID_CASCADE_INCREMENTAL)
+                pid_calculate_incremental(stage->pid, _feedback[i]);
+            else
+                pid_calculate_positional(stage->pid, _feedback[i]);
+
+            exec = clock() - start;
+            stage->exec_last = exec;
+            if (exec > stage->exec_max)
+                stage->exec_max = exec;
+            stage->exec_total += exec;
+            stage->run_count++;
+        }
+        else
+#endif
+        {
+            if (stage->form == PID_CASCADE_INCREMENTAL)
+                pid_calculate_incremental(stage->pid, _feedback[i]);
+            else
+                pid_calculate_positional(stage->pid, _feedback[i]);
+#if PID_CASCADE_ENABLE_STATS
+            stage->run_count++;
+#endif
+        }
+
+        /* 外环输出作为内环目标值，直接写入，不清除内环历史状态 */
+        if (i + 1 < _tpCascade->count)
+            _tpCascade->stage[i + 1].pid->target = stage->pid->out;
+    }
+    _tpCascade->tick_count++;
+
+#if PID_CASCADE_ENABLE_STATS
+    if (clock)
+    {
+        uint32_t exec = clock() - tick_start;
+
+        _tpCascade->tick_exec_last = exec;
+        if (exec > _tpCascade->tick_exec_max)
+            _tpCascade->tick_exec_max = exec;
+    }
+#endif
+
+    return _tpCascade->stage[_tpCascade->count - 1].pid->out;
+}
+
+#if PID_CASCADE_ENABLE_STATS
+/**
+ * @brief 安装计时源
+ */
+void pid_cascade_set_clock(PID_CASCADE_T *_tpCascade, PID_CASCADE_CLOCK_FN _clock)
+{
+    _tpCascade->clock = _clock;
+    pid_cascade_stats_reset(_tpCascade);
+}
+
+/**
+ * @brief 清空执行时间统计
+ */
+void pid_cascade_stats_reset(PID_CASCADE_T *_tpCascade)
+{
+    uint8_t i;
+
+    for (i = 0; i < _tpCascade->count; i++)
+    {
+        _tpCascade->stage[i].run_count = 0;
+        _tpCascade->stage[i].exec_last = 0;
+        _tpCascade->stage[i].exec_max = 0;
+        _tpCascade->stage[i].exec_total = 0;
+    }
+    _tpCascade->tick_exec_last = 0;
+    _tpCascade->tick_exec_max = 0;
+}
+
+/**
+ * @brief 获取某级的平均执行时间
+ */
+uint32_t pid_cascade_exec_mean(const PID_CASCADE_T *_tpCascade, uint8_t _stage)
+{
+    const PID_CASCADE_STAGE_T *stage;
+
+    if (_stage >= _tpCascade->count)
+        return 0;
+
+    stage = &_tpCascade->stage[_stage];
+    if (stage->run_count == 0)
+        return 0;
+    return (uint32_t)(stage->exec_total / stage->run_count);
+}
+#endif
+
+#if PID_CASCADE_USE_SCHEDULER
+/**
+ * @brief 把串级挂到调度器上
+ */
+int pid_cascade_add_task(PID_CASCADE_T *_tpCascade, scheduler_t *sched,
+                         scheduler_task_fn task_func, uint32_t period_ms)
+{
+    int index = scheduler_add_task(sched, task_func, period_ms);
+
+    if (index < 0)
+        return -1;
+
+    /* 控制环不能因为时间片预算被推迟 */
+    scheduler_set_priority(sched, index, SCHEDULER_PRIORITY_HIGHEST);
+
+#if PID_CASCADE_ENABLE_STATS && SCHEDULER_ENABLE_STATS
+    if (_tpCascade->clock == 0 && sched->timestamp != 0)
+        pid_cascade_set_clock(_tpCascade, sched->timestamp);
+#else
+    (void)_tpCascade;
+#endif
+    return index;
+}
+#endif
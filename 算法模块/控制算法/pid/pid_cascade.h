@@ -0,0 +1,171 @@
+/**
+ ******************************************************************************
+ * @file    pid_cascade.h
+ * @brief   多速率串级PID：位置→速度→电流等多级 PID_T 串联，各级按分频运行
+ * @author  XiFeng
+ * @version 1.0.0
+ ******************************************************************************
+ * @attention
+ *
+ * 每次 pid_cascade_tick() 为一个基本节拍（通常是电流环的定时器中断），
+ * 第 i 级每 divisor 个节拍运行一次，输出写入下一级的 target，
+ * 不到期的外环直接跳过，内环沿用上次的目标值（零阶保持）
+ *
+ ******************************************************************************
+ */
+
+#ifndef __PID_CASCADE_H
+#define __PID_CASCADE_H
+
+#include <stdint.h>
+#include "pid.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* 最大级数 */
+#ifndef PID_CASCADE_MAX_STAGES
+#define PID_CASCADE_MAX_STAGES  4
+#endif
+
+/* 为1时统计各级执行时间（需 pid_cascade_set_clock() 安装计时源），为0时不占用空间和时间 */
+#ifndef PID_CASCADE_ENABLE_STATS
+#define PID_CASCADE_ENABLE_STATS 1
+#endif
+
+/* 为1时提供 pid_cascade_add_task()，把串级挂到 scheduler 上运行 */
+#ifndef PID_CASCADE_USE_SCHEDULER
+#define PID_CASCADE_USE_SCHEDULER 0
+#endif
+
+#if PID_CASCADE_USE_SCHEDULER
+#include "scheduler.h"
+#endif
+
+/* 每级使用的PID形式 */
+#define PID_CASCADE_POSITIONAL  0   /* pid_calculate_positional() */
+#define PID_CASCADE_INCREMENTAL 1   /* pid_calculate_incremental() */
+
+/* 计时源函数类型，与 scheduler_timestamp_fn 相同（如 DWT->CYCCNT、微秒定时器） */
+typedef uint32_t (*PID_CASCADE_CLOCK_FN)(void);
+
+/* 串级中的一级 */
+typedef struct
+{
+    PID_T *pid;             /* 该级的PID控制器 */
+    uint16_t divisor;       /* 分频：每 divisor 个节拍运行一次 */
+    uint16_t countdown;     /* 距下次运行的节拍数，0 表示本节拍运行 */
+    uint8_t form;           /* PID_CASCADE_POSITIONAL / PID_CASCADE_INCREMENTAL */
+#if PID_CASCADE_ENABLE_STATS
+    uint32_t run_count;     /* 运行次数 */
+    uint32_t exec_last;     /* 最近一次执行时间（计时源单位） */
+    uint32_t exec_max;      /* 最长执行时间 */
+    uint64_t exec_total;    /* 累计执行时间 */
+#endif
+} PID_CASCADE_STAGE_T;
+
+/* 串级控制器，stage[0] 为最外环，stage[count-1] 为最内环 */
+typedef struct
+{
+    PID_CASCADE_STAGE_T stage[PID_CASCADE_MAX_STAGES];
+    uint8_t count;                  /* 级数 */
+    uint32_t tick_count;            /* 已运行的节拍数 */
+#if PID_CASCADE_ENABLE_STATS
+    PID_CASCADE_CLOCK_FN clock;     /* 计时源，NULL 时不计时 */
+    uint32_t tick_exec_last;        /* 最近一个节拍的总执行时间 */
+    uint32_t tick_exec_max;         /* 单个节拍的最长执行时间（中断最坏耗时） */
+#endif
+} PID_CASCADE_T;
+
+/**
+ * @brief 串级控制器初始化，清空所有级
+ * @param _tpCascade 指向串级结构体的指针
+ */
+void pid_cascade_init(PID_CASCADE_T *_tpCascade);
+
+/**
+ * @brief 在最内侧追加一级（先加外环，后加内环）
+ * @param _tpCascade 指向串级结构体的指针
+ * @param _tpPID 该级的PID控制器，需已用 pid_init() 初始化
+ * @param _form PID_CASCADE_POSITIONAL 或 PID_CASCADE_INCREMENTAL
+ * @param _divisor 分频，1 表示每个节拍都运行，0 按 1 处理
+ * @return 级号，-1 表示已满
+ * @note 外环的增益按它自己的运行周期（基本节拍 × divisor）整定
+ */
+int pid_cascade_add_stage(PID_CASCADE_T *_tpCascade, PID_T *_tpPID, uint8_t _form, uint16_t _divisor);
+
+/**
+ * @brief 设置某级的相位，把分频相同的外环错开到不同节拍，降低中断最坏耗时
+ * @param _tpCascade 指向串级结构体的指针
+ * @param _stage 级号
+ * @param _phase 第一次运行前等待的节拍数，应小于 divisor
+ * @return 0 成功，-1 失败
+ */
+int pid_cascade_set_phase(PID_CASCADE_T *_tpCascade, uint8_t _stage, uint16_t _phase);
+
+/**
+ * @brief 设置最外环目标值
+ * @param _tpCascade 指向串级结构体的指针
+ * @param _target 目标值
+ * @note 只改 target，不像 pid_set_target() 那样清除历史状态，运行中可随时调用
+ */
+void pid_cascade_set_target(PID_CASCADE_T *_tpCascade, float _target);
+
+/**
+ * @brief 重置所有级的PID状态（pid_reset()）和分频计数，统计数据不变
+ * @param _tpCascade 指向串级结构体的指针
+ */
+void pid_cascade_reset(PID_CASCADE_T *_tpCascade);
+
+/**
+ * @brief 运行一个基本节拍
+ * @param _tpCascade 指向串级结构体的指针
+ * @param _feedback 各级的测量值，_feedback[i] 对应 stage[i]；不到期的级不读取
+ * @return 最内环的输出（执行量）
+ */
+float pid_cascade_tick(PID_CASCADE_T *_tpCascade, const float *_feedback);
+
+#if PID_CASCADE_ENABLE_STATS
+/**
+ * @brief 安装计时源，同时清空统计数据
+ * @param _tpCascade 指向串级结构体的指针
+ * @param _clock 计时源，NULL 表示不计时
+ */
+void pid_cascade_set_clock(PID_CASCADE_T *_tpCascade, PID_CASCADE_CLOCK_FN _clock);
+
+/**
+ * @brief 清空各级的执行时间统计
+ * @param _tpCascade 指向串级结构体的指针
+ */
+void pid_cascade_stats_reset(PID_CASCADE_T *_tpCascade);
+
+/**
+ * @brief 获取某级的平均执行时间
+ * @param _tpCascade 指向串级结构体的指针
+ * @param _stage 级号
+ * @return 平均执行时间（计时源单位），未运行过时为0
+ */
+uint32_t pid_cascade_exec_mean(const PID_CASCADE_T *_tpCascade, uint8_t _stage);
+#endif
+
+#if PID_CASCADE_USE_SCHEDULER
+/**
+ * @brief 把串级挂到调度器上，以 period_ms 为基本节拍运行
+ * @param _tpCascade 指向串级结构体的指针
+ * @param sched 调度器
+ * @param task_func 任务函数，在其中读取测量值并调用 pid_cascade_tick()
+ * @param period_ms 基本节拍（毫秒）
+ * @return 任务索引，-1 表示失败
+ * @note 任务设为最高优先级，不受时间片预算限制；
+ *       调度器开启统计且串级未安装计时源时，沿用调度器的时间戳源，两边的执行时间单位一致
+ */
+int pid_cascade_add_task(PID_CASCADE_T *_tpCascade, scheduler_t *sched,
+                         scheduler_task_fn task_func, uint32_t period_ms);
+#endif
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* __PID_CASCADE_H */
@@ -0,0 +1,441 @@
+/**
+ ******************************************************************************
+ * @file    pid_fixed.c
+ * @brief   定点PID控制器库实现
+ * @author  XiFeng
+ * @version 1.0.0
+ ******************************************************************************
+ * @attention
+ *
+ * 三项乘积先在宽累加器中相加，最后只做一次四舍五入的右移，
+ * 增量式的输出在累加器中保留 q 位小数，不足1的增量不会丢失
+ * 负数右移按算术右移处理（GCC、Keil、IAR 均如此）
+ *
+ ******************************************************************************
+ */
+
+#include "pid_fixed.h"
+
+/* ======================= 饱和运算 ======================= */
+
+/**
+ * @brief 32位结果饱和为16位
+ */
+static int16_t pid_sat16(int32_t x)
+{
+    if (x > INT16_MAX)
+        return INT16_MAX;
+    else if (x < INT16_MIN)
+        return INT16_MIN;
+    return (int16_t)x;
+}
+
+/**
+ * @brief 32位饱和加法，不用64位运算
+ */
+static int32_t pid_add_sat32(int32_t a, int32_t b)
+{
+    int32_t s = (int32_t)((uint32_t)a + (uint32_t)b);
+
+    /* 两个加数同号而结果异号即溢出 */
+    if (((a ^ s) & (b ^ s)) < 0)
+        return (a < 0) ? INT32_MIN : INT32_MAX;
+    return s;
+}
+
+/**
+ * @brief 四舍五入右移 q 位
+ */
+static int32_t pid_round_shift32(int32_t x, uint8_t q)
+{
+    if (q == 0)
+        return x;
+    return pid_add_sat32(x, (int32_t)1 << (q - 1)) >> q;
+}
+
+/* ======================= 16位定点PID ======================= */
+
+/**
+ * @brief 输出限幅，与 pid_out_limit 相同
+ */
+static void pid_q15_out_limit(PID_Q15_T *_tpPID)
+{
+    if (_tpPID->out > _tpPID->limit)
+        _tpPID->out = _tpPID->limit;
+    else if (_tpPID->out < -_tpPID->limit)
+        _tpPID->out = pid_sat16(-(int32_t)_tpPID->limit);
+}
+
+/**
+ * @brief 16位定点PID初始化
+ */
+void pid_q15_init(PID_Q15_T *_tpPID, int16_t _kp, int16_t _ki, int16_t _kd, uint8_t _q,
+                  int16_t _target, int16_t _limit)
+{
+    _tpPID->kp = _kp;
+    _tpPID->ki = _ki;
+    _tpPID->kd = _kd;
+    _tpPID->q = (_q > 15) ? 15 : _q;
+    _tpPID->target = _target;
+    _tpPID->limit = _limit;
+    _tpPID->current = 0;
+    _tpPID->error = 0;
+    pid_q15_reset(_tpPID);
+}
+
+/**
+ * @brief 设置PID目标值
+ */
+void pid_q15_set_target(PID_Q15_T *_tpPID, int16_t _target)
+{
+    _tpPID->target = _target;
+    pid_q15_reset(_tpPID);
+}
+
+/**
+ * @brief 设置PID参数
+ */
+void pid_q15_set_params(PID_Q15_T *_tpPID, int16_t _kp, int16_t _ki, int16_t _kd)
+{
+    _tpPID->kp = _kp;
+    _tpPID->ki = _ki;
+    _tpPID->kd = _kd;
+}
+
+/**
+ * @brief 设置PID输出限幅
+ */
+void pid_q15_set_limit(PID_Q15_T *_tpPID, int16_t _limit)
+{
+    _tpPID->limit = _limit;
+}
+
+/**
+ * @brief 重置PID控制器
+ */
+void pid_q15_reset(PID_Q15_T *_tpPID)
+{
+    _tpPID->integral = 0;
+    _tpPID->last_error = 0;
+    _tpPID->last2_error = 0;
+    _tpPID->out = 0;
+    _tpPID->out_acc = 0;
+#if PID_FIXED_DEBUG
+    _tpPID->p_out = 0;
+    _tpPID->i_out = 0;
+    _tpPID->d_out = 0;
+#endif
+}
+
+/**
+ * @brief 计算位置式PID
+ * @note 在位置式中，P-响应性，I-准确性，D-稳定性
+ */
+int16_t pid_q15_calculate_positional(PID_Q15_T *_tpPID, int16_t _current)
+{
+    int32_t p_acc, i_acc, d_acc;
+
+    _tpPID->current = _current;
+    _tpPID->error = pid_sat16((int32_t)_tpPID->target - _current);
+    _tpPID->integral = pid_sat16((int32_t)_tpPID->integral + _tpPID->error);
+
+    p_acc = (int32_t)_tpPID->kp * _tpPID->error;
+    i_acc = (int32_t)_tpPID->ki * _tpPID->integral;
+    d_acc = (int32_t)_tpPID->kd * pid_sat16((int32_t)_tpPID->error - _tpPID->last_error);
+
+    _tpPID->out = pid_sat16(pid_round_shift32(pid_add_sat32(pid_add_sat32(p_acc, i_acc), d_acc), _tpPID->q));
+    pid_q15_out_limit(_tpPID);
+#if PID_FIXED_DEBUG
+    _tpPID->p_out = pid_sat16(pid_round_shift32(p_acc, _tpPID->q));
+    _tpPID->i_out = pid_sat16(pid_round_shift32(i_acc, _tpPID->q));
+    _tpPID->d_out = pid_sat16(pid_round_shift32(d_acc, _tpPID->q));
+#endif
+
+    _tpPID->last_error = _tpPID->error;
+    return _tpPID->out;
+}
+
+/**
+ * @brief 计算增量式PID
+ * @note 在增量式中，P-稳定性，I-响应性，D-准确性
+ */
+int16_t pid_q15_calculate_incremental(PID_Q15_T *_tpPID, int16_t _current)
+{
+    int32_t p_acc, i_acc, d_acc, limit;
+
+    _tpPID->current = _current;
+    _tpPID->error = pid_sat16((int32_t)_tpPID->target - _current);
+
+    p_acc = (int32_t)_tpPID->kp * pid_sat16((int32_t)_tpPID->error - _tpPID->last_error);
+    i_acc = (int32_t)_tpPID->ki * _tpPID->error;
+    d_acc = (int32_t)_tpPID->kd * pid_sat16((int32_t)_tpPID->error - 2 * (int32_t)_tpPID->last_error +
+                                            _tpPID->last2_error);
+
+    /* 限幅作用在累加器上，与 pid.c 限幅后的 out 继续累加一致 */
+    _tpPID->out_acc = pid_add_sat32(_tpPID->out_acc, pid_add_sat32(pid_add_sat32(p_acc, i_acc), d_acc));
+    limit = (int32_t)_tpPID->limit * ((int32_t)1 << _tpPID->q);
+    if (_tpPID->out_acc > limit)
+        _tpPID->out_acc = limit;
+    else if (_tpPID->out_acc < -limit)
+        _tpPID->out_acc = -limit;
+    _tpPID->out = pid_sat16(pid_round_shift32(_tpPID->out_acc, _tpPID->q));
+#if PID_FIXED_DEBUG
+    _tpPID->p_out = pid_sat16(pid_round_shift32(p_acc, _tpPID->q));
+    _tpPID->i_out = pid_sat16(pid_round_shift32(i_acc, _tpPID->q));
+    _tpPID->d_out = pid_sat16(pid_round_shift32(d_acc, _tpPID->q));
+#endif
+
+    _tpPID->last2_error = _tpPID->last_error;
+    _tpPID->last_error = _tpPID->error;
+    return _tpPID->out;
+}
+
+/**
+ * @brief 积分限幅函数
+ */
+void pid_q15_limit_integral(PID_Q15_T *_tpPID, int16_t min, int16_t max)
+{
+    if (_tpPID->integral > max)
+    {
+        _tpPID->integral = max;
+    }
+    else if (_tpPID->integral < min)
+    {
+        _tpPID->integral = min;
+    }
+}
+
+/**
+ * @brief 浮点增益转为16位定点数
+ */
+int16_t pid_q15_gain(float k, uint8_t q)
+{
+    float v = k * (float)((int32_t)1 << q) + ((k >= 0) ? 0.5f : -0.5f);
+
+    if (!(v == v))      /* NaN */
+        return 0;
+    if (v >= 32767.0f)
+        return INT16_MAX;
+    if (v <= -32768.0f)
+        return INT16_MIN;
+    return (int16_t)v;
+}
+
+/**
+ * @brief 16位定点增益转回浮点数
+ */
+float pid_q15_to_float(int16_t k, uint8_t q)
+{
+    return (float)k / (float)((int32_t)1 << q);
+}
+
+#if PID_FIXED_Q31
+
+/* ======================= 32位定点PID ======================= */
+
+/**
+ * @brief 64位结果饱和为32位
+ */
+static int32_t pid_sat32(int64_t x)
+{
+    if (x > INT32_MAX)
+        return INT32_MAX;
+    else if (x < INT32_MIN)
+        return INT32_MIN;
+    return (int32_t)x;
+}
+
+/**
+ * @brief 64位饱和加法
+ */
+static int64_t pid_add_sat64(int64_t a, int64_t b)
+{
+    int64_t s = (int64_t)((uint64_t)a + (uint64_t)b);
+
+    if (((a ^ s) & (b ^ s)) < 0)
+        return (a < 0) ? INT64_MIN : INT64_MAX;
+    return s;
+}
+
+/**
+ * @brief 四舍五入右移 q 位
+ */
+static int64_t pid_round_shift64(int64_t x, uint8_t q)
+{
+    if (q == 0)
+        return x;
+    return pid_add_sat64(x, (int64_t)1 << (q - 1)) >> q;
+}
+
+/**
+ * @brief 输出限幅，与 pid_out_limit 相同
+ */
+static void pid_q31_out_limit(PID_Q31_T *_tpPID)
+{
+    if (_tpPID->out > _tpPID->limit)
+        _tpPID->out = _tpPID->limit;
+    else if ((int64_t)_tpPID->out < -(int64_t)_tpPID->limit)
+        _tpPID->out = pid_sat32(-(int64_t)_tpPID->limit);
+}
+
+/**
+ * @brief 32位定点PID初始化
+ */
+void pid_q31_init(PID_Q31_T *_tpPID, int32_t _kp, int32_t _ki, int32_t _kd, uint8_t _q,
+                  int32_t _target, int32_t _limit)
+{
+    _tpPID->kp = _kp;
+    _tpPID->ki = _ki;
+    _tpPID->kd = _kd;
+    _tpPID->q = (_q > 31) ? 31 : _q;
+    _tpPID->target = _target;
+    _tpPID->limit = _limit;
+    _tpPID->current = 0;
+    _tpPID->error = 0;
+    pid_q31_reset(_tpPID);
+}
+
+/**
+ * @brief 设置PID目标值
+ */
+void pid_q31_set_target(PID_Q31_T *_tpPID, int32_t _target)
+{
+    _tpPID->target = _target;
+    pid_q31_reset(_tpPID);
+}
+
+/**
+ * @brief 设置PID参数
+ */
+void pid_q31_set_params(PID_Q31_T *_tpPID, int32_t _kp, int32_t _ki, int32_t _kd)
+{
+    _tpPID->kp = _kp;
+    _tpPID->ki = _ki;
+    _tpPID->kd = _kd;
+}
+
+/**
+ * @brief 设置PID输出限幅
+ */
+void pid_q31_set_limit(PID_Q31_T *_tpPID, int32_t _limit)
+{
+    _tpPID->limit = _limit;
+}
+
+/**
+ * @brief 重置PID控制器
+ */
+void pid_q31_reset(PID_Q31_T *_tpPID)
+{
+    _tpPID->integral = 0;
+    _tpPID->last_error = 0;
+    _tpPID->last2_error = 0;
+    _tpPID->out = 0;
+    _tpPID->out_acc = 0;
+#if PID_FIXED_DEBUG
+    _tpPID->p_out = 0;
+    _tpPID->i_out = 0;
+    _tpPID->d_out = 0;
+#endif
+}
+
+/**
+ * @brief 计算位置式PID
+ */
+int32_t pid_q31_calculate_positional(PID_Q31_T *_tpPID, int32_t _current)
+{
+    int64_t p_acc, i_acc, d_acc;
+
+    _tpPID->current = _current;
+    _tpPID->error = pid_sat32((int64_t)_tpPID->target - _current);
+    _tpPID->integral = pid_sat32((int64_t)_tpPID->integral + _tpPID->error);
+
+    p_acc = (int64_t)_tpPID->kp * _tpPID->error;
+    i_acc = (int64_t)_tpPID->ki * _tpPID->integral;
+    d_acc = (int64_t)_tpPID->kd * pid_sat32((int64_t)_tpPID->error - _tpPID->last_error);
+
+    _tpPID->out = pid_sat32(pid_round_shift64(pid_add_sat64(pid_add_sat64(p_acc, i_acc), d_acc), _tpPID->q));
+    pid_q31_out_limit(_tpPID);
+#if PID_FIXED_DEBUG
+    _tpPID->p_out = pid_sat32(pid_round_shift64(p_acc, _tpPID->q));
+    _tpPID->i_out = pid_sat32(pid_round_shift64(i_acc, _tpPID->q));
+    _tpPID->d_out = pid_sat32(pid_round_shift64(d_acc, _tpPID->q));
+#endif
+
+    _tpPID->last_error = _tpPID->error;
+    return _tpPID->out;
+}
+
+/**
+ * @brief 计算增量式PID
+ */
+int32_t pid_q31_calculate_incremental(PID_Q31_T *_tpPID, int32_t _current)
+{
+    int64_t p_acc, i_acc, d_acc, limit;
+
+    _tpPID->current = _current;
+    _tpPID->error = pid_sat32((int64_t)_tpPID->target - _current);
+
+    p_acc = (int64_t)_tpPID->kp * pid_sat32((int64_t)_tpPID->error - _tpPID->last_error);
+    i_acc = (int64_t)_tpPID->ki * _tpPID->error;
+    d_acc = (int64_t)_tpPID->kd * pid_sat32((int64_t)_tpPID->error - 2 * (int64_t)_tpPID->last_error +
+                                            _tpPID->last2_error);
+
+    _tpPID->out_acc = pid_add_sat64(_tpPID->out_acc, pid_add_sat64(pid_add_sat64(p_acc, i_acc), d_acc));
+    limit = (int64_t)_tpPID->limit * ((int64_t)1 << _tpPID->q);
+    if (_tpPID->out_acc > limit)
+        _tpPID->out_acc = limit;
+    else if (_tpPID->out_acc < -limit)
+        _tpPID->out_acc = -limit;
+    _tpPID->out = pid_sat32(pid_round_shift64(_tpPID->out_acc, _tpPID->q));
+#if PID_FIXED_DEBUG
+    _tpPID->p_out = pid_sat32(pid_round_shift64(p_acc, _tpPID->q));
+    _tpPID->i_out = pid_sat32(pid_round_shift64(i_acc, _tpPID->q));
+    _tpPID->d_out = pid_sat32(pid_round_shift64(d_acc, _tpPID->q));
+#endif
+
+    _tpPID->last2_error = _tpPID->last_error;
+    _tpPID->last_error = _tpPID->error;
+    return _tpPID->out;
+}
+
+/**
+ * @brief 积分限幅函数
+ */
+void pid_q31_limit_integral(PID_Q31_T *_tpPID, int32_t min, int32_t max)
+{
+    if (_tpPID->integral > max)
+    {
+        _tpPID->integral = max;
+    }
+    else if (_tpPID->integral < min)
+    {
+        _tpPID->integral = min;
+    }
+}
+
+/**
+ * @brief 浮点增益转为32位定点数
+ */
+int32_t pid_q31_gain(float k, uint8_t q)
+{
+    float v = k * (float)((int64_t)1 << q) + ((k >= 0) ? 0.5f : -0.5f);
+
+    if (!(v == v))      /* NaN */
+        return 0;
+    if (v >= 2147483648.0f)
+        return INT32_MAX;
+    if (v <= -2147483648.0f)
+        return INT32_MIN;
+    return (int32_t)v;
+}
+
+/**
+ * @brief 32位定点增益转回浮点数
+ */
+float pid_q31_to_float(int32_t k, uint8_t q)
+{
+    return (float)k / (float)((int64_t)1 << q);
+}
+
+#endif /* PID_FIXED_Q31 */
@@ -0,0 +1,266 @@
+/**
+ ******************************************************************************
+ * @file    pid_fixed.h
+ * @brief   定点PID控制器库，用于没有FPU的单片机
+ * @author  XiFeng
+ * @version 1.0.0
+ ******************************************************************************
+ * @attention
+ *
+ * 与 pid.c 相同的位置式/增量式公式、输出限幅和积分限幅，只用整数运算
+ * 目标值、当前值、输出为整数（编码器计数、PWM 占空比等），增益为定点数，
+ * 小数位数 q 每个控制器单独选择，所有加法和乘积都做饱和处理
+ *
+ *   PID_Q15_T  16位信号和增益，16x16->32位乘法，适合 STC16、8位/16位单片机
+ *   PID_Q31_T  32位信号和增益，32x32->64位乘法，适合 Cortex-M0/M0+
+ *
+ ******************************************************************************
+ */
+
+#ifndef __PID_FIXED_H
+#define __PID_FIXED_H
+
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* 为0时不编译 PID_Q31_T（编译器不支持64位整数时，如 Keil C251） */
+#ifndef PID_FIXED_Q31
+#define PID_FIXED_Q31   1
+#endif
+
+/* 为1时保存比例、积分、微分分量（对应 PID_T 的 p_out/i_out/d_out），会多3次移位 */
+#ifndef PID_FIXED_DEBUG
+#define PID_FIXED_DEBUG 0
+#endif
+
+/**
+ * @brief 浮点增益转为 q 位小数的定点数（四舍五入），常数参数时由编译器算好，不产生浮点运算
+ * @note 不做饱和，超出范围时用 pid_q15_gain()/pid_q31_gain() 或减小 q
+ */
+#define PID_Q15_GAIN(k, q)  ((int16_t)((k) * (float)(1L << (q)) + ((k) >= 0 ? 0.5f : -0.5f)))
+#define PID_Q31_GAIN(k, q)  ((int32_t)((k) * (double)(1LL << (q)) + ((k) >= 0 ? 0.5 : -0.5)))
+
+/* 16位定点PID结构体 */
+typedef struct
+{
+    int16_t kp;             /* 比例系数，q 位小数 */
+    int16_t ki;             /* 积分系数，q 位小数 */
+    int16_t kd;             /* 微分系数，q 位小数 */
+    uint8_t q;              /* 增益小数位数 0~15 */
+    int16_t target;         /* 目标值 */
+    int16_t current;        /* 当前值 */
+    int16_t out;            /* 执行量(输出) */
+    int16_t limit;          /* PID输出限幅值 */
+
+    int16_t error;          /* 当前误差 */
+    int16_t last_error;     /* 上一次误差 */
+    int16_t last2_error;    /* 上上次误差 */
+    int16_t integral;       /* 积分项（累加，在 int16 范围内饱和） */
+    int32_t out_acc;        /* 增量式输出累加器，q 位小数，保留不足1的增量 */
+#if PID_FIXED_DEBUG
+    int16_t p_out, i_out, d_out;    /* 比例、积分、微分分量 */
+#endif
+} PID_Q15_T;
+
+/**
+ * @brief 16位定点PID初始化
+ * @param _tpPID 指向PID结构体的指针
+ * @param _kp 比例系数，q 位小数（用 PID_Q15_GAIN() 或 pid_q15_gain() 转换）
+ * @param _ki 积分系数，q 位小数
+ * @param _kd 微分系数，q 位小数
+ * @param _q 增益小数位数 0~15
+ * @param _target 目标值
+ * @param _limit 输出限幅值
+ */
+void pid_q15_init(PID_Q15_T *_tpPID, int16_t _kp, int16_t _ki, int16_t _kd, uint8_t _q,
+                  int16_t _target, int16_t _limit);
+
+/**
+ * @brief 设置PID目标值
+ * @param _tpPID 指向PID结构体的指针
+ * @param _target 目标值
+ * @note 与 pid_set_target() 相同，会清除历史状态；每周期改目标值时直接写 target
+ */
+void pid_q15_set_target(PID_Q15_T *_tpPID, int16_t _target);
+
+/**
+ * @brief 设置PID参数，小数位数不变
+ * @param _tpPID 指向PID结构体的指针
+ * @param _kp 比例系数
+ * @param _ki 积分系数
+ * @param _kd 微分系数
+ */
+void pid_q15_set_params(PID_Q15_T *_tpPID, int16_t _kp, int16_t _ki, int16_t _kd);
+
+/**
+ * @brief 设置PID输出限幅
+ * @param _tpPID 指向PID结构体的指针
+ * @param _limit 限幅值
+ */
+void pid_q15_set_limit(PID_Q15_T *_tpPID, int16_t _limit);
+
+/**
+ * @brief 重置PID控制器，清除所有历史误差数据
+ * @param _tpPID 指向PID结构体的指针
+ */
+void pid_q15_reset(PID_Q15_T *_tpPID);
+
+/**
+ * @brief 计算位置式PID
+ * @param _tpPID 指向PID结构体的指针
+ * @param _current 当前值
+ * @return PID计算后的输出值
+ */
+int16_t pid_q15_calculate_positional(PID_Q15_T *_tpPID, int16_t _current);
+
+/**
+ * @brief 计算增量式PID
+ * @param _tpPID 指向PID结构体的指针
+ * @param _current 当前值
+ * @return PID计算后的输出值
+ */
+int16_t pid_q15_calculate_incremental(PID_Q15_T *_tpPID, int16_t _current);
+
+/**
+ * @brief 积分限幅函数
+ * @param _tpPID PID控制器
+ * @param min 最小值
+ * @param max 最大值
+ */
+void pid_q15_limit_integral(PID_Q15_T *_tpPID, int16_t min, int16_t max);
+
+/**
+ * @brief 浮点增益转为 q 位小数的16位定点数，四舍五入并饱和
+ * @param k 浮点增益
+ * @param q 小数位数
+ * @return 定点增益
+ * @note 会用到浮点运算，只在初始化或调参时调用
+ */
+int16_t pid_q15_gain(float k, uint8_t q);
+
+/**
+ * @brief 16位定点增益转回浮点数，用于显示
+ * @param k 定点增益
+ * @param q 小数位数
+ * @return 浮点增益
+ */
+float pid_q15_to_float(int16_t k, uint8_t q);
+
+#if PID_FIXED_Q31
+
+/* 32位定点PID结构体 */
+typedef struct
+{
+    int32_t kp;             /* 比例系数，q 位小数 */
+    int32_t ki;             /* 积分系数，q 位小数 */
+    int32_t kd;             /* 微分系数，q 位小数 */
+    uint8_t q;              /* 增益小数位数 0~31 */
+    int32_t target;         /* 目标值 */
+    int32_t current;        /* 当前值 */
+    int32_t out;            /* 执行量(输出) */
+    int32_t limit;          /* PID输出限幅值 */
+
+    int32_t error;          /* 当前误差 */
+    int32_t last_error;     /* 上一次误差 */
+    int32_t last2_error;    /* 上上次误差 */
+    int32_t integral;       /* 积分项（累加，在 int32 范围内饱和） */
+    int64_t out_acc;        /* 增量式输出累加器，q 位小数 */
+#if PID_FIXED_DEBUG
+    int32_t p_out, i_out, d_out;    /* 比例、积分、微分分量 */
+#endif
+} PID_Q31_T;
+
+/**
+ * @brief 32位定点PID初始化
+ * @param _tpPID 指向PID结构体的指针
+ * @param _kp 比例系数，q 位小数（用 PID_Q31_GAIN() 或 pid_q31_gain() 转换）
+ * @param _ki 积分系数，q 位小数
+ * @param _kd 微分系数，q 位小数
+ * @param _q 增益小数位数 0~31
+ * @param _target 目标值
+ * @param _limit 输出限幅值
+ */
+void pid_q31_init(PID_Q31_T *_tpPID, int32_t _kp, int32_t _ki, int32_t _kd, uint8_t _q,
+                  int32_t _target, int32_t _limit);
+
+/**
+ * @brief 设置PID目标值
+ * @param _tpPID 指向PID结构体的指针
+ * @param _target 目标值
+ * @note 与 pid_set_target() 相同，会清除历史状态；每周期改目标值时直接写 target
+ */
+void pid_q31_set_target(PID_Q31_T *_tpPID, int32_t _target);
+
+/**
+ * @brief 设置PID参数，小数位数不变
+ * @param _tpPID 指向PID结构体的指针
+ * @param _kp 比例系数
+ * @param _ki 积分系数
+ * @param _kd 微分系数
+ */
+void pid_q31_set_params(PID_Q31_T *_tpPID, int32_t _kp, int32_t _ki, int32_t _kd);
+
+/**
+ * @brief 设置PID输出限幅
+ * @param _tpPID 指向PID结构体的指针
+ * @param _limit 限幅值
+ */
+void pid_q31_set_limit(PID_Q31_T *_tpPID, int32_t _limit);
+
+/**
+ * @brief 重置PID控制器，清除所有历史误差数据
+ * @param _tpPID 指向PID结构体的指针
+ */
+void pid_q31_reset(PID_Q31_T *_tpPID);
+
+/**
+ * @brief 计算位置式PID
+ * @param _tpPID 指向PID结构体的指针
+ * @param _current 当前值
+ * @return PID计算后的输出值
+ */
+int32_t pid_q31_calculate_positional(PID_Q31_T *_tpPID, int32_t _current);
+
+/**
+ * @brief 计算增量式PID
+ * @param _tpPID 指向PID结构体的指针
+ * @param _current 当前值
+ * @return PID计算后的输出值
+ */
+int32_t pid_q31_calculate_incremental(PID_Q31_T *_tpPID, int32_t _current);
+
+/**
+ * @brief 积分限幅函数
+ * @param _tpPID PID控制器
+ * @param min 最小值
+ * @param max 最大值
+ */
+void pid_q31_limit_integral(PID_Q31_T *_tpPID, int32_t min, int32_t max);
+
+/**
+ * @brief 浮点增益转为 q 位小数的32位定点数，四舍五入并饱和
+ * @param k 浮点增益
+ * @param q 小数位数
+ * @return 定点增益
+ * @note 会用到浮点运算，只在初始化或调参时调用
+ */
+int32_t pid_q31_gain(float k, uint8_t q);
+
+/**
+ * @brief 32位定点增益转回浮点数，用于显示
+ * @param k 定点增益
+ * @param q 小数位数
+ * @return 浮点增益
+ */
+float pid_q31_to_float(int32_t k, uint8_t q);
+
+#endif /* PID_FIXED_Q31 */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* __PID_FIXED_H */